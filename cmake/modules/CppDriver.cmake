@@ -378,9 +378,11 @@ endmacro()
 #------------------------
 # CassConfigureTests
 #
-# Add test subdirs for core driver to the build if testing is enabled.
+# Add test subdirs for core driver to the build if testing or benchmarking is
+# enabled.
 #
-# Input: CASS_BUILD_INTEGRATION_TESTS, CASS_BUILD_UNIT_TESTS, CASS_ROOT_DIR
+# Input: CASS_BUILD_INTEGRATION_TESTS, CASS_BUILD_UNIT_TESTS,
+#        CASS_BUILD_BENCHMARKS, CASS_ROOT_DIR
 #------------------------
 macro(CassConfigureTests)
   if(CASS_BUILD_INTEGRATION_TESTS)
@@ -390,7 +392,7 @@ macro(CassConfigureTests)
     add_subdirectory(${CASS_ROOT_DIR}/test/integration_tests)
   endif()
 
-  if (CASS_BUILD_INTEGRATION_TESTS OR CASS_BUILD_UNIT_TESTS)
+  if (CASS_BUILD_INTEGRATION_TESTS OR CASS_BUILD_UNIT_TESTS OR CASS_BUILD_BENCHMARKS)
     add_subdirectory(${CASS_ROOT_DIR}/gtests)
   endif()
 endmacro()
@@ -1067,6 +1069,7 @@ macro(CassConfigure)
     if(CASS_USE_TIMERFD)
       check_symbol_exists(timerfd_create "sys/timerfd.h" HAVE_TIMERFD)
     endif()
+    check_symbol_exists(eventfd "sys/eventfd.h" HAVE_EVENTFD)
   else()
     check_symbol_exists(arc4random_buf "stdlib.h" HAVE_ARC4RANDOM)
   endif()
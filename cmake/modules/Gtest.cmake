@@ -241,3 +241,72 @@ macro(GtestUnitTests project_name extra_files extra_includes excluded_test_files
       COMMAND ${UNIT_TESTS_NAME})
   set_tests_properties(${UNIT_TESTS_DISPLAY_NAME} PROPERTIES TIMEOUT 5)
 endmacro()
+
+#------------------------
+# GtestBenchmarks
+#
+# Configure benchmarks to be built. The benchmarks use the Google Benchmark
+# library (1.6 or later) which must be installed (or found using
+# benchmark_DIR).
+#
+# Arguments:
+#   project_name        - Name of project that has benchmarks.
+#------------------------
+macro(GtestBenchmarks project_name)
+  find_package(benchmark 1.6 REQUIRED)
+
+  set(BENCHMARKS_NAME "${project_name}-benchmarks")
+  set(BENCHMARKS_DISPLAY_NAME "Benchmarks (${project_name})")
+  set(BENCHMARKS_SOURCE_DIR "${TESTS_SOURCE_DIR}/benchmarks")
+
+  # The benchmarks reuse the unit tests' helpers for building results and
+  # token maps.
+  set(UNIT_TESTS_SOURCE_DIR "${TESTS_SOURCE_DIR}/unit")
+  file(GLOB BENCHMARKS_INCLUDE_FILES ${BENCHMARKS_SOURCE_DIR}/*.hpp)
+  file(GLOB BENCHMARKS_SOURCE_FILES ${BENCHMARKS_SOURCE_DIR}/*.cpp)
+  source_group("Header Files" FILES ${BENCHMARKS_INCLUDE_FILES})
+  source_group("Source Files" FILES ${BENCHMARKS_SOURCE_FILES})
+  add_executable(${BENCHMARKS_NAME}
+                 ${BENCHMARKS_SOURCE_FILES}
+                 ${BENCHMARKS_INCLUDE_FILES}
+                 ${CASS_API_HEADER_FILES})
+  if(CMAKE_VERSION VERSION_LESS "2.8.11")
+    include_directories(${BENCHMARKS_SOURCE_DIR} ${UNIT_TESTS_SOURCE_DIR})
+  else()
+    target_include_directories(${BENCHMARKS_NAME}
+                               PUBLIC ${BENCHMARKS_SOURCE_DIR}
+                                      ${UNIT_TESTS_SOURCE_DIR})
+  endif()
+  target_link_libraries(${BENCHMARKS_NAME}
+                        benchmark::benchmark
+                        ${PROJECT_LIB_NAME_TARGET})
+  # Google Benchmark requires C++11
+  set_property(TARGET ${BENCHMARKS_NAME} PROPERTY CXX_STANDARD 11)
+  set_property(TARGET ${BENCHMARKS_NAME} PROPERTY PROJECT_LABEL ${BENCHMARKS_DISPLAY_NAME})
+  set_property(TARGET ${BENCHMARKS_NAME} PROPERTY FOLDER "Tests")
+  set_property(TARGET ${BENCHMARKS_NAME} APPEND PROPERTY COMPILE_FLAGS ${TEST_CXX_FLAGS})
+
+  # End-to-end benchmark using an in-process mock cluster (mockssandra)
+  set(CLUSTER_BENCHMARK_NAME "${project_name}-cluster-benchmark")
+  set(CLUSTER_BENCHMARK_DISPLAY_NAME "Cluster Benchmark (${project_name})")
+  file(GLOB CLUSTER_BENCHMARK_SOURCE_FILES ${BENCHMARKS_SOURCE_DIR}/cluster/*.cpp)
+  set(MOCKSSANDRA_FILES ${UNIT_TESTS_SOURCE_DIR}/mockssandra.hpp
+                        ${UNIT_TESTS_SOURCE_DIR}/mockssandra.cpp)
+  source_group("Source Files" FILES ${CLUSTER_BENCHMARK_SOURCE_FILES} ${MOCKSSANDRA_FILES})
+  add_executable(${CLUSTER_BENCHMARK_NAME}
+                 ${CLUSTER_BENCHMARK_SOURCE_FILES}
+                 ${MOCKSSANDRA_FILES}
+                 ${CASS_API_HEADER_FILES})
+  if(CMAKE_VERSION VERSION_LESS "2.8.11")
+    include_directories(${UNIT_TESTS_SOURCE_DIR})
+  else()
+    target_include_directories(${CLUSTER_BENCHMARK_NAME}
+                               PUBLIC ${UNIT_TESTS_SOURCE_DIR})
+  endif()
+  target_link_libraries(${CLUSTER_BENCHMARK_NAME}
+                        ${DSE_LIBS}
+                        ${PROJECT_LIB_NAME_TARGET})
+  set_property(TARGET ${CLUSTER_BENCHMARK_NAME} PROPERTY PROJECT_LABEL ${CLUSTER_BENCHMARK_DISPLAY_NAME})
+  set_property(TARGET ${CLUSTER_BENCHMARK_NAME} PROPERTY FOLDER "Tests")
+  set_property(TARGET ${CLUSTER_BENCHMARK_NAME} APPEND PROPERTY COMPILE_FLAGS ${TEST_CXX_FLAGS})
+endmacro()
@@ -0,0 +1,170 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "decoder.hpp"
+#include "result_response.hpp"
+#include "row.hpp"
+#include "test_token_map_utils.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+#define NUM_VALUES 1024
+#define NUM_ROWS 1024
+
+static void BM_DecoderInt32(benchmark::State& state) {
+  BufferBuilder builder;
+  for (int32_t i = 0; i < NUM_VALUES; ++i) {
+    builder.append<int32_t>(i);
+  }
+
+  while (state.KeepRunning()) {
+    Decoder decoder(builder.data(), builder.size());
+    int32_t value;
+    for (int i = 0; i < NUM_VALUES; ++i) {
+      decoder.decode_int32(value);
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+BENCHMARK(BM_DecoderInt32);
+
+static void BM_DecoderInt64(benchmark::State& state) {
+  BufferBuilder builder;
+  for (int64_t i = 0; i < NUM_VALUES; ++i) {
+    builder.append<int64_t>(i);
+  }
+
+  while (state.KeepRunning()) {
+    Decoder decoder(builder.data(), builder.size());
+    int64_t value;
+    for (int i = 0; i < NUM_VALUES; ++i) {
+      decoder.decode_int64(value);
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+BENCHMARK(BM_DecoderInt64);
+
+static void BM_DecoderString(benchmark::State& state) {
+  String value(static_cast<size_t>(state.range(0)), 'a');
+  BufferBuilder builder;
+  for (int i = 0; i < NUM_VALUES; ++i) {
+    builder.append_string(value);
+  }
+
+  while (state.KeepRunning()) {
+    Decoder decoder(builder.data(), builder.size());
+    StringRef output;
+    for (int i = 0; i < NUM_VALUES; ++i) {
+      decoder.decode_string(&output);
+      benchmark::DoNotOptimize(output.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+BENCHMARK(BM_DecoderString)->Arg(8)->Arg(64)->Arg(512);
+
+static void BM_DecoderBytes(benchmark::State& state) {
+  String value(static_cast<size_t>(state.range(0)), 'a');
+  BufferBuilder builder;
+  for (int i = 0; i < NUM_VALUES; ++i) {
+    builder.append_value<String>(value);
+  }
+
+  while (state.KeepRunning()) {
+    Decoder decoder(builder.data(), builder.size());
+    const char* output;
+    size_t size;
+    for (int i = 0; i < NUM_VALUES; ++i) {
+      decoder.decode_bytes(&output, size);
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+BENCHMARK(BM_DecoderBytes)->Arg(8)->Arg(64)->Arg(512);
+
+static void BM_DecoderUuid(benchmark::State& state) {
+  BufferBuilder builder;
+  for (int i = 0; i < NUM_VALUES; ++i) {
+    builder.append<int64_t>(i);
+    builder.append<int64_t>(i);
+  }
+
+  while (state.KeepRunning()) {
+    Decoder decoder(builder.data(), builder.size());
+    CassUuid value;
+    for (int i = 0; i < NUM_VALUES; ++i) {
+      decoder.decode_uuid(&value);
+      benchmark::DoNotOptimize(value);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+BENCHMARK(BM_DecoderUuid);
+
+// Decode the rows of a result with an int, bigint, text and timestamp column.
+// This is the work done by `cass_iterator_next()` for each row of a result.
+static void BM_DecodeRow(benchmark::State& state) {
+  const CassValueType types[] = { CASS_VALUE_TYPE_INT, CASS_VALUE_TYPE_BIGINT,
+                                  CASS_VALUE_TYPE_VARCHAR, CASS_VALUE_TYPE_TIMESTAMP };
+  const int32_t column_count = sizeof(types) / sizeof(types[0]);
+
+  BufferBuilder builder;
+  builder.append<int32_t>(CASS_RESULT_KIND_ROWS);
+  builder.append<int32_t>(CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+  builder.append<int32_t>(column_count);
+  builder.append_string("keyspace");
+  builder.append_string("table");
+  for (int32_t i = 0; i < column_count; ++i) {
+    OStringStream ss;
+    ss << "column" << i;
+    builder.append_string(ss.str());
+    builder.append<uint16_t>(types[i]);
+  }
+  builder.append<int32_t>(NUM_ROWS);
+  for (int32_t i = 0; i < NUM_ROWS; ++i) {
+    builder.append_value<int32_t>(i);
+    builder.append_value<int64_t>(i);
+    builder.append_value<String>("abcdefghijklmnopqrstuvwxyz");
+    builder.append_value<int64_t>(1234567890123LL);
+  }
+
+  ResultResponse result;
+  Decoder result_decoder(builder.data(), builder.size());
+  if (!result.decode(result_decoder)) {
+    state.SkipWithError("Unable to decode result");
+    return;
+  }
+
+  OutputValueVec values;
+  while (state.KeepRunning()) {
+    // The first row is decoded with the result
+    Decoder decoder(result.row_decoder());
+    for (int32_t i = 1; i < NUM_ROWS; ++i) {
+      decode_row(decoder, &result, values);
+      benchmark::DoNotOptimize(values.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (NUM_ROWS - 1));
+}
+BENCHMARK(BM_DecodeRow);
@@ -0,0 +1,95 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "dense_hash_map.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+#include <stdio.h>
+
+using datastax::String;
+using datastax::internal::DenseHashMap;
+using datastax::internal::Vector;
+
+// Keys shaped like the driver's own uses of `DenseHashMap` (e.g. prepared
+// statement ids and keyspace/table names).
+static Vector<String> create_keys(size_t count) {
+  Vector<String> keys;
+  for (size_t i = 0; i < count; ++i) {
+    char key[64];
+    sprintf(key, "keyspace%u.table%u", static_cast<unsigned>(i % 16), static_cast<unsigned>(i));
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+static void BM_DenseHashMapFind(benchmark::State& state) {
+  size_t size = static_cast<size_t>(state.range(0));
+  Vector<String> keys(create_keys(size));
+
+  DenseHashMap<String, int> map;
+  map.set_empty_key(String());
+  for (size_t i = 0; i < size; ++i) {
+    map[keys[i]] = static_cast<int>(i);
+  }
+
+  size_t index = 0;
+  while (state.KeepRunning()) {
+    DenseHashMap<String, int>::const_iterator it = map.find(keys[index++ % size]);
+    benchmark::DoNotOptimize(it->second);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DenseHashMapFind)->Arg(16)->Arg(1024)->Arg(65536);
+
+static void BM_DenseHashMapFindMissing(benchmark::State& state) {
+  size_t size = static_cast<size_t>(state.range(0));
+  Vector<String> keys(create_keys(2 * size));
+
+  DenseHashMap<String, int> map;
+  map.set_empty_key(String());
+  for (size_t i = 0; i < size; ++i) {
+    map[keys[i]] = static_cast<int>(i);
+  }
+
+  size_t index = 0;
+  while (state.KeepRunning()) {
+    DenseHashMap<String, int>::const_iterator it = map.find(keys[size + index++ % size]);
+    benchmark::DoNotOptimize(it);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DenseHashMapFindMissing)->Arg(16)->Arg(1024)->Arg(65536);
+
+static void BM_DenseHashMapFindInt(benchmark::State& state) {
+  int size = static_cast<int>(state.range(0));
+
+  DenseHashMap<int, int> map;
+  map.set_empty_key(-1);
+  for (int i = 0; i < size; ++i) {
+    map[i] = i;
+  }
+
+  int index = 0;
+  while (state.KeepRunning()) {
+    DenseHashMap<int, int>::const_iterator it = map.find(index++ % size);
+    benchmark::DoNotOptimize(it->second);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DenseHashMapFindInt)->Arg(16)->Arg(1024)->Arg(65536);
@@ -0,0 +1,129 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "buffer.hpp"
+#include "encode.hpp"
+#include "string.hpp"
+
+using datastax::String;
+using namespace datastax::internal::core;
+
+#define NUM_VALUES 1024
+
+static void BM_BufferEncodeInt32(benchmark::State& state) {
+  Buffer buffer(NUM_VALUES * sizeof(int32_t));
+
+  while (state.KeepRunning()) {
+    size_t pos = 0;
+    for (int32_t i = 0; i < NUM_VALUES; ++i) {
+      pos = buffer.encode_int32(pos, i);
+    }
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+BENCHMARK(BM_BufferEncodeInt32);
+
+static void BM_BufferEncodeInt64(benchmark::State& state) {
+  Buffer buffer(NUM_VALUES * sizeof(int64_t));
+
+  while (state.KeepRunning()) {
+    size_t pos = 0;
+    for (int64_t i = 0; i < NUM_VALUES; ++i) {
+      pos = buffer.encode_int64(pos, i);
+    }
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+}
+BENCHMARK(BM_BufferEncodeInt64);
+
+static void BM_BufferEncodeString(benchmark::State& state) {
+  String value(static_cast<size_t>(state.range(0)), 'a');
+  Buffer buffer(NUM_VALUES * (sizeof(uint16_t) + value.size()));
+
+  while (state.KeepRunning()) {
+    size_t pos = 0;
+    for (int i = 0; i < NUM_VALUES; ++i) {
+      pos = buffer.encode_string(pos, value.data(), static_cast<uint16_t>(value.size()));
+    }
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_VALUES);
+  state.SetBytesProcessed(state.iterations() * NUM_VALUES * value.size());
+}
+BENCHMARK(BM_BufferEncodeString)->Arg(8)->Arg(64)->Arg(512);
+
+// Buffers up to `Buffer::FIXED_BUFFER_SIZE` are stored inline, larger buffers
+// are allocated.
+static void BM_BufferCreate(benchmark::State& state) {
+  size_t size = static_cast<size_t>(state.range(0));
+
+  while (state.KeepRunning()) {
+    Buffer buffer(size);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BufferCreate)->Arg(8)->Arg(16)->Arg(64)->Arg(4096);
+
+static void BM_EncodeWithLengthInt32(benchmark::State& state) {
+  cass_int32_t value = 0;
+
+  while (state.KeepRunning()) {
+    Buffer buffer(encode_with_length(value++));
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeWithLengthInt32);
+
+static void BM_EncodeWithLengthInt64(benchmark::State& state) {
+  cass_int64_t value = 0;
+
+  while (state.KeepRunning()) {
+    Buffer buffer(encode_with_length(value++));
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeWithLengthInt64);
+
+static void BM_EncodeWithLengthString(benchmark::State& state) {
+  String value(static_cast<size_t>(state.range(0)), 'a');
+  CassString string(value.data(), value.size());
+
+  while (state.KeepRunning()) {
+    Buffer buffer(encode_with_length(string));
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * value.size());
+}
+BENCHMARK(BM_EncodeWithLengthString)->Arg(8)->Arg(64)->Arg(512);
+
+static void BM_EncodeWithLengthUuid(benchmark::State& state) {
+  CassUuid value = { 0x0123456789abcdefULL, 0xfedcba9876543210ULL };
+
+  while (state.KeepRunning()) {
+    Buffer buffer(encode_with_length(value));
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EncodeWithLengthUuid);
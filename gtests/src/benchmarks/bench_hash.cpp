@@ -0,0 +1,74 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "md5.hpp"
+#include "murmur3.hpp"
+#include "string.hpp"
+#include "token_map_impl.hpp"
+
+using datastax::String;
+using datastax::internal::Md5;
+using namespace datastax::internal::core;
+
+// Routing keys are usually small (e.g. a single int, bigint or uuid partition
+// key) so the sizes are biased towards the small end.
+
+static void BM_MurmurHash3(benchmark::State& state) {
+  String key(static_cast<size_t>(state.range(0)), 'a');
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        datastax::internal::MurmurHash3_x64_128(key.data(), static_cast<int>(key.size()), 0));
+  }
+  state.SetBytesProcessed(state.iterations() * key.size());
+}
+BENCHMARK(BM_MurmurHash3)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(512);
+
+static void BM_Md5(benchmark::State& state) {
+  String key(static_cast<size_t>(state.range(0)), 'a');
+
+  while (state.KeepRunning()) {
+    uint8_t result[16];
+    Md5 md5;
+    md5.update(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+    md5.final(result);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * key.size());
+}
+BENCHMARK(BM_Md5)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(512);
+
+static void BM_Murmur3PartitionerHash(benchmark::State& state) {
+  String key(static_cast<size_t>(state.range(0)), 'a');
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(Murmur3Partitioner::hash(key));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Murmur3PartitionerHash)->Arg(4)->Arg(8)->Arg(16);
+
+static void BM_RandomPartitionerHash(benchmark::State& state) {
+  String key(static_cast<size_t>(state.range(0)), 'a');
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(RandomPartitioner::hash(key));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RandomPartitionerHash)->Arg(4)->Arg(8)->Arg(16);
@@ -0,0 +1,155 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "atomic.hpp"
+#include "lane_queue.hpp"
+#include "mpmc_queue.hpp"
+#include "scoped_ptr.hpp"
+#include "spsc_queue.hpp"
+
+#include <uv.h>
+#include <vector>
+
+using datastax::internal::Atomic;
+using datastax::internal::ScopedPtr;
+using datastax::internal::core::LaneQueue;
+using datastax::internal::core::MPMCQueue;
+using datastax::internal::core::SPSCQueue;
+
+#define QUEUE_SIZE 8192
+
+// Each thread enqueues and then dequeues an item so the threads contend on
+// both ends of the queue.
+static void BM_MPMCQueueEnqueueDequeue(benchmark::State& state) {
+  static ScopedPtr<MPMCQueue<int> > queue;
+  if (state.thread_index() == 0) {
+    queue.reset(new MPMCQueue<int>(QUEUE_SIZE));
+  }
+
+  int item = 0;
+  while (state.KeepRunning()) {
+    queue->enqueue(item);
+    queue->dequeue(item);
+    benchmark::DoNotOptimize(item);
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    queue.reset();
+  }
+}
+BENCHMARK(BM_MPMCQueueEnqueueDequeue)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_SPSCQueueEnqueueDequeue(benchmark::State& state) {
+  SPSCQueue<int> queue(QUEUE_SIZE);
+
+  int item = 0;
+  while (state.KeepRunning()) {
+    queue.enqueue(item);
+    queue.dequeue(item);
+    benchmark::DoNotOptimize(item);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SPSCQueueEnqueueDequeue);
+
+// The first thread produces and the second thread consumes. Both threads run
+// the same number of iterations so every item produced is consumed.
+static void BM_SPSCQueueProducerConsumer(benchmark::State& state) {
+  static ScopedPtr<SPSCQueue<int> > queue;
+  if (state.thread_index() == 0) {
+    queue.reset(new SPSCQueue<int>(QUEUE_SIZE));
+  }
+
+  int item = 0;
+  if (state.thread_index() == 0) {
+    while (state.KeepRunning()) {
+      while (!queue->enqueue(item)) {
+      }
+    }
+  } else {
+    while (state.KeepRunning()) {
+      while (!queue->dequeue(item)) {
+      }
+      benchmark::DoNotOptimize(item);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    queue.reset();
+  }
+}
+BENCHMARK(BM_SPSCQueueProducerConsumer)->Threads(2)->UseRealTime();
+
+template <class Queue>
+struct ProducerArgs {
+  Queue* queue;
+  Atomic<bool>* is_running;
+};
+
+template <class Queue>
+static void produce(void* data) {
+  ProducerArgs<Queue>* args = static_cast<ProducerArgs<Queue>*>(data);
+  size_t item = 0;
+  while (args->is_running->load()) {
+    if (args->queue->enqueue(item)) ++item;
+  }
+}
+
+// Consume items on the benchmark thread while `state.range(0)` producer
+// threads keep the queue full, like the request queue of an I/O thread.
+template <class Queue>
+static void run_producers(benchmark::State& state, Queue* queue) {
+  size_t producer_count = static_cast<size_t>(state.range(0));
+  Atomic<bool> is_running(true);
+  std::vector<uv_thread_t> threads(producer_count);
+  std::vector<ProducerArgs<Queue> > args(producer_count);
+  for (size_t i = 0; i < producer_count; ++i) {
+    args[i].queue = queue;
+    args[i].is_running = &is_running;
+    uv_thread_create(&threads[i], produce<Queue>, &args[i]);
+  }
+
+  size_t item;
+  while (state.KeepRunning()) {
+    while (!queue->dequeue(item)) {
+    }
+    benchmark::DoNotOptimize(item);
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  is_running.store(false);
+  for (size_t i = 0; i < producer_count; ++i) {
+    uv_thread_join(&threads[i]);
+  }
+}
+
+static void BM_MPMCQueueProducers(benchmark::State& state) {
+  MPMCQueue<size_t> queue(QUEUE_SIZE);
+  run_producers(state, &queue);
+}
+BENCHMARK(BM_MPMCQueueProducers)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+
+static void BM_LaneQueueProducers(benchmark::State& state) {
+  // Thread IDs aren't reused and every run creates new producer threads so
+  // allow enough lanes that each producer still owns its lane.
+  LaneQueue<size_t> queue(QUEUE_SIZE, 4096);
+  run_producers(state, &queue);
+}
+BENCHMARK(BM_LaneQueueProducers)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
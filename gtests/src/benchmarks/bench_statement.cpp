@@ -0,0 +1,59 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "query_request.hpp"
+#include "request_callback.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class NopRequestCallback : public SimpleRequestCallback {
+public:
+  NopRequestCallback(const Request::ConstPtr& request)
+      : SimpleRequestCallback(request) {}
+
+private:
+  virtual void on_internal_set(ResponseMessage* response) {}
+  virtual void on_internal_error(CassError code, const String& message) {}
+  virtual void on_internal_timeout() {}
+};
+
+// Encode a query with `state.range(0)` bound int values and the same number of
+// bound text values.
+static void BM_StatementEncode(benchmark::State& state) {
+  size_t value_count = static_cast<size_t>(state.range(0));
+  String text("abcdefghijklmnopqrstuvwxyz");
+
+  SharedRefPtr<QueryRequest> request(new QueryRequest(
+      "INSERT INTO ks.table (key, value) VALUES (?, ?)", 2 * value_count));
+  for (size_t i = 0; i < value_count; ++i) {
+    request->set(2 * i, static_cast<cass_int32_t>(i));
+    request->set(2 * i + 1, CassString(text.data(), text.size()));
+  }
+  RequestCallback::Ptr callback(new NopRequestCallback(request));
+
+  BufferVec bufs;
+  while (state.KeepRunning()) {
+    bufs.clear();
+    int32_t length = request->encode(ProtocolVersion::highest_supported(), callback.get(), &bufs);
+    benchmark::DoNotOptimize(length);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StatementEncode)->Arg(0)->Arg(1)->Arg(8)->Arg(32);
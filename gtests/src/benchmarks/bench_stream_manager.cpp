@@ -0,0 +1,171 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "constants.hpp"
+#include "dense_hash_map.hpp"
+#include "stream_manager.hpp"
+
+#include <vector>
+
+using datastax::internal::DenseHashMap;
+using datastax::internal::core::StreamManager;
+
+// Acquire and release a single stream while `state.range(0)` other streams
+// are in-flight. The more streams that are in use the further the search for
+// a free stream has to go.
+static void BM_StreamManagerAcquireRelease(benchmark::State& state) {
+  StreamManager<int> streams;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    streams.acquire(1);
+  }
+
+  while (state.KeepRunning()) {
+    int stream = streams.acquire(1);
+    benchmark::DoNotOptimize(stream);
+    streams.release(stream);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamManagerAcquireRelease)
+    ->Arg(0)
+    ->Arg(1024)
+    ->Arg(CASS_MAX_STREAMS / 2)
+    ->Arg(CASS_MAX_STREAMS - 1);
+
+// Acquire every stream and then release them all, like a connection that's
+// saturated and then drained.
+static void BM_StreamManagerFillDrain(benchmark::State& state) {
+  StreamManager<int> streams;
+  int max_streams = static_cast<int>(streams.max_streams());
+
+  while (state.KeepRunning()) {
+    for (int i = 0; i < max_streams; ++i) {
+      benchmark::DoNotOptimize(streams.acquire(1));
+    }
+    for (int i = 0; i < max_streams; ++i) {
+      streams.release(i);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * max_streams);
+}
+BENCHMARK(BM_StreamManagerFillDrain);
+
+// Look up the pending item for a stream and release it, as is done for every
+// response.
+static void BM_StreamManagerGetAndRelease(benchmark::State& state) {
+  StreamManager<int> streams;
+  int item = 0;
+
+  while (state.KeepRunning()) {
+    int stream = streams.acquire(1);
+    streams.get(stream, item);
+    benchmark::DoNotOptimize(item);
+    streams.release(stream);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamManagerGetAndRelease);
+
+#if defined(__GNUC__) // The baseline uses GCC builtins
+
+// The previous stream manager implementation. It tracks pending streams using a
+// hash map and searches for available streams one word of the bitmap at a
+// time. It's used as a baseline for the benchmarks below.
+class HashStreamManager {
+public:
+  struct StreamHash {
+    std::size_t operator()(int stream) const { return ((stream & 0x3F) << 10) | (stream >> 6); }
+  };
+
+  HashStreamManager()
+      : offset_(0)
+      , words_(NUM_WORDS, ~static_cast<uint64_t>(0)) {
+    pending_.set_empty_key(-1);
+    pending_.set_deleted_key(-2);
+    pending_.max_load_factor(0.4f);
+  }
+
+  int acquire(int item) {
+    const size_t offset = offset_++;
+    for (size_t i = 0; i < NUM_WORDS; ++i) {
+      size_t index = (i + offset) % NUM_WORDS;
+      uint64_t word = words_[index];
+      if (word != 0) {
+        int bit = __builtin_ctzll(word);
+        words_[index] ^= (static_cast<uint64_t>(1) << bit);
+        int stream = bit + 64 * index;
+        pending_.insert(std::pair<int, int>(stream, item));
+        return stream;
+      }
+    }
+    return -1;
+  }
+
+  void release(int stream) {
+    pending_.erase(stream);
+    words_[stream / 64] |= (static_cast<uint64_t>(1) << (stream % 64));
+  }
+
+  bool get(int stream, int& output) {
+    DenseHashMap<int, int, StreamHash>::iterator it = pending_.find(stream);
+    if (it == pending_.end()) return false;
+    output = it->second;
+    return true;
+  }
+
+private:
+  static const size_t NUM_WORDS = CASS_MAX_STREAMS / 64;
+
+  size_t offset_;
+  std::vector<uint64_t> words_;
+  DenseHashMap<int, int, StreamHash> pending_;
+};
+
+// Simulate a response being received (lookup and release) followed by a new
+// request (acquire) while `state.range(0)` requests stay in-flight.
+template <class Streams>
+static void run_in_flight(benchmark::State& state) {
+  Streams streams;
+  size_t in_flight = static_cast<size_t>(state.range(0));
+  std::vector<int> active;
+  for (size_t i = 0; i < in_flight; ++i) {
+    active.push_back(streams.acquire(static_cast<int>(i)));
+  }
+
+  size_t i = 0;
+  while (state.KeepRunning()) {
+    size_t index = (i++ * 7919) % in_flight;
+    int item = -1;
+    streams.get(active[index], item);
+    streams.release(active[index]);
+    active[index] = streams.acquire(item);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_StreamManagerInFlight(benchmark::State& state) {
+  run_in_flight<StreamManager<int> >(state);
+}
+BENCHMARK(BM_StreamManagerInFlight)->Arg(1)->Arg(128)->Arg(4096)->Arg(32000)->Arg(32767);
+
+static void BM_HashStreamManagerInFlight(benchmark::State& state) {
+  run_in_flight<HashStreamManager>(state);
+}
+BENCHMARK(BM_HashStreamManagerInFlight)->Arg(1)->Arg(128)->Arg(4096)->Arg(32000)->Arg(32767);
+
+#endif
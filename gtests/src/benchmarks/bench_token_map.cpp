@@ -0,0 +1,270 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "test_token_map_utils.hpp"
+#include "token_map.hpp"
+#include "token_ring.hpp"
+
+#include <algorithm>
+
+#include <stdio.h>
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+#define NUM_VNODES 256
+#define NUM_ROUTING_KEYS 1024
+#define REPLICATION_FACTOR 3
+
+/**
+ * Create a Murmur3 token map with `hosts_per_dc` hosts (with 256 vnodes each)
+ * in each data center. A single data center uses `SimpleStrategy` and
+ * multiple data centers use `NetworkTopologyStrategy` with a replication
+ * factor of 3 in each data center.
+ */
+static TokenMap::Ptr create_token_map(int num_dcs, int hosts_per_dc, bool build = true) {
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+  MT19937_64 rng;
+
+  ReplicationMap replication;
+  int host_count = 1;
+  for (int i = 1; i <= num_dcs; ++i) {
+    char dc[32];
+    sprintf(dc, "dc%d", i);
+    char rf[32];
+    sprintf(rf, "%d", REPLICATION_FACTOR);
+    replication[dc] = rf;
+
+    for (int j = 0; j < hosts_per_dc; ++j) {
+      char ip[32];
+      sprintf(ip, "127.0.%d.%d", host_count / 255, host_count % 255);
+      char rack[32];
+      sprintf(rack, "rack%d", j % 3 + 1);
+      host_count++;
+
+      // Note: The test utility's row builder swaps the data center and rack
+      token_map->add_host(create_host(ip, random_murmur3_tokens(rng, NUM_VNODES),
+                                      Murmur3Partitioner::name().to_string(), rack, dc));
+    }
+  }
+
+  if (num_dcs == 1) {
+    add_keyspace_simple("ks", REPLICATION_FACTOR, token_map.get());
+  } else {
+    add_keyspace_network_topology("ks", replication, token_map.get());
+  }
+
+  if (build) token_map->build();
+  return token_map;
+}
+
+static void get_replicas(benchmark::State& state, int num_dcs) {
+  TokenMap::Ptr token_map(create_token_map(num_dcs, static_cast<int>(state.range(0))));
+
+  Vector<String> routing_keys;
+  MT19937_64 rng;
+  for (int i = 0; i < NUM_ROUTING_KEYS; ++i) {
+    routing_keys.push_back(to_string(static_cast<Murmur3Partitioner::Token>(rng())));
+  }
+
+  size_t index = 0;
+  while (state.KeepRunning()) {
+    const CopyOnWriteHostVec& replicas =
+        token_map->get_replicas("ks", routing_keys[index++ % NUM_ROUTING_KEYS]);
+    benchmark::DoNotOptimize(&replicas);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_TokenMapGetReplicasSimple(benchmark::State& state) { get_replicas(state, 1); }
+BENCHMARK(BM_TokenMapGetReplicasSimple)->Arg(3)->Arg(12)->Arg(48);
+
+static void BM_TokenMapGetReplicasNetworkTopology(benchmark::State& state) {
+  get_replicas(state, 3);
+}
+BENCHMARK(BM_TokenMapGetReplicasNetworkTopology)->Arg(3)->Arg(12)->Arg(48);
+
+static void BM_TokenMapBuild(benchmark::State& state) {
+  int num_dcs = static_cast<int>(state.range(0));
+  int hosts_per_dc = static_cast<int>(state.range(1));
+
+  TokenMap::Ptr token_map;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    token_map = create_token_map(num_dcs, hosts_per_dc, false); // Also frees the previous map
+    state.ResumeTiming();
+    token_map->build();
+  }
+}
+BENCHMARK(BM_TokenMapBuild)
+    ->Args({ 1, 12 })
+    ->Args({ 3, 12 })
+    ->Args({ 3, 48 })
+    ->Unit(benchmark::kMillisecond);
+
+/**
+ * Build a token map with many keyspaces that use the same replication
+ * strategy. The replicas are only computed once and shared by the keyspaces.
+ */
+static void BM_TokenMapBuildManyKeyspaces(benchmark::State& state) {
+  int num_keyspaces = static_cast<int>(state.range(0));
+
+  ReplicationMap replication;
+  replication["dc1"] = "3";
+  replication["dc2"] = "3";
+  replication["dc3"] = "3";
+
+  TokenMap::Ptr token_map;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    token_map = create_token_map(3, 12, false); // Also frees the previous map
+    for (int i = 0; i < num_keyspaces; ++i) {
+      char keyspace_name[32];
+      sprintf(keyspace_name, "ks%d", i);
+      add_keyspace_network_topology(keyspace_name, replication, token_map.get());
+    }
+    state.ResumeTiming();
+    token_map->build();
+  }
+}
+BENCHMARK(BM_TokenMapBuildManyKeyspaces)->Arg(1)->Arg(20)->Unit(benchmark::kMillisecond);
+
+/**
+ * Build a token map with many keyspaces that have different replication
+ * strategies, but only use a single keyspace. With lazy replicas only the used
+ * keyspace's replicas are built.
+ */
+static void BM_TokenMapBuildLazyReplicas(benchmark::State& state) {
+  bool is_lazy = state.range(0) != 0;
+
+  TokenMap::Ptr token_map;
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    token_map = create_token_map(3, 12, false); // Also frees the previous map
+    token_map->set_lazy_replicas(is_lazy);
+    for (int i = 0; i < 20; ++i) {
+      char keyspace_name[32];
+      sprintf(keyspace_name, "ks%d", i);
+      char replication_factor[8];
+      ReplicationMap replication;
+      sprintf(replication_factor, "%d", i % 5 + 1);
+      replication["dc1"] = replication_factor;
+      sprintf(replication_factor, "%d", i / 5 + 1);
+      replication["dc2"] = replication_factor;
+      add_keyspace_network_topology(keyspace_name, replication, token_map.get());
+    }
+    state.ResumeTiming();
+    token_map->build();
+    benchmark::DoNotOptimize(token_map->get_replicas("ks0", "key"));
+  }
+}
+BENCHMARK(BM_TokenMapBuildLazyReplicas)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+/**
+ * Bounce a single host (remove it and add it back) in an already built token
+ * map. Only the replicas of the token ranges affected by the host are
+ * recomputed.
+ */
+static void BM_TokenMapBounceHost(benchmark::State& state) {
+  int num_dcs = static_cast<int>(state.range(0));
+  int hosts_per_dc = static_cast<int>(state.range(1));
+
+  TokenMap::Ptr token_map(create_token_map(num_dcs, hosts_per_dc));
+
+  MT19937_64 rng(12345);
+  Host::Ptr host(create_host("127.1.0.1", random_murmur3_tokens(rng, NUM_VNODES),
+                             Murmur3Partitioner::name().to_string(), "rack1", "dc1"));
+  token_map->update_host_and_build(host);
+
+  while (state.KeepRunning()) {
+    token_map->remove_host_and_build(host);
+    token_map->update_host_and_build(host);
+  }
+}
+BENCHMARK(BM_TokenMapBounceHost)
+    ->Args({ 1, 12 })
+    ->Args({ 3, 12 })
+    ->Args({ 3, 48 })
+    ->Unit(benchmark::kMillisecond);
+
+typedef std::pair<Murmur3Partitioner::Token, CopyOnWriteHostVec> TokenReplicas;
+typedef Vector<TokenReplicas> TokenReplicasVec;
+
+struct TokenReplicasCompare {
+  bool operator()(const TokenReplicas& lhs, const TokenReplicas& rhs) const {
+    return lhs.first < rhs.first;
+  }
+};
+
+static void create_token_replicas(int num_tokens, TokenReplicasVec* replicas,
+                                  Vector<Murmur3Partitioner::Token>* lookups) {
+  MT19937_64 rng;
+  for (int i = 0; i < num_tokens; ++i) {
+    replicas->push_back(TokenReplicas(static_cast<Murmur3Partitioner::Token>(rng()),
+                                      CopyOnWriteHostVec(new HostVec())));
+  }
+  std::sort(replicas->begin(), replicas->end(), TokenReplicasCompare());
+  for (int i = 0; i < NUM_ROUTING_KEYS; ++i) {
+    lookups->push_back(static_cast<Murmur3Partitioner::Token>(rng()));
+  }
+}
+
+/**
+ * Token ring lookups using a binary search over a sorted vector of
+ * (token, replicas) pairs, the layout used before `TokenRing`.
+ */
+static void BM_TokenRingSortedVector(benchmark::State& state) {
+  TokenReplicasVec replicas;
+  Vector<Murmur3Partitioner::Token> lookups;
+  create_token_replicas(static_cast<int>(state.range(0)), &replicas, &lookups);
+  CopyOnWriteHostVec dummy(NULL);
+
+  size_t index = 0;
+  while (state.KeepRunning()) {
+    TokenReplicasVec::const_iterator it =
+        std::upper_bound(replicas.begin(), replicas.end(),
+                         TokenReplicas(lookups[index++ % NUM_ROUTING_KEYS], dummy),
+                         TokenReplicasCompare());
+    const CopyOnWriteHostVec& result = it != replicas.end() ? it->second : replicas.front().second;
+    benchmark::DoNotOptimize(&result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TokenRingSortedVector)
+    ->Arg(3 * NUM_VNODES)
+    ->Arg(48 * NUM_VNODES)
+    ->Arg(300 * NUM_VNODES);
+
+static void BM_TokenRingEytzinger(benchmark::State& state) {
+  TokenReplicasVec replicas;
+  Vector<Murmur3Partitioner::Token> lookups;
+  create_token_replicas(static_cast<int>(state.range(0)), &replicas, &lookups);
+  TokenRing<Murmur3Partitioner::Token, CopyOnWriteHostVec> ring;
+  ring.build(replicas);
+
+  size_t index = 0;
+  while (state.KeepRunning()) {
+    const CopyOnWriteHostVec* result = ring.find(lookups[index++ % NUM_ROUTING_KEYS]);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TokenRingEytzinger)
+    ->Arg(3 * NUM_VNODES)
+    ->Arg(48 * NUM_VNODES)
+    ->Arg(300 * NUM_VNODES);
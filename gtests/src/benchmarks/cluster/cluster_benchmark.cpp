@@ -0,0 +1,699 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+/*
+ * End-to-end throughput and latency benchmark. A `mockssandra` cluster is
+ * started in-process and driven using the public API so that results are
+ * repeatable and don't require a real cluster or network.
+ *
+ * Two load models are supported:
+ *
+ *   closed: A fixed number of requests are kept in-flight; a new request is
+ *           started as soon as one finishes.
+ *   open:   Requests are started at a fixed arrival rate regardless of how
+ *           quickly previous requests finish.
+ *
+ * Latencies are recorded into HDR histograms. In open-loop mode latency is
+ * measured from a request's intended start time which corrects for
+ * coordinated omission (a stalled client doesn't hide the requests it should
+ * have sent). In closed-loop mode the correction is made using an expected
+ * interval between requests (if one is provided).
+ */
+
+#include "cassandra.h"
+#include "get_time.hpp"
+#include "mockssandra.hpp"
+#include "scoped_lock.hpp"
+#include "third_party/hdr_histogram/hdr_histogram.hpp"
+
+#include <uv.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using datastax::String;
+using datastax::internal::Map;
+using datastax::internal::ScopedMutex;
+using datastax::internal::Vector;
+using datastax::internal::core::Address;
+
+#define HIGHEST_TRACKABLE_LATENCY_US (60ULL * 1000ULL * 1000ULL)
+
+#define BENCHMARK_QUERY "SELECT value FROM benchmark.data"
+
+namespace {
+
+enum Mode { MODE_CLOSED, MODE_OPEN };
+
+struct Settings {
+  Settings()
+      : mode(MODE_CLOSED)
+      , is_prepared(false)
+      , num_nodes(3)
+      , num_server_threads(1)
+      , num_io_threads(1)
+      , num_connections(1)
+      , concurrency(128)
+      , rate(10000)
+      , max_outstanding(16384)
+      , warmup_secs(2)
+      , duration_secs(10)
+      , jitter_ms(0)
+      , row_count(1)
+      , value_size(64)
+      , expected_interval_us(0) {}
+
+  Mode mode;
+  bool is_prepared;
+  unsigned num_nodes;
+  unsigned num_server_threads;
+  unsigned num_io_threads;
+  unsigned num_connections;
+  unsigned concurrency;
+  unsigned rate;
+  unsigned max_outstanding;
+  unsigned warmup_secs;
+  unsigned duration_secs;
+  Vector<uint64_t> latencies_ms;
+  unsigned jitter_ms;
+  unsigned row_count;
+  unsigned value_size;
+  unsigned expected_interval_us;
+  String hgrm_file;
+};
+
+void print_usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [options]\n\n"
+          "Load options:\n"
+          "  --mode=<closed|open>        Load model (default: closed)\n"
+          "  --statement=<simple|prepared>\n"
+          "                              Type of statement executed (default: simple)\n"
+          "  --concurrency=<n>           Closed-loop: in-flight requests (default: 128)\n"
+          "  --rate=<n>                  Open-loop: requests per second (default: 10000)\n"
+          "  --max-outstanding=<n>       Open-loop: in-flight request limit (default: 16384)\n"
+          "  --expected-interval-us=<n>  Closed-loop: expected interval between requests\n"
+          "                              used to correct for coordinated omission\n"
+          "  --warmup=<secs>             Time before recording starts (default: 2)\n"
+          "  --duration=<secs>           Time recorded (default: 10)\n\n"
+          "Driver options:\n"
+          "  --io-threads=<n>            Number of I/O threads (default: 1)\n"
+          "  --connections=<n>           Connections per host (default: 1)\n\n"
+          "Cluster options:\n"
+          "  --nodes=<n>                 Number of nodes (default: 3)\n"
+          "  --server-threads=<n>        Event loop threads used by the cluster; each node's\n"
+          "                              connections are spread across them (default: 1)\n"
+          "  --latency-ms=<ms>[,<ms>...] Service latency per node; the last value is used\n"
+          "                              for the remaining nodes (default: 0)\n"
+          "  --jitter-ms=<ms>            Random latency added to each request (default: 0)\n"
+          "  --rows=<n>                  Rows per result (default: 1)\n"
+          "  --value-size=<bytes>        Size of the value in each row (default: 64)\n\n"
+          "Output options:\n"
+          "  --hgrm=<file>               Write the corrected latency distribution\n"
+          "                              (HdrHistogram percentile format)\n",
+          program);
+}
+
+bool parse_unsigned(const char* value, unsigned* result) {
+  char* end;
+  errno = 0;
+  unsigned long temp = strtoul(value, &end, 10);
+  if (errno != 0 || end == value || *end != '\0') {
+    return false;
+  }
+  *result = static_cast<unsigned>(temp);
+  return true;
+}
+
+bool parse_latencies(const char* value, Vector<uint64_t>* result) {
+  const char* pos = value;
+  while (true) {
+    char* end;
+    errno = 0;
+    unsigned long long latency = strtoull(pos, &end, 10);
+    if (errno != 0 || end == pos || (*end != ',' && *end != '\0')) {
+      return false;
+    }
+    result->push_back(latency);
+    if (*end == '\0') break;
+    pos = end + 1;
+  }
+  return true;
+}
+
+bool parse_settings(int argc, char* argv[], Settings* settings) {
+  for (int i = 1; i < argc; ++i) {
+    String arg(argv[i]);
+    size_t pos = arg.find('=');
+    if (arg.compare(0, 2, "--") != 0 || pos == String::npos) {
+      fprintf(stderr, "Invalid argument '%s'\n", argv[i]);
+      return false;
+    }
+    String name(arg.substr(2, pos - 2));
+    const char* value = argv[i] + pos + 1;
+
+    bool is_valid = true;
+    if (name == "mode") {
+      if (strcmp(value, "closed") == 0) {
+        settings->mode = MODE_CLOSED;
+      } else if (strcmp(value, "open") == 0) {
+        settings->mode = MODE_OPEN;
+      } else {
+        is_valid = false;
+      }
+    } else if (name == "statement") {
+      if (strcmp(value, "simple") == 0) {
+        settings->is_prepared = false;
+      } else if (strcmp(value, "prepared") == 0) {
+        settings->is_prepared = true;
+      } else {
+        is_valid = false;
+      }
+    } else if (name == "concurrency") {
+      is_valid = parse_unsigned(value, &settings->concurrency) && settings->concurrency > 0;
+    } else if (name == "rate") {
+      is_valid = parse_unsigned(value, &settings->rate) && settings->rate > 0;
+    } else if (name == "max-outstanding") {
+      is_valid = parse_unsigned(value, &settings->max_outstanding) && settings->max_outstanding > 0;
+    } else if (name == "expected-interval-us") {
+      is_valid = parse_unsigned(value, &settings->expected_interval_us);
+    } else if (name == "warmup") {
+      is_valid = parse_unsigned(value, &settings->warmup_secs);
+    } else if (name == "duration") {
+      is_valid = parse_unsigned(value, &settings->duration_secs) && settings->duration_secs > 0;
+    } else if (name == "io-threads") {
+      is_valid = parse_unsigned(value, &settings->num_io_threads) && settings->num_io_threads > 0;
+    } else if (name == "connections") {
+      is_valid = parse_unsigned(value, &settings->num_connections) && settings->num_connections > 0;
+    } else if (name == "nodes") {
+      is_valid = parse_unsigned(value, &settings->num_nodes) && settings->num_nodes > 0 &&
+                 settings->num_nodes < 255;
+    } else if (name == "server-threads") {
+      is_valid = parse_unsigned(value, &settings->num_server_threads) &&
+                 settings->num_server_threads > 0;
+    } else if (name == "latency-ms") {
+      settings->latencies_ms.clear();
+      is_valid = parse_latencies(value, &settings->latencies_ms);
+    } else if (name == "jitter-ms") {
+      is_valid = parse_unsigned(value, &settings->jitter_ms);
+    } else if (name == "rows") {
+      is_valid = parse_unsigned(value, &settings->row_count);
+    } else if (name == "value-size") {
+      is_valid = parse_unsigned(value, &settings->value_size);
+    } else if (name == "hgrm") {
+      settings->hgrm_file = value;
+    } else {
+      fprintf(stderr, "Unknown option '%s'\n", name.c_str());
+      return false;
+    }
+
+    if (!is_valid) {
+      fprintf(stderr, "Invalid value for option '%s'\n", name.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * A cheap, stateless source of randomness that's safe to use from multiple
+ * server threads (splitmix64 finalizer).
+ */
+uint64_t mix64(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+/**
+ * Delays a request using the service latency of the node that received it
+ * plus a uniformly distributed jitter.
+ */
+class ServiceLatency : public mockssandra::Action {
+public:
+  ServiceLatency(const Map<Address, uint64_t>& latencies_ms, uint64_t jitter_ms)
+      : latencies_ms_(latencies_ms)
+      , jitter_ms_(jitter_ms) {}
+
+  virtual void on_run(mockssandra::Request* request) const {
+    uint64_t timeout = 0;
+    Map<Address, uint64_t>::const_iterator it = latencies_ms_.find(request->address());
+    if (it != latencies_ms_.end()) {
+      timeout = it->second;
+    }
+    if (jitter_ms_ > 0) {
+      timeout += mix64(uv_hrtime() ^ static_cast<uint64_t>(request->stream())) % (jitter_ms_ + 1);
+    }
+    if (timeout > 0) {
+      request->wait(timeout, this);
+    } else {
+      run_next(request);
+    }
+  }
+
+private:
+  const Map<Address, uint64_t> latencies_ms_;
+  const uint64_t jitter_ms_;
+};
+
+mockssandra::ResultSet create_result(const Settings& settings) {
+  mockssandra::ResultSet::Builder builder("benchmark", "data");
+  builder.column("value", mockssandra::Type::text());
+  String value(settings.value_size, 'x');
+  for (unsigned i = 0; i < settings.row_count; ++i) {
+    builder.row(mockssandra::Row::Builder().text(value).build());
+  }
+  return builder.build();
+}
+
+/**
+ * Responds with a result of a fixed size. The result is encoded up front for
+ * each protocol version so the server's cost is mostly writing the response.
+ */
+class FixedRowsResult : public mockssandra::Action {
+public:
+  FixedRowsResult(const mockssandra::ResultSet& result) {
+    for (int version = 0; version < NUM_PROTOCOL_VERSIONS; ++version) {
+      bodies_[version] = result.encode(version);
+    }
+  }
+
+  virtual void on_run(mockssandra::Request* request) const {
+    int version = request->version();
+    if (version < 0 || version >= NUM_PROTOCOL_VERSIONS) {
+      request->error(mockssandra::ERROR_PROTOCOL_ERROR, "Invalid protocol version");
+    } else {
+      request->write(mockssandra::OPCODE_RESULT, bodies_[version]);
+    }
+  }
+
+private:
+  static const int NUM_PROTOCOL_VERSIONS = 6;
+  String bodies_[NUM_PROTOCOL_VERSIONS];
+};
+
+class BenchmarkRequestHandlerBuilder : public mockssandra::SimpleRequestHandlerBuilder {
+public:
+  BenchmarkRequestHandlerBuilder(const Settings& settings,
+                                 const Map<Address, uint64_t>& latencies) {
+    mockssandra::ResultSet result(create_result(settings));
+    on(mockssandra::OPCODE_QUERY)
+        .system_local()
+        .system_peers()
+        .is_query(BENCHMARK_QUERY)
+        .then(mockssandra::Action::Builder()
+                  .execute(new ServiceLatency(latencies, settings.jitter_ms))
+                  .execute(new FixedRowsResult(result)))
+        .empty_rows_result(0); // Other metadata queries (e.g. keyspaces)
+
+    mockssandra::Matches matches;
+    matches.push_back(mockssandra::Match(BENCHMARK_QUERY, result));
+    on(mockssandra::OPCODE_PREPARE)
+        .prepare_query(matches)
+        .error(mockssandra::ERROR_INVALID_QUERY, "Unknown query");
+    on(mockssandra::OPCODE_EXECUTE)
+        .execute(new ServiceLatency(latencies, settings.jitter_ms))
+        .execute_prepared(matches);
+  }
+};
+
+class BenchmarkCluster : public mockssandra::MultiThreadedCluster {
+public:
+  BenchmarkCluster(const Settings& settings)
+      : MultiThreadedCluster(create_request_handler(settings), settings.num_server_threads,
+                             settings.num_nodes) {}
+
+private:
+  static const mockssandra::RequestHandler* create_request_handler(const Settings& settings) {
+    // Nodes use the same sequence of addresses as the generator used by the
+    // cluster.
+    mockssandra::Ipv4AddressGenerator generator;
+    Map<Address, uint64_t> latencies;
+    for (unsigned i = 0; i < settings.num_nodes; ++i) {
+      uint64_t latency = 0;
+      if (!settings.latencies_ms.empty()) {
+        latency = settings.latencies_ms[std::min(static_cast<size_t>(i),
+                                                 settings.latencies_ms.size() - 1)];
+      }
+      latencies[generator.next()] = latency;
+    }
+    return BenchmarkRequestHandlerBuilder(settings, latencies).build();
+  }
+};
+
+class LatencyHistogram {
+public:
+  LatencyHistogram() {
+    hdr_init(1LL, HIGHEST_TRACKABLE_LATENCY_US, 3, &histogram_);
+  }
+
+  ~LatencyHistogram() { free(histogram_); }
+
+  void record(uint64_t latency_us, uint64_t expected_interval_us = 0) {
+    int64_t value = static_cast<int64_t>(latency_us > 0 ? latency_us : 1);
+    if (expected_interval_us > 0) {
+      hdr_record_corrected_value(histogram_, value, static_cast<int64_t>(expected_interval_us));
+    } else {
+      hdr_record_value(histogram_, value);
+    }
+  }
+
+  int64_t count() const { return histogram_->total_count; }
+  double mean() const { return hdr_mean(histogram_); }
+  int64_t max() const { return hdr_max(histogram_); }
+  int64_t percentile(double p) const { return hdr_value_at_percentile(histogram_, p); }
+
+  /**
+   * Write the distribution in the HdrHistogram percentile output format (the
+   * format used by HdrHistogram's plotter). Values are in milliseconds.
+   */
+  void write_percentiles(FILE* file) const {
+    fprintf(file, "%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount",
+            "1/(1-Percentile)");
+    hdr_iter iter;
+    hdr_iter_percentile_init(&iter, histogram_, 5);
+    while (hdr_iter_next(&iter)) {
+      double value = static_cast<double>(iter.highest_equivalent_value) / 1000.0;
+      double percentile = iter.specifics.percentiles.percentile / 100.0;
+      if (percentile < 1.0) {
+        fprintf(file, "%12.3f %2.12f %10lld %14.2f\n", value, percentile,
+                static_cast<long long>(iter.count_to_index), 1.0 / (1.0 - percentile));
+      } else {
+        fprintf(file, "%12.3f %2.12f %10lld\n", value, percentile,
+                static_cast<long long>(iter.count_to_index));
+      }
+    }
+    fprintf(file, "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", hdr_mean(histogram_) / 1000.0,
+            hdr_stddev(histogram_) / 1000.0);
+    fprintf(file, "#[Max     = %12.3f, Total count    = %12lld]\n",
+            static_cast<double>(hdr_max(histogram_)) / 1000.0,
+            static_cast<long long>(histogram_->total_count));
+  }
+
+private:
+  hdr_histogram* histogram_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(LatencyHistogram);
+};
+
+/**
+ * Generates load using the public API and records the results.
+ */
+class LoadGenerator {
+public:
+  LoadGenerator(CassSession* session, const CassPrepared* prepared, const Settings& settings)
+      : session_(session)
+      , prepared_(prepared)
+      , settings_(settings)
+      , measure_start_(0)
+      , end_(0)
+      , outstanding_(0)
+      , is_waiting_(false)
+      , completed_(0)
+      , errors_(0)
+      , last_error_(CASS_OK) {
+    uv_mutex_init(&mutex_);
+    uv_cond_init(&cond_);
+  }
+
+  ~LoadGenerator() {
+    uv_cond_destroy(&cond_);
+    uv_mutex_destroy(&mutex_);
+  }
+
+  void run() {
+    uint64_t start = uv_hrtime();
+    measure_start_ = start + settings_.warmup_secs * NANOSECONDS_PER_SECOND;
+    end_ = measure_start_ + settings_.duration_secs * NANOSECONDS_PER_SECOND;
+
+    if (settings_.mode == MODE_CLOSED) {
+      run_closed(start);
+    } else {
+      run_open(start);
+    }
+
+    ScopedMutex l(&mutex_);
+    is_waiting_ = true;
+    while (outstanding_ > 0) {
+      uv_cond_wait(&cond_, l.get());
+    }
+    is_waiting_ = false;
+  }
+
+  void report(FILE* file) const {
+    double duration = static_cast<double>(settings_.duration_secs);
+    fprintf(file, "Mode:            %s\n",
+            settings_.mode == MODE_CLOSED ? "closed-loop" : "open-loop");
+    if (settings_.mode == MODE_CLOSED) {
+      fprintf(file, "Concurrency:     %u\n", settings_.concurrency);
+    } else {
+      fprintf(file, "Target rate:     %u req/s\n", settings_.rate);
+    }
+    fprintf(file, "Statement:       %s\n", prepared_ ? "prepared" : "simple");
+    fprintf(file, "Nodes:           %u (%u server threads)\n", settings_.num_nodes,
+            settings_.num_server_threads);
+    fprintf(file, "I/O threads:     %u\n", settings_.num_io_threads);
+    fprintf(file, "Connections:     %u per host\n", settings_.num_connections);
+    fprintf(file, "Duration:        %u s (after %u s warmup)\n", settings_.duration_secs,
+            settings_.warmup_secs);
+    fprintf(file, "Completed:       %llu\n", static_cast<unsigned long long>(completed_));
+    fprintf(file, "Errors:          %llu", static_cast<unsigned long long>(errors_));
+    if (errors_ > 0) {
+      fprintf(file, " (last: %s)", cass_error_desc(last_error_));
+    }
+    fprintf(file, "\nThroughput:      %.1f req/s\n\n", static_cast<double>(completed_) / duration);
+
+    fprintf(file, "Latency (us)     %12s %12s\n", "corrected", "uncorrected");
+    fprintf(file, "  mean           %12.1f %12.1f\n", corrected_.mean(), uncorrected_.mean());
+    static const double percentiles[] = { 50.0, 90.0, 99.0, 99.9, 99.99 };
+    for (size_t i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); ++i) {
+      fprintf(file, "  p%-13g %12lld %12lld\n", percentiles[i],
+              static_cast<long long>(corrected_.percentile(percentiles[i])),
+              static_cast<long long>(uncorrected_.percentile(percentiles[i])));
+    }
+    fprintf(file, "  max            %12lld %12lld\n", static_cast<long long>(corrected_.max()),
+            static_cast<long long>(uncorrected_.max()));
+  }
+
+  bool write_percentiles(const String& file_name) const {
+    FILE* file = fopen(file_name.c_str(), "w");
+    if (file == NULL) {
+      return false;
+    }
+    corrected_.write_percentiles(file);
+    fclose(file);
+    return true;
+  }
+
+private:
+  struct RequestContext {
+    LoadGenerator* generator;
+    uint64_t intended_start;
+    uint64_t start;
+  };
+
+  void run_closed(uint64_t start) {
+    {
+      ScopedMutex l(&mutex_);
+      outstanding_ = settings_.concurrency;
+    }
+    for (unsigned i = 0; i < settings_.concurrency; ++i) {
+      RequestContext* context = new RequestContext();
+      context->generator = this;
+      execute(context, start);
+    }
+  }
+
+  void run_open(uint64_t start) {
+    double interval_ns = static_cast<double>(NANOSECONDS_PER_SECOND) / settings_.rate;
+    for (uint64_t i = 0;; ++i) {
+      uint64_t intended_start = start + static_cast<uint64_t>(i * interval_ns);
+      if (intended_start >= end_) break;
+
+      {
+        // The intended start time is used to measure latency so any time spent
+        // waiting here (because the client fell behind) is still accounted
+        // for.
+        ScopedMutex l(&mutex_);
+        is_waiting_ = true;
+        uint64_t now = uv_hrtime();
+        while (now < intended_start || outstanding_ >= settings_.max_outstanding) {
+          if (outstanding_ >= settings_.max_outstanding) {
+            uv_cond_wait(&cond_, l.get());
+          } else {
+            uv_cond_timedwait(&cond_, l.get(), intended_start - now);
+          }
+          now = uv_hrtime();
+        }
+        is_waiting_ = false;
+        ++outstanding_;
+      }
+
+      RequestContext* context = new RequestContext();
+      context->generator = this;
+      execute(context, intended_start);
+    }
+  }
+
+  void execute(RequestContext* context, uint64_t intended_start) {
+    context->intended_start = intended_start;
+    context->start = uv_hrtime();
+    CassStatement* statement =
+        prepared_ ? cass_prepared_bind(prepared_) : cass_statement_new(BENCHMARK_QUERY, 0);
+    CassFuture* future = cass_session_execute(session_, statement);
+    cass_future_set_callback(future, on_result, context);
+    cass_future_free(future);
+    cass_statement_free(statement);
+  }
+
+  static void on_result(CassFuture* future, void* data) {
+    RequestContext* context = static_cast<RequestContext*>(data);
+    context->generator->handle_result(future, context);
+  }
+
+  void handle_result(CassFuture* future, RequestContext* context) {
+    uint64_t now = uv_hrtime();
+    CassError rc = cass_future_error_code(future);
+
+    bool is_next = false;
+    {
+      ScopedMutex l(&mutex_);
+      if (context->intended_start >= measure_start_ && context->intended_start < end_) {
+        if (rc == CASS_OK) {
+          uint64_t latency_us = (now - context->start) / NANOSECONDS_PER_MICROSECOND;
+          uncorrected_.record(latency_us);
+          if (settings_.mode == MODE_OPEN) {
+            corrected_.record((now - context->intended_start) / NANOSECONDS_PER_MICROSECOND);
+          } else {
+            corrected_.record(latency_us, settings_.expected_interval_us);
+          }
+          ++completed_;
+        } else {
+          last_error_ = rc;
+          ++errors_;
+        }
+      }
+
+      if (settings_.mode == MODE_CLOSED && now < end_) {
+        is_next = true;
+      } else {
+        --outstanding_;
+      }
+      if (is_waiting_) {
+        uv_cond_signal(&cond_);
+      }
+    }
+
+    if (is_next) {
+      execute(context, now);
+    } else {
+      delete context;
+    }
+  }
+
+private:
+  CassSession* session_;
+  const CassPrepared* prepared_;
+  const Settings settings_;
+  uint64_t measure_start_;
+  uint64_t end_;
+
+  uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  unsigned outstanding_;
+  bool is_waiting_;
+  uint64_t completed_;
+  uint64_t errors_;
+  CassError last_error_;
+  LatencyHistogram corrected_;
+  LatencyHistogram uncorrected_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(LoadGenerator);
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  Settings settings;
+  if (!parse_settings(argc, argv, &settings)) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  cass_log_set_level(CASS_LOG_ERROR);
+
+  BenchmarkCluster mock_cluster(settings);
+  if (mock_cluster.start_all() != 0) {
+    fprintf(stderr, "Unable to start mock cluster\n");
+    return 1;
+  }
+
+  CassCluster* cluster = cass_cluster_new();
+  cass_cluster_set_contact_points(cluster, "127.0.0.1");
+  cass_cluster_set_num_threads_io(cluster, settings.num_io_threads);
+  cass_cluster_set_core_connections_per_host(cluster, settings.num_connections);
+  cass_cluster_set_queue_size_io(cluster, std::max(settings.max_outstanding, settings.concurrency));
+  cass_cluster_set_use_schema(cluster, cass_false);
+
+  CassSession* session = cass_session_new();
+  CassFuture* connect_future = cass_session_connect(session, cluster);
+  CassError rc = cass_future_error_code(connect_future);
+  cass_future_free(connect_future);
+
+  const CassPrepared* prepared = NULL;
+  if (rc == CASS_OK && settings.is_prepared) {
+    CassFuture* prepare_future = cass_session_prepare(session, BENCHMARK_QUERY);
+    rc = cass_future_error_code(prepare_future);
+    if (rc == CASS_OK) {
+      prepared = cass_future_get_prepared(prepare_future);
+    }
+    cass_future_free(prepare_future);
+  }
+
+  int result = 0;
+  if (rc != CASS_OK) {
+    fprintf(stderr, "Unable to %s: %s\n", settings.is_prepared ? "connect and prepare" : "connect",
+            cass_error_desc(rc));
+    result = 1;
+  } else {
+    LoadGenerator generator(session, prepared, settings);
+    generator.run();
+    generator.report(stdout);
+    if (!settings.hgrm_file.empty() && !generator.write_percentiles(settings.hgrm_file)) {
+      fprintf(stderr, "Unable to write '%s'\n", settings.hgrm_file.c_str());
+      result = 1;
+    }
+
+    CassFuture* close_future = cass_session_close(session);
+    cass_future_wait(close_future);
+    cass_future_free(close_future);
+  }
+
+  if (prepared) {
+    cass_prepared_free(prepared);
+  }
+  cass_session_free(session);
+  cass_cluster_free(cluster);
+  return result;
+}
@@ -0,0 +1,63 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "cassandra.h"
+#include "string.hpp"
+#include "vector.hpp"
+
+using datastax::String;
+using datastax::internal::OStringStream;
+using datastax::internal::Vector;
+
+static String driver_version() {
+  OStringStream ss;
+  ss << CASS_VERSION_MAJOR << "." << CASS_VERSION_MINOR << "." << CASS_VERSION_PATCH;
+  if (!String(CASS_VERSION_SUFFIX).empty()) {
+    ss << "-" << CASS_VERSION_SUFFIX;
+  }
+  return ss.str();
+}
+
+int main(int argc, char* argv[]) {
+  // Results are reported as JSON by default so that runs from different
+  // commits can be compared (e.g. using Google Benchmark's tools/compare.py).
+  // Arguments that come later take precedence so this can still be
+  // overridden using "--benchmark_format=console".
+  char json_format[] = "--benchmark_format=json";
+  Vector<char*> args;
+  args.push_back(argv[0]);
+  args.push_back(json_format);
+  for (int i = 1; i < argc; ++i) {
+    args.push_back(argv[i]);
+  }
+  int args_count = static_cast<int>(args.size());
+  args.push_back(NULL);
+
+  benchmark::Initialize(&args_count, &args[0]);
+  if (benchmark::ReportUnrecognizedArguments(args_count, &args[0])) {
+    return 1;
+  }
+
+  // Logging from the setup of benchmarks would add noise to the results
+  cass_log_set_level(CASS_LOG_ERROR);
+
+  benchmark::AddCustomContext("cassandra_driver_version", driver_version().c_str());
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
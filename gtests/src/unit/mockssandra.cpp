@@ -17,9 +17,12 @@
 #include "mockssandra.hpp"
 
 #include <assert.h>
+#include <errno.h>
 #include <stdio.h>
 
 #include "control_connection.hpp" // For host queries
+#include "lz4.hpp"
+#include "md5.hpp"
 #include "memory.hpp"
 #include "scoped_lock.hpp"
 #include "tracing_data_handler.hpp" // For tracing query
@@ -34,7 +37,9 @@
 #endif
 
 using datastax::internal::bind_callback;
+using datastax::internal::Lz4;
 using datastax::internal::Map;
+using datastax::internal::Md5;
 using datastax::internal::Memory;
 using datastax::internal::OStringStream;
 using datastax::internal::ScopedMutex;
@@ -262,6 +267,24 @@ Tcp::Tcp(void* data) { tcp_.data = data; }
 
 int Tcp::init(uv_loop_t* loop) { return uv_tcp_init(loop, &tcp_); }
 
+// Creates the socket up front so that options can be set before binding
+int Tcp::init(uv_loop_t* loop, int family) { return uv_tcp_init_ex(loop, &tcp_, family); }
+
+int Tcp::set_reuse_port() {
+#if defined(SO_REUSEPORT) && !defined(_WIN32)
+  uv_os_fd_t fd;
+  int rc = uv_fileno(as_handle(), &fd);
+  if (rc != 0) return rc;
+  int on = 1;
+  if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0) {
+    return -errno;
+  }
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
 int Tcp::bind(const struct sockaddr* addr) { return uv_tcp_bind(&tcp_, addr, 0); }
 
 uv_handle_t* Tcp::as_handle() { return reinterpret_cast<uv_handle_t*>(&tcp_); }
@@ -294,6 +317,16 @@ int ClientConnection::write(const char* data, size_t len) {
   }
 }
 
+int ClientConnection::write(const String& data, const char* shared_data, size_t shared_len) {
+  if (ssl_) {
+    int rc = ssl_write(data.data(), data.length());
+    if (rc != 0) return rc;
+    return ssl_write(shared_data, shared_len);
+  } else {
+    return internal_write(data.data(), data.length(), shared_data, shared_len);
+  }
+}
+
 void ClientConnection::close() {
   if (!uv_is_closing(tcp_.as_handle())) {
     uv_close(tcp_.as_handle(), on_close);
@@ -366,12 +399,15 @@ void ClientConnection::handle_write(int status) {
   on_write();
 }
 
-int ClientConnection::internal_write(const char* data, size_t len) {
-  uv_buf_t buf;
+int ClientConnection::internal_write(const char* data, size_t len, const char* shared_data,
+                                     size_t shared_len) {
+  uv_buf_t bufs[2];
   WriteReq* write = new WriteReq(data, len, this);
-  buf.base = const_cast<char*>(write->data.data());
-  buf.len = write->data.length();
-  int rc = uv_write(&write->req, tcp_.as_stream(), &buf, 1, on_write);
+  bufs[0].base = const_cast<char*>(write->data.data());
+  bufs[0].len = write->data.length();
+  bufs[1].base = const_cast<char*>(shared_data);
+  bufs[1].len = shared_len;
+  int rc = uv_write(&write->req, tcp_.as_stream(), bufs, shared_len > 0 ? 2 : 1, on_write);
   if (rc != 0) {
     delete write;
   }
@@ -464,6 +500,7 @@ ServerConnection::ServerConnection(const Address& address, const ClientConnectio
     , address_(address)
     , factory_(factory)
     , ssl_context_(NULL)
+    , is_reuse_port_(false)
     , connection_attempts_(0) {
   uv_mutex_init(&mutex_);
   uv_cond_init(&cond_);
@@ -556,6 +593,13 @@ bool ServerConnection::use_ssl(const String& key, const String& cert,
   return true;
 }
 
+bool ServerConnection::use_reuse_port() {
+#if defined(SO_REUSEPORT) && !defined(_WIN32)
+  is_reuse_port_ = true;
+#endif
+  return is_reuse_port_;
+}
+
 using datastax::internal::core::Task;
 
 class RunListen : public Task {
@@ -633,7 +677,11 @@ void ServerConnection::run(const ServerConnectionTask::Ptr& task) {
 void ServerConnection::internal_listen() {
   int rc = 0;
 
-  rc = tcp_.init(loop());
+  if (is_reuse_port_) {
+    rc = tcp_.init(loop(), address_.family() == Address::IPv6 ? AF_INET6 : AF_INET);
+  } else {
+    rc = tcp_.init(loop());
+  }
   if (rc != 0) {
     fprintf(stderr, "Unable to initialize socket\n");
     signal_listen(rc);
@@ -642,6 +690,17 @@ void ServerConnection::internal_listen() {
 
   inc_ref(); // For the TCP handle
 
+  if (is_reuse_port_) {
+    // Binding the address would fail for any other shards
+    rc = tcp_.set_reuse_port();
+    if (rc != 0) {
+      fprintf(stderr, "Unable to set SO_REUSEPORT on socket: %s\n", uv_strerror(rc));
+      uv_close(tcp_.as_handle(), on_close);
+      signal_listen(rc);
+      return;
+    }
+  }
+
   Address::SocketStorage storage;
   rc = tcp_.bind(address_.to_sockaddr(&storage));
   if (rc != 0) {
@@ -1130,6 +1189,36 @@ static String encode_header(int8_t version, int8_t flags, int16_t stream, int8_t
   return header;
 }
 
+static size_t header_size(int8_t version) { return version >= 3 ? 9 : 8; }
+
+static String compress_frame(const String& frame) {
+  const size_t size = header_size(frame[0] & 0x7F);
+  if (frame.size() <= size) {
+    return frame; // Frames without a body are never compressed
+  }
+
+  const size_t body_size = frame.size() - size;
+  String compressed;
+  encode_int32(body_size, &compressed);
+  compressed.resize(sizeof(int32_t) + Lz4::compress_bound(body_size));
+  compressed.resize(sizeof(int32_t) + Lz4::compress(frame.data() + size, body_size,
+                                                    &compressed[sizeof(int32_t)]));
+
+  String header(frame.data(), size - sizeof(int32_t));
+  header[1] = static_cast<char>(header[1] | FLAG_COMPRESSION);
+  encode_int32(compressed.size(), &header);
+  return header + compressed;
+}
+
+static bool decompress_body(const String& body, String* output) {
+  const char* end = body.data() + body.size();
+  int32_t size = 0;
+  const char* pos = decode_int32(body.data(), end, &size);
+  if (pos > end || size < 0) return false;
+  output->resize(size);
+  return Lz4::decompress(pos, end - pos, &(*output)[0], size);
+}
+
 Type Type::text() { return Type(TYPE_VARCHAR); }
 
 Type Type::inet() { return Type(TYPE_INET); }
@@ -1250,16 +1339,7 @@ String ResultSet::encode(int protocol_version) const {
 
   encode_int32(RESULT_ROWS, &body); // Result type
 
-  encode_int32(RESULT_FLAG_GLOBAL_TABLESPEC, &body); // Flags
-  encode_int32(columns_.size(), &body);              // Column count
-  encode_string(keyspace_name_, &body);              // Global spec keyspace name
-  encode_string(table_name_, &body);                 // Global spec table name
-
-  // Columns
-  for (Vector<Column>::const_iterator it = columns_.begin(), end = columns_.end(); it != end;
-       ++it) {
-    it->encode(protocol_version, &body);
-  }
+  encode_metadata(protocol_version, &body);
 
   encode_int32(rows_.size(), &body); // Row count
 
@@ -1271,6 +1351,19 @@ String ResultSet::encode(int protocol_version) const {
   return body;
 }
 
+void ResultSet::encode_metadata(int protocol_version, String* output) const {
+  encode_int32(RESULT_FLAG_GLOBAL_TABLESPEC, output); // Flags
+  encode_int32(columns_.size(), output);              // Column count
+  encode_string(keyspace_name_, output);              // Global spec keyspace name
+  encode_string(table_name_, output);                 // Global spec table name
+
+  // Columns
+  for (Vector<Column>::const_iterator it = columns_.begin(), end = columns_.end(); it != end;
+       ++it) {
+    it->encode(protocol_version, output);
+  }
+}
+
 Action::Builder& Action::Builder::reset() {
   first_.reset();
   last_ = NULL;
@@ -1345,6 +1438,14 @@ Action::Builder& Action::Builder::match_query(const Matches& matches) {
   return execute(new MatchQuery(matches));
 }
 
+Action::Builder& Action::Builder::prepare_query(const Matches& matches) {
+  return execute(new PrepareQuery(matches));
+}
+
+Action::Builder& Action::Builder::execute_prepared(const Matches& matches) {
+  return execute(new ExecutePrepared(matches));
+}
+
 Action::Builder& Action::Builder::client_options() { return execute(new ClientOptions()); }
 
 Action::Builder& Action::Builder::system_local() { return execute(new SystemLocal()); }
@@ -1424,9 +1525,11 @@ Request::Request(int8_t version, int8_t flags, int16_t stream, int8_t opcode, co
 void Request::write(int8_t opcode, const String& body) { write(stream_, opcode, body); }
 
 void Request::write(int16_t stream, int8_t opcode, const String& body) {
-  client_->write(encode_header(version_, flags_, stream, opcode, body.size()) + body);
+  client_->write_frame(encode_header(version_, flags_, stream, opcode, body.size()) + body);
 }
 
+void Request::write_frame(const String& frame) { client_->write_shared_frame(frame, stream_); }
+
 void Request::error(int32_t code, const String& message) {
   String body;
   encode_int32(code, &body);
@@ -1468,6 +1571,8 @@ bool Request::decode_execute(String* id, QueryParameters* params) {
          end();
 }
 
+bool Request::decode_execute_id(String* id) { return decode_string(start(), end(), id) <= end(); }
+
 bool Request::decode_prepare(String* query, PrepareParameters* params) {
   return decode_prepare_params(version_, decode_long_string(start(), end(), query), end(),
                                params) == end();
@@ -1509,8 +1614,10 @@ void SendAuthSuccess::on_run(Request* request) const {
 }
 
 void SendSupported::on_run(Request* request) const {
+  Map<String, Vector<String> > supported;
+  supported["COMPRESSION"].push_back("lz4");
   String body;
-  encode_uint16(0, &body);
+  encode_string_map(supported, &body);
   request->write(OPCODE_SUPPORTED, body);
 }
 
@@ -1559,6 +1666,81 @@ void MatchQuery::on_run(Request* request) const {
   run_next(request);
 }
 
+static String prepared_id(const String& query) {
+  uint8_t hash[16];
+  Md5 md5;
+  md5.update(reinterpret_cast<const uint8_t*>(query.data()), query.size());
+  md5.final(hash);
+  return String(reinterpret_cast<const char*>(hash), sizeof(hash));
+}
+
+void PrepareQuery::on_run(Request* request) const {
+  String query;
+  PrepareParameters params;
+  if (!request->decode_prepare(&query, &params)) {
+    request->error(ERROR_PROTOCOL_ERROR, "Invalid prepare message");
+    return;
+  } else {
+    for (Matches::const_iterator it = matches.begin(), end = matches.end(); it != end; ++it) {
+      if (it->first == query) {
+        int version = request->version();
+        String id(prepared_id(query));
+        String body;
+        encode_int32(RESULT_SET_PREPARED, &body);
+        encode_string(id, &body);
+        if (version >= 5) {
+          encode_string(id, &body); // Result metadata ID
+        }
+        encode_int32(0, &body); // Bind variables flags
+        encode_int32(0, &body); // Bind variables column count
+        if (version >= 4) {
+          encode_int32(0, &body); // Partition key count
+        }
+        if (version >= 2) {
+          it->second.encode_metadata(version, &body);
+        }
+        request->write(OPCODE_RESULT, body);
+        return;
+      }
+    }
+  }
+  run_next(request);
+}
+
+ExecutePrepared::ExecutePrepared(const Matches& matches) {
+  for (Matches::const_iterator it = matches.begin(), end = matches.end(); it != end; ++it) {
+    Result& result = results[prepared_id(it->first)];
+    for (int version = 1; version < NUM_PROTOCOL_VERSIONS; ++version) {
+      String body(it->second.encode(version));
+      result.frames[version] = encode_header(version, 0, 0, OPCODE_RESULT, body.size()) + body;
+      result.bodies[version] = body;
+    }
+  }
+}
+
+void ExecutePrepared::on_run(Request* request) const {
+  String id;
+  int version = request->version();
+  if (!request->decode_execute_id(&id) || version < 1 || version >= NUM_PROTOCOL_VERSIONS) {
+    request->error(ERROR_PROTOCOL_ERROR, "Invalid execute message");
+    return;
+  }
+
+  Map<String, Result>::const_iterator it = results.find(id);
+  if (it == results.end()) {
+    String body;
+    encode_int32(ERROR_UNPREPARED, &body);
+    encode_string("Prepared statement not found", &body);
+    encode_string(id, &body);
+    request->write(OPCODE_ERROR, body);
+  } else if (request->flags() != 0) {
+    // The cached frames are only valid for requests without flags (e.g. tracing)
+    request->write(OPCODE_RESULT, it->second.bodies[version]);
+  } else {
+    request->write_frame(it->second.frames[version]);
+  }
+}
+
 void ClientOptions::on_run(Request* request) const {
   String query;
   QueryParameters params;
@@ -1868,6 +2050,11 @@ void ValidateStartup::on_run(Request* request) const {
     request->error(ERROR_PROTOCOL_ERROR, "Invalid startup message");
   } else {
     request->client()->set_options(options);
+    for (Options::const_iterator it = options.begin(), end = options.end(); it != end; ++it) {
+      if (it->first == "COMPRESSION" && it->second == "lz4") {
+        request->client()->set_compression_enabled();
+      }
+    }
     run_next(request);
   }
 }
@@ -2044,11 +2231,89 @@ int32_t ProtocolHandler::decode_frame(ClientConnection* client, const char* fram
 }
 
 void ProtocolHandler::decode_body(ClientConnection* client, const char* body, int32_t len) {
-  Request::Ptr request(new Request(version_, flags_, stream_, opcode_, String(body, len), client));
+  String decoded(body, len);
+  if (flags_ & FLAG_COMPRESSION) {
+    String decompressed;
+    if (!decompress_body(decoded, &decompressed)) {
+      Request::Ptr request(new Request(version_, 0, stream_, opcode_, String(), client));
+      request->error(ERROR_PROTOCOL_ERROR, "Invalid LZ4 compressed body");
+      return;
+    }
+    decoded = decompressed;
+  }
+  Request::Ptr request(
+      new Request(version_, flags_ & ~FLAG_COMPRESSION, stream_, opcode_, decoded, client));
   request_handler_->run(request.get());
 }
 
-void ClientConnection::on_read(const char* data, size_t len) { handler_.decode(this, data, len); }
+void ClientConnection::on_read(const char* data, size_t len) {
+  if (!segment_decoder_) {
+    handler_.decode(this, data, len);
+    return;
+  }
+
+  while (len > 0) {
+    ssize_t consumed = segment_decoder_->decode(data, len);
+    if (consumed <= 0) {
+      fprintf(stderr, "Invalid segment\n");
+      close();
+      return;
+    }
+    if (segment_decoder_->is_payload_ready()) {
+      const String& payload = segment_decoder_->payload();
+      handler_.decode(this, payload.data(), payload.size());
+    }
+    data += consumed;
+    len -= consumed;
+  }
+}
+
+void ClientConnection::write_frame(const String& frame) {
+  if (segment_encoder_) {
+    datastax::internal::core::BufferVec frames, segments;
+    frames.push_back(datastax::internal::core::Buffer(frame.data(), frame.size()));
+    datastax::internal::core::SizeVec frame_sizes(1, frame.size());
+    segment_encoder_->encode(frames, frame_sizes, &segments);
+    for (datastax::internal::core::BufferVec::const_iterator it = segments.begin(),
+                                                            end = segments.end();
+         it != end; ++it) {
+      write(it->data(), it->size());
+    }
+    return;
+  }
+
+  // Protocol v5 compresses segments instead of frames
+  if (is_compression_enabled_ && (frame[0] & 0x7F) < 5) {
+    write(compress_frame(frame));
+  } else {
+    write(frame);
+  }
+
+  // Protocol v5 switches to segments after the final response of the handshake
+  int8_t opcode = frame[4];
+  if ((frame[0] & 0x7F) == 5 && (opcode == OPCODE_READY || opcode == OPCODE_AUTHENTICATE)) {
+    segment_encoder_.reset(new SegmentEncoder(is_compression_enabled_));
+    segment_decoder_.reset(new SegmentDecoder(is_compression_enabled_));
+  }
+}
+
+void ClientConnection::write_shared_frame(const String& frame, int16_t stream) {
+  int8_t version = frame[0] & 0x7F;
+  String header(frame.data(), header_size(version));
+  if (version >= 3) {
+    header[2] = static_cast<char>(stream >> 8);
+    header[3] = static_cast<char>(stream & 0xFF);
+  } else {
+    header[2] = static_cast<char>(stream);
+  }
+
+  // Segments and compressed frames are encoded from the whole frame
+  if (segment_encoder_ || is_compression_enabled_) {
+    write_frame(header + frame.substr(header.size()));
+  } else {
+    write(header, frame.data() + header.size(), frame.size() - header.size());
+  }
+}
 
 Event::Event(const String& event_body)
     : event_body_(event_body) {}
@@ -2059,7 +2324,7 @@ void Event::run(internal::ServerConnection* server_connection) {
        it != end; ++it) {
     ClientConnection* client = static_cast<ClientConnection*>(*it);
     if (client->is_registered_for_events() && client->protocol_version() > 0) {
-      client->write(
+      client->write_frame(
           encode_header(client->protocol_version(), 0, -1, OPCODE_EVENT, event_body_.size()) +
           event_body_);
     }
@@ -2193,13 +2458,43 @@ String SchemaChangeEvent::encode(SchemaChangeEvent::Target target, SchemaChangeE
   return body;
 }
 
+void Cluster::Server::listen(EventLoopGroup* event_loop_group) {
+  for (internal::ServerConnections::iterator it = connections.begin(), end = connections.end();
+       it != end; ++it) {
+    (*it)->listen(event_loop_group);
+  }
+}
+
+int Cluster::Server::wait_listen() {
+  for (internal::ServerConnections::iterator it = connections.begin(), end = connections.end();
+       it != end; ++it) {
+    int rc = (*it)->wait_listen();
+    if (rc != 0) return rc;
+  }
+  return 0;
+}
+
+void Cluster::Server::close() {
+  for (internal::ServerConnections::iterator it = connections.begin(), end = connections.end();
+       it != end; ++it) {
+    (*it)->close();
+  }
+}
+
+void Cluster::Server::wait_close() {
+  for (internal::ServerConnections::iterator it = connections.begin(), end = connections.end();
+       it != end; ++it) {
+    (*it)->wait_close();
+  }
+}
+
 void Cluster::init(AddressGenerator& generator, ClientConnectionFactory& factory,
-                   size_t num_nodes_dc1, size_t num_nodes_dc2) {
+                   size_t num_nodes_dc1, size_t num_nodes_dc2, size_t num_shards /*= 1*/) {
   for (size_t i = 0; i < num_nodes_dc1; ++i) {
-    create_and_add_server(generator, factory, "dc1");
+    create_and_add_server(generator, factory, "dc1", num_shards);
   }
   for (size_t i = 0; i < num_nodes_dc2; ++i) {
-    create_and_add_server(generator, factory, "dc2");
+    create_and_add_server(generator, factory, "dc2", num_shards);
   }
 }
 
@@ -2210,8 +2505,10 @@ String Cluster::use_ssl(const String& cn /*= ""*/) {
   String cert(Ssl::generate_cert(key, cn));
   for (size_t i = 0; i < servers_.size(); ++i) {
     Server& server = servers_[i];
-    if (!server.connection->use_ssl(key, cert)) {
-      return "";
+    for (size_t j = 0; j < server.connections.size(); ++j) {
+      if (!server.connections[j]->use_ssl(key, cert)) {
+        return "";
+      }
     }
   }
   return cert;
@@ -2221,7 +2518,7 @@ int Cluster::start_all(EventLoopGroup* event_loop_group) {
   start_all_async(event_loop_group);
   for (size_t i = 0; i < servers_.size(); ++i) {
     Server& server = servers_[i];
-    int rc = server.connection->wait_listen();
+    int rc = server.wait_listen();
     if (rc != 0) return rc;
   }
   return 0;
@@ -2230,7 +2527,7 @@ int Cluster::start_all(EventLoopGroup* event_loop_group) {
 void Cluster::start_all_async(EventLoopGroup* event_loop_group) {
   for (size_t i = 0; i < servers_.size(); ++i) {
     Server& server = servers_[i];
-    server.connection->listen(event_loop_group);
+    server.listen(event_loop_group);
   }
 }
 
@@ -2238,14 +2535,14 @@ void Cluster::stop_all() {
   stop_all_async();
   for (size_t i = 0; i < servers_.size(); ++i) {
     Server& server = servers_[i];
-    server.connection->wait_close();
+    server.wait_close();
   }
 }
 
 void Cluster::stop_all_async() {
   for (size_t i = 0; i < servers_.size(); ++i) {
     Server& server = servers_[i];
-    server.connection->close();
+    server.close();
   }
 }
 
@@ -2254,8 +2551,8 @@ int Cluster::start(EventLoopGroup* event_loop_group, size_t node) {
     return -1;
   }
   Server& server = servers_[node - 1];
-  server.connection->listen(event_loop_group);
-  return server.connection->wait_listen();
+  server.listen(event_loop_group);
+  return server.wait_listen();
 }
 
 void Cluster::start_async(EventLoopGroup* event_loop_group, size_t node) {
@@ -2263,7 +2560,7 @@ void Cluster::start_async(EventLoopGroup* event_loop_group, size_t node) {
     return;
   }
   Server& server = servers_[node - 1];
-  server.connection->listen(event_loop_group);
+  server.listen(event_loop_group);
 }
 
 void Cluster::stop(size_t node) {
@@ -2271,8 +2568,8 @@ void Cluster::stop(size_t node) {
     return;
   }
   Server& server = servers_[node - 1];
-  server.connection->close();
-  server.connection->wait_close();
+  server.close();
+  server.wait_close();
 }
 
 void Cluster::stop_async(size_t node) {
@@ -2280,7 +2577,7 @@ void Cluster::stop_async(size_t node) {
     return;
   }
   Server& server = servers_[node - 1];
-  server.connection->close();
+  server.close();
 }
 
 int Cluster::add(EventLoopGroup* event_loop_group, size_t node) {
@@ -2289,12 +2586,12 @@ int Cluster::add(EventLoopGroup* event_loop_group, size_t node) {
   }
   Server& server = servers_[node - 1];
   bool is_removed = server.is_removed.exchange(false);
-  server.connection->listen(event_loop_group);
-  int rc = server.connection->wait_listen();
+  server.listen(event_loop_group);
+  int rc = server.wait_listen();
 
   // Send the added node event after starting the socket
   if (is_removed) { // Only send topology change event if node was previously removed
-    event(TopologyChangeEvent::new_node(server.connection->address()));
+    event(TopologyChangeEvent::new_node(server.host.address));
   }
 
   return rc;
@@ -2309,11 +2606,11 @@ void Cluster::remove(size_t node) {
 
   // Send the remove node event before closing the socket
   if (!is_removed) { // Only send the topology change event if node was previously active
-    event(TopologyChangeEvent::removed_node(server.connection->address()));
+    event(TopologyChangeEvent::removed_node(server.host.address));
   }
 
-  server.connection->close();
-  server.connection->wait_close();
+  server.close();
+  server.wait_close();
 }
 
 const Host& Cluster::host(const Address& address) const {
@@ -2342,14 +2639,28 @@ unsigned Cluster::connection_attempts(size_t node) const {
     return 0;
   }
   const Server& server = servers_[node - 1];
-  return server.connection->connection_attempts();
+  unsigned attempts = 0;
+  for (size_t i = 0; i < server.connections.size(); ++i) {
+    attempts += server.connections[i]->connection_attempts();
+  }
+  return attempts;
 }
 
 int Cluster::create_and_add_server(AddressGenerator& generator, ClientConnectionFactory& factory,
-                                   const String& dc) {
+                                   const String& dc, size_t num_shards) {
   Address address(generator.next());
-  Server server(Host(address, dc, "rack1", token_rng_),
-                internal::ServerConnection::Ptr(new internal::ServerConnection(address, factory)));
+  internal::ServerConnections connections;
+  connections.push_back(
+      internal::ServerConnection::Ptr(new internal::ServerConnection(address, factory)));
+  if (num_shards > 1 && connections.front()->use_reuse_port()) {
+    for (size_t i = 1; i < num_shards; ++i) {
+      internal::ServerConnection::Ptr connection(new internal::ServerConnection(address, factory));
+      connection->use_reuse_port();
+      connections.push_back(connection);
+    }
+  }
+
+  Server server(Host(address, dc, "rack1", token_rng_), connections);
 
   servers_.push_back(server);
   return static_cast<int>(servers_.size());
@@ -2357,7 +2668,10 @@ int Cluster::create_and_add_server(AddressGenerator& generator, ClientConnection
 
 void Cluster::event(const Event::Ptr& event) {
   for (Servers::const_iterator it = servers_.begin(), end = servers_.end(); it != end; ++it) {
-    it->connection->run(internal::ServerConnectionTask::Ptr(event));
+    const internal::ServerConnections& connections = it->connections;
+    for (size_t i = 0; i < connections.size(); ++i) {
+      connections[i]->run(internal::ServerConnectionTask::Ptr(event));
+    }
   }
 }
 
@@ -2397,6 +2711,14 @@ SimpleEventLoopGroup::~SimpleEventLoopGroup() {
   join();
 }
 
+MultiThreadedCluster::MultiThreadedCluster(const RequestHandler* request_handler,
+                                           size_t num_threads, size_t num_nodes_dc1 /*= 1*/,
+                                           size_t num_nodes_dc2 /*= 0*/)
+    : factory_(request_handler, this)
+    , event_loop_group_(num_threads) {
+  init(generator_, factory_, num_nodes_dc1, num_nodes_dc2, num_threads);
+}
+
 SimpleRequestHandlerBuilder::SimpleRequestHandlerBuilder()
     : RequestHandler::Builder() {
   on(OPCODE_STARTUP).validate_startup().ready();
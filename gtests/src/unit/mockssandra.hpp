@@ -31,6 +31,7 @@
 #include "map.hpp"
 #include "ref_counted.hpp"
 #include "scoped_ptr.hpp"
+#include "segment.hpp"
 #include "string.hpp"
 #include "third_party/mt19937_64/mt19937_64.hpp"
 #include "timer.hpp"
@@ -56,6 +57,8 @@ using datastax::internal::core::Address;
 using datastax::internal::core::EventLoop;
 using datastax::internal::core::EventLoopGroup;
 using datastax::internal::core::RoundRobinEventLoopGroup;
+using datastax::internal::core::SegmentDecoder;
+using datastax::internal::core::SegmentEncoder;
 using datastax::internal::core::Task;
 using datastax::internal::core::Timer;
 
@@ -77,6 +80,8 @@ public:
   Tcp(void* data);
 
   int init(uv_loop_t* loop);
+  int init(uv_loop_t* loop, int family);
+  int set_reuse_port();
   int bind(const struct sockaddr* addr);
 
   uv_handle_t* as_handle();
@@ -101,6 +106,9 @@ public:
 
   int write(const String& data);
   int write(const char* data, size_t len);
+  // Writes a copy of `data` followed by `shared_data` (without copying it). The
+  // shared data must outlive the connection.
+  int write(const String& data, const char* shared_data, size_t shared_len);
   void close();
 
 protected:
@@ -121,7 +129,8 @@ private:
   void handle_write(int status);
 
 private:
-  int internal_write(const char* data, size_t len);
+  int internal_write(const char* data, size_t len, const char* shared_data = NULL,
+                     size_t shared_len = 0);
   int ssl_write(const char* data, size_t len);
 
   bool is_handshake_done();
@@ -177,6 +186,15 @@ public:
   bool use_ssl(const String& key, const String& cert, const String& ca_cert = "",
                bool require_client_cert = false);
 
+  /**
+   * Allow other server connections to listen on the same address (using
+   * `SO_REUSEPORT`) so that accepted connections are load balanced between
+   * them by the operating system.
+   *
+   * @return false if not supported on this platform.
+   */
+  bool use_reuse_port();
+
   void listen(EventLoopGroup* event_loop_group);
   int wait_listen();
 
@@ -223,9 +241,12 @@ private:
   const Address address_;
   const ClientConnectionFactory& factory_;
   SSL_CTX* ssl_context_;
+  bool is_reuse_port_;
   Atomic<unsigned> connection_attempts_;
 };
 
+typedef Vector<ServerConnection::Ptr> ServerConnections;
+
 } // namespace internal
 
 enum {
@@ -521,6 +542,7 @@ public:
   };
 
   String encode(int protocol_version) const;
+  void encode_metadata(int protocol_version, String* output) const;
 
   size_t column_count() const { return columns_.size(); }
 
@@ -601,6 +623,8 @@ struct Action {
     Builder& empty_rows_result(int32_t row_count);
     Builder& no_result();
     Builder& match_query(const Matches& matches);
+    Builder& prepare_query(const Matches& matches);
+    Builder& execute_prepared(const Matches& matches);
 
     Builder& client_options();
 
@@ -692,6 +716,7 @@ public:
           ClientConnection* client);
 
   int8_t version() const { return version_; }
+  int8_t flags() const { return flags_; }
   int16_t stream() const { return stream_; }
   int8_t opcode() const { return opcode_; }
 
@@ -699,6 +724,7 @@ public:
 
   void write(int8_t opcode, const String& body);
   void write(int16_t stream, int8_t opcode, const String& body);
+  void write_frame(const String& frame);
   void error(int32_t code, const String& message);
   void wait(uint64_t timeout, const Action* action);
   void close();
@@ -709,6 +735,7 @@ public:
   bool decode_register(EventTypes* types);
   bool decode_query(String* query, QueryParameters* params);
   bool decode_execute(String* id, QueryParameters* params);
+  bool decode_execute_id(String* id);
   bool decode_prepare(String* query, PrepareParameters* params);
 
   const Address& address() const;
@@ -818,6 +845,37 @@ struct MatchQuery : public Action {
   Matches matches;
 };
 
+/**
+ * Prepares queries with a known result. The prepared ID is the MD5 hash of
+ * the query.
+ */
+struct PrepareQuery : public Action {
+  PrepareQuery(const Matches& matches)
+      : matches(matches) {}
+  virtual void on_run(Request* request) const;
+  Matches matches;
+};
+
+/**
+ * Executes prepared queries (see `PrepareQuery`) using a cache of result
+ * frames that are encoded up front for every protocol version. Responses are
+ * written from the cached frames (only the header is copied) so a server can
+ * generate a high request rate.
+ */
+struct ExecutePrepared : public Action {
+  ExecutePrepared(const Matches& matches);
+  virtual void on_run(Request* request) const;
+
+  static const int NUM_PROTOCOL_VERSIONS = 6;
+
+  struct Result {
+    String bodies[NUM_PROTOCOL_VERSIONS];
+    String frames[NUM_PROTOCOL_VERSIONS];
+  };
+
+  Map<String, Result> results;
+};
+
 struct ClientOptions : public Action {
   virtual void on_run(Request* request) const;
 };
@@ -1003,7 +1061,8 @@ public:
       , handler_(request_handler)
       , cluster_(cluster)
       , protocol_version_(-1)
-      , is_registered_for_events_(false) {}
+      , is_registered_for_events_(false)
+      , is_compression_enabled_(false) {}
 
   virtual void on_read(const char* data, size_t len);
 
@@ -1017,11 +1076,23 @@ public:
   const Options& options() const { return options_; }
   void set_options(const Options& options) { options_ = options; }
 
+  bool is_compression_enabled() const { return is_compression_enabled_; }
+  void set_compression_enabled() { is_compression_enabled_ = true; }
+
+  bool is_segmented() const { return segment_encoder_.get() != NULL; }
+
+  void write_frame(const String& frame);
+  // Writes a frame that's shared by many requests with its stream replaced
+  void write_shared_frame(const String& frame, int16_t stream);
+
 private:
   ProtocolHandler handler_;
   const Cluster* cluster_;
   int protocol_version_;
   bool is_registered_for_events_;
+  bool is_compression_enabled_;
+  ScopedPtr<SegmentEncoder> segment_encoder_;
+  ScopedPtr<SegmentDecoder> segment_decoder_;
   Options options_;
 };
 
@@ -1148,7 +1219,7 @@ public:
 class Cluster {
 protected:
   void init(AddressGenerator& generator, ClientConnectionFactory& factory, size_t num_nodes_dc1,
-            size_t num_nodes_dc2);
+            size_t num_nodes_dc2, size_t num_shards = 1);
 
 public:
   ~Cluster();
@@ -1178,33 +1249,43 @@ public:
   void event(const Event::Ptr& event);
 
 private:
+  /**
+   * A node. A node's connections (shards) listen on the same address and run
+   * on different event loops; accepted connections are distributed between
+   * them.
+   */
   struct Server {
-    Server(const Host& host, const internal::ServerConnection::Ptr& connection)
+    Server(const Host& host, const internal::ServerConnections& connections)
         : host(host)
-        , connection(connection)
+        , connections(connections)
         , is_removed(false) {}
 
     Server(const Server& server)
         : host(server.host)
-        , connection(server.connection)
+        , connections(server.connections)
         , is_removed(server.is_removed.load()) {}
 
     Server& operator=(const Server& server) {
       host = server.host;
-      connection = server.connection;
+      connections = server.connections;
       is_removed.store(server.is_removed.load());
       return *this;
     }
 
+    void listen(EventLoopGroup* event_loop_group);
+    int wait_listen();
+    void close();
+    void wait_close();
+
     Host host;
-    internal::ServerConnection::Ptr connection;
+    internal::ServerConnections connections;
     Atomic<bool> is_removed;
   };
 
   typedef Vector<Server> Servers;
 
   int create_and_add_server(AddressGenerator& generator, ClientConnectionFactory& factory,
-                            const String& dc);
+                            const String& dc, size_t num_shards);
 
 private:
   Servers servers_;
@@ -1253,6 +1334,31 @@ private:
   SimpleEventLoopGroup event_loop_group_;
 };
 
+/**
+ * A cluster for generating high request rates (e.g. as the target of a
+ * benchmark). Each node has a shard on every event loop thread so that its
+ * accepted connections are spread across all the threads. This requires
+ * `SO_REUSEPORT`; without it each node only uses a single thread.
+ */
+class MultiThreadedCluster : public Cluster {
+public:
+  MultiThreadedCluster(const RequestHandler* request_handler, size_t num_threads,
+                       size_t num_nodes_dc1 = 1, size_t num_nodes_dc2 = 0);
+
+  ~MultiThreadedCluster() { stop_all(); }
+
+  int start_all() { return Cluster::start_all(&event_loop_group_); }
+
+  int start(size_t node) { return Cluster::start(&event_loop_group_, node); }
+
+  int add(size_t node) { return Cluster::add(&event_loop_group_, node); }
+
+private:
+  Ipv4AddressGenerator generator_;
+  ClientConnectionFactory factory_;
+  SimpleEventLoopGroup event_loop_group_;
+};
+
 class SimpleEchoServer {
 public:
   SimpleEchoServer()
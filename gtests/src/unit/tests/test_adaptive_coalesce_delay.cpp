@@ -0,0 +1,83 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "adaptive_coalesce_delay.hpp"
+
+using namespace datastax::internal::core;
+
+TEST(AdaptiveCoalesceDelayUnitTest, Initial) {
+  AdaptiveCoalesceDelay delay(200, 32);
+  EXPECT_EQ(200u, delay.delay_us());
+  EXPECT_LT(delay.rate(), 0.0);
+}
+
+TEST(AdaptiveCoalesceDelayUnitTest, LowLoad) {
+  AdaptiveCoalesceDelay delay(200, 32);
+
+  // A single request every millisecond can't be batched within 200 us
+  for (int i = 0; i < 10; ++i) {
+    delay.record_flush(1, 1000, 0);
+    EXPECT_EQ(0u, delay.delay_us());
+  }
+}
+
+TEST(AdaptiveCoalesceDelayUnitTest, ModerateLoad) {
+  AdaptiveCoalesceDelay delay(500, 32);
+
+  // 16 requests every 128 us takes 256 us to fill a batch
+  delay.record_flush(16, 128, 0);
+  EXPECT_EQ(256u, delay.delay_us());
+
+  // Queued requests reduce the time to wait for a full batch
+  delay.record_flush(16, 128, 16);
+  EXPECT_EQ(128u, delay.delay_us());
+
+  // The delay never exceeds the maximum
+  for (int i = 0; i < 20; ++i) {
+    delay.record_flush(1, 128, 0);
+  }
+  EXPECT_EQ(500u, delay.delay_us());
+}
+
+TEST(AdaptiveCoalesceDelayUnitTest, HighLoad) {
+  AdaptiveCoalesceDelay delay(200, 32);
+
+  // 1 request/us fills a batch in 32 us
+  delay.record_flush(100, 100, 0);
+  EXPECT_EQ(32u, delay.delay_us());
+
+  // A full batch is already queued
+  delay.record_flush(100, 100, 64);
+  EXPECT_EQ(0u, delay.delay_us());
+}
+
+TEST(AdaptiveCoalesceDelayUnitTest, Converges) {
+  AdaptiveCoalesceDelay delay(200, 32);
+
+  // Start at high load then drop to low load
+  for (int i = 0; i < 10; ++i) {
+    delay.record_flush(100, 100, 0);
+  }
+  EXPECT_EQ(32u, delay.delay_us());
+
+  for (int i = 0; i < 50; ++i) {
+    delay.record_flush(1, 1000, 0);
+  }
+  EXPECT_EQ(0u, delay.delay_us());
+  EXPECT_NEAR(0.001, delay.rate(), 0.001);
+}
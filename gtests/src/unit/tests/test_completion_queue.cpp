@@ -0,0 +1,179 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "completion_queue.hpp"
+#include "driver_config.hpp"
+#include "future.hpp"
+
+#ifdef HAVE_EVENTFD
+#include <poll.h>
+#endif
+
+using namespace datastax::internal::core;
+
+#define NUM_FUTURES 16
+
+static void set_future(void* arg) { static_cast<Future*>(arg)->set(); }
+
+#ifdef HAVE_EVENTFD
+static bool is_readable(int fd) {
+  struct pollfd pfd;
+  pfd.fd = fd;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+  return poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN);
+}
+#endif
+
+TEST(CompletionQueueUnitTest, Empty) {
+  CompletionQueue::Ptr queue(new CompletionQueue());
+  CassCompletion completions[4];
+  EXPECT_EQ(0u, queue->poll(completions, 4, 0));
+  EXPECT_EQ(0u, queue->poll(completions, 4, 1000)); // Timeout
+}
+
+TEST(CompletionQueueUnitTest, Batch) {
+  CompletionQueue::Ptr queue(new CompletionQueue());
+
+  Future::Vec futures;
+  for (size_t i = 0; i < NUM_FUTURES; ++i) {
+    Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+    EXPECT_TRUE(future->set_completion_queue(queue.get(), reinterpret_cast<void*>(i)));
+    EXPECT_FALSE(future->set_completion_queue(queue.get(), NULL));
+    futures.push_back(future);
+  }
+
+  CassCompletion completions[NUM_FUTURES];
+  EXPECT_EQ(0u, queue->poll(completions, NUM_FUTURES, 0));
+
+  for (size_t i = 0; i < NUM_FUTURES; ++i) {
+    futures[i]->set();
+  }
+
+  // Completions are retrieved in the order the futures were set
+  size_t count = queue->poll(completions, NUM_FUTURES / 2, 0);
+  ASSERT_EQ(static_cast<size_t>(NUM_FUTURES / 2), count);
+  count += queue->poll(completions + count, NUM_FUTURES, 0);
+  ASSERT_EQ(static_cast<size_t>(NUM_FUTURES), count);
+  for (size_t i = 0; i < NUM_FUTURES; ++i) {
+    EXPECT_EQ(futures[i].get(), completions[i].future->from());
+    EXPECT_EQ(reinterpret_cast<void*>(i), completions[i].tag);
+    completions[i].future->from()->dec_ref();
+  }
+  EXPECT_EQ(0u, queue->poll(completions, NUM_FUTURES, 0));
+}
+
+TEST(CompletionQueueUnitTest, AlreadySet) {
+  CompletionQueue::Ptr queue(new CompletionQueue());
+
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  future->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Timeout");
+  EXPECT_TRUE(future->set_completion_queue(queue.get(), NULL));
+
+  CassCompletion completion;
+  ASSERT_EQ(1u, queue->poll(&completion, 1, 0));
+  EXPECT_EQ(future.get(), completion.future->from());
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, completion.future->from()->error()->code);
+  completion.future->from()->dec_ref();
+}
+
+TEST(CompletionQueueUnitTest, WaitForCompletion) {
+  CompletionQueue::Ptr queue(new CompletionQueue());
+
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  future->set_completion_queue(queue.get(), NULL);
+
+  uv_thread_t thread;
+  ASSERT_EQ(0, uv_thread_create(&thread, set_future, future.get()));
+
+  CassCompletion completion;
+  size_t count = queue->poll(&completion, 1, 30 * 1000 * 1000);
+  uv_thread_join(&thread);
+
+  ASSERT_EQ(1u, count);
+  EXPECT_EQ(future.get(), completion.future->from());
+  completion.future->from()->dec_ref();
+}
+
+TEST(CompletionQueueUnitTest, PartialPolls) {
+  CompletionQueue::Ptr queue(new CompletionQueue());
+
+  // Keep a backlog of completions so that the queue is never drained
+  for (size_t i = 0; i < NUM_FUTURES; ++i) {
+    Future* future = new Future(Future::FUTURE_TYPE_GENERIC);
+    future->inc_ref(); // Transferred to the queue
+    queue->push(future, NULL);
+  }
+
+  CassCompletion completion;
+  for (size_t i = 0; i < 1000; ++i) {
+    Future* future = new Future(Future::FUTURE_TYPE_GENERIC);
+    future->inc_ref();
+    queue->push(future, NULL);
+    ASSERT_EQ(1u, queue->poll(&completion, 1, 0));
+    completion.future->from()->dec_ref();
+
+    // The retrieved completions are compacted
+    EXPECT_LE(queue->storage_size(), 2u * (NUM_FUTURES + 1));
+  }
+
+  CassCompletion completions[NUM_FUTURES];
+  ASSERT_EQ(static_cast<size_t>(NUM_FUTURES), queue->poll(completions, NUM_FUTURES, 0));
+  for (size_t i = 0; i < NUM_FUTURES; ++i) {
+    completions[i].future->from()->dec_ref();
+  }
+  EXPECT_EQ(0u, queue->storage_size());
+}
+
+TEST(CompletionQueueUnitTest, FreeWithUnretrieved) {
+  // Freeing the queue releases the futures that were never retrieved
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  {
+    CompletionQueue::Ptr queue(new CompletionQueue());
+    future->set_completion_queue(queue.get(), NULL);
+    future->set();
+    EXPECT_EQ(2, future->ref_count());
+  }
+  EXPECT_EQ(1, future->ref_count());
+}
+
+#ifdef HAVE_EVENTFD
+TEST(CompletionQueueUnitTest, FileDescriptor) {
+  CompletionQueue::Ptr queue(new CompletionQueue());
+  ASSERT_GE(queue->fd(), 0);
+  EXPECT_FALSE(is_readable(queue->fd()));
+
+  Future::Ptr future1(new Future(Future::FUTURE_TYPE_GENERIC));
+  Future::Ptr future2(new Future(Future::FUTURE_TYPE_GENERIC));
+  future1->set_completion_queue(queue.get(), NULL);
+  future2->set_completion_queue(queue.get(), NULL);
+  future1->set();
+  future2->set();
+  EXPECT_TRUE(is_readable(queue->fd()));
+
+  // The file descriptor stays readable until the queue is drained
+  CassCompletion completion;
+  ASSERT_EQ(1u, queue->poll(&completion, 1, 0));
+  completion.future->from()->dec_ref();
+  EXPECT_TRUE(is_readable(queue->fd()));
+
+  ASSERT_EQ(1u, queue->poll(&completion, 1, 0));
+  completion.future->from()->dec_ref();
+  EXPECT_FALSE(is_readable(queue->fd()));
+}
+#endif
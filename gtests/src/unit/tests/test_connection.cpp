@@ -117,6 +117,50 @@ public:
       *error_code = connector->error_code();
     }
   }
+
+  const mockssandra::RequestHandler* large_result() {
+    mockssandra::SimpleRequestHandlerBuilder builder;
+    builder.on(mockssandra::OPCODE_QUERY).execute(new LargeResult());
+    return builder.build();
+  }
+
+private:
+  // Returns a single blob that's larger than socket reads and segments
+  class LargeResult : public mockssandra::Action {
+  public:
+    virtual void on_run(mockssandra::Request* request) const {
+      String body;
+      encode_int32(mockssandra::RESULT_ROWS, &body);
+      encode_int32(1, &body); // Global table spec
+      encode_int32(1, &body); // Column count
+      encode_string("ks", &body);
+      encode_string("table", &body);
+      encode_string("value", &body);
+      encode_int16(CASS_VALUE_TYPE_BLOB, &body);
+      encode_int32(1, &body); // Row count
+      encode_int32(1024 * 1024, &body);
+      body.append(1024 * 1024, 'x');
+      request->write(mockssandra::OPCODE_RESULT, body);
+    }
+
+  private:
+    static void encode_int32(int32_t value, String* output) {
+      char buf[sizeof(int32_t)];
+      datastax::internal::encode_int32(buf, value);
+      output->append(buf, sizeof(buf));
+    }
+
+    static void encode_int16(int16_t value, String* output) {
+      char buf[sizeof(int16_t)];
+      datastax::internal::encode_int16(buf, value);
+      output->append(buf, sizeof(buf));
+    }
+
+    static void encode_string(const String& value, String* output) {
+      encode_int16(value.size(), output);
+      output->append(value);
+    }
+  };
 };
 
 TEST_F(ConnectionUnitTest, Simple) {
@@ -174,6 +218,93 @@ TEST_F(ConnectionUnitTest, Auth) {
   EXPECT_EQ(state.status, STATUS_SUCCESS);
 }
 
+TEST_F(ConnectionUnitTest, Segments) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  State state;
+  Connector::Ptr connector(new Connector(Host::Ptr(new Host(Address("127.0.0.1", PORT))),
+                                         ProtocolVersion(CASS_PROTOCOL_VERSION_V5),
+                                         bind_callback(on_connection_connected, &state)));
+
+  connector->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(state.status, STATUS_SUCCESS);
+}
+
+TEST_F(ConnectionUnitTest, CompressedSegments) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  State state;
+  Connector::Ptr connector(new Connector(Host::Ptr(new Host(Address("127.0.0.1", PORT))),
+                                         ProtocolVersion(CASS_PROTOCOL_VERSION_V5),
+                                         bind_callback(on_connection_connected, &state)));
+
+  ConnectionSettings settings;
+  settings.compression = CASS_COMPRESSION_LZ4;
+
+  connector->with_settings(settings)->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(state.status, STATUS_SUCCESS);
+  EXPECT_EQ(CASS_COMPRESSION_LZ4, state.connection->compression());
+}
+
+TEST_F(ConnectionUnitTest, AuthSegments) {
+  mockssandra::SimpleCluster cluster(auth());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  State state;
+  Connector::Ptr connector(new Connector(Host::Ptr(new Host(Address("127.0.0.1", PORT))),
+                                         ProtocolVersion(CASS_PROTOCOL_VERSION_V5),
+                                         bind_callback(on_connection_connected, &state)));
+
+  ConnectionSettings settings;
+  settings.auth_provider.reset(new PlainTextAuthProvider("cassandra", "cassandra"));
+
+  connector->with_settings(settings)->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(state.status, STATUS_SUCCESS);
+}
+
+TEST_F(ConnectionUnitTest, LargeResult) {
+  mockssandra::SimpleCluster cluster(large_result());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  State state;
+  Connector::Ptr connector(new Connector(Host::Ptr(new Host(Address("127.0.0.1", PORT))),
+                                         PROTOCOL_VERSION,
+                                         bind_callback(on_connection_connected, &state)));
+
+  connector->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(state.status, STATUS_SUCCESS);
+}
+
+TEST_F(ConnectionUnitTest, LargeResultSegments) {
+  mockssandra::SimpleCluster cluster(large_result());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  State state;
+  Connector::Ptr connector(new Connector(Host::Ptr(new Host(Address("127.0.0.1", PORT))),
+                                         ProtocolVersion(CASS_PROTOCOL_VERSION_V5),
+                                         bind_callback(on_connection_connected, &state)));
+
+  connector->connect(loop());
+
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(state.status, STATUS_SUCCESS);
+}
+
 TEST_F(ConnectionUnitTest, Ssl) {
   mockssandra::SimpleCluster cluster(simple());
   ConnectionSettings settings(use_ssl(&cluster));
@@ -49,6 +49,21 @@ public:
     EventLoop* event_loop_;
   };
 
+  class Sleep : public Task {
+  public:
+    Sleep(unsigned int sleep_ms, Atomic<int>* count)
+        : sleep_ms_(sleep_ms)
+        , count_(count) {}
+    virtual void run(EventLoop* event_loop) {
+      test::Utils::msleep(sleep_ms_);
+      count_->fetch_add(1);
+    }
+
+  private:
+    unsigned int sleep_ms_;
+    Atomic<int>* count_;
+  };
+
   class StartIoTime : public Task {
   public:
     virtual void run(EventLoop* event_loop) { event_loop->maybe_start_io_time(); }
@@ -185,3 +200,40 @@ TEST_F(EventLoopUnitTest, IoTimeElapsed) {
    * io_time_elapsed() using a uv_prepare_t on the same uv_run() iteration.
    */
 }
+
+TEST_F(EventLoopUnitTest, Stats) {
+  EventLoop event_loop;
+  ASSERT_EQ(0, event_loop.init("EventLoopUnitTest::Stats"));
+
+  // Queue the tasks before the loop is running so that they're all waiting in
+  // the task queue at the same time.
+  Atomic<int> count(0);
+  for (int i = 0; i < 4; ++i) {
+    event_loop.add(new Sleep(10, &count));
+  }
+  ASSERT_EQ(0, event_loop.run());
+
+  while (count.load() < 4) {
+    test::Utils::msleep(1);
+  }
+
+  // Leave the loop idle then wake it up so that the idle iteration completes.
+  test::Utils::msleep(50);
+  event_loop.add(new Sleep(0, &count));
+  while (count.load() < 5) {
+    test::Utils::msleep(1);
+  }
+
+  event_loop.close_handles();
+  event_loop.join();
+
+  EventLoopStats::Snapshot snapshot;
+  event_loop.stats()->get_snapshot(&snapshot);
+  EXPECT_GE(snapshot.iterations, 2u);
+  EXPECT_GE(snapshot.loop_time_ns, snapshot.poll_time_ns);
+  EXPECT_GE(snapshot.loop_time_ns - snapshot.poll_time_ns, 40u * 1000 * 1000); // Running tasks
+  EXPECT_GE(snapshot.poll_time_ns, 25u * 1000 * 1000);                          // Idle
+  EXPECT_GE(snapshot.max_iteration_time_ns, 40u * 1000 * 1000);
+  EXPECT_EQ(0u, snapshot.task_queue_depth);
+  EXPECT_EQ(4u, snapshot.max_task_queue_depth);
+}
@@ -20,9 +20,11 @@
 #include "test_utils.hpp"
 
 #include <uv.h>
+#include <utility>
 
 #define DELAY_MS 500 // 500 milliseconds
 
+using datastax::internal::core::AggregateFuture;
 using datastax::internal::core::Future;
 
 void on_timeout_set_future(uv_timer_t* handle) {
@@ -86,6 +88,58 @@ TEST(FutureUnitTest, WaitFor) {
   ASSERT_EQ(0, uv_thread_join(&thread));
 }
 
+TEST(FutureUnitTest, WaitForTimeout) {
+  Future future(Future::FUTURE_TYPE_GENERIC);
+  ASSERT_FALSE(future.wait_for(0));
+  ASSERT_FALSE(future.wait_for(1000)); // 1 millisecond
+  future.set();
+  ASSERT_TRUE(future.wait_for(0));
+}
+
+static void wait_future(void* arg) {
+  Future* future = static_cast<Future*>(arg);
+  future->wait();
+}
+
+TEST(FutureUnitTest, WaitMultipleThreads) {
+  for (int i = 0; i < 100; ++i) {
+    Future future(Future::FUTURE_TYPE_GENERIC);
+    uv_thread_t threads[4];
+    for (int j = 0; j < 4; ++j) {
+      ASSERT_EQ(0, uv_thread_create(&threads[j], wait_future, &future));
+    }
+    future.set();
+    for (int j = 0; j < 4; ++j) {
+      ASSERT_EQ(0, uv_thread_join(&threads[j]));
+    }
+  }
+}
+
+static void on_future_callback_count(CassFuture* future, void* data) {
+  static_cast<datastax::internal::Atomic<int>*>(data)->fetch_add(1);
+}
+
+static void set_callback_count(void* arg) {
+  std::pair<Future*, datastax::internal::Atomic<int>*>* args =
+      static_cast<std::pair<Future*, datastax::internal::Atomic<int>*>*>(arg);
+  args->first->set_callback(on_future_callback_count, args->second);
+}
+
+TEST(FutureUnitTest, CallbackRace) {
+  // The callback must run exactly once when the future is set concurrently
+  for (int i = 0; i < 1000; ++i) {
+    datastax::internal::Atomic<int> count(0);
+    Future future(Future::FUTURE_TYPE_GENERIC);
+    std::pair<Future*, datastax::internal::Atomic<int>*> args(&future, &count);
+
+    uv_thread_t thread;
+    ASSERT_EQ(0, uv_thread_create(&thread, set_callback_count, &args));
+    future.set();
+    ASSERT_EQ(0, uv_thread_join(&thread));
+    ASSERT_EQ(1, count.load());
+  }
+}
+
 TEST(FutureUnitTest, Error) {
   Future future(Future::FUTURE_TYPE_GENERIC);
   future.set_error(CASS_ERROR_LIB_BAD_PARAMS, "FutureUnitTest error message");
@@ -124,3 +178,55 @@ TEST(FutureUnitTest, CallbackAfterFutureIsSet) {
   ASSERT_TRUE(future.set_callback(&on_future_callback, &is_future_callback_called));
   ASSERT_TRUE(is_future_callback_called);
 }
+
+TEST(FutureUnitTest, Aggregate) {
+  AggregateFuture::Ptr all(new AggregateFuture(3));
+  Future::Ptr futures[3];
+  for (int i = 0; i < 3; ++i) {
+    futures[i].reset(new Future(Future::FUTURE_TYPE_GENERIC));
+    all->add(futures[i].get());
+  }
+
+  futures[0]->set();
+  futures[2]->set();
+  ASSERT_FALSE(all->ready());
+
+  futures[1]->set();
+  ASSERT_TRUE(all->ready());
+  ASSERT_FALSE(all->error());
+}
+
+TEST(FutureUnitTest, AggregateError) {
+  AggregateFuture::Ptr all(new AggregateFuture(3));
+  Future::Ptr futures[3];
+  for (int i = 0; i < 3; ++i) {
+    futures[i].reset(new Future(Future::FUTURE_TYPE_GENERIC));
+    all->add(futures[i].get());
+  }
+
+  // The first failure is used as the aggregate's error
+  futures[0]->set();
+  futures[2]->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "First error");
+  futures[1]->set_error(CASS_ERROR_LIB_BAD_PARAMS, "Second error");
+  ASSERT_TRUE(all->ready());
+  ASSERT_TRUE(all->error());
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, all->error()->code);
+  EXPECT_EQ("First error", all->error()->message);
+}
+
+TEST(FutureUnitTest, AggregateEmpty) {
+  AggregateFuture::Ptr all(new AggregateFuture(0));
+  ASSERT_TRUE(all->ready());
+  ASSERT_FALSE(all->error());
+}
+
+TEST(FutureUnitTest, AggregateCallback) {
+  bool is_future_callback_called = false;
+  AggregateFuture::Ptr all(new AggregateFuture(1));
+  ASSERT_TRUE(all->set_callback(&on_future_callback, &is_future_callback_called));
+
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  all->add(future.get());
+  future->set();
+  ASSERT_TRUE(is_future_callback_called);
+}
@@ -0,0 +1,177 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "lane_queue.hpp"
+
+#include <uv.h>
+#include <vector>
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+#define ITEMS_PER_THREAD 100000
+
+template <class Queue>
+struct ProducerArgs {
+  Queue* queue;
+  size_t thread_index;
+  Atomic<size_t>* ready_count;
+  size_t thread_count;
+};
+
+// Enqueue items encoded with the producer's index and a sequence number
+template <class Queue>
+static void produce(void* arg) {
+  ProducerArgs<Queue>* args = static_cast<ProducerArgs<Queue>*>(arg);
+
+  // Start all producers at (roughly) the same time
+  args->ready_count->fetch_add(1);
+  while (args->ready_count->load() < args->thread_count) {
+  }
+
+  for (size_t i = 0; i < ITEMS_PER_THREAD; ++i) {
+    size_t item = (args->thread_index << 32) | i;
+    while (!args->queue->enqueue(item)) {
+    }
+  }
+}
+
+// Run producer threads and consume all items on the current thread
+template <class Queue>
+static void run_producers(Queue* queue, size_t thread_count) {
+  Atomic<size_t> ready_count(0);
+  std::vector<uv_thread_t> threads(thread_count);
+  std::vector<ProducerArgs<Queue> > args(thread_count);
+  std::vector<size_t> expected(thread_count, 0);
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    args[i].queue = queue;
+    args[i].thread_index = i;
+    args[i].ready_count = &ready_count;
+    args[i].thread_count = thread_count;
+  }
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    EXPECT_EQ(0, uv_thread_create(&threads[i], produce<Queue>, &args[i]));
+  }
+
+  size_t remaining = thread_count * ITEMS_PER_THREAD;
+  while (remaining > 0) {
+    size_t item;
+    if (queue->dequeue(item)) {
+      // Items from the same producer must be dequeued in order
+      size_t thread_index = item >> 32;
+      EXPECT_EQ(expected[thread_index]++, item & 0xFFFFFFFF);
+      remaining--;
+    }
+  }
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    uv_thread_join(&threads[i]);
+  }
+}
+
+TEST(LaneQueueUnitTest, Simple) {
+  LaneQueue<int> queue(8);
+  EXPECT_TRUE(queue.is_empty());
+  EXPECT_EQ(0u, queue.lane_count());
+
+  int value;
+  EXPECT_FALSE(queue.dequeue(value));
+
+  // A single lane has the full size of the queue
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(queue.enqueue(i));
+  }
+  EXPECT_FALSE(queue.enqueue(8));
+  EXPECT_FALSE(queue.is_empty());
+  EXPECT_EQ(8u, queue.approx_size());
+  EXPECT_EQ(1u, queue.lane_count());
+
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_TRUE(queue.dequeue(value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_FALSE(queue.dequeue(value));
+  EXPECT_TRUE(queue.is_empty());
+}
+
+struct FillArgs {
+  LaneQueue<int>* queue;
+  size_t count;
+};
+
+static void fill(void* arg) {
+  FillArgs* args = static_cast<FillArgs*>(arg);
+  while (args->queue->enqueue(0)) {
+    args->count++;
+  }
+}
+
+static void get_thread_id(void* arg) { *static_cast<size_t*>(arg) = lane_queue_thread_id(); }
+
+TEST(LaneQueueUnitTest, SplitSize) {
+  LaneQueue<int> queue(64);
+
+  // Create the current thread's lane then fill a second lane on another thread
+  EXPECT_TRUE(queue.enqueue(0));
+  FillArgs args = { &queue, 0 };
+  uv_thread_t thread;
+  ASSERT_EQ(0, uv_thread_create(&thread, fill, &args));
+  uv_thread_join(&thread);
+  EXPECT_EQ(32u, args.count);
+
+  // The current thread's lane is limited to its share of the size
+  FillArgs current_args = { &queue, 1 };
+  fill(&current_args);
+  EXPECT_EQ(32u, current_args.count);
+  EXPECT_EQ(2u, queue.lane_count());
+  EXPECT_EQ(64u, queue.approx_size());
+}
+
+TEST(LaneQueueUnitTest, RecycledThreadIds) {
+  size_t first_id;
+  uv_thread_t thread;
+  ASSERT_EQ(0, uv_thread_create(&thread, get_thread_id, &first_id));
+  uv_thread_join(&thread);
+
+  // A new thread reuses the ID of the thread that exited
+  size_t second_id;
+  ASSERT_EQ(0, uv_thread_create(&thread, get_thread_id, &second_id));
+  uv_thread_join(&thread);
+  EXPECT_EQ(first_id, second_id);
+}
+
+#if defined(_LP64) || defined(_WIN64)
+TEST(LaneQueueUnitTest, MultipleProducers) {
+  LaneQueue<size_t> queue(1024);
+  run_producers(&queue, 8);
+  EXPECT_TRUE(queue.is_empty());
+  EXPECT_EQ(8u, queue.lane_count());
+}
+
+TEST(LaneQueueUnitTest, SharedLanes) {
+  // More producers than lanes; at most 2 lanes are owned by a single producer
+  // and the other producers share the 2 shared lanes.
+  LaneQueue<size_t> queue(1024, 2);
+  run_producers(&queue, 8);
+  EXPECT_TRUE(queue.is_empty());
+  EXPECT_GE(queue.lane_count(), 2u);
+  EXPECT_LE(queue.lane_count(), 4u);
+}
+#endif
@@ -24,6 +24,7 @@
 #include "event_loop.hpp"
 #include "latency_aware_policy.hpp"
 #include "murmur3.hpp"
+#include "power_of_two_choices_policy.hpp"
 #include "query_request.hpp"
 #include "random.hpp"
 #include "request_handler.hpp"
@@ -1015,6 +1016,70 @@ TEST(LatencyAwareLoadBalancingUnitTest, MinAverageUnderMinMeasured) {
   EXPECT_EQ(policy.min_average(), -1);
 }
 
+TEST(PowerOfTwoChoicesLoadBalancingUnitTest, InflightRequests) {
+  HostMap hosts;
+  populate_hosts(4, "rack1", LOCAL_DC, &hosts);
+  PowerOfTwoChoicesPolicy policy(new RoundRobinPolicy());
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+
+  Host::Ptr host1(hosts[addr_for_sequence(1)]);
+  for (int i = 0; i < 3; ++i) {
+    host1->increment_inflight_requests();
+  }
+
+  // Host 1 is busier than host 2 so they're swapped
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("ks", NULL, NULL));
+    const size_t seq[] = { 2, 1, 3, 4 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+
+  // Equally loaded hosts keep the child policy's order
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("ks", NULL, NULL));
+    const size_t seq[] = { 2, 3, 4, 1 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+}
+
+TEST(PowerOfTwoChoicesLoadBalancingUnitTest, LatencyWeighted) {
+  PowerOfTwoChoicesPolicy::Settings settings;
+  settings.min_measured = 0;
+
+  HostMap hosts;
+  populate_hosts(2, "rack1", LOCAL_DC, &hosts);
+  PowerOfTwoChoicesPolicy policy(new RoundRobinPolicy(), settings);
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+
+  const uint64_t one_ms = 1000000LL; // 1 ms in ns
+  Host::Ptr host1(hosts[addr_for_sequence(1)]);
+  Host::Ptr host2(hosts[addr_for_sequence(2)]);
+
+  // Without latency measurements only the in-flight requests are compared
+  host2->increment_inflight_requests();
+  EXPECT_TRUE(policy.is_less_loaded(host1, host2, uv_hrtime()));
+
+  // Host 2 has more in-flight requests, but is much faster
+  host1->update_latency(10 * one_ms);
+  host2->update_latency(one_ms);
+  EXPECT_TRUE(policy.is_less_loaded(host2, host1, uv_hrtime()));
+
+  ScopedPtr<QueryPlan> qp(policy.new_query_plan("ks", NULL, NULL));
+  const size_t seq[] = { 2, 1 };
+  verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+}
+
+TEST(PowerOfTwoChoicesLoadBalancingUnitTest, SingleHost) {
+  HostMap hosts;
+  populate_hosts(1, "rack1", LOCAL_DC, &hosts);
+  PowerOfTwoChoicesPolicy policy(new RoundRobinPolicy());
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+
+  ScopedPtr<QueryPlan> qp(policy.new_query_plan("ks", NULL, NULL));
+  const size_t seq[] = { 1 };
+  verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+}
+
 TEST(WhitelistLoadBalancingUnitTest, Hosts) {
   const int64_t num_hosts = 100;
   HostMap hosts;
@@ -0,0 +1,161 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "atomic.hpp"
+#include "constants.hpp"
+#include "logger.hpp"
+#include "test_utils.hpp"
+
+#include <string.h>
+#include <uv.h>
+
+using namespace datastax::internal;
+
+#define NUM_MESSAGES 100
+
+struct LogState {
+  LogState()
+      : count(0)
+      , dropped_warnings(0)
+      , other_thread_count(0)
+      , is_blocked(false) {
+    thread = uv_thread_self();
+  }
+
+  Atomic<int> count;
+  Atomic<int> dropped_warnings;
+  Atomic<int> other_thread_count;
+  Atomic<bool> is_blocked;
+  uv_thread_t thread;
+};
+
+static void on_log(const CassLogMessage* message, void* data) {
+  LogState* state = static_cast<LogState*>(data);
+  if (strstr(message->message, "Dropped") == message->message) {
+    state->dropped_warnings.fetch_add(1);
+    return;
+  }
+  uv_thread_t self = uv_thread_self();
+  if (!uv_thread_equal(&self, &state->thread)) {
+    state->other_thread_count.fetch_add(1);
+  }
+  state->count.fetch_add(1);
+  while (state->is_blocked.load()) {
+    test::Utils::msleep(1);
+  }
+}
+
+class LoggerUnitTest : public testing::Test {
+public:
+  virtual void SetUp() {
+    Logger::set_log_level(CASS_LOG_INFO);
+    Logger::set_callback(on_log, &state_);
+  }
+
+  virtual void TearDown() {
+    Logger::set_async(false);
+    Logger::set_queue_size(CASS_DEFAULT_LOG_QUEUE_SIZE);
+    Logger::set_log_level(CASS_LOG_DISABLED);
+    Logger::set_callback(NULL, NULL);
+  }
+
+protected:
+  LogState state_;
+};
+
+TEST_F(LoggerUnitTest, Sync) {
+  for (int i = 0; i < NUM_MESSAGES; ++i) {
+    LOG_INFO("Message %d", i);
+  }
+  EXPECT_EQ(NUM_MESSAGES, state_.count.load());
+  EXPECT_EQ(0, state_.other_thread_count.load());
+}
+
+TEST_F(LoggerUnitTest, Async) {
+  uint64_t dropped_count = Logger::dropped_count();
+
+  Logger::set_async(true);
+  for (int i = 0; i < NUM_MESSAGES; ++i) {
+    LOG_INFO("Message %d", i);
+  }
+  Logger::set_async(false); // Waits for queued messages
+
+  EXPECT_EQ(NUM_MESSAGES, state_.count.load());
+  EXPECT_EQ(NUM_MESSAGES, state_.other_thread_count.load());
+  EXPECT_EQ(dropped_count, Logger::dropped_count());
+  EXPECT_EQ(0, state_.dropped_warnings.load());
+
+  // Messages are delivered on the logging thread after disabling
+  LOG_INFO("Message");
+  EXPECT_EQ(NUM_MESSAGES + 1, state_.count.load());
+  EXPECT_EQ(NUM_MESSAGES, state_.other_thread_count.load());
+}
+
+TEST_F(LoggerUnitTest, Dropped) {
+  uint64_t dropped_count = Logger::dropped_count();
+
+  Logger::set_queue_size(4);
+  Logger::set_async(true);
+
+  // Block the background thread on the first message so the queue fills
+  state_.is_blocked.store(true);
+  LOG_INFO("Blocking message");
+  for (int i = 0; i < NUM_MESSAGES; ++i) {
+    LOG_INFO("Message %d", i);
+  }
+  state_.is_blocked.store(false);
+  Logger::set_async(false);
+
+  uint64_t dropped = Logger::dropped_count() - dropped_count;
+  EXPECT_GT(dropped, 0u);
+  EXPECT_EQ(NUM_MESSAGES + 1, state_.count.load() + static_cast<int>(dropped));
+  EXPECT_EQ(1, state_.dropped_warnings.load());
+}
+
+static void log_messages(void* arg) {
+  for (int i = 0; i < NUM_MESSAGES; ++i) {
+    LOG_INFO("Message %d", i);
+  }
+}
+
+TEST_F(LoggerUnitTest, ToggleWhileLogging) {
+  const int num_threads = 4;
+  uint64_t dropped_count = Logger::dropped_count();
+
+  uv_thread_t threads[num_threads];
+  Logger::set_async(true);
+  for (int i = 0; i < num_threads; ++i) {
+    ASSERT_EQ(0, uv_thread_create(&threads[i], log_messages, NULL));
+  }
+
+  // Messages logged while asynchronous logging is disabled (or its queue is
+  // replaced) are still delivered.
+  for (int i = 0; i < 10; ++i) {
+    Logger::set_async(false);
+    Logger::set_queue_size(i % 2 == 0 ? 64 : 128);
+    Logger::set_async(true);
+  }
+
+  for (int i = 0; i < num_threads; ++i) {
+    uv_thread_join(&threads[i]);
+  }
+  Logger::set_async(false);
+
+  uint64_t dropped = Logger::dropped_count() - dropped_count;
+  EXPECT_EQ(num_threads * NUM_MESSAGES, state_.count.load() + static_cast<int>(dropped));
+}
@@ -0,0 +1,100 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "lz4.hpp"
+#include "random.hpp"
+#include "string.hpp"
+
+using datastax::String;
+using datastax::internal::Lz4;
+
+static String compress(const String& input) {
+  String output(Lz4::compress_bound(input.size()), '\0');
+  output.resize(Lz4::compress(input.data(), input.size(), &output[0]));
+  return output;
+}
+
+static bool round_trip(const String& input) {
+  String compressed(compress(input));
+  String output(input.size(), '\0');
+  return Lz4::decompress(compressed.data(), compressed.size(), &output[0], output.size()) &&
+         output == input;
+}
+
+TEST(Lz4UnitTest, RoundTrip) {
+  EXPECT_EQ(String(1, '\0'), compress("")); // A single empty literals token
+  EXPECT_TRUE(round_trip(""));
+  EXPECT_TRUE(round_trip("a"));
+  EXPECT_TRUE(round_trip("abcdefghijklmnop"));
+
+  String repeated;
+  for (int i = 0; i < 1000; ++i) {
+    repeated.append("012345689abcdef");
+  }
+  EXPECT_TRUE(round_trip(repeated));
+  EXPECT_LT(compress(repeated).size(), repeated.size() / 10);
+
+  // Long runs of a single byte produce overlapping matches
+  EXPECT_TRUE(round_trip(String(100000, 'x')));
+}
+
+TEST(Lz4UnitTest, RoundTripRandom) {
+  MT19937_64 rng;
+  for (size_t size = 1; size <= 65536; size *= 4) {
+    String random;
+    for (size_t i = 0; i < size; ++i) {
+      // Use a small alphabet so that there's a mix of matches and literals
+      random.push_back(static_cast<char>('a' + rng() % 4));
+    }
+    EXPECT_TRUE(round_trip(random)) << "Failed with size " << size;
+  }
+}
+
+TEST(Lz4UnitTest, DecompressReferenceBlock) {
+  // Generated using the reference implementation's LZ4_compress_default()
+  const char block[] = "\xef\x48\x65\x6c\x6c\x6f\x2c\x20\x57\x6f\x72\x6c\x64\x21\x20\x0e\x00\x11"
+                       "\x50\x6f\x72\x6c\x64\x21";
+  const String expected("Hello, World! Hello, World! Hello, World! Hello, World!");
+
+  String output(expected.size(), '\0');
+  ASSERT_TRUE(Lz4::decompress(block, sizeof(block) - 1, &output[0], output.size()));
+  EXPECT_EQ(expected, output);
+}
+
+TEST(Lz4UnitTest, DecompressInvalid) {
+  String input;
+  for (int i = 0; i < 100; ++i) {
+    input.append("abcdef");
+  }
+  String compressed(compress(input));
+  String output(input.size(), '\0');
+
+  // Incorrect uncompressed size
+  EXPECT_FALSE(
+      Lz4::decompress(compressed.data(), compressed.size(), &output[0], output.size() - 1));
+  String larger(input.size() + 1, '\0');
+  EXPECT_FALSE(Lz4::decompress(compressed.data(), compressed.size(), &larger[0], larger.size()));
+
+  // Truncated input
+  EXPECT_FALSE(
+      Lz4::decompress(compressed.data(), compressed.size() - 1, &output[0], output.size()));
+
+  // Match offset that points before the start of the output
+  const char invalid_offset[] = "\x14\x61\xff\x00";
+  EXPECT_FALSE(Lz4::decompress(invalid_offset, sizeof(invalid_offset) - 1, &output[0], 9));
+}
@@ -25,7 +25,9 @@
 #define NUM_THREADS 2
 #define NUM_ITERATIONS 100
 
+using datastax::internal::core::Address;
 using datastax::internal::core::Metrics;
+using datastax::internal::core::RequestTiming;
 
 struct CounterThreadArgs {
   uv_thread_t thread;
@@ -52,6 +54,24 @@ void histogram_thread(void* data) {
   }
 }
 
+struct HostHistogramsThreadArgs {
+  uv_thread_t thread;
+  Metrics::HostHistograms* histograms;
+};
+
+Address host_histograms_address(int i) {
+  char ip[32];
+  sprintf(ip, "127.0.0.%d", (i % 10) + 1);
+  return Address(ip, 9042);
+}
+
+void host_histograms_thread(void* data) {
+  HostHistogramsThreadArgs* args = static_cast<HostHistogramsThreadArgs*>(data);
+  for (int i = 0; i < NUM_ITERATIONS; ++i) {
+    args->histograms->record_value(host_histograms_address(i), i + 1);
+  }
+}
+
 struct MeterThreadArgs {
   uv_thread_t thread;
   Metrics::Meter* meter;
@@ -174,6 +194,198 @@ TEST(MetricsUnitTest, HistogramWithThreads) {
   EXPECT_EQ(snapshot.mean, snapshot.median);
 }
 
+TEST(MetricsUnitTest, HostHistograms) {
+  Metrics::ThreadState thread_state(1);
+  Metrics::HostHistograms histograms(&thread_state);
+  Metrics::HostHistograms::SnapshotVec snapshots;
+  histograms.get_snapshots(&snapshots);
+  EXPECT_TRUE(snapshots.empty());
+
+  // Hosts are added out of order
+  histograms.add(Address("127.0.0.3", 9042));
+  histograms.add(Address("127.0.0.1", 9042));
+  histograms.add(Address("127.0.0.2", 9042));
+  histograms.add(Address("127.0.0.2", 9042)); // Already added
+
+  // Hosts that haven't been added aren't recorded
+  histograms.record_value(Address("127.0.0.4", 9042), 1);
+
+  for (int64_t i = 1; i <= 100; ++i) {
+    histograms.record_value(Address("127.0.0.3", 9042), i);
+    histograms.record_value(Address("127.0.0.1", 9042), 2 * i);
+  }
+  histograms.record_value(Address("127.0.0.2", 9042), 1000);
+
+  histograms.get_snapshots(&snapshots);
+  ASSERT_EQ(3u, snapshots.size());
+  EXPECT_EQ(Address("127.0.0.1", 9042), snapshots[0].address);
+  EXPECT_EQ(Address("127.0.0.2", 9042), snapshots[1].address);
+  EXPECT_EQ(Address("127.0.0.3", 9042), snapshots[2].address);
+
+  EXPECT_EQ(100, snapshots[0].latencies.count);
+  EXPECT_EQ(2, snapshots[0].latencies.min);
+  EXPECT_EQ(200, snapshots[0].latencies.max);
+
+  EXPECT_EQ(1, snapshots[1].latencies.count);
+  EXPECT_EQ(1000, snapshots[1].latencies.min);
+
+  EXPECT_EQ(100, snapshots[2].latencies.count);
+  EXPECT_EQ(1, snapshots[2].latencies.min);
+  EXPECT_EQ(100, snapshots[2].latencies.max);
+
+  // Removed hosts are dropped and late latencies for them aren't recorded
+  histograms.remove(Address("127.0.0.1", 9042));
+  histograms.remove(Address("127.0.0.4", 9042)); // Doesn't exist
+  histograms.record_value(Address("127.0.0.1", 9042), 1);
+  histograms.get_snapshots(&snapshots);
+  ASSERT_EQ(2u, snapshots.size());
+  EXPECT_EQ(Address("127.0.0.2", 9042), snapshots[0].address);
+  EXPECT_EQ(Address("127.0.0.3", 9042), snapshots[1].address);
+
+  // A host that's added again starts over
+  histograms.add(Address("127.0.0.1", 9042));
+  histograms.record_value(Address("127.0.0.1", 9042), 1);
+  histograms.get_snapshots(&snapshots);
+  ASSERT_EQ(3u, snapshots.size());
+  EXPECT_EQ(Address("127.0.0.1", 9042), snapshots[0].address);
+  EXPECT_EQ(1, snapshots[0].latencies.count);
+}
+
+TEST(MetricsUnitTest, HostHistogramsWithThreads) {
+  HostHistogramsThreadArgs args[NUM_THREADS];
+
+  Metrics::ThreadState thread_state(NUM_THREADS);
+  Metrics::HostHistograms histograms(&thread_state);
+  for (int i = 0; i < 10; ++i) {
+    histograms.add(host_histograms_address(i));
+  }
+
+  for (int i = 0; i < NUM_THREADS; ++i) {
+    args[i].histograms = &histograms;
+    uv_thread_create(&args[i].thread, host_histograms_thread, &args[i]);
+  }
+
+  for (int i = 0; i < NUM_THREADS; ++i) {
+    uv_thread_join(&args[i].thread);
+  }
+
+  Metrics::HostHistograms::SnapshotVec snapshots;
+  histograms.get_snapshots(&snapshots);
+  ASSERT_EQ(10u, snapshots.size());
+
+  int64_t total = 0;
+  for (size_t i = 0; i < snapshots.size(); ++i) {
+    total += snapshots[i].latencies.count;
+  }
+  EXPECT_EQ(NUM_THREADS * NUM_ITERATIONS, total);
+}
+
+TEST(MetricsUnitTest, HostHistogramsRemoveWithThreads) {
+  HostHistogramsThreadArgs args[NUM_THREADS];
+
+  Metrics::ThreadState thread_state(NUM_THREADS);
+  Metrics::HostHistograms histograms(&thread_state);
+
+  for (int i = 0; i < NUM_THREADS; ++i) {
+    args[i].histograms = &histograms;
+    uv_thread_create(&args[i].thread, host_histograms_thread, &args[i]);
+  }
+
+  // Add and remove hosts while they're being recorded
+  for (int i = 0; i < 1000; ++i) {
+    histograms.add(host_histograms_address(i));
+    histograms.remove(host_histograms_address(i + 5));
+  }
+
+  for (int i = 0; i < NUM_THREADS; ++i) {
+    uv_thread_join(&args[i].thread);
+  }
+
+  Metrics::HostHistograms::SnapshotVec snapshots;
+  histograms.get_snapshots(&snapshots);
+  EXPECT_LE(snapshots.size(), 10u);
+}
+
+TEST(MetricsUnitTest, DetailedLatenciesDisabled) {
+  Metrics metrics(1);
+  metrics.record_request(1000000, Address("127.0.0.1", 9042), CQL_OPCODE_QUERY);
+
+  Metrics::Histogram::Snapshot snapshot;
+  metrics.request_latencies.get_snapshot(&snapshot);
+  EXPECT_EQ(1, snapshot.count);
+  EXPECT_TRUE(metrics.request_latencies_by_opcode(CQL_OPCODE_QUERY) == NULL);
+  EXPECT_TRUE(metrics.host_request_latencies() == NULL);
+
+  // Stage latencies are only tracked when request timing is enabled
+  RequestTiming timing;
+  timing.enqueue = 1000000;
+  timing.dequeue = 2000000;
+  metrics.record_request_timing(timing);
+  EXPECT_TRUE(metrics.request_latencies_by_stage(CASS_REQUEST_STAGE_QUEUE) == NULL);
+}
+
+TEST(MetricsUnitTest, RequestLatenciesByOpcode) {
+  Metrics metrics(1, true);
+  Address address("127.0.0.1", 9042);
+  metrics.host_request_latencies()->add(address);
+
+  metrics.record_request(1000000, address, CQL_OPCODE_QUERY);
+  metrics.record_request(2000000, address, CQL_OPCODE_QUERY);
+  metrics.record_request(3000000, address, CQL_OPCODE_EXECUTE);
+  metrics.record_request(4000000, address, CQL_OPCODE_OPTIONS); // Not tracked by opcode
+
+  Metrics::Histogram::Snapshot snapshot;
+  metrics.request_latencies_by_opcode(CQL_OPCODE_QUERY)->get_snapshot(&snapshot);
+  EXPECT_EQ(2, snapshot.count);
+  metrics.request_latencies_by_opcode(CQL_OPCODE_EXECUTE)->get_snapshot(&snapshot);
+  EXPECT_EQ(1, snapshot.count);
+  EXPECT_EQ(3000, snapshot.min);
+  metrics.request_latencies_by_opcode(CQL_OPCODE_BATCH)->get_snapshot(&snapshot);
+  EXPECT_EQ(0, snapshot.count);
+  EXPECT_TRUE(metrics.request_latencies_by_opcode(CQL_OPCODE_OPTIONS) == NULL);
+
+  // All requests are included in the session-wide and host histograms
+  metrics.request_latencies.get_snapshot(&snapshot);
+  EXPECT_EQ(4, snapshot.count);
+  Metrics::HostHistograms::SnapshotVec hosts;
+  metrics.host_request_latencies()->get_snapshots(&hosts);
+  ASSERT_EQ(1u, hosts.size());
+  EXPECT_EQ(4, hosts[0].latencies.count);
+}
+
+TEST(MetricsUnitTest, RequestTiming) {
+  Metrics metrics(1, false, true);
+
+  RequestTiming timing;
+  timing.enqueue = 1000000;
+  timing.dequeue = 2000000;
+  timing.write = 4000000;
+  timing.flush = 7000000;
+  timing.first_byte = 11000000;
+  timing.decode = 16000000;
+  timing.complete = 22000000;
+  metrics.record_request_timing(timing);
+
+  // Stages that weren't reached aren't recorded
+  timing.first_byte = timing.decode = timing.complete = 0;
+  metrics.record_request_timing(timing);
+
+  const struct {
+    CassRequestStage stage;
+    int64_t count;
+    int64_t latency_us;
+  } expected[] = { { CASS_REQUEST_STAGE_QUEUE, 2, 1000 },  { CASS_REQUEST_STAGE_WRITE, 2, 2000 },
+                   { CASS_REQUEST_STAGE_COALESCE, 2, 3000 }, { CASS_REQUEST_STAGE_SERVER, 1, 4000 },
+                   { CASS_REQUEST_STAGE_DECODE, 1, 5000 },   { CASS_REQUEST_STAGE_DISPATCH, 1, 6000 } };
+
+  for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); ++i) {
+    Metrics::Histogram::Snapshot snapshot;
+    metrics.request_latencies_by_stage(expected[i].stage)->get_snapshot(&snapshot);
+    EXPECT_EQ(expected[i].count, snapshot.count) << "Stage " << expected[i].stage;
+    EXPECT_EQ(expected[i].latency_us, snapshot.min) << "Stage " << expected[i].stage;
+  }
+}
+
 TEST(MetricsUnitTest, Meter) {
   Metrics::ThreadState thread_state(1);
   Metrics::Meter meter(&thread_state);
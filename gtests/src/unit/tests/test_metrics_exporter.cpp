@@ -0,0 +1,178 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "callback.hpp"
+#include "http_client.hpp"
+#include "metrics_exporter.hpp"
+#include "metrics_server.hpp"
+#include "session.hpp"
+
+#include <uv.h>
+
+#define METRICS_SERVER_IP "127.0.0.1"
+#define METRICS_SERVER_PORT 39090
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class MetricsExporterUnitTest : public testing::Test {
+public:
+  MetricsExporterUnitTest()
+      : metrics_(1, true) {
+    Address address("127.0.0.1", 9042);
+    metrics_.host_request_latencies()->add(address);
+    metrics_.record_request(1000000, address, CQL_OPCODE_QUERY);
+    metrics_.record_request(2000000, address, CQL_OPCODE_QUERY);
+    metrics_.record_request(3000000, address, CQL_OPCODE_EXECUTE);
+    metrics_.record_speculative_request(500000);
+    metrics_.request_timeouts.inc();
+
+    EventLoopStats::Ptr stats(new EventLoopStats());
+    stats->record_iteration(3000000, 2000000);
+    stats->record_timer_lag(250000);
+    Metrics::EventLoopStatsVec io_thread_stats;
+    io_thread_stats.push_back(stats);
+    metrics_.set_io_thread_stats(io_thread_stats);
+  }
+
+  String export_metrics(CassMetricsFormat format) {
+    String output;
+    MetricsExporter(format).export_metrics(&metrics_, &output);
+    return output;
+  }
+
+  static bool contains(const String& output, const String& value) {
+    return output.find(value) != String::npos;
+  }
+
+  static void on_response(HttpClient* client, HttpClient::Ptr* result) { result->reset(client); }
+
+private:
+  Metrics metrics_;
+};
+
+TEST_F(MetricsExporterUnitTest, OpenMetrics) {
+  String output(export_metrics(CASS_METRICS_FORMAT_OPENMETRICS));
+
+  EXPECT_TRUE(contains(output, "# TYPE cass_request_latency_microseconds summary\n"));
+  EXPECT_TRUE(contains(output, "# UNIT cass_request_latency_microseconds microseconds\n"));
+  EXPECT_TRUE(contains(output, "cass_request_latency_microseconds_count 3\n"));
+  EXPECT_TRUE(contains(output, "cass_request_type_latency_microseconds_count{type=\"query\"} 2\n"));
+  EXPECT_TRUE(
+      contains(output, "cass_request_type_latency_microseconds_count{type=\"execute\"} 1\n"));
+  EXPECT_TRUE(contains(output, "cass_request_type_latency_microseconds_count{type=\"batch\"} 0\n"));
+  EXPECT_TRUE(contains(output, "cass_host_request_latency_microseconds_count{host=\"127.0.0.1:9042\"} 3\n"));
+  EXPECT_TRUE(contains(output, "cass_speculative_request_latency_microseconds_count 1\n"));
+  EXPECT_TRUE(contains(output, "cass_request_latency_microseconds{quantile=\"0.5\"} "));
+
+  // Counters use the metric family name for metadata and "_total" samples
+  EXPECT_TRUE(contains(output, "# TYPE cass_requests counter\n"));
+  EXPECT_TRUE(contains(output, "cass_requests_total 3\n"));
+  EXPECT_TRUE(contains(output, "cass_speculative_requests_total 1\n"));
+  EXPECT_TRUE(contains(output, "cass_request_timeouts_total 1\n"));
+
+  EXPECT_TRUE(contains(output, "cass_request_rate{window=\"1m\"} "));
+
+  EXPECT_TRUE(contains(output, "cass_io_thread_iterations_total{thread=\"0\"} 1\n"));
+  EXPECT_TRUE(contains(output, "cass_io_thread_loop_time_microseconds_total{thread=\"0\"} 3000\n"));
+  EXPECT_TRUE(contains(output, "cass_io_thread_poll_time_microseconds_total{thread=\"0\"} 2000\n"));
+  EXPECT_TRUE(contains(output, "cass_io_thread_max_timer_lag_microseconds{thread=\"0\"} 250\n"));
+
+  ASSERT_GE(output.size(), 6u);
+  EXPECT_EQ("# EOF\n", output.substr(output.size() - 6));
+}
+
+TEST_F(MetricsExporterUnitTest, Prometheus) {
+  String output(export_metrics(CASS_METRICS_FORMAT_PROMETHEUS));
+
+  EXPECT_TRUE(contains(output, "# TYPE cass_request_latency_microseconds summary\n"));
+  EXPECT_FALSE(contains(output, "# UNIT"));
+  EXPECT_TRUE(contains(output, "cass_request_latency_microseconds_count 3\n"));
+
+  // Counters use the "_total" name for metadata
+  EXPECT_TRUE(contains(output, "# TYPE cass_requests_total counter\n"));
+  EXPECT_TRUE(contains(output, "cass_requests_total 3\n"));
+
+  EXPECT_FALSE(contains(output, "# EOF"));
+}
+
+TEST_F(MetricsExporterUnitTest, NoMetrics) {
+  String output;
+  MetricsExporter(CASS_METRICS_FORMAT_OPENMETRICS).export_metrics(NULL, &output);
+  EXPECT_EQ("# EOF\n", output);
+
+  output.clear();
+  MetricsExporter(CASS_METRICS_FORMAT_PROMETHEUS).export_metrics(NULL, &output);
+  EXPECT_TRUE(output.empty());
+}
+
+TEST_F(MetricsExporterUnitTest, ExportTruncated) {
+  CassSession* session = cass_session_new();
+
+  // The metrics aren't available until the session is connected
+  size_t length = cass_session_metrics_export(session, CASS_METRICS_FORMAT_OPENMETRICS, NULL, 0);
+  EXPECT_EQ(6u, length);
+
+  char buffer[4];
+  EXPECT_EQ(length, cass_session_metrics_export(session, CASS_METRICS_FORMAT_OPENMETRICS, buffer,
+                                                sizeof(buffer)));
+  EXPECT_STREQ("# E", buffer);
+
+  cass_session_free(session);
+}
+
+TEST_F(MetricsExporterUnitTest, Server) {
+  CassSession* session = cass_session_new();
+
+  EXPECT_EQ(CASS_ERROR_LIB_BAD_PARAMS,
+            cass_session_start_metrics_server(session, "invalid", METRICS_SERVER_PORT));
+  ASSERT_EQ(CASS_OK,
+            cass_session_start_metrics_server(session, METRICS_SERVER_IP, METRICS_SERVER_PORT));
+  EXPECT_EQ(CASS_ERROR_LIB_UNABLE_TO_INIT,
+            cass_session_start_metrics_server(session, METRICS_SERVER_IP, METRICS_SERVER_PORT));
+
+  uv_loop_t loop;
+  ASSERT_EQ(0, uv_loop_init(&loop));
+
+  Address address(METRICS_SERVER_IP, METRICS_SERVER_PORT);
+
+  HttpClient::Ptr response;
+  HttpClient::Ptr client(
+      new HttpClient(address, "/metrics", bind_callback(on_response, &response)));
+  client->request(&loop);
+  uv_run(&loop, UV_RUN_DEFAULT);
+
+  ASSERT_TRUE(response);
+  EXPECT_TRUE(response->is_ok()) << response->error_message();
+  EXPECT_EQ(200u, response->status_code());
+  EXPECT_EQ("text/plain; version=0.0.4; charset=utf-8", response->content_type());
+  EXPECT_TRUE(response->response_body().empty()); // Not connected
+
+  response.reset();
+  client.reset(new HttpClient(address, "/invalid", bind_callback(on_response, &response)));
+  client->request(&loop);
+  uv_run(&loop, UV_RUN_DEFAULT);
+
+  ASSERT_TRUE(response);
+  EXPECT_TRUE(response->is_error_status_code());
+  EXPECT_EQ(404u, response->status_code());
+
+  uv_loop_close(&loop);
+  cass_session_free(session);
+}
@@ -381,6 +381,30 @@ public:
     manager->flush();
   }
 
+  static void on_pool_connected_power_of_two_choices(ConnectionPoolManagerInitializer* initializer,
+                                                     RequestStatusWithManager* status) {
+    const Address address("127.0.0.1", 9042);
+    ConnectionPoolManager::Ptr manager = initializer->release_manager();
+    status->set_manager(manager);
+
+    // Write a request without flushing so the connection has an in-flight
+    // request and pending write bytes.
+    PooledConnection::Ptr busy = manager->find_least_busy(address);
+    ASSERT_TRUE(busy);
+    RequestCallback::Ptr callback(new RequestCallback(status));
+    if (busy->write(callback.get()) < 0) {
+      status->error_failed_write();
+    }
+    EXPECT_GT(busy->pending_write_bytes(), 0u);
+
+    // The busy connection is always compared against an idle connection
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_NE(busy.get(), manager->find_least_busy(address).get());
+    }
+
+    manager->flush();
+  }
+
   static void on_pool_nop(ConnectionPoolManagerInitializer* initializer,
                           RequestStatusWithManager* status) {
     ConnectionPoolManager::Ptr manager = initializer->release_manager();
@@ -839,3 +863,26 @@ TEST_F(PoolUnitTest, NoAvailableStreams) {
 
   EXPECT_EQ(status.count(RequestStatus::SUCCESS), CASS_MAX_STREAMS) << status.results();
 }
+
+TEST_F(PoolUnitTest, PowerOfTwoChoices) {
+  mockssandra::SimpleCluster cluster(simple(), 1);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  RequestStatusWithManager status(loop(), 1);
+
+  ConnectionPoolManagerInitializer::Ptr initializer(new ConnectionPoolManagerInitializer(
+      PROTOCOL_VERSION, bind_callback(on_pool_connected_power_of_two_choices, &status)));
+
+  ConnectionPoolSettings settings;
+  settings.num_connections_per_host = 4;
+  settings.power_of_two_choices_connection_selection = true;
+  initializer->with_settings(settings)->initialize(loop(), hosts(1));
+  uv_run(loop(), UV_RUN_DEFAULT);
+
+  EXPECT_EQ(status.count(RequestStatus::SUCCESS), 1u) << status.results();
+
+  // All the pending writes have completed
+  PooledConnection::Ptr connection = status.manager()->find_least_busy(Address("127.0.0.1", 9042));
+  ASSERT_TRUE(connection);
+  EXPECT_EQ(connection->pending_write_bytes(), 0u);
+}
@@ -44,6 +44,7 @@ struct MockTokenMap {
   };
 
   HostSet hosts;
+  HostIdMap host_ids;
   IdGenerator dc_ids;
   IdGenerator rack_ids;
 
@@ -101,8 +102,8 @@ struct MockTokenMap {
 
   void build_replicas() {
     std::sort(tokens.begin(), tokens.end()); // We assume sorted tokens
-    build_datacenters(hosts, datacenters);
-    strategy.build_replicas(tokens, datacenters, replicas);
+    build_datacenters(hosts, host_ids, datacenters);
+    strategy.build_replicas(tokens, host_ids, datacenters, replicas);
   }
 
   const CopyOnWriteHostVec& find_hosts(Token token) {
@@ -118,11 +119,11 @@ struct MockTokenMap {
   Host* create_host(const String& address, const String& rack = "", const String& dc = "") {
     Host::Ptr host(new Host(Address(address, 9042)));
     host->set_rack_and_dc(rack, dc);
-    host->set_rack_and_dc_ids(rack_ids.get(rack), dc_ids.get(dc));
     HostSet::iterator i = hosts.find(host);
     if (i != hosts.end()) {
       return i->get();
     } else {
+      host_ids[host->address()] = HostIds(rack_ids.get(rack), dc_ids.get(dc));
       hosts.insert(host);
       return host.get();
     }
@@ -146,9 +146,10 @@ public:
     const RequestProcessor::Ptr& processor() const { return processor_; }
 
     void set_processor(const RequestProcessor::Ptr& processor) {
-      ScopedMutex lock(&mutex_);
-      processor_ = processor;
-      internal_set(lock);
+      if (claim()) {
+        processor_ = processor;
+        internal_set();
+      }
     }
 
   private:
@@ -326,6 +327,50 @@ TEST_F(RequestProcessorUnitTest, CloseWithRequestsPending) {
   }
 }
 
+TEST_F(RequestProcessorUnitTest, AdaptiveCoalesceDelay) {
+  mockssandra::SimpleCluster cluster(simple(), NUM_NODES);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  HostMap hosts(generate_hosts());
+
+  RequestProcessorSettings settings;
+  settings.coalesce_delay_adaptive = true;
+
+  Future::Ptr connect_future(new Future());
+  RequestProcessorInitializer::Ptr initializer(new RequestProcessorInitializer(
+      hosts.begin()->second, PROTOCOL_VERSION, hosts, TokenMap::Ptr(), "",
+      bind_callback(on_connected, connect_future.get())));
+
+  initializer->with_settings(settings)->initialize(event_loop());
+
+  ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME));
+  EXPECT_FALSE(connect_future->error());
+
+  RequestProcessor::Ptr processor(connect_future->processor());
+
+  // Single requests and a burst of requests
+  try_request(processor);
+
+  Vector<ResponseFuture::Ptr> futures;
+  for (int i = 0; i < 1024; ++i) {
+    ResponseFuture::Ptr response_future(new ResponseFuture());
+    Request::ConstPtr request(new QueryRequest("SELECT * FROM table"));
+    RequestHandler::Ptr request_handler(new RequestHandler(request, response_future));
+
+    processor->process_request(request_handler);
+    futures.push_back(response_future);
+  }
+
+  for (Vector<ResponseFuture::Ptr>::const_iterator it = futures.begin(), end = futures.end();
+       it != end; ++it) {
+    ResponseFuture::Ptr response_future(*it);
+    ASSERT_TRUE(response_future->wait_for(WAIT_FOR_TIME));
+    EXPECT_FALSE(response_future->error());
+  }
+
+  try_request(processor);
+}
+
 TEST_F(RequestProcessorUnitTest, Auth) {
   mockssandra::SimpleCluster cluster(auth(), NUM_NODES);
   ASSERT_EQ(cluster.start_all(), 0);
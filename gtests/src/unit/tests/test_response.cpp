@@ -0,0 +1,124 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "constants.hpp"
+#include "error_response.hpp"
+#include "response.hpp"
+#include "serialization.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+// Encode an error response frame with a message of the given size
+static RefBuffer::Ptr error_frame(size_t message_size, size_t* frame_size) {
+  const size_t body_size = sizeof(int32_t) + sizeof(uint16_t) + message_size;
+  *frame_size = CASS_HEADER_SIZE_V3 + body_size;
+
+  RefBuffer::Ptr buffer(RefBuffer::create(*frame_size));
+  char* pos = buffer->data();
+  pos = encode_byte(pos, CASS_PROTOCOL_VERSION_V4 | 0x80); // Response
+  pos = encode_int8(pos, 0);
+  pos = encode_int16(pos, 1);
+  pos = encode_int8(pos, CQL_OPCODE_ERROR);
+  pos = encode_int32(pos, body_size);
+  pos = encode_int32(pos, CQL_ERROR_INVALID_QUERY);
+  pos = encode_uint16(pos, message_size);
+  memset(pos, 'a', message_size);
+  return buffer;
+}
+
+static bool is_within(const RefBuffer::Ptr& buffer, size_t size, const char* data) {
+  return data >= buffer->data() && data < buffer->data() + size;
+}
+
+TEST(ResponseUnitTest, ZeroCopy) {
+  size_t frame_size;
+  RefBuffer::Ptr frame(error_frame(32 * 1024, &frame_size));
+
+  ResponseMessage message;
+  ASSERT_EQ(static_cast<ssize_t>(frame_size),
+            message.decode(frame->data(), frame_size, frame.get()));
+  ASSERT_TRUE(message.is_body_ready());
+
+  // The body references the input buffer instead of a copy
+  const Response::Ptr& response = message.response_body();
+  EXPECT_TRUE(is_within(frame, frame_size, response->data()));
+  EXPECT_EQ(frame, response->buffer());
+  EXPECT_EQ(2, frame->ref_count());
+
+  ErrorResponse* error = static_cast<ErrorResponse*>(response.get());
+  EXPECT_EQ(CQL_ERROR_INVALID_QUERY, error->code());
+  EXPECT_EQ(String(32 * 1024, 'a'), error->message().to_string());
+}
+
+TEST(ResponseUnitTest, SmallBodyCopied) {
+  size_t frame_size;
+  RefBuffer::Ptr frame(error_frame(100, &frame_size));
+
+  ResponseMessage message;
+  ASSERT_EQ(static_cast<ssize_t>(frame_size),
+            message.decode(frame->data(), frame_size, frame.get()));
+  ASSERT_TRUE(message.is_body_ready());
+
+  // Small bodies don't keep the input buffer alive
+  EXPECT_FALSE(is_within(frame, frame_size, message.response_body()->data()));
+  EXPECT_EQ(1, frame->ref_count());
+}
+
+TEST(ResponseUnitTest, PartialCopied) {
+  size_t frame_size;
+  RefBuffer::Ptr frame(error_frame(32 * 1024, &frame_size));
+
+  // The body is split across multiple inputs so it must be copied
+  ResponseMessage message;
+  size_t half = frame_size / 2;
+  ASSERT_EQ(static_cast<ssize_t>(half), message.decode(frame->data(), half, frame.get()));
+  ASSERT_FALSE(message.is_body_ready());
+  ASSERT_EQ(static_cast<ssize_t>(frame_size - half),
+            message.decode(frame->data() + half, frame_size - half, frame.get()));
+  ASSERT_TRUE(message.is_body_ready());
+
+  EXPECT_FALSE(is_within(frame, frame_size, message.response_body()->data()));
+  ErrorResponse* error = static_cast<ErrorResponse*>(message.response_body().get());
+  EXPECT_EQ(String(32 * 1024, 'a'), error->message().to_string());
+}
+
+TEST(ResponseUnitTest, RemainingBody) {
+  size_t frame_size;
+  RefBuffer::Ptr frame(error_frame(1000, &frame_size));
+
+  ResponseMessage message;
+  size_t size = 0;
+  EXPECT_TRUE(message.remaining_body(&size) == NULL);
+
+  const size_t initial = CASS_HEADER_SIZE_V3 + 100;
+  ASSERT_EQ(static_cast<ssize_t>(initial), message.decode(frame->data(), initial));
+
+  // Fill the rest of the body in place (as if read directly from a socket)
+  char* body = message.remaining_body(&size);
+  ASSERT_TRUE(body != NULL);
+  ASSERT_EQ(frame_size - initial, size);
+  memcpy(body, frame->data() + initial, size);
+  ASSERT_EQ(static_cast<ssize_t>(size), message.decode(body, size));
+  ASSERT_TRUE(message.is_body_ready());
+  EXPECT_TRUE(message.remaining_body(&size) == NULL);
+
+  ErrorResponse* error = static_cast<ErrorResponse*>(message.response_body().get());
+  EXPECT_EQ(String(1000, 'a'), error->message().to_string());
+}
@@ -0,0 +1,200 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "random.hpp"
+#include "segment.hpp"
+
+using namespace datastax;
+using namespace datastax::internal::core;
+
+static String to_string(const BufferVec& buffers) {
+  String result;
+  for (BufferVec::const_iterator it = buffers.begin(), end = buffers.end(); it != end; ++it) {
+    result.append(it->data(), it->size());
+  }
+  return result;
+}
+
+static String random_string(size_t size, int alphabet_size) {
+  MT19937_64 rng;
+  String result;
+  for (size_t i = 0; i < size; ++i) {
+    result.push_back(static_cast<char>('a' + rng() % alphabet_size));
+  }
+  return result;
+}
+
+// Decode all segments in the input and concatenate their payloads
+static bool decode_all(bool is_compressed, const String& input, String* output,
+                       size_t* segment_count = NULL) {
+  SegmentDecoder decoder(is_compressed);
+  const char* pos = input.data();
+  size_t remaining = input.size();
+  size_t count = 0;
+  while (remaining > 0) {
+    ssize_t consumed = decoder.decode(pos, remaining);
+    if (consumed <= 0) return false;
+    if (decoder.is_payload_ready()) {
+      output->append(decoder.payload());
+      count++;
+    }
+    pos += consumed;
+    remaining -= consumed;
+  }
+  if (segment_count) *segment_count = count;
+  return decoder.is_payload_ready();
+}
+
+TEST(SegmentUnitTest, Checksums) {
+  // Expected values were generated using the algorithms from the protocol spec
+  EXPECT_EQ(0x7DE777u, Segment::crc24(0, 3));
+  EXPECT_EQ(0x9A9919u, Segment::crc24(5 | (1 << 17), 3));
+  EXPECT_EQ(0x44777ED3u, Segment::crc32("", 0));
+  EXPECT_EQ(0xB60E8074u, Segment::crc32("hello", 5));
+}
+
+TEST(SegmentUnitTest, EncodeUncompressed) {
+  SegmentEncoder encoder(false);
+  Buffer segment(encoder.encode_segment("hello", 5, true));
+
+  const char expected[] = "\x05\x00\x02\x19\x99\x9a"
+                          "hello"
+                          "\x74\x80\x0e\xb6";
+  EXPECT_EQ(String(expected, sizeof(expected) - 1), String(segment.data(), segment.size()));
+}
+
+TEST(SegmentUnitTest, RoundTrip) {
+  for (int i = 0; i < 2; ++i) {
+    bool is_compressed = i == 1;
+    SegmentEncoder encoder(is_compressed);
+
+    BufferVec frames;
+    SizeVec frame_sizes;
+    String expected;
+
+    // Compressible, incompressible and empty frames
+    String frame1(1000, 'a');
+    String frame2(random_string(100, 256));
+    String frame3;
+    frames.push_back(Buffer(frame1.data(), frame1.size()));
+    frames.push_back(Buffer(frame2.data(), frame2.size()));
+    frame_sizes.push_back(frame1.size());
+    frame_sizes.push_back(frame2.size());
+    frame_sizes.push_back(frame3.size());
+    expected = frame1 + frame2 + frame3;
+
+    BufferVec segments;
+    encoder.encode(frames, frame_sizes, &segments);
+    ASSERT_EQ(1u, segments.size());
+
+    String output;
+    ASSERT_TRUE(decode_all(is_compressed, to_string(segments), &output));
+    EXPECT_EQ(expected, output);
+  }
+}
+
+TEST(SegmentUnitTest, Compressed) {
+  SegmentEncoder encoder(true);
+
+  // Compressible payloads are smaller than the original
+  String compressible(10000, 'x');
+  Buffer segment(encoder.encode_segment(compressible.data(), compressible.size(), true));
+  EXPECT_LT(segment.size(), compressible.size());
+
+  // Incompressible payloads are stored uncompressed
+  String incompressible(random_string(10000, 256));
+  segment = encoder.encode_segment(incompressible.data(), incompressible.size(), true);
+  EXPECT_EQ(Segment::COMPRESSED_HEADER_SIZE + incompressible.size() + Segment::TRAILER_SIZE,
+            segment.size());
+
+  String output;
+  ASSERT_TRUE(decode_all(true, String(segment.data(), segment.size()), &output));
+  EXPECT_EQ(incompressible, output);
+}
+
+TEST(SegmentUnitTest, LargeFrames) {
+  for (int i = 0; i < 2; ++i) {
+    bool is_compressed = i == 1;
+    SegmentEncoder encoder(is_compressed);
+
+    // A frame that's too large for a single segment is split into multiple
+    // segments and smaller frames are packed together.
+    String small(100, 's');
+    String large(random_string(3 * Segment::MAX_PAYLOAD_SIZE + 1, 4));
+
+    BufferVec frames;
+    SizeVec frame_sizes;
+    frames.push_back(Buffer(small.data(), small.size()));
+    frames.push_back(Buffer(small.data(), small.size()));
+    frames.push_back(Buffer(large.data(), large.size()));
+    frames.push_back(Buffer(small.data(), small.size()));
+    frame_sizes.push_back(small.size());
+    frame_sizes.push_back(small.size());
+    frame_sizes.push_back(large.size());
+    frame_sizes.push_back(small.size());
+
+    BufferVec segments;
+    encoder.encode(frames, frame_sizes, &segments);
+    EXPECT_EQ(6u, segments.size());
+
+    String output;
+    size_t segment_count = 0;
+    ASSERT_TRUE(decode_all(is_compressed, to_string(segments), &output, &segment_count));
+    EXPECT_EQ(6u, segment_count);
+    EXPECT_EQ(small + small + large + small, output);
+  }
+}
+
+TEST(SegmentUnitTest, Partial) {
+  SegmentEncoder encoder(true);
+  String payload(random_string(5000, 4));
+  Buffer segment(encoder.encode_segment(payload.data(), payload.size(), false));
+
+  // Decode a byte at a time
+  SegmentDecoder decoder(true);
+  for (size_t i = 0; i < segment.size(); ++i) {
+    EXPECT_FALSE(decoder.is_payload_ready());
+    ASSERT_EQ(1, decoder.decode(segment.data() + i, 1));
+  }
+  ASSERT_TRUE(decoder.is_payload_ready());
+  EXPECT_FALSE(decoder.is_self_contained());
+  EXPECT_EQ(payload, decoder.payload());
+}
+
+TEST(SegmentUnitTest, Corrupted) {
+  for (int i = 0; i < 2; ++i) {
+    bool is_compressed = i == 1;
+    SegmentEncoder encoder(is_compressed);
+    String payload(1000, 'a');
+    Buffer segment(encoder.encode_segment(payload.data(), payload.size(), true));
+    String encoded(segment.data(), segment.size());
+    String output;
+
+    String bad_header(encoded);
+    bad_header[1] ^= 0x01;
+    EXPECT_FALSE(decode_all(is_compressed, bad_header, &output));
+
+    String bad_payload(encoded);
+    bad_payload[bad_payload.size() - Segment::TRAILER_SIZE - 1] ^= 0x01;
+    EXPECT_FALSE(decode_all(is_compressed, bad_payload, &output));
+
+    String bad_trailer(encoded);
+    bad_trailer[bad_trailer.size() - 1] ^= 0x01;
+    EXPECT_FALSE(decode_all(is_compressed, bad_trailer, &output));
+  }
+}
@@ -149,16 +149,14 @@ public:
     Type type() { return event_.first; }
 
     void set_event(Type type, const Address& host) {
-      ScopedMutex lock(&mutex_);
-      if (!is_set()) {
+      if (claim()) {
         event_ = Event(type, host);
-        internal_set(lock);
+        internal_set();
       }
     }
 
     Event wait_for_event(uint64_t timeout_us) {
-      ScopedMutex lock(&mutex_);
-      return internal_wait_for(lock, timeout_us) ? event_ : Event(INVALID, Address());
+      return internal_wait_for(timeout_us) ? event_ : Event(INVALID, Address());
     }
 
   private:
@@ -283,6 +281,285 @@ TEST_F(SessionUnitTest, ExecuteQueryNotConnected) {
   ASSERT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, future->error()->code);
 }
 
+TEST_F(SessionUnitTest, ExecuteManyNotConnected) {
+  Request::ConstVec requests;
+  requests.push_back(Request::ConstPtr(new QueryRequest("blah", 0)));
+  requests.push_back(Request::ConstPtr(new QueryRequest("blah", 0)));
+
+  Session session;
+  Future::Ptr future = session.execute_many(requests);
+  ASSERT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, future->error()->code);
+
+  Future::Vec futures;
+  future = session.execute_many(requests, &futures);
+  ASSERT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, future->error()->code);
+  ASSERT_EQ(2u, futures.size());
+  for (Future::Vec::const_iterator it = futures.begin(); it != futures.end(); ++it) {
+    EXPECT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, (*it)->error()->code);
+  }
+}
+
+TEST_F(SessionUnitTest, ExecuteMany) {
+  mockssandra::SimpleCluster cluster(simple(), 3);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.set_thread_count_io(3);
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  Session session;
+  connect(config, &session);
+
+  for (size_t count = 0; count < 1000; count = 2 * count + 1) {
+    Request::ConstVec requests;
+    for (size_t i = 0; i < count; ++i) {
+      requests.push_back(Request::ConstPtr(new QueryRequest("blah", 0)));
+    }
+
+    Future::Ptr future = session.execute_many(requests);
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing queries";
+    EXPECT_FALSE(future->error());
+
+    // Both the aggregate future and each request's future are available
+    Future::Vec futures;
+    future = session.execute_many(requests, &futures);
+    ASSERT_EQ(count, futures.size());
+    for (Future::Vec::const_iterator it = futures.begin(); it != futures.end(); ++it) {
+      ASSERT_TRUE((*it)->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+      EXPECT_FALSE((*it)->error());
+    }
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing queries";
+    EXPECT_FALSE(future->error());
+  }
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, HostMetrics) {
+  mockssandra::SimpleCluster cluster(simple(), 3);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_detailed_latency_metrics(true);
+  Session session;
+  connect(config, &session);
+
+  const size_t num_requests = 30;
+  for (size_t i = 0; i < num_requests; ++i) {
+    Future::Ptr future = session.execute(Request::ConstPtr(new QueryRequest("blah", 0)));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE(future->error());
+  }
+
+  // Latencies are recorded after the future is set so close the session to
+  // wait for the I/O threads to finish. Metrics remain available after close.
+  close(&session);
+
+  CassIterator* iterator = cass_session_get_host_metrics(CassSession::to(&session));
+  ASSERT_TRUE(iterator != NULL);
+  cass_uint64_t total = 0;
+  size_t host_count = 0;
+  while (cass_iterator_next(iterator)) {
+    const CassHostMetrics* host_metrics = cass_iterator_get_host_metrics(iterator);
+    ASSERT_TRUE(host_metrics != NULL);
+    EXPECT_EQ(9042, host_metrics->port);
+    EXPECT_EQ(4u, host_metrics->address.address_length);
+    EXPECT_GT(host_metrics->requests.count, 0u);
+    total += host_metrics->requests.count;
+    host_count++;
+  }
+  cass_iterator_free(iterator);
+
+  // Requests are distributed round-robin to all hosts
+  EXPECT_EQ(3u, host_count);
+  EXPECT_EQ(num_requests, total);
+
+  CassLatencyMetrics query_metrics;
+  cass_session_get_request_type_metrics(CassSession::to(&session), CASS_REQUEST_TYPE_QUERY,
+                                        &query_metrics);
+  EXPECT_EQ(num_requests, query_metrics.count);
+
+  CassLatencyMetrics prepare_metrics;
+  cass_session_get_request_type_metrics(CassSession::to(&session), CASS_REQUEST_TYPE_PREPARE,
+                                        &prepare_metrics);
+  EXPECT_EQ(0u, prepare_metrics.count);
+}
+
+TEST_F(SessionUnitTest, TokenMap) {
+  mockssandra::SimpleCluster cluster(simple(), 3);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  EXPECT_TRUE(cass_session_get_token_map(CassSession::to(&session)) == NULL);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  connect(config, &session);
+
+  const CassTokenMap* token_map = cass_session_get_token_map(CassSession::to(&session));
+  ASSERT_TRUE(token_map != NULL);
+
+  // The mock cluster doesn't have any keyspaces
+  const char* routing_keys[] = { "a", "b" };
+  const size_t routing_key_lengths[] = { 1, 1 };
+  const CassReplicas* replicas[] = { NULL, NULL };
+  EXPECT_TRUE(cass_token_map_get_replicas(token_map, "blah", "a", 1) == NULL);
+  EXPECT_EQ(CASS_OK, cass_token_map_get_replicas_batch(token_map, "blah", routing_keys,
+                                                       routing_key_lengths, 2, replicas));
+  EXPECT_TRUE(replicas[0] == NULL);
+  EXPECT_TRUE(replicas[1] == NULL);
+
+  close(&session);
+  EXPECT_TRUE(cass_session_get_token_map(CassSession::to(&session)) == NULL);
+
+  // The snapshot is still valid after the session is closed
+  EXPECT_TRUE(cass_token_map_get_replicas(token_map, "blah", "a", 1) == NULL);
+  cass_token_map_free(token_map);
+}
+
+TEST_F(SessionUnitTest, RequestTiming) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_request_timing(true);
+  Session session;
+  connect(config, &session);
+
+  const size_t num_requests = 10;
+  for (size_t i = 0; i < num_requests; ++i) {
+    Future::Ptr future = session.execute(Request::ConstPtr(new QueryRequest("blah", 0)));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE(future->error());
+
+    CassRequestTiming timing;
+    ASSERT_EQ(CASS_OK, cass_future_timing(CassFuture::to(future.get()), &timing));
+    EXPECT_GT(timing.enqueue, 0u);
+    EXPECT_LE(timing.enqueue, timing.dequeue);
+    EXPECT_LE(timing.dequeue, timing.write);
+    EXPECT_LE(timing.write, timing.flush);
+    EXPECT_LE(timing.flush, timing.first_byte);
+    EXPECT_LE(timing.first_byte, timing.decode);
+    EXPECT_LE(timing.decode, timing.complete);
+  }
+
+  close(&session);
+
+  CassLatencyMetrics stage_metrics;
+  cass_session_get_request_stage_metrics(CassSession::to(&session), CASS_REQUEST_STAGE_SERVER,
+                                         &stage_metrics);
+  EXPECT_EQ(num_requests, stage_metrics.count);
+}
+
+TEST_F(SessionUnitTest, RequestTimingDisabled) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  Session session;
+  connect(config, &session);
+
+  Future::Ptr future = session.execute(Request::ConstPtr(new QueryRequest("blah", 0)));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+
+  CassRequestTiming timing;
+  EXPECT_EQ(CASS_ERROR_LIB_NO_REQUEST_TIMING,
+            cass_future_timing(CassFuture::to(future.get()), &timing));
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, IoThreadMetrics) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_thread_count_io(2);
+  Session session;
+  connect(config, &session);
+
+  for (size_t i = 0; i < 10; ++i) {
+    Future::Ptr future = session.execute(Request::ConstPtr(new QueryRequest("blah", 0)));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE(future->error());
+  }
+
+  CassIterator* iterator = cass_session_get_io_thread_metrics(CassSession::to(&session));
+  EXPECT_EQ(CASS_ITERATOR_TYPE_IO_THREAD_METRICS, cass_iterator_type(iterator));
+
+  unsigned num_threads = 0;
+  cass_uint64_t timer_fires = 0;
+  while (cass_iterator_next(iterator)) {
+    const CassIoThreadMetrics* metrics = cass_iterator_get_io_thread_metrics(iterator);
+    ASSERT_TRUE(metrics != NULL);
+    EXPECT_EQ(num_threads++, metrics->thread_index);
+    EXPECT_GT(metrics->iterations, 0u);
+    EXPECT_GE(metrics->loop_time, metrics->poll_time);
+    EXPECT_GE(metrics->loop_time, metrics->busy_time);
+    EXPECT_GE(metrics->utilization, 0.0);
+    EXPECT_LE(metrics->utilization, 1.0);
+    timer_fires += metrics->timer_fires;
+  }
+  cass_iterator_free(iterator);
+
+  EXPECT_EQ(2u, num_threads);
+  EXPECT_GT(timer_fires, 0u); // Requests are processed by the coalescing timer
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, MultiThreadedClusterPrepared) {
+  const char* query = "SELECT value FROM ks.table";
+  mockssandra::ResultSet result_set = mockssandra::ResultSet::Builder("ks", "table")
+                                          .column("value", mockssandra::Type::text())
+                                          .row(mockssandra::Row::Builder().text("abc").build())
+                                          .build();
+  mockssandra::Matches matches;
+  matches.push_back(mockssandra::Match(query, result_set));
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_PREPARE).prepare_query(matches);
+  builder.on(mockssandra::OPCODE_EXECUTE).execute_prepared(matches);
+  mockssandra::MultiThreadedCluster cluster(builder.build(), 2, 3);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_core_connections_per_host(4);
+  Session session;
+  connect(config, &session);
+
+  CassFuture* prepare_future = cass_session_prepare(CassSession::to(&session), query);
+  ASSERT_EQ(CASS_OK, cass_future_error_code(prepare_future));
+  const CassPrepared* prepared = cass_future_get_prepared(prepare_future);
+  cass_future_free(prepare_future);
+  ASSERT_TRUE(prepared != NULL);
+
+  for (size_t i = 0; i < 10; ++i) {
+    CassStatement* statement = cass_prepared_bind(prepared);
+    CassFuture* future = cass_session_execute(CassSession::to(&session), statement);
+    EXPECT_EQ(CASS_OK, cass_future_error_code(future));
+
+    const CassResult* result = cass_future_get_result(future);
+    ASSERT_TRUE(result != NULL);
+    EXPECT_EQ(1u, cass_result_row_count(result));
+    const char* value;
+    size_t value_length;
+    EXPECT_EQ(CASS_OK, cass_value_get_string(cass_row_get_column(cass_result_first_row(result), 0),
+                                             &value, &value_length));
+    EXPECT_EQ("abc", String(value, value_length));
+
+    cass_result_free(result);
+    cass_future_free(future);
+    cass_statement_free(statement);
+  }
+
+  cass_prepared_free(prepared);
+  close(&session);
+}
+
 TEST_F(SessionUnitTest, InvalidKeyspace) {
   mockssandra::SimpleRequestHandlerBuilder builder;
   builder.on(mockssandra::OPCODE_QUERY)
@@ -123,6 +123,49 @@ TEST_F(StartupRequestUnitTest, EnableNoCompact) {
   ASSERT_EQ("true", options["NO_COMPACT"]);
 }
 
+TEST_F(StartupRequestUnitTest, EnableCompression) {
+  mockssandra::SimpleCluster cluster(simple_with_client_options());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  config().set_compression(CASS_COMPRESSION_LZ4);
+  connect(); // The READY response and all subsequent frames are compressed
+  Map<String, String> options = client_options();
+  ASSERT_EQ(5u, options.size());
+
+  ASSERT_EQ(client_id(), options["CLIENT_ID"]);
+  ASSERT_EQ("lz4", options["COMPRESSION"]);
+  ASSERT_EQ(CASS_DEFAULT_CQL_VERSION, options["CQL_VERSION"]);
+  ASSERT_EQ(driver_name(), options["DRIVER_NAME"]);
+  ASSERT_EQ(driver_version(), options["DRIVER_VERSION"]);
+}
+
+TEST_F(StartupRequestUnitTest, CompressionNotSupported) {
+  class NoSupportedOptions : public mockssandra::Action {
+  public:
+    virtual void on_run(mockssandra::Request* request) const {
+      String body;
+      mockssandra::encode_string_map(StringMultimap(), &body);
+      request->write(mockssandra::OPCODE_SUPPORTED, body);
+    }
+  };
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_OPTIONS).execute(new NoSupportedOptions());
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .client_options()
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  config().set_compression(CASS_COMPRESSION_LZ4);
+  connect();
+  Map<String, String> options = client_options();
+  ASSERT_EQ(4u, options.size());
+  ASSERT_EQ(options.end(), options.find("COMPRESSION"));
+}
+
 TEST_F(StartupRequestUnitTest, Application) {
   mockssandra::SimpleCluster cluster(simple_with_client_options());
   ASSERT_EQ(cluster.start_all(), 0);
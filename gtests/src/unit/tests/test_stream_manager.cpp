@@ -18,6 +18,8 @@
 
 #include "stream_manager.hpp"
 
+#include <set>
+
 using datastax::internal::core::StreamManager;
 
 TEST(StreamManagerUnitTest, MaxStreams) { ASSERT_EQ(StreamManager<int>().max_streams(), 32768u); }
@@ -70,3 +72,42 @@ TEST(StreamManagerUnitTest, Release) {
   // Verify there are no more streams left
   ASSERT_LT(streams.acquire(streams.max_streams()), 0);
 }
+
+TEST(StreamManagerUnitTest, Sparse) {
+  StreamManager<int> streams;
+
+  for (size_t i = 0; i < streams.max_streams(); ++i) {
+    ASSERT_GE(streams.acquire(i), 0);
+  }
+  EXPECT_EQ(0u, streams.available_streams());
+
+  // Release streams that are far apart. They need to be found no matter where
+  // the search for an available stream starts.
+  const int released[] = { 0, 63, 64, 4095, 20000, 32767 };
+  const size_t num_released = sizeof(released) / sizeof(released[0]);
+  for (size_t i = 0; i < num_released; ++i) {
+    int item = -1;
+    EXPECT_TRUE(streams.get(released[i], item));
+    streams.release(released[i]);
+    EXPECT_FALSE(streams.get(released[i], item));
+  }
+  EXPECT_EQ(num_released, streams.available_streams());
+
+  std::set<int> acquired;
+  for (size_t i = 0; i < num_released; ++i) {
+    int stream = streams.acquire(-1);
+    ASSERT_GE(stream, 0);
+    acquired.insert(stream);
+  }
+  EXPECT_EQ(std::set<int>(released, released + num_released), acquired);
+  EXPECT_LT(streams.acquire(-1), 0);
+  EXPECT_EQ(streams.max_streams(), streams.pending_streams());
+}
+
+TEST(StreamManagerUnitTest, InvalidStream) {
+  StreamManager<int> streams;
+  int item = -1;
+  EXPECT_FALSE(streams.get(-1, item));
+  EXPECT_FALSE(streams.get(0, item));
+  EXPECT_FALSE(streams.get(static_cast<int>(streams.max_streams()), item));
+}
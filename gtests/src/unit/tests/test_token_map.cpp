@@ -19,6 +19,7 @@
 #include "map.hpp"
 #include "set.hpp"
 #include "test_token_map_utils.hpp"
+#include "token_map_updater.hpp"
 
 using namespace datastax;
 using namespace datastax::internal;
@@ -81,6 +82,89 @@ struct TestTokenMap {
   }
 };
 
+struct TestHost {
+  TestHost() {}
+  TestHost(const TokenVec& tokens, const String& rack, const String& dc)
+      : tokens(tokens)
+      , rack(rack)
+      , dc(dc) {}
+  TokenVec tokens;
+  String rack;
+  String dc;
+};
+
+typedef Map<String, TestHost> TestHostMap;
+
+Host::Ptr create_test_host(const TestHostMap::value_type& host) {
+  return create_host(host.first, host.second.tokens, Murmur3Partitioner::name().to_string(),
+                     host.second.rack, host.second.dc);
+}
+
+const char* test_keyspaces[] = { "simple", "nts", "nts_all_dcs", "nts_missing_dc",
+                                 "nts_large_rf" };
+
+void add_test_keyspaces(TokenMap* token_map) {
+  add_keyspace_simple("simple", 3, token_map);
+
+  ReplicationMap nts;
+  nts["dc1"] = "3";
+  nts["dc2"] = "2";
+  add_keyspace_network_topology("nts", nts, token_map);
+
+  ReplicationMap nts_all_dcs;
+  nts_all_dcs["dc1"] = "2";
+  nts_all_dcs["dc2"] = "2";
+  nts_all_dcs["dc3"] = "1";
+  add_keyspace_network_topology("nts_all_dcs", nts_all_dcs, token_map);
+
+  ReplicationMap nts_missing_dc;
+  nts_missing_dc["dc1"] = "1";
+  nts_missing_dc["dc4"] = "2";
+  add_keyspace_network_topology("nts_missing_dc", nts_missing_dc, token_map);
+
+  ReplicationMap nts_large_rf;
+  nts_large_rf["dc1"] = "10";
+  nts_large_rf["dc3"] = "3";
+  add_keyspace_network_topology("nts_large_rf", nts_large_rf, token_map);
+}
+
+// Verify that an incrementally updated token map has exactly the same replicas
+// as a token map built from scratch using the same hosts.
+void verify_same_as_full_build(const TokenMapImpl<Murmur3Partitioner>& token_map,
+                               const TestHostMap& hosts) {
+  typedef TokenMapImpl<Murmur3Partitioner>::TokenReplicasVec TokenReplicasVec;
+
+  TokenMapImpl<Murmur3Partitioner> expected_token_map;
+  add_test_keyspaces(&expected_token_map);
+  for (TestHostMap::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
+    expected_token_map.add_host(create_test_host(*i));
+  }
+  expected_token_map.build();
+
+  for (size_t i = 0; i < sizeof(test_keyspaces) / sizeof(test_keyspaces[0]); ++i) {
+    const String keyspace_name(test_keyspaces[i]);
+    TokenReplicasVec replicas;
+    TokenReplicasVec expected_replicas;
+    token_map.get_all_replicas(keyspace_name, &replicas);
+    expected_token_map.get_all_replicas(keyspace_name, &expected_replicas);
+
+    ASSERT_EQ(expected_replicas.size(), replicas.size()) << keyspace_name;
+    for (size_t j = 0; j < replicas.size(); ++j) {
+      EXPECT_EQ(expected_replicas[j].first, replicas[j].first) << keyspace_name;
+      const HostVec& hosts = *replicas[j].second;
+      const HostVec& expected_hosts = *expected_replicas[j].second;
+      ASSERT_EQ(expected_hosts.size(), hosts.size()) << keyspace_name;
+      for (size_t k = 0; k < hosts.size(); ++k) {
+        EXPECT_EQ(expected_hosts[k]->address(), hosts[k]->address()) << keyspace_name;
+      }
+    }
+  }
+}
+
+void on_token_map_updated(const TokenMapUpdater* updater, Vector<TokenMap::Ptr>* published) {
+  published->push_back(updater->token_map());
+}
+
 } // namespace
 
 TEST(TokenMapUnitTest, Murmur3) {
@@ -456,3 +540,469 @@ TEST(TokenMapUnitTest, DropKeyspace) {
     EXPECT_FALSE(replicas);
   }
 }
+
+/**
+ * Incrementally update the token map when a single host is added, updated or
+ * removed.
+ *
+ * This test will verify that the replicas of an incrementally updated token
+ * map are the same as a token map built from scratch for several replication
+ * strategies, including changes that modify the number of datacenters and
+ * racks.
+ *
+ * @test_category token_map
+ * @expected_results The incrementally updated replicas should match a full
+ * rebuild.
+ */
+TEST(TokenMapUnitTest, IncrementalUpdateMatchesFullBuild) {
+  const size_t tokens_per_host = 32;
+  MT19937_64 rng;
+
+  TestHostMap hosts;
+  hosts["1.0.0.1"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc1");
+  hosts["1.0.0.2"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc1");
+  hosts["1.0.0.3"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack2", "dc1");
+  hosts["1.0.0.4"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack2", "dc1");
+  hosts["1.0.0.5"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack3", "dc1");
+  hosts["1.0.0.6"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack3", "dc1");
+  hosts["2.0.0.1"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc2");
+  hosts["2.0.0.2"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc2");
+  hosts["2.0.0.3"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack2", "dc2");
+  hosts["2.0.0.4"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack2", "dc2");
+  hosts["3.0.0.1"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc3");
+
+  TokenMapImpl<Murmur3Partitioner> token_map;
+  add_test_keyspaces(&token_map);
+  for (TestHostMap::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
+    token_map.add_host(create_test_host(*i));
+  }
+  token_map.build();
+  verify_same_as_full_build(token_map, hosts);
+  const size_t num_full_rebuilt = token_map.num_rebuilt();
+
+  { // Remove a host and add it back with the same tokens
+    TestHostMap::iterator it = hosts.find("1.0.0.3");
+    TestHost removed_host(it->second);
+    token_map.remove_host_and_build(create_test_host(*it));
+    hosts.erase(it);
+    verify_same_as_full_build(token_map, hosts);
+    EXPECT_LT(token_map.num_rebuilt(), num_full_rebuilt);
+
+    hosts["1.0.0.3"] = removed_host;
+    token_map.update_host_and_build(create_test_host(*hosts.find("1.0.0.3")));
+    verify_same_as_full_build(token_map, hosts);
+    EXPECT_LT(token_map.num_rebuilt(), num_full_rebuilt);
+  }
+
+  { // Update a host's tokens
+    hosts["2.0.0.2"].tokens = random_murmur3_tokens(rng, tokens_per_host);
+    token_map.update_host_and_build(create_test_host(*hosts.find("2.0.0.2")));
+    verify_same_as_full_build(token_map, hosts);
+  }
+
+  { // Move a host to a different rack
+    hosts["1.0.0.6"].rack = "rack1";
+    token_map.update_host_and_build(create_test_host(*hosts.find("1.0.0.6")));
+    verify_same_as_full_build(token_map, hosts);
+  }
+
+  { // Add a host in a new rack
+    hosts["2.0.0.5"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack3", "dc2");
+    token_map.update_host_and_build(create_test_host(*hosts.find("2.0.0.5")));
+    verify_same_as_full_build(token_map, hosts);
+  }
+
+  { // Remove the only host of a datacenter
+    TestHostMap::iterator it = hosts.find("3.0.0.1");
+    token_map.remove_host_and_build(create_test_host(*it));
+    hosts.erase(it);
+    verify_same_as_full_build(token_map, hosts);
+  }
+
+  { // Add a host to the missing datacenter
+    hosts["4.0.0.1"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc4");
+    token_map.update_host_and_build(create_test_host(*hosts.find("4.0.0.1")));
+    verify_same_as_full_build(token_map, hosts);
+  }
+
+  { // Remove several hosts one at a time
+    const char* addresses[] = { "1.0.0.1", "2.0.0.3", "1.0.0.5", "2.0.0.1" };
+    for (size_t i = 0; i < sizeof(addresses) / sizeof(addresses[0]); ++i) {
+      TestHostMap::iterator it = hosts.find(addresses[i]);
+      token_map.remove_host_and_build(create_test_host(*it));
+      hosts.erase(it);
+      verify_same_as_full_build(token_map, hosts);
+    }
+  }
+}
+
+/**
+ * Only recompute the replicas of the tokens affected by a host change.
+ *
+ * This test will verify that removing a host and adding it back only
+ * recomputes the replicas of the tokens whose replicas could have changed.
+ * Using SimpleStrategy, a token's replicas only depend on the next
+ * "replication factor" tokens so each of the host's tokens can only affect
+ * that many tokens.
+ *
+ * @test_category token_map
+ * @expected_results The number of recomputed replicas should be well below
+ * the number of tokens.
+ */
+TEST(TokenMapUnitTest, IncrementalUpdateRebuildsFewReplicas) {
+  const size_t num_hosts = 11;
+  const size_t tokens_per_host = 32;
+  const size_t replication_factor = 3;
+  MT19937_64 rng;
+
+  TestHostMap hosts;
+  for (size_t i = 1; i <= num_hosts; ++i) {
+    OStringStream ss;
+    ss << "1.0.0." << i;
+    hosts[ss.str()] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc1");
+  }
+
+  TokenMapImpl<Murmur3Partitioner> token_map;
+  add_keyspace_simple("simple", replication_factor, &token_map);
+  for (TestHostMap::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
+    token_map.add_host(create_test_host(*i));
+  }
+  token_map.build();
+  const size_t num_tokens = num_hosts * tokens_per_host;
+  EXPECT_EQ(num_tokens, token_map.num_rebuilt());
+
+  TestHostMap::iterator it = hosts.find("1.0.0.3");
+  TestHost removed_host(it->second);
+  token_map.remove_host_and_build(create_test_host(*it));
+  hosts.erase(it);
+  EXPECT_LE(token_map.num_rebuilt(), tokens_per_host * replication_factor);
+  EXPECT_LT(token_map.num_rebuilt(), num_tokens / 3);
+
+  hosts["1.0.0.3"] = removed_host;
+  token_map.update_host_and_build(create_test_host(*hosts.find("1.0.0.3")));
+  EXPECT_LE(token_map.num_rebuilt(), tokens_per_host * replication_factor);
+  EXPECT_LT(token_map.num_rebuilt(), num_tokens / 3);
+}
+
+/**
+ * Share replicas between keyspaces and tokens.
+ *
+ * This test will verify that keyspaces with the same replication strategy
+ * share the same replicas and that tokens with the same replicas share the
+ * same host vector.
+ *
+ * @test_category token_map
+ * @expected_results Equal replicas should be shared.
+ */
+TEST(TokenMapUnitTest, SharedReplicas) {
+  typedef TokenMapImpl<Murmur3Partitioner>::TokenReplicasVec TokenReplicasVec;
+
+  const size_t tokens_per_host = 256;
+  MT19937_64 rng;
+
+  TokenMapImpl<Murmur3Partitioner> token_map;
+
+  ReplicationMap replication;
+  replication["dc1"] = "3";
+  add_keyspace_network_topology("ks1", replication, &token_map);
+  add_keyspace_network_topology("ks2", replication, &token_map);
+  add_keyspace_simple("ks3", 2, &token_map);
+
+  Host::Ptr host(create_host("1.0.0.1", random_murmur3_tokens(rng, tokens_per_host),
+                             Murmur3Partitioner::name().to_string(), "rack1", "dc1"));
+  token_map.add_host(host);
+  token_map.add_host(create_host("1.0.0.2", random_murmur3_tokens(rng, tokens_per_host),
+                                 Murmur3Partitioner::name().to_string(), "rack1", "dc1"));
+  token_map.add_host(create_host("1.0.0.3", random_murmur3_tokens(rng, tokens_per_host),
+                                 Murmur3Partitioner::name().to_string(), "rack1", "dc1"));
+  token_map.build();
+
+  EXPECT_TRUE(token_map.is_sharing_replicas("ks1", "ks2"));
+  EXPECT_FALSE(token_map.is_sharing_replicas("ks1", "ks3"));
+
+  { // There are at most 27 sequences of three replicas from three hosts
+    TokenReplicasVec replicas;
+    token_map.get_all_replicas("ks1", &replicas);
+    ASSERT_EQ(3 * tokens_per_host, replicas.size());
+    Set<const HostVec*> distinct;
+    for (TokenReplicasVec::const_iterator i = replicas.begin(), end = replicas.end(); i != end;
+         ++i) {
+      distinct.insert(&(*i->second));
+    }
+    EXPECT_LE(distinct.size(), 27u);
+  }
+
+  // Keyspaces that are still using the same replication strategy continue to
+  // share replicas after the token map is updated
+  token_map.remove_host_and_build(host);
+  EXPECT_TRUE(token_map.is_sharing_replicas("ks1", "ks2"));
+  token_map.update_host_and_build(host);
+  EXPECT_TRUE(token_map.is_sharing_replicas("ks1", "ks2"));
+
+  add_keyspace_simple("ks2", 2, &token_map);
+  token_map.build();
+  EXPECT_TRUE(token_map.is_sharing_replicas("ks2", "ks3"));
+  EXPECT_FALSE(token_map.is_sharing_replicas("ks1", "ks2"));
+}
+
+/**
+ * Build replicas using multiple threads.
+ *
+ * This test will verify that building and updating a token map with multiple
+ * threads produces the same replicas as a serial build.
+ *
+ * @test_category token_map
+ * @expected_results The replicas should be the same as a serial build.
+ */
+TEST(TokenMapUnitTest, ParallelBuild) {
+  const size_t tokens_per_host = 64;
+  MT19937_64 rng;
+
+  TestHostMap hosts;
+  hosts["1.0.0.1"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc1");
+  hosts["1.0.0.2"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack2", "dc1");
+  hosts["1.0.0.3"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack3", "dc1");
+  hosts["2.0.0.1"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc2");
+  hosts["2.0.0.2"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack2", "dc2");
+  hosts["3.0.0.1"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc3");
+
+  TokenMapImpl<Murmur3Partitioner> token_map;
+  token_map.set_build_pool(ParallelTaskPool::Ptr(new ParallelTaskPool(4)));
+  add_test_keyspaces(&token_map);
+  for (TestHostMap::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
+    token_map.add_host(create_test_host(*i));
+  }
+  token_map.build();
+  verify_same_as_full_build(token_map, hosts);
+
+  hosts["2.0.0.3"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack3", "dc2");
+  token_map.update_host_and_build(create_test_host(*hosts.find("2.0.0.3")));
+  verify_same_as_full_build(token_map, hosts);
+
+  TestHostMap::iterator it = hosts.find("1.0.0.2");
+  token_map.remove_host_and_build(create_test_host(*it));
+  hosts.erase(it);
+  verify_same_as_full_build(token_map, hosts);
+}
+
+/**
+ * Update a token map in the background.
+ *
+ * This test will verify that token map updates are applied on a worker thread
+ * and that the current token map is left unchanged until the updated token
+ * map is published.
+ *
+ * @test_category token_map
+ * @expected_results The updates should be published in order and the original
+ * token map should not be modified.
+ */
+TEST(TokenMapUnitTest, BackgroundUpdate) {
+  const size_t tokens_per_host = 64;
+  MT19937_64 rng;
+
+  TestHostMap hosts;
+  hosts["1.0.0.1"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc1");
+  hosts["1.0.0.2"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack2", "dc1");
+  hosts["2.0.0.1"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc2");
+  hosts["2.0.0.2"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack2", "dc2");
+  const TestHostMap original_hosts(hosts);
+
+  SharedRefPtr<TokenMapImpl<Murmur3Partitioner> > token_map(
+      new TokenMapImpl<Murmur3Partitioner>());
+  add_test_keyspaces(token_map.get());
+  for (TestHostMap::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
+    token_map->add_host(create_test_host(*i));
+  }
+  token_map->build();
+
+  uv_loop_t loop;
+  ASSERT_EQ(0, uv_loop_init(&loop));
+
+  Vector<TokenMap::Ptr> published;
+  TokenMapUpdater::Ptr updater(
+      new TokenMapUpdater(&loop, 2, bind_callback(on_token_map_updated, &published)));
+  token_map->set_build_pool(updater->build_pool());
+  updater->reset(TokenMap::Ptr(token_map));
+
+  // The first update is started right away and the rest are batched together
+  hosts["1.0.0.3"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack3", "dc1");
+  updater->update_host(create_test_host(*hosts.find("1.0.0.3")));
+  hosts["2.0.0.3"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack3", "dc2");
+  updater->update_host(create_test_host(*hosts.find("2.0.0.3")));
+  TestHostMap::iterator it = hosts.find("1.0.0.1");
+  updater->remove_host(create_test_host(*it));
+  hosts.erase(it);
+
+  EXPECT_TRUE(updater->is_updating());
+  EXPECT_EQ(token_map.get(), updater->token_map().get());
+
+  uv_run(&loop, UV_RUN_DEFAULT);
+
+  EXPECT_FALSE(updater->is_updating());
+  ASSERT_EQ(2u, published.size());
+  EXPECT_EQ(published.back().get(), updater->token_map().get());
+  EXPECT_NE(token_map.get(), updater->token_map().get());
+
+  verify_same_as_full_build(
+      static_cast<const TokenMapImpl<Murmur3Partitioner>&>(*updater->token_map()), hosts);
+  verify_same_as_full_build(*token_map, original_hosts);
+
+  // Updates are discarded after the updater is closed
+  updater->close();
+  updater->drop_keyspace("simple");
+  uv_run(&loop, UV_RUN_DEFAULT);
+  EXPECT_EQ(2u, published.size());
+
+  uv_loop_close(&loop);
+}
+
+/**
+ * Only build the replicas of specific keyspaces.
+ *
+ * This test will verify that only the replicas of the keyspaces set using
+ * `set_replica_keyspaces()` are built and that other keyspaces have no
+ * replicas (unless they share a replication strategy with a built keyspace).
+ *
+ * @test_category token_map
+ * @expected_results Only the given keyspaces should have replicas.
+ */
+TEST(TokenMapUnitTest, ReplicaKeyspaces) {
+  TokenMapImpl<Murmur3Partitioner> token_map;
+
+  StringVec keyspace_names;
+  keyspace_names.push_back("ks1");
+  token_map.set_replica_keyspaces(keyspace_names);
+
+  add_keyspace_simple("ks1", 3, &token_map);
+  add_keyspace_simple("ks2", 2, &token_map);
+  add_keyspace_simple("ks3", 3, &token_map);
+
+  token_map.add_host(create_host("1.0.0.1", single_token(CASS_INT64_MIN / 2)));
+  token_map.add_host(create_host("1.0.0.2", single_token(0)));
+  token_map.add_host(create_host("1.0.0.3", single_token(CASS_INT64_MAX / 2)));
+  token_map.build();
+
+  EXPECT_TRUE(token_map.is_replicas_built("ks1"));
+  EXPECT_FALSE(token_map.is_replicas_built("ks2"));
+  EXPECT_TRUE(token_map.is_replicas_built("ks3")); // Uses the same strategy as "ks1"
+
+  EXPECT_EQ(3u, token_map.get_replicas("ks1", "key")->size());
+  EXPECT_FALSE(token_map.get_replicas("ks2", "key"));
+
+  token_map.update_host_and_build(create_host("1.0.0.4", single_token(CASS_INT64_MAX / 4)));
+  EXPECT_TRUE(token_map.is_replicas_built("ks1"));
+  EXPECT_FALSE(token_map.is_replicas_built("ks2"));
+}
+
+/**
+ * Build a keyspace's replicas the first time they're used.
+ *
+ * This test will verify that lazy replicas are built by `get_replicas()`, are
+ * the same as replicas that are built up front and are kept up to date after
+ * they've been used.
+ *
+ * @test_category token_map
+ * @expected_results Replicas should only be built for the keyspaces that are
+ * used.
+ */
+TEST(TokenMapUnitTest, LazyReplicas) {
+  typedef TokenMapImpl<Murmur3Partitioner>::TokenReplicasVec TokenReplicasVec;
+
+  const size_t tokens_per_host = 32;
+  MT19937_64 rng;
+
+  TestHostMap hosts;
+  hosts["1.0.0.1"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc1");
+  hosts["1.0.0.2"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack2", "dc1");
+  hosts["1.0.0.3"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack3", "dc1");
+  hosts["2.0.0.1"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc2");
+  hosts["2.0.0.2"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack2", "dc2");
+
+  SharedRefPtr<TokenMapImpl<Murmur3Partitioner> > token_map(
+      new TokenMapImpl<Murmur3Partitioner>());
+  token_map->set_lazy_replicas(true);
+  add_test_keyspaces(token_map.get());
+  for (TestHostMap::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
+    token_map->add_host(create_test_host(*i));
+  }
+  token_map->build();
+
+  for (size_t i = 0; i < sizeof(test_keyspaces) / sizeof(test_keyspaces[0]); ++i) {
+    EXPECT_FALSE(token_map->is_replicas_built(test_keyspaces[i])) << test_keyspaces[i];
+  }
+
+  // Using a keyspace builds its replicas
+  EXPECT_TRUE(token_map->get_replicas("nts", "key"));
+  EXPECT_TRUE(token_map->is_replicas_built("nts"));
+  EXPECT_FALSE(token_map->is_replicas_built("simple"));
+
+  // A copy of the token map keeps the used replicas up to date
+  SharedRefPtr<TokenMapImpl<Murmur3Partitioner> > updated(
+      static_cast<TokenMapImpl<Murmur3Partitioner>*>(token_map->copy().get()));
+  hosts["1.0.0.4"] = TestHost(random_murmur3_tokens(rng, tokens_per_host), "rack1", "dc1");
+  updated->update_host_and_build(create_test_host(*hosts.find("1.0.0.4")));
+  EXPECT_TRUE(updated->is_replicas_built("nts"));
+  EXPECT_FALSE(updated->is_replicas_built("simple"));
+
+  // Lazy replicas are the same as replicas that are built up front
+  for (size_t i = 0; i < sizeof(test_keyspaces) / sizeof(test_keyspaces[0]); ++i) {
+    updated->get_replicas(test_keyspaces[i], "key");
+  }
+  SharedRefPtr<TokenMapImpl<Murmur3Partitioner> > promoted(
+      static_cast<TokenMapImpl<Murmur3Partitioner>*>(updated->copy().get()));
+  verify_same_as_full_build(*promoted, hosts);
+
+  TokenReplicasVec replicas;
+  token_map->get_all_replicas("simple", &replicas);
+  EXPECT_TRUE(replicas.empty()); // The original token map is unchanged
+}
+
+/**
+ * Get replicas using the public token map API.
+ *
+ * This test will verify that the public API returns the token map's own
+ * replicas (without a copy) for single and batched lookups.
+ *
+ * @test_category token_map
+ * @expected_results The public API should return the same replicas as the
+ * token map.
+ */
+TEST(TokenMapUnitTest, PublicApi) {
+  TokenMap::Ptr token_map(new TokenMapImpl<Murmur3Partitioner>());
+
+  add_keyspace_simple("ks", 2, token_map.get());
+  token_map->add_host(create_host("1.0.0.1", single_token(CASS_INT64_MIN / 2)));
+  token_map->add_host(create_host("1.0.0.2", single_token(0)));
+  token_map->add_host(create_host("1.0.0.3", single_token(CASS_INT64_MAX / 2)));
+  token_map->build();
+
+  const CassTokenMap* external = CassTokenMap::to(token_map.get());
+
+  const char* routing_keys[] = { "a", "b", "c", "d" };
+  const size_t routing_key_lengths[] = { 1, 1, 1, 1 };
+  const size_t count = sizeof(routing_keys) / sizeof(routing_keys[0]);
+  const CassReplicas* replicas[count];
+  ASSERT_EQ(CASS_OK, cass_token_map_get_replicas_batch(external, "ks", routing_keys,
+                                                       routing_key_lengths, count, replicas));
+
+  for (size_t i = 0; i < count; ++i) {
+    const CopyOnWriteHostVec& expected = token_map->get_replicas("ks", routing_keys[i]);
+    ASSERT_TRUE(replicas[i] != NULL);
+    EXPECT_EQ(&*expected, replicas[i]->from());
+    EXPECT_EQ(replicas[i], cass_token_map_get_replicas(external, "ks", routing_keys[i], 1));
+
+    ASSERT_EQ(2u, cass_replicas_count(replicas[i]));
+    for (size_t j = 0; j < 2; ++j) {
+      CassInet address;
+      int port;
+      ASSERT_EQ(CASS_OK, cass_replicas_get_address(replicas[i], j, &address, &port));
+      EXPECT_EQ(expected->at(j)->address(),
+                Address(address.address, address.address_length, port));
+    }
+    CassInet address;
+    EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS,
+              cass_replicas_get_address(replicas[i], 2, &address, NULL));
+  }
+
+  EXPECT_TRUE(cass_token_map_get_replicas(external, "invalid", "a", 1) == NULL);
+}
@@ -0,0 +1,103 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "constants.hpp"
+#include "third_party/mt19937_64/mt19937_64.hpp"
+#include "token_ring.hpp"
+
+#include <algorithm>
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+typedef TokenRing<int64_t, int> TestTokenRing;
+
+struct EntryCompare {
+  bool operator()(const TestTokenRing::Entry& lhs, const TestTokenRing::Entry& rhs) const {
+    return lhs.first < rhs.first;
+  }
+};
+
+// Find the expected value using a binary search over the sorted entries.
+static int expected_value(const TestTokenRing::EntryVec& sorted, int64_t token) {
+  TestTokenRing::EntryVec::const_iterator it = std::upper_bound(
+      sorted.begin(), sorted.end(), TestTokenRing::Entry(token, 0), EntryCompare());
+  return it != sorted.end() ? it->second : sorted.front().second;
+}
+
+TEST(TokenRingUnitTest, Empty) {
+  TestTokenRing ring;
+  EXPECT_TRUE(ring.empty());
+  EXPECT_TRUE(ring.find(0) == NULL);
+
+  ring.build(TestTokenRing::EntryVec());
+  EXPECT_TRUE(ring.empty());
+  EXPECT_TRUE(ring.find(0) == NULL);
+}
+
+TEST(TokenRingUnitTest, Simple) {
+  TestTokenRing::EntryVec sorted;
+  sorted.push_back(TestTokenRing::Entry(-100, 1));
+  sorted.push_back(TestTokenRing::Entry(0, 2));
+  sorted.push_back(TestTokenRing::Entry(100, 3));
+
+  TestTokenRing ring;
+  ring.build(sorted);
+  EXPECT_EQ(3u, ring.size());
+
+  EXPECT_EQ(1, *ring.find(-101));
+  EXPECT_EQ(2, *ring.find(-100)); // Tokens are exclusive
+  EXPECT_EQ(2, *ring.find(-1));
+  EXPECT_EQ(3, *ring.find(0));
+  EXPECT_EQ(3, *ring.find(99));
+  EXPECT_EQ(1, *ring.find(100)); // Wraps around
+  EXPECT_EQ(1, *ring.find(CASS_INT64_MAX));
+}
+
+TEST(TokenRingUnitTest, MatchesBinarySearch) {
+  MT19937_64 rng;
+
+  // Verify rings of every shape up to a complete tree and then some
+  for (size_t size = 1; size <= 130; ++size) {
+    TestTokenRing::EntryVec sorted;
+    for (size_t i = 0; i < size; ++i) {
+      sorted.push_back(TestTokenRing::Entry(static_cast<int64_t>(rng()), static_cast<int>(i)));
+    }
+    std::sort(sorted.begin(), sorted.end(), EntryCompare());
+
+    TestTokenRing ring;
+    ring.build(sorted);
+    ASSERT_EQ(size, ring.size());
+
+    TestTokenRing::EntryVec entries;
+    ring.get_entries(&entries);
+    ASSERT_EQ(sorted, entries);
+
+    for (size_t i = 0; i < size; ++i) {
+      int64_t token = sorted[i].first;
+      EXPECT_EQ(expected_value(sorted, token - 1), *ring.find(token - 1));
+      EXPECT_EQ(expected_value(sorted, token), *ring.find(token));
+      EXPECT_EQ(expected_value(sorted, token + 1), *ring.find(token + 1));
+    }
+
+    for (int i = 0; i < 100; ++i) {
+      int64_t token = static_cast<int64_t>(rng());
+      EXPECT_EQ(expected_value(sorted, token), *ring.find(token));
+    }
+  }
+}
@@ -199,6 +199,16 @@ typedef struct CassBatch_ CassBatch;
  */
 typedef struct CassFuture_ CassFuture;
 
+/**
+ * A queue of finished futures. Futures are added to a completion queue when
+ * they're set and the application harvests them in batches by polling the
+ * queue. This is an alternative to future callbacks, which run on the
+ * driver's I/O threads, and to waiting on each future individually.
+ *
+ * @struct CassCompletionQueue
+ */
+typedef struct CassCompletionQueue_ CassCompletionQueue;
+
 /**
  * A statement that has been prepared cluster-side (It has been pre-parsed
  * and cached).
@@ -321,6 +331,22 @@ typedef struct CassVersion_ {
  */
 typedef struct CassSchemaMeta_ CassSchemaMeta;
 
+/**
+ * A snapshot of the token map used for token-aware routing.
+ *
+ * @struct CassTokenMap
+ */
+typedef struct CassTokenMap_ CassTokenMap;
+
+/**
+ * The replicas of a partition. Replicas are owned by the token map snapshot
+ * they were retrieved from and are only valid until that token map is freed.
+ * Partitions with the same replicas share the same instance.
+ *
+ * @struct CassReplicas
+ */
+typedef struct CassReplicas_ CassReplicas;
+
 /**
  * Keyspace metadata
  *
@@ -443,6 +469,115 @@ typedef struct CassSpeculativeExecutionMetrics_ {
   cass_double_t percentage; /**< Fraction of requests that are aborted speculative retries */
 } CassSpeculativeExecutionMetrics;
 
+/**
+ * A snapshot of request latencies for a subset of the session's requests.
+ *
+ * @struct CassLatencyMetrics
+ *
+ * @see cass_session_get_host_metrics()
+ * @see cass_session_get_request_type_metrics()
+ */
+typedef struct CassLatencyMetrics_ {
+  cass_uint64_t count; /**< The number of requests */
+  cass_uint64_t min; /**< Minimum in microseconds */
+  cass_uint64_t max; /**< Maximum in microseconds */
+  cass_uint64_t mean; /**< Mean in microseconds */
+  cass_uint64_t stddev; /**< Standard deviation in microseconds */
+  cass_uint64_t median; /**< Median in microseconds */
+  cass_uint64_t percentile_75th; /**< 75th percentile in microseconds */
+  cass_uint64_t percentile_95th; /**< 95th percentile in microseconds */
+  cass_uint64_t percentile_98th; /**< 98th percentile in microseconds */
+  cass_uint64_t percentile_99th; /**< 99the percentile in microseconds */
+  cass_uint64_t percentile_999th; /**< 99.9th percentile in microseconds */
+} CassLatencyMetrics;
+
+/**
+ * A snapshot of the request latencies for a single host.
+ *
+ * @struct CassHostMetrics
+ *
+ * @see cass_session_get_host_metrics()
+ */
+typedef struct CassHostMetrics_ {
+  CassInet address; /**< The host's address */
+  int port; /**< The host's port */
+  CassLatencyMetrics requests; /**< Latencies of requests that the host responded to */
+} CassHostMetrics;
+
+/**
+ * A snapshot of the utilization of a single I/O thread. Times are cumulative
+ * from when the session connected so the utilization over an interval can be
+ * found from the difference of two snapshots. An I/O thread that is rarely
+ * blocked waiting for events, or whose task queue depth or timer lag keeps
+ * growing, is saturated and more I/O threads may be needed.
+ *
+ * @struct CassIoThreadMetrics
+ *
+ * @see cass_session_get_io_thread_metrics()
+ * @see cass_cluster_set_num_threads_io()
+ */
+typedef struct CassIoThreadMetrics_ {
+  unsigned thread_index; /**< The index of the I/O thread */
+  cass_uint64_t iterations; /**< The number of event loop iterations */
+  cass_uint64_t loop_time; /**< Time spent in event loop iterations in microseconds */
+  cass_uint64_t poll_time; /**< Time spent blocked waiting for events in microseconds */
+  cass_uint64_t busy_time; /**< Time spent running callbacks in microseconds */
+  cass_uint64_t max_iteration_time; /**< Longest event loop iteration in microseconds */
+  cass_double_t utilization; /**< Fraction of the loop time spent running callbacks */
+  cass_uint64_t task_queue_depth; /**< The number of tasks waiting to be run */
+  cass_uint64_t max_task_queue_depth; /**< Largest number of tasks waiting to be run */
+  cass_uint64_t timer_fires; /**< The number of request coalescing timeouts */
+  cass_uint64_t mean_timer_lag; /**< Mean lag of the coalescing timer in microseconds */
+  cass_uint64_t max_timer_lag; /**< Maximum lag of the coalescing timer in microseconds */
+} CassIoThreadMetrics;
+
+/**
+ * The times a request passed through each of the driver's stages. Times are
+ * in nanoseconds from an arbitrary point in the past and are only meaningful
+ * relative to each other. A stage that wasn't reached has a time of zero.
+ * If the request was retried or speculatively executed, the write, flush,
+ * first byte and decode times are from the execution that finished the
+ * request.
+ *
+ * @struct CassRequestTiming
+ *
+ * @see cass_future_timing()
+ */
+typedef struct CassRequestTiming_ {
+  cass_uint64_t enqueue; /**< The request was queued by the application */
+  cass_uint64_t dequeue; /**< The request was removed from the queue by an I/O thread */
+  cass_uint64_t write; /**< The request was written to a connection's buffers */
+  cass_uint64_t flush; /**< The connection's buffers were flushed to the socket */
+  cass_uint64_t first_byte; /**< The first bytes of the response were read */
+  cass_uint64_t decode; /**< The response was decoded */
+  cass_uint64_t complete; /**< The result was set and the future's callback was fired */
+} CassRequestTiming;
+
+/**
+ * The stages of a request. The latency of a stage is the time between two
+ * consecutive times in CassRequestTiming.
+ *
+ * @see cass_session_get_request_stage_metrics()
+ */
+typedef enum CassRequestStage_ {
+  CASS_REQUEST_STAGE_QUEUE, /**< From enqueue to dequeue */
+  CASS_REQUEST_STAGE_WRITE, /**< From dequeue to write (routing and encoding) */
+  CASS_REQUEST_STAGE_COALESCE, /**< From write to flush */
+  CASS_REQUEST_STAGE_SERVER, /**< From flush to first byte (network and server) */
+  CASS_REQUEST_STAGE_DECODE, /**< From first byte to decode */
+  CASS_REQUEST_STAGE_DISPATCH /**< From decode to complete */
+} CassRequestStage;
+
+/**
+ * Text exposition formats for exporting metrics.
+ *
+ * @see cass_session_metrics_export()
+ */
+typedef enum CassMetricsFormat_ {
+  CASS_METRICS_FORMAT_OPENMETRICS, /**< OpenMetrics 1.0 text format */
+  CASS_METRICS_FORMAT_PROMETHEUS /**< Prometheus 0.0.4 text format */
+} CassMetricsFormat;
+
 typedef enum CassConsistency_ {
   CASS_CONSISTENCY_UNKNOWN      = 0xFFFF,
   CASS_CONSISTENCY_ANY          = 0x0000,
@@ -574,6 +709,13 @@ typedef enum CassBatchType_ {
   CASS_BATCH_TYPE_COUNTER  = 0x02
 } CassBatchType;
 
+typedef enum CassRequestType_ {
+  CASS_REQUEST_TYPE_QUERY,
+  CASS_REQUEST_TYPE_EXECUTE,
+  CASS_REQUEST_TYPE_BATCH,
+  CASS_REQUEST_TYPE_PREPARE
+} CassRequestType;
+
 typedef enum CassIteratorType_ {
   CASS_ITERATOR_TYPE_RESULT,
   CASS_ITERATOR_TYPE_ROW,
@@ -589,7 +731,9 @@ typedef enum CassIteratorType_ {
   CASS_ITERATOR_TYPE_AGGREGATE_META,
   CASS_ITERATOR_TYPE_COLUMN_META,
   CASS_ITERATOR_TYPE_INDEX_META,
-  CASS_ITERATOR_TYPE_MATERIALIZED_VIEW_META
+  CASS_ITERATOR_TYPE_MATERIALIZED_VIEW_META,
+  CASS_ITERATOR_TYPE_HOST_METRICS,
+  CASS_ITERATOR_TYPE_IO_THREAD_METRICS
 } CassIteratorType;
 
 #define CASS_LOG_LEVEL_MAPPING(XX) \
@@ -633,6 +777,11 @@ typedef enum CassProtocolVersion_ {
                                            driver with DataStax Enterprise */
 } CassProtocolVersion;
 
+typedef enum CassCompression_ {
+  CASS_COMPRESSION_NONE,
+  CASS_COMPRESSION_LZ4
+} CassCompression;
+
 typedef enum  CassErrorSource_ {
   CASS_ERROR_SOURCE_NONE,
   CASS_ERROR_SOURCE_LIB,
@@ -677,6 +826,7 @@ typedef enum  CassErrorSource_ {
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_NO_CUSTOM_PAYLOAD, 33, "No custom payload") \
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_EXECUTION_PROFILE_INVALID, 34, "Invalid execution profile specified") \
   XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_NO_TRACING_ID, 35, "No tracing ID") \
+  XX(CASS_ERROR_SOURCE_LIB, CASS_ERROR_LIB_NO_REQUEST_TIMING, 36, "No request timing") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_SERVER_ERROR, 0x0000, "Server error") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_PROTOCOL_ERROR, 0x000A, "Protocol error") \
   XX(CASS_ERROR_SOURCE_SERVER, CASS_ERROR_SERVER_BAD_CREDENTIALS, 0x0100, "Bad credentials") \
@@ -731,6 +881,24 @@ typedef enum CassError_ {
 typedef void (*CassFutureCallback)(CassFuture* future,
                                    void* data);
 
+/**
+ * A finished future retrieved from a completion queue.
+ *
+ * @struct CassCompletion
+ *
+ * @see cass_completion_queue_poll()
+ */
+typedef struct CassCompletion_ {
+  /**
+   * The finished future. This must be freed using cass_future_free().
+   */
+  CassFuture* future;
+  /**
+   * The user defined tag provided when the future was added to the queue.
+   */
+  void* tag;
+} CassCompletion;
+
 /**
  * Maximum size of a log message
  */
@@ -1196,6 +1364,28 @@ cass_execution_profile_set_latency_aware_routing_settings(CassExecProfile* profi
                                                           cass_uint64_t update_rate_ms,
                                                           cass_uint64_t min_measured);
 
+/**
+ * Configures the execution profile to use power-of-two-choices request
+ * routing or not.
+ *
+ * <b>Note:</b> Execution profiles use the cluster-level load balancing policy
+ * unless enabled. This setting is not applicable unless a load balancing policy
+ * is enabled on the execution profile.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_power_of_two_choices_routing()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_power_of_two_choices_routing(CassExecProfile* profile,
+                                                        cass_bool_t enabled);
+
 /**
  * Sets/Appends whitelist hosts for the execution profile. The first call sets
  * the whitelist hosts and any subsequent calls appends additional hosts.
@@ -1665,7 +1855,10 @@ cass_cluster_set_num_threads_io(CassCluster* cluster,
 
 /**
  * Sets the size of the fixed size queue that stores
- * pending requests.
+ * pending requests. Each application thread that submits
+ * requests uses its own queue (beyond 64 threads, the
+ * additional threads share queues) and this size is split
+ * (approximately) evenly between those queues.
  *
  * <b>Default:</b> 8192
  *
@@ -1714,6 +1907,26 @@ CASS_EXPORT CassError
 cass_cluster_set_core_connections_per_host(CassCluster* cluster,
                                            unsigned num_connections);
 
+/**
+ * Enables "power of two choices" connection selection. Instead of comparing
+ * every connection to a host, two connections are chosen at random and the
+ * less busy one is used. A connection's load is its number of in-flight
+ * requests plus the number of bytes waiting to be written to the network.
+ * This is useful when there are many connections per host.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ *
+ * @see cass_cluster_set_core_connections_per_host()
+ */
+CASS_EXPORT void
+cass_cluster_set_power_of_two_choices_connection_selection(CassCluster* cluster,
+                                                           cass_bool_t enabled);
+
 /**
  * Sets the maximum number of connections made to each server in each
  * IO thread.
@@ -1833,6 +2046,72 @@ CASS_EXPORT CassError
 cass_cluster_set_new_request_ratio(CassCluster* cluster,
                                    cass_int32_t ratio);
 
+/**
+ * Enables adaptive coalescing. When enabled, the delay used to coalesce
+ * requests into a single system call is adjusted using the observed request
+ * rate and the number of queued requests. Requests are written immediately
+ * when the load is too low to benefit from coalescing and the delay grows
+ * with load up to the value set by cass_cluster_set_coalesce_delay(), which
+ * becomes the maximum delay. This is useful for applications that mix
+ * latency bound and throughput bound workloads.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_coalesce_delay()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_coalesce_delay_adaptive(CassCluster* cluster,
+                                         cass_bool_t enabled);
+
+/**
+ * Enables per-request timing. When enabled, the time at which each request
+ * passes through the driver's stages (queueing, writing, flushing, reading
+ * and decoding the response, etc.) is recorded. The timings of a request are
+ * available using cass_future_timing() and the latencies of each stage are
+ * aggregated into the session's metrics.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_future_timing()
+ * @see cass_session_get_request_stage_metrics()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_request_timing(CassCluster* cluster,
+                                cass_bool_t enabled);
+
+/**
+ * Enables detailed latency metrics. When enabled, request latencies are also
+ * tracked for each host and for each type of request. Each of these
+ * histograms is kept for every I/O thread so this uses additional memory
+ * for each host in the cluster.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_get_host_metrics()
+ * @see cass_session_get_request_type_metrics()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_detailed_latency_metrics(CassCluster* cluster,
+                                          cass_bool_t enabled);
+
 /**
  * Sets the maximum number of connections that will be created concurrently.
  * Connections are created when the current connections are unable to keep up with
@@ -2277,6 +2556,26 @@ cass_cluster_set_latency_aware_routing_settings(CassCluster* cluster,
                                                 cass_uint64_t update_rate_ms,
                                                 cass_uint64_t min_measured);
 
+/**
+ * Configures the cluster to use power-of-two-choices request routing or not.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * This routing policy uses the base routing policy to determine locality
+ * (dc-aware) and/or placement (token-aware). The first two hosts of each
+ * query plan (e.g. two replicas when token-aware routing is enabled) are
+ * compared and the one with the fewest in-flight requests, weighted by its
+ * recent average latency, is tried first. No periodic timer is required.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ */
+CASS_EXPORT void
+cass_cluster_set_power_of_two_choices_routing(CassCluster* cluster,
+                                              cass_bool_t enabled);
+
 /**
  * Sets/Appends whitelist hosts. The first call sets the whitelist hosts and
  * any subsequent calls appends additional hosts. Passing an empty string will
@@ -2641,6 +2940,93 @@ CASS_EXPORT CassError
 cass_cluster_set_max_reusable_write_objects(CassCluster* cluster,
                                             unsigned num_objects);
 
+/**
+ * Sets the maximum number of threads used to build the token map's replicas.
+ * Keyspaces with different replication strategies have their replicas built
+ * in parallel. Token map updates caused by topology and schema changes are
+ * always built in the background (on libuv's thread pool) and the previous
+ * token map continues to be used for routing until the update is finished.
+ *
+ * <b>Default:</b> 1
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] num_threads
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_token_aware_routing()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_token_map_build_threads(CassCluster* cluster,
+                                         unsigned num_threads);
+
+/**
+ * Sets the keyspaces that have their token-aware routing replicas computed
+ * when the token map is built. Requests for other keyspaces are not routed
+ * using token-aware routing unless lazy replicas are enabled.
+ *
+ * Examples: "keyspace1", "keyspace1,keyspace2"
+ *
+ * <b>Default:</b> An empty list (the replicas of all keyspaces are computed).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] keyspaces A comma delimited list of keyspaces. An empty string
+ * will clear the keyspaces. The string is copied into the cluster
+ * configuration; the memory pointed to by this parameter can be freed after
+ * this call.
+ *
+ * @see cass_cluster_set_token_map_lazy_replicas()
+ */
+CASS_EXPORT void
+cass_cluster_set_token_map_keyspaces(CassCluster* cluster,
+                                     const char* keyspaces);
+
+/**
+ * Same as cass_cluster_set_token_map_keyspaces(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] keyspaces
+ * @param[in] keyspaces_length
+ *
+ * @see cass_cluster_set_token_map_keyspaces()
+ */
+CASS_EXPORT void
+cass_cluster_set_token_map_keyspaces_n(CassCluster* cluster,
+                                       const char* keyspaces,
+                                       size_t keyspaces_length);
+
+/**
+ * Enables computing a keyspace's token-aware routing replicas the first time
+ * they're used instead of when the token map is built. Once computed, a
+ * keyspace's replicas are kept up to date when the cluster's topology changes.
+ * Keyspaces that are never used don't use any memory or time to compute
+ * their replicas.
+ *
+ * This applies to the keyspaces that are not set using
+ * cass_cluster_set_token_map_keyspaces().
+ *
+ * <b>Note:</b> The first request that uses a keyspace's replicas computes
+ * them which delays that request.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ *
+ * @see cass_cluster_set_token_map_keyspaces()
+ */
+CASS_EXPORT void
+cass_cluster_set_token_map_lazy_replicas(CassCluster* cluster,
+                                         cass_bool_t enabled);
+
 /**
  * Associates a named execution profile which can be utilized during execution.
  *
@@ -2742,6 +3128,24 @@ CASS_EXPORT CassError
 cass_cluster_set_no_compact(CassCluster* cluster,
                             cass_bool_t enabled);
 
+/**
+ * Sets the compression algorithm used for frame bodies. Compression is
+ * negotiated with each host during the protocol handshake and connections
+ * fall back to uncompressed frames if the host doesn't support the
+ * requested algorithm.
+ *
+ * <b>Default:</b> CASS_COMPRESSION_NONE
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] compression
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_compression(CassCluster* cluster,
+                             CassCompression compression);
+
 /**
  * Sets a callback for handling host state changes in the cluster.
  *
@@ -3009,6 +3413,35 @@ CASS_EXPORT CassFuture*
 cass_session_execute_batch(CassSession* session,
                            const CassBatch* batch);
 
+/**
+ * Execute multiple independent statements. This is more efficient than
+ * calling cass_session_execute() for each statement because the statements
+ * are submitted to the session's I/O threads together.
+ *
+ * The returned future is set after all of the statements have finished, it
+ * has no result, and if any of the statements fail it contains the error of
+ * the first failure. Each statement's result is also available using the
+ * futures returned in the <code>futures</code> array (if it's not NULL).
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statements An array of statements.
+ * @param[in] statement_count The number of statements.
+ * @param[out] futures An array, with room for statement_count elements, that
+ * is populated with a future for each statement (in the same order). Each
+ * future must be freed. This can be NULL if only the returned future is
+ * needed.
+ * @return A future that must be freed.
+ *
+ * @see cass_session_execute()
+ */
+CASS_EXPORT CassFuture*
+cass_session_execute_many(CassSession* session,
+                          const CassStatement* const* statements,
+                          size_t statement_count,
+                          CassFuture** futures);
+
 /**
  * Gets a snapshot of this session's schema metadata. The returned
  * snapshot of the schema metadata is not updated. This function
@@ -3025,6 +3458,24 @@ cass_session_execute_batch(CassSession* session,
 CASS_EXPORT const CassSchemaMeta*
 cass_session_get_schema_meta(const CassSession* session);
 
+/**
+ * Gets a snapshot of the token map this session uses for token-aware
+ * routing. The returned snapshot is not updated. This function must be
+ * called again to retrieve any topology or schema changes since the previous
+ * call.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return A token map instance that must be freed or NULL if the session is
+ * not connected or token-aware routing is disabled.
+ *
+ * @see cass_token_map_free()
+ * @see cass_cluster_set_token_aware_routing()
+ */
+CASS_EXPORT const CassTokenMap*
+cass_session_get_token_map(const CassSession* session);
+
 /**
  * Gets a copy of this session's performance/diagnostic metrics.
  *
@@ -3049,6 +3500,123 @@ CASS_EXPORT void
 cass_session_get_speculative_execution_metrics(const CassSession* session,
                                                CassSpeculativeExecutionMetrics* output);
 
+/**
+ * Gets an iterator over the request latency metrics of each host. A host's
+ * latencies include every request that it responded to, measured from when
+ * the request was started, and are tracked while the host is part of the
+ * cluster. The iterator is empty unless detailed latency metrics are enabled.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return A new iterator that must be freed.
+ *
+ * @see cass_iterator_get_host_metrics()
+ * @see cass_iterator_free()
+ */
+CASS_EXPORT CassIterator*
+cass_session_get_host_metrics(const CassSession* session);
+
+/**
+ * Gets a copy of the request latency metrics for a type of request. These
+ * are only recorded when detailed latency metrics are enabled.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] type
+ * @param[out] output
+ *
+ * @see cass_cluster_set_detailed_latency_metrics()
+ */
+CASS_EXPORT void
+cass_session_get_request_type_metrics(const CassSession* session,
+                                      CassRequestType type,
+                                      CassLatencyMetrics* output);
+
+/**
+ * Gets a copy of the latency metrics for a stage of request processing.
+ * Stage latencies are only recorded when request timing is enabled.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] stage
+ * @param[out] output
+ *
+ * @see cass_cluster_set_request_timing()
+ */
+CASS_EXPORT void
+cass_session_get_request_stage_metrics(const CassSession* session,
+                                       CassRequestStage stage,
+                                       CassLatencyMetrics* output);
+
+/**
+ * Gets an iterator over the utilization metrics of each of the session's I/O
+ * threads. These can be used to determine whether the number of I/O threads
+ * is too small for the session's workload.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @return A new iterator that must be freed.
+ *
+ * @see cass_iterator_get_io_thread_metrics()
+ * @see cass_iterator_free()
+ */
+CASS_EXPORT CassIterator*
+cass_session_get_io_thread_metrics(const CassSession* session);
+
+/**
+ * Renders this session's metrics, including request latencies (overall, by
+ * request type and by host), speculative execution metrics, request rates,
+ * connection counts and timeout counts, using a text exposition format
+ * suitable for scraping by Prometheus or other OpenMetrics consumers.
+ *
+ * Like snprintf(), the output is truncated to fit the buffer and is always
+ * null-terminated (if buffer_size is non-zero). The full length is returned
+ * so that the required buffer size can be determined by passing a NULL
+ * buffer.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] format
+ * @param[out] buffer The buffer to render into. May be NULL.
+ * @param[in] buffer_size The size of the buffer in bytes.
+ * @return The length of the full output in bytes, not including the null
+ * terminator.
+ */
+CASS_EXPORT size_t
+cass_session_metrics_export(const CassSession* session,
+                            CassMetricsFormat format,
+                            char* buffer,
+                            size_t buffer_size);
+
+/**
+ * Starts a minimal HTTP server that serves this session's metrics on
+ * "/metrics". OpenMetrics is served to clients that accept
+ * "application/openmetrics-text", otherwise the Prometheus text format is
+ * used. The server runs on its own thread and is stopped when the session is
+ * freed.
+ *
+ * <b>Note:</b> The server doesn't support TLS or authentication and should
+ * only be bound to a trusted interface (e.g. "127.0.0.1").
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] address An IP address to listen on.
+ * @param[in] port The port to listen on.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_metrics_export()
+ */
+CASS_EXPORT CassError
+cass_session_start_metrics_server(CassSession* session,
+                                  const char* address,
+                                  int port);
+
 /***********************************************************************************
  *
  * Schema Metadata
@@ -4385,6 +4953,127 @@ cass_aggregate_meta_field_by_name_n(const CassAggregateMeta* aggregate_meta,
                                     const char* name,
                                     size_t name_length);
 
+/***********************************************************************************
+ *
+ * Token Map
+ *
+ ***********************************************************************************/
+
+/**
+ * Frees a token map instance. The replicas retrieved from the token map
+ * are invalid after the token map is freed.
+ *
+ * @public @memberof CassTokenMap
+ *
+ * @param[in] token_map
+ */
+CASS_EXPORT void
+cass_token_map_free(const CassTokenMap* token_map);
+
+/**
+ * Gets the replicas of a partition. These are the same replicas that
+ * token-aware routing uses for requests with the same keyspace and routing
+ * key.
+ *
+ * @public @memberof CassTokenMap
+ *
+ * @param[in] token_map
+ * @param[in] keyspace
+ * @param[in] routing_key The serialized partition key. Composite partition
+ * keys use the same encoding as the routing key of a statement.
+ * @param[in] routing_key_length
+ * @return The replicas (owned by the token map) or NULL if there are no
+ * replicas for the keyspace. The replicas must not be used after the token
+ * map is freed.
+ *
+ * @see cass_replicas_count()
+ * @see cass_replicas_get_address()
+ */
+CASS_EXPORT const CassReplicas*
+cass_token_map_get_replicas(const CassTokenMap* token_map,
+                            const char* keyspace,
+                            const char* routing_key,
+                            size_t routing_key_length);
+
+/**
+ * Same as cass_token_map_get_replicas(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassTokenMap
+ *
+ * @param[in] token_map
+ * @param[in] keyspace
+ * @param[in] keyspace_length
+ * @param[in] routing_key
+ * @param[in] routing_key_length
+ * @return same as cass_token_map_get_replicas()
+ *
+ * @see cass_token_map_get_replicas()
+ */
+CASS_EXPORT const CassReplicas*
+cass_token_map_get_replicas_n(const CassTokenMap* token_map,
+                              const char* keyspace,
+                              size_t keyspace_length,
+                              const char* routing_key,
+                              size_t routing_key_length);
+
+/**
+ * Gets the replicas of several partitions in a keyspace. Partitions with
+ * the same replicas are given the same replicas instance so the returned
+ * pointers can be compared to group partitions by their replicas.
+ *
+ * @public @memberof CassTokenMap
+ *
+ * @param[in] token_map
+ * @param[in] keyspace
+ * @param[in] routing_keys The serialized partition keys.
+ * @param[in] routing_key_lengths The length of each partition key.
+ * @param[in] count The number of partition keys.
+ * @param[out] replicas The replicas of each partition key (owned by the
+ * token map). An element is NULL if there are no replicas for its
+ * partition key. The replicas must not be used after the token map is
+ * freed.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_token_map_get_replicas()
+ */
+CASS_EXPORT CassError
+cass_token_map_get_replicas_batch(const CassTokenMap* token_map,
+                                  const char* keyspace,
+                                  const char* const* routing_keys,
+                                  const size_t* routing_key_lengths,
+                                  size_t count,
+                                  const CassReplicas** replicas);
+
+/**
+ * Gets the number of hosts in a partition's replicas.
+ *
+ * @public @memberof CassReplicas
+ *
+ * @param[in] replicas
+ * @return The number of hosts.
+ */
+CASS_EXPORT size_t
+cass_replicas_count(const CassReplicas* replicas);
+
+/**
+ * Gets the address of a host in a partition's replicas. Hosts are in the
+ * order that token-aware routing uses them (before any shuffling).
+ *
+ * @public @memberof CassReplicas
+ *
+ * @param[in] replicas
+ * @param[in] index
+ * @param[out] address
+ * @param[out] port The host's port. This can be NULL.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_replicas_get_address(const CassReplicas* replicas,
+                          size_t index,
+                          CassInet* address,
+                          int* port);
+
 /***********************************************************************************
  *
  * SSL
@@ -4731,6 +5420,29 @@ cass_future_set_callback(CassFuture* future,
                          CassFutureCallback callback,
                          void* data);
 
+/**
+ * Adds a future to a completion queue. The future is added to the queue,
+ * along with the tag, after it's set (or immediately if it's already set). A
+ * future can only be added to a single completion queue.
+ *
+ * The queue holds its own reference to the future so the future can be freed
+ * after calling this function, but each future retrieved using
+ * cass_completion_queue_poll() must be freed.
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] future
+ * @param[in] queue
+ * @param[in] tag user defined data returned with the completion.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_completion_queue_poll()
+ */
+CASS_EXPORT CassError
+cass_future_set_completion_queue(CassFuture* future,
+                                 CassCompletionQueue* queue,
+                                 void* tag);
+
 /**
  * Gets the set status of the future.
  *
@@ -4845,6 +5557,23 @@ cass_future_error_message(CassFuture* future,
                           const char** message,
                           size_t* message_length);
 
+/**
+ * Gets the times the request passed through each of the driver's stages.
+ * This is a blocking call if the future is not ready.
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] future
+ * @param[out] timing
+ * @return CASS_OK if successful, CASS_ERROR_LIB_NO_REQUEST_TIMING if request
+ * timing wasn't enabled, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_request_timing()
+ */
+CASS_EXPORT CassError
+cass_future_timing(CassFuture* future,
+                   CassRequestTiming* timing);
+
 /**
  * Gets the tracing ID associated with the request.
  *
@@ -4896,6 +5625,72 @@ cass_future_custom_payload_item(CassFuture* future,
                                 const cass_byte_t** value,
                                 size_t* value_size);
 
+/***********************************************************************************
+ *
+ * Completion Queue
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new completion queue.
+ *
+ * @public @memberof CassCompletionQueue
+ *
+ * @return Returns a completion queue that must be freed.
+ *
+ * @see cass_completion_queue_free()
+ */
+CASS_EXPORT CassCompletionQueue*
+cass_completion_queue_new();
+
+/**
+ * Frees a completion queue instance. Futures that are still pending remain
+ * valid, but they're no longer retrievable from the queue.
+ *
+ * @public @memberof CassCompletionQueue
+ *
+ * @param[in] queue
+ */
+CASS_EXPORT void
+cass_completion_queue_free(CassCompletionQueue* queue);
+
+/**
+ * Retrieves up to <code>max_completions</code> finished futures from the
+ * queue. If the queue is empty this waits up to <code>timeout_us</code> for a
+ * future to finish.
+ *
+ * @public @memberof CassCompletionQueue
+ *
+ * @param[in] queue
+ * @param[out] completions An array with room for max_completions elements.
+ * The future of each completion must be freed.
+ * @param[in] max_completions
+ * @param[in] timeout_us The maximum time to wait, in microseconds, when the
+ * queue is empty. Use 0 to return immediately.
+ * @return The number of completions retrieved. Zero if the wait timed out.
+ */
+CASS_EXPORT size_t
+cass_completion_queue_poll(CassCompletionQueue* queue,
+                           CassCompletion* completions,
+                           size_t max_completions,
+                           cass_duration_t timeout_us);
+
+/**
+ * Gets a file descriptor that's readable while the completion queue is not
+ * empty. This can be registered with epoll() (or a similar mechanism) to
+ * determine when to call cass_completion_queue_poll(). The file descriptor
+ * is owned by the queue and must not be read from or closed.
+ *
+ * <b>Note:</b> This is only supported on Linux.
+ *
+ * @public @memberof CassCompletionQueue
+ *
+ * @param[in] queue
+ * @return A file descriptor or -1 if not supported on this platform.
+ */
+CASS_EXPORT int
+cass_completion_queue_fd(CassCompletionQueue* queue);
+
 /***********************************************************************************
  *
  * Statement
@@ -10088,6 +10883,39 @@ cass_iterator_get_user_type_field_name(const CassIterator* iterator,
 CASS_EXPORT const CassValue*
 cass_iterator_get_user_type_field_value(const CassIterator* iterator);
 
+/**
+ * Gets the host metrics at the host metrics iterator's current position.
+ *
+ * Calling cass_iterator_next() will invalidate the previous
+ * value returned by this method.
+ *
+ * @public @memberof CassIterator
+ *
+ * @param[in] iterator
+ * @return The host's metrics
+ *
+ * @see cass_session_get_host_metrics()
+ */
+CASS_EXPORT const CassHostMetrics*
+cass_iterator_get_host_metrics(const CassIterator* iterator);
+
+/**
+ * Gets the I/O thread metrics at the I/O thread metrics iterator's current
+ * position.
+ *
+ * Calling cass_iterator_next() will invalidate the previous
+ * value returned by this method.
+ *
+ * @public @memberof CassIterator
+ *
+ * @param[in] iterator
+ * @return The I/O thread's metrics
+ *
+ * @see cass_session_get_io_thread_metrics()
+ */
+CASS_EXPORT const CassIoThreadMetrics*
+cass_iterator_get_io_thread_metrics(const CassIterator* iterator);
+
 /**
  * Gets the keyspace metadata entry at the iterator's current position.
  *
@@ -11164,26 +11992,60 @@ cass_log_set_level(CassLogLevel log_level);
  * @param[in] data An opaque data object passed to the callback.
  * @param[in] callback A callback that handles logging events. This is
  * called in a separate thread so access to shared data must be synchronized.
+ *
+ * @see cass_log_set_async()
  */
 CASS_EXPORT void
 cass_log_set_callback(CassLogCallback callback,
                       void* data);
 
 /**
- * Sets the log queue size.
+ * Sets the log queue size used by asynchronous logging. Messages logged while
+ * the queue is full are dropped.
  *
- * <b>Note:</b> This needs to be done before any call that might log, such as
- * any of the cass_cluster_*() or cass_ssl_*() functions.
+ * <b>Note:</b> This needs to be done before asynchronous logging is enabled.
  *
  * <b>Default:</b> 2048
  *
- * @deprecated This is no longer useful and does nothing. Expect this to be
- * removed in a future release.
- *
  * @param[in] queue_size
+ *
+ * @see cass_log_set_async()
  */
-CASS_EXPORT CASS_DEPRECATED(void
-cass_log_set_queue_size(size_t queue_size));
+CASS_EXPORT void
+cass_log_set_queue_size(size_t queue_size);
+
+/**
+ * Enables asynchronous logging. Log messages are queued by the thread that
+ * logs them and the log callback is run on a dedicated background thread so
+ * that a slow callback doesn't delay request processing. Disabling
+ * asynchronous logging waits for queued messages to be delivered.
+ *
+ * <b>Note:</b> This needs to be done before any call that might log, such as
+ * any of the cass_cluster_*() or cass_ssl_*() functions, and it must not be
+ * called concurrently. Asynchronous logging should be disabled before the
+ * application exits to flush the remaining messages.
+ *
+ * <b>Default:</b> cass_false (the log callback is run by the thread that logs)
+ *
+ * @param[in] enabled
+ *
+ * @see cass_log_set_queue_size()
+ * @see cass_log_dropped_count()
+ */
+CASS_EXPORT void
+cass_log_set_async(cass_bool_t enabled);
+
+/**
+ * Gets the number of log messages dropped because the asynchronous log queue
+ * was full. The log callback also receives a warning with the number of
+ * messages dropped.
+ *
+ * @return The total number of dropped log messages.
+ *
+ * @see cass_log_set_async()
+ */
+CASS_EXPORT cass_uint64_t
+cass_log_dropped_count();
 
 /**
  * Gets the string for a log level.
@@ -0,0 +1,100 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_ADAPTIVE_COALESCE_DELAY_HPP
+#define DATASTAX_INTERNAL_ADAPTIVE_COALESCE_DELAY_HPP
+
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+
+// The number of requests that should ideally be written per flush
+#define CASS_COALESCE_TARGET_BATCH_SIZE 32
+
+// The weight of the newest rate sample in the moving average
+#define CASS_COALESCE_RATE_ALPHA 0.25
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Determines how long requests are allowed to accumulate before being written
+ * (the coalesce delay) using the observed request rate and the current queue
+ * depth. The goal is to write a target number of requests per flush (system
+ * call) without waiting longer than a maximum delay.
+ *
+ * When the request rate is too low to batch more than a single request within
+ * the maximum delay, or the queue already holds a full batch, requests are
+ * flushed without delay because waiting would only add latency.
+ */
+class AdaptiveCoalesceDelay {
+public:
+  /**
+   * Constructor
+   *
+   * @param max_delay_us The maximum coalesce delay in microseconds.
+   * @param target_batch_size The number of requests to write per flush.
+   */
+  AdaptiveCoalesceDelay(uint64_t max_delay_us,
+                        size_t target_batch_size = CASS_COALESCE_TARGET_BATCH_SIZE)
+      : max_delay_us_(max_delay_us)
+      , target_batch_size_(target_batch_size)
+      , rate_(-1.0)
+      , delay_us_(max_delay_us) {}
+
+  /**
+   * The current coalesce delay.
+   *
+   * @return The delay in microseconds.
+   */
+  uint64_t delay_us() const { return delay_us_; }
+
+  /**
+   * The average request rate.
+   *
+   * @return The rate in requests per microsecond or negative if no flushes
+   * have been recorded.
+   */
+  double rate() const { return rate_; }
+
+  /**
+   * Record a flush and update the coalesce delay.
+   *
+   * @param written The number of requests written by the flush.
+   * @param elapsed_us The amount of time since the previous flush.
+   * @param queued The number of requests still waiting in the queue.
+   */
+  void record_flush(size_t written, uint64_t elapsed_us, size_t queued) {
+    double rate = static_cast<double>(written) / std::max(elapsed_us, static_cast<uint64_t>(1));
+    rate_ = rate_ < 0.0 ? rate : rate_ + CASS_COALESCE_RATE_ALPHA * (rate - rate_);
+
+    if (queued >= target_batch_size_ || rate_ * max_delay_us_ < 2.0) {
+      delay_us_ = 0;
+    } else {
+      double delay_us = static_cast<double>(target_batch_size_ - queued) / rate_;
+      delay_us_ = std::min(static_cast<uint64_t>(delay_us), max_delay_us_);
+    }
+  }
+
+private:
+  const uint64_t max_delay_us_;
+  const size_t target_batch_size_;
+  double rate_;
+  uint64_t delay_us_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -182,6 +182,22 @@ public:
 
   size_t size() const { return size_; }
 
+  /**
+   * Shrink the size of the buffer. The underlying memory is kept unless the
+   * new size fits into the fixed buffer.
+   *
+   * @param size The new size; it must not be larger than the current size.
+   */
+  void truncate(size_t size) {
+    assert(size <= size_);
+    if (size_ > FIXED_BUFFER_SIZE && size <= FIXED_BUFFER_SIZE) {
+      RefBuffer* temp = data_.buffer;
+      memcpy(data_.fixed, temp->data(), size);
+      temp->dec_ref();
+    }
+    size_ = size;
+  }
+
 private:
   // Enough space to avoid extra allocations for most of the basic types
   static const size_t FIXED_BUFFER_SIZE = 16;
@@ -202,6 +202,8 @@ ClusterSettings::ClusterSettings()
     , prepare_on_up_or_add_host(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST)
     , max_prepares_per_flush(CASS_DEFAULT_MAX_PREPARES_PER_FLUSH)
     , disable_events_on_startup(false)
+    , token_map_build_threads(CASS_DEFAULT_TOKEN_MAP_BUILD_THREADS)
+    , token_map_lazy_replicas(CASS_DEFAULT_TOKEN_MAP_LAZY_REPLICAS)
     , cluster_metadata_resolver_factory(new DefaultClusterMetadataResolverFactory()) {
   load_balancing_policies.push_back(load_balancing_policy);
 }
@@ -215,6 +217,9 @@ ClusterSettings::ClusterSettings(const Config& config)
     , prepare_on_up_or_add_host(config.prepare_on_up_or_add_host())
     , max_prepares_per_flush(CASS_DEFAULT_MAX_PREPARES_PER_FLUSH)
     , disable_events_on_startup(false)
+    , token_map_build_threads(config.token_map_build_threads())
+    , token_map_keyspaces(config.token_map_keyspaces())
+    , token_map_lazy_replicas(config.token_map_lazy_replicas())
     , cluster_metadata_resolver_factory(config.cluster_metadata_resolver_factory()) {}
 
 Cluster::Cluster(const ControlConnection::Ptr& connection, ClusterListener* listener,
@@ -234,14 +239,24 @@ Cluster::Cluster(const ControlConnection::Ptr& connection, ClusterListener* list
     , hosts_(hosts)
     , local_dc_(local_dc)
     , supported_options_(supported_options)
-    , is_recording_events_(settings.disable_events_on_startup) {
+    , is_recording_events_(settings.disable_events_on_startup)
+    , token_map_updater_(new TokenMapUpdater(connection->loop(),
+                                             settings.token_map_build_threads,
+                                             bind_callback(&Cluster::on_token_map_updated, this))) {
   inc_ref();
   connection_->set_listener(this);
 
   query_plan_.reset(load_balancing_policy_->new_query_plan("", NULL, NULL));
 
   update_schema(schema);
-  update_token_map(hosts, connected_host_->partitioner(), schema);
+
+  // The initial token map is built on the event loop thread so that it's
+  // available when the cluster is connected.
+  token_map_ = create_token_map(hosts, connected_host_->partitioner(), schema);
+  if (token_map_) {
+    token_map_->build();
+  }
+  token_map_updater_->reset(token_map_);
 
   listener_->on_reconnect(this);
 }
@@ -359,20 +374,29 @@ void Cluster::update_schema(const ControlConnectionSchema& schema) {
   metadata_.swap_to_back_and_update_front();
 }
 
-void Cluster::update_token_map(const HostMap& hosts, const String& partitioner,
-                               const ControlConnectionSchema& schema) {
+TokenMap::Ptr Cluster::create_token_map(const HostMap& hosts, const String& partitioner,
+                                        const ControlConnectionSchema& schema) {
+  TokenMap::Ptr token_map;
   if (settings_.control_connection_settings.use_token_aware_routing && schema.keyspaces) {
     // Create a new token map and populate it
-    token_map_ = TokenMap::from_partitioner(partitioner);
-    if (!token_map_) {
-      return; // Partition is not supported
+    token_map = TokenMap::from_partitioner(partitioner);
+    if (!token_map) {
+      return token_map; // Partition is not supported
     }
-    token_map_->add_keyspaces(connection_->server_version(), schema.keyspaces.get());
+    token_map->set_build_pool(token_map_updater_->build_pool());
+    token_map->set_replica_keyspaces(settings_.token_map_keyspaces);
+    token_map->set_lazy_replicas(settings_.token_map_lazy_replicas);
+    token_map->add_keyspaces(connection_->server_version(), schema.keyspaces.get());
     for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
-      token_map_->add_host(it->second);
+      token_map->add_host(it->second);
     }
-    token_map_->build();
   }
+  return token_map;
+}
+
+void Cluster::on_token_map_updated(const TokenMapUpdater* updater) {
+  token_map_ = updater->token_map();
+  notify_or_record(ClusterEvent(token_map_));
 }
 
 // All hosts from the cluster are included in the host map and in the load
@@ -433,11 +457,13 @@ void Cluster::on_reconnect(ControlConnector* connector) {
     assert(connected_host_ && "Connected host not found in hosts map");
 
     update_schema(connector->schema());
-    update_token_map(connector->hosts(), connected_host_->partitioner(), connector->schema());
 
-    // Notify the listener that we've built a new token map
-    if (token_map_) {
-      notify_or_record(ClusterEvent(token_map_));
+    // Rebuild the token map in the background (notifying the listener when
+    // it's finished). The current token map is used until then.
+    TokenMap::Ptr token_map(
+        create_token_map(connector->hosts(), connected_host_->partitioner(), connector->schema()));
+    if (token_map) {
+      token_map_updater_->rebuild(token_map);
     }
 
     LOG_INFO("Control connection connected to %s", connected_host_->address_string().c_str());
@@ -454,6 +480,7 @@ void Cluster::on_reconnect(ControlConnector* connector) {
 
 void Cluster::internal_close() {
   is_closing_ = true;
+  token_map_updater_->close();
   monitor_reporting_timer_.stop();
   if (timer_.is_running()) {
     timer_.stop();
@@ -603,11 +630,7 @@ void Cluster::notify_host_add(const Host::Ptr& host) {
 }
 
 void Cluster::notify_host_add_after_prepare(const Host::Ptr& host) {
-  if (token_map_) {
-    token_map_ = token_map_->copy();
-    token_map_->update_host_and_build(host);
-    notify_or_record(ClusterEvent(token_map_));
-  }
+  token_map_updater_->update_host(host);
   notify_or_record(ClusterEvent(ClusterEvent::HOST_ADD, host));
 }
 
@@ -621,11 +644,7 @@ void Cluster::notify_host_remove(const Address& address) {
 
   Host::Ptr host(it->second);
 
-  if (token_map_) {
-    token_map_ = token_map_->copy();
-    token_map_->remove_host_and_build(host);
-    notify_or_record(ClusterEvent(token_map_));
-  }
+  token_map_updater_->remove_host(host);
 
   // If not marked down yet then explicitly trigger the event.
   if (load_balancing_policy_->is_host_up(address)) {
@@ -677,11 +696,7 @@ void Cluster::on_update_schema(SchemaType type, const ResultResponse::Ptr& resul
     case KEYSPACE:
       // Virtual keyspaces are not updated (always false)
       metadata_.update_keyspaces(result.get(), false);
-      if (token_map_) {
-        token_map_ = token_map_->copy();
-        token_map_->update_keyspaces_and_build(connection_->server_version(), result.get());
-        notify_or_record(ClusterEvent(token_map_));
-      }
+      token_map_updater_->update_keyspaces(connection_->server_version(), result);
       break;
     case TABLE:
       metadata_.update_tables(result.get());
@@ -712,11 +727,7 @@ void Cluster::on_drop_schema(SchemaType type, const String& keyspace_name,
   switch (type) {
     case KEYSPACE:
       metadata_.drop_keyspace(keyspace_name);
-      if (token_map_) {
-        token_map_ = token_map_->copy();
-        token_map_->drop_keyspace(keyspace_name);
-        notify_or_record(ClusterEvent(token_map_));
-      }
+      token_map_updater_->drop_keyspace(keyspace_name);
       break;
     case TABLE:
       metadata_.drop_table_or_view(keyspace_name, target_name);
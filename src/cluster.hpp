@@ -25,6 +25,7 @@
 #include "monitor_reporting.hpp"
 #include "prepare_host_handler.hpp"
 #include "prepared.hpp"
+#include "token_map_updater.hpp"
 
 #include <uv.h>
 
@@ -214,6 +215,23 @@ struct ClusterSettings {
    */
   bool disable_events_on_startup;
 
+  /**
+   * The maximum number of threads used to build the token map's replicas.
+   */
+  unsigned token_map_build_threads;
+
+  /**
+   * The keyspaces that have their replicas built when the token map is built.
+   * If empty then all keyspaces are built (unless lazy replicas are enabled).
+   */
+  StringVec token_map_keyspaces;
+
+  /**
+   * If true then the replicas of the keyspaces not in `token_map_keyspaces`
+   * are built the first time they're used.
+   */
+  bool token_map_lazy_replicas;
+
   /**
    * A factory for creating cluster metadata resolvers. A cluster metadata resolver is used to
    * determine contact points and retrieve other metadata required to connect the
@@ -366,8 +384,10 @@ private:
 private:
   void update_hosts(const HostMap& hosts);
   void update_schema(const ControlConnectionSchema& schema);
-  void update_token_map(const HostMap& hosts, const String& partitioner,
-                        const ControlConnectionSchema& schema);
+  TokenMap::Ptr create_token_map(const HostMap& hosts, const String& partitioner,
+                                 const ControlConnectionSchema& schema);
+
+  void on_token_map_updated(const TokenMapUpdater* updater);
 
   bool is_host_ignored(const Host::Ptr& host) const;
 
@@ -444,6 +464,7 @@ private:
   Timer timer_;
   bool is_recording_events_;
   ClusterEvent::Vec recorded_events_;
+  TokenMapUpdater::Ptr token_map_updater_;
   ScopedPtr<MonitorReporting> monitor_reporting_;
   Timer monitor_reporting_timer_;
   ScopedPtr<ReconnectionSchedule> reconnection_schedule_;
@@ -136,6 +136,11 @@ CassError cass_cluster_set_core_connections_per_host(CassCluster* cluster,
   return CASS_OK;
 }
 
+void cass_cluster_set_power_of_two_choices_connection_selection(CassCluster* cluster,
+                                                                cass_bool_t enabled) {
+  cluster->config().set_power_of_two_choices_connection_selection(enabled == cass_true);
+}
+
 CassError cass_cluster_set_max_connections_per_host(CassCluster* cluster,
                                                     unsigned num_connections) {
   return CASS_OK;
@@ -185,6 +190,21 @@ CassError cass_cluster_set_new_request_ratio(CassCluster* cluster, cass_int32_t
   return CASS_OK;
 }
 
+CassError cass_cluster_set_coalesce_delay_adaptive(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_coalesce_delay_adaptive(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_request_timing(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_request_timing(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_cluster_set_detailed_latency_metrics(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_detailed_latency_metrics(enabled == cass_true);
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_max_concurrent_creation(CassCluster* cluster, unsigned num_connections) {
   // Deprecated
   return CASS_OK;
@@ -316,6 +336,10 @@ void cass_cluster_set_latency_aware_routing_settings(
   cluster->config().set_latency_aware_routing_settings(settings);
 }
 
+void cass_cluster_set_power_of_two_choices_routing(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_power_of_two_choices_routing(enabled == cass_true);
+}
+
 void cass_cluster_set_whitelist_filtering(CassCluster* cluster, const char* hosts) {
   cass_cluster_set_whitelist_filtering_n(cluster, hosts, SAFE_STRLEN(hosts));
 }
@@ -437,6 +461,31 @@ CassError cass_cluster_set_max_reusable_write_objects(CassCluster* cluster, unsi
   return CASS_OK;
 }
 
+CassError cass_cluster_set_token_map_build_threads(CassCluster* cluster, unsigned num_threads) {
+  if (num_threads == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_token_map_build_threads(num_threads);
+  return CASS_OK;
+}
+
+void cass_cluster_set_token_map_keyspaces(CassCluster* cluster, const char* keyspaces) {
+  cass_cluster_set_token_map_keyspaces_n(cluster, keyspaces, SAFE_STRLEN(keyspaces));
+}
+
+void cass_cluster_set_token_map_keyspaces_n(CassCluster* cluster, const char* keyspaces,
+                                            size_t keyspaces_length) {
+  if (keyspaces_length == 0) {
+    cluster->config().token_map_keyspaces().clear();
+  } else {
+    explode(String(keyspaces, keyspaces_length), cluster->config().token_map_keyspaces());
+  }
+}
+
+void cass_cluster_set_token_map_lazy_replicas(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_token_map_lazy_replicas(enabled == cass_true);
+}
+
 CassError cass_cluster_set_execution_profile(CassCluster* cluster, const char* name,
                                              CassExecProfile* profile) {
   return cass_cluster_set_execution_profile_n(cluster, name, SAFE_STRLEN(name), profile);
@@ -485,6 +534,14 @@ CassError cass_cluster_set_no_compact(CassCluster* cluster, cass_bool_t enabled)
   return CASS_OK;
 }
 
+CassError cass_cluster_set_compression(CassCluster* cluster, CassCompression compression) {
+  if (compression != CASS_COMPRESSION_NONE && compression != CASS_COMPRESSION_LZ4) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_compression(compression);
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_host_listener_callback(CassCluster* cluster,
                                                   CassHostListenerCallback callback, void* data) {
   cluster->config().set_host_listener(
@@ -0,0 +1,155 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "completion_queue.hpp"
+
+#include "future.hpp"
+#include "logger.hpp"
+#include "scoped_lock.hpp"
+
+#ifdef HAVE_EVENTFD
+#include <errno.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassCompletionQueue* cass_completion_queue_new() {
+  CompletionQueue* queue = new CompletionQueue();
+  queue->inc_ref();
+  return CassCompletionQueue::to(queue);
+}
+
+void cass_completion_queue_free(CassCompletionQueue* queue) { queue->dec_ref(); }
+
+size_t cass_completion_queue_poll(CassCompletionQueue* queue, CassCompletion* completions,
+                                  size_t max_completions, cass_duration_t timeout_us) {
+  return queue->poll(completions, max_completions, timeout_us);
+}
+
+int cass_completion_queue_fd(CassCompletionQueue* queue) { return queue->fd(); }
+
+} // extern "C"
+
+CompletionQueue::CompletionQueue()
+    : head_(0)
+    , waiters_(0)
+    , fd_(-1) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+#ifdef HAVE_EVENTFD
+  fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (fd_ < 0) {
+    LOG_ERROR("Unable to create completion queue eventfd: %s", strerror(errno));
+  }
+#endif
+}
+
+CompletionQueue::~CompletionQueue() {
+  // Release the futures that were never retrieved
+  for (size_t i = head_; i < completions_.size(); ++i) {
+    completions_[i].future->from()->dec_ref();
+  }
+#ifdef HAVE_EVENTFD
+  if (fd_ >= 0) close(fd_);
+#endif
+  uv_mutex_destroy(&mutex_);
+  uv_cond_destroy(&cond_);
+}
+
+void CompletionQueue::push(Future* future, void* tag) {
+  CassCompletion completion;
+  completion.future = CassFuture::to(future);
+  completion.tag = tag;
+
+  ScopedMutex lock(&mutex_);
+  bool was_empty = head_ == completions_.size();
+  completions_.push_back(completion);
+  if (was_empty) {
+    // Only signal the transition to non-empty so that a batch of completions
+    // costs a single wakeup.
+    signal();
+    if (waiters_ > 0) uv_cond_signal(&cond_);
+  }
+}
+
+size_t CompletionQueue::poll(CassCompletion* completions, size_t max_completions,
+                             uint64_t timeout_us) {
+  ScopedMutex lock(&mutex_);
+
+  if (head_ == completions_.size() && timeout_us > 0 && max_completions > 0) {
+    uint64_t deadline = uv_hrtime() + timeout_us * 1000;
+    waiters_++;
+    while (head_ == completions_.size()) {
+      uint64_t now = uv_hrtime();
+      if (now >= deadline ||
+          uv_cond_timedwait(&cond_, lock.get(), deadline - now) != 0) { // Expects nanos
+        break;
+      }
+    }
+    waiters_--;
+  }
+
+  size_t count = std::min(max_completions, completions_.size() - head_);
+  std::copy(completions_.begin() + head_, completions_.begin() + head_ + count, completions);
+  head_ += count;
+
+  if (head_ == completions_.size()) {
+    completions_.clear();
+    head_ = 0;
+    if (count > 0) clear_signal();
+  } else {
+    // Remove the retrieved completions once they're the majority so that the
+    // storage stays bounded when the queue is never completely drained.
+    if (head_ > completions_.size() / 2) {
+      completions_.erase(completions_.begin(), completions_.begin() + head_);
+      head_ = 0;
+    }
+    if (waiters_ > 0) {
+      uv_cond_signal(&cond_); // Let other pollers take the remaining completions
+    }
+  }
+
+  return count;
+}
+
+void CompletionQueue::signal() {
+#ifdef HAVE_EVENTFD
+  if (fd_ >= 0) {
+    uint64_t value = 1;
+    ssize_t rc = write(fd_, &value, sizeof(value));
+    (void)rc; // Only fails when the counter would overflow
+  }
+#endif
+}
+
+void CompletionQueue::clear_signal() {
+#ifdef HAVE_EVENTFD
+  if (fd_ >= 0) {
+    uint64_t value;
+    ssize_t rc = read(fd_, &value, sizeof(value));
+    (void)rc; // Fails with EAGAIN if already cleared
+  }
+#endif
+}
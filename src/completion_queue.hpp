@@ -0,0 +1,104 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_COMPLETION_QUEUE_HPP
+#define DATASTAX_INTERNAL_COMPLETION_QUEUE_HPP
+
+#include "cassandra.h"
+#include "driver_config.hpp"
+#include "external.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "scoped_lock.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class Future;
+
+/**
+ * A queue of finished futures that's drained in batches by an application
+ * thread. Futures are pushed by the thread that sets them (usually an I/O
+ * thread) and the queue is only signaled when it goes from empty to
+ * non-empty.
+ *
+ * On Linux, an eventfd is provided that's readable while the queue is not
+ * empty so that the queue can be used with epoll().
+ */
+class CompletionQueue : public RefCounted<CompletionQueue> {
+public:
+  typedef SharedRefPtr<CompletionQueue> Ptr;
+
+  CompletionQueue();
+  ~CompletionQueue();
+
+  /**
+   * A file descriptor that's readable while the queue is not empty.
+   *
+   * @return The file descriptor or -1 if not supported.
+   */
+  int fd() const { return fd_; }
+
+  /**
+   * Add a finished future to the queue.
+   *
+   * @param future The future. The caller's reference to the future is
+   * transferred to the queue and then to the application when the
+   * completion is retrieved.
+   * @param tag User defined data.
+   */
+  void push(Future* future, void* tag);
+
+  /**
+   * Retrieve finished futures from the queue.
+   *
+   * @param completions The output array for the completions.
+   * @param max_completions The size of the output array.
+   * @param timeout_us The amount of time to wait if the queue is empty.
+   * @return The number of completions retrieved.
+   */
+  size_t poll(CassCompletion* completions, size_t max_completions, uint64_t timeout_us);
+
+  // Test only. The number of completions stored, including those that have
+  // already been retrieved but not yet compacted.
+  size_t storage_size() const {
+    ScopedMutex lock(&mutex_);
+    return completions_.size();
+  }
+
+private:
+  void signal();
+  void clear_signal();
+
+private:
+  mutable uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  Vector<CassCompletion> completions_;
+  size_t head_;
+  int waiters_;
+  int fd_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(CompletionQueue);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::CompletionQueue, CassCompletionQueue)
+
+#endif
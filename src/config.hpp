@@ -28,6 +28,7 @@
 #include "speculative_execution.hpp"
 #include "ssl.hpp"
 #include "string.hpp"
+#include "string_ref.hpp"
 #include "timestamp_generator.hpp"
 
 #include <climits>
@@ -54,6 +55,11 @@ public:
       , tracing_consistency_(CASS_DEFAULT_TRACING_CONSISTENCY)
       , coalesce_delay_us_(CASS_DEFAULT_COALESCE_DELAY)
       , new_request_ratio_(CASS_DEFAULT_NEW_REQUEST_RATIO)
+      , coalesce_delay_adaptive_(CASS_DEFAULT_COALESCE_DELAY_ADAPTIVE)
+      , request_timing_(CASS_DEFAULT_REQUEST_TIMING)
+      , detailed_latency_metrics_(CASS_DEFAULT_DETAILED_LATENCY_METRICS)
+      , power_of_two_choices_connection_selection_(
+            CASS_DEFAULT_POWER_OF_TWO_CHOICES_CONNECTION_SELECTION)
       , log_level_(CASS_DEFAULT_LOG_LEVEL)
       , log_callback_(stderr_log_callback)
       , log_data_(NULL)
@@ -68,9 +74,12 @@ public:
       , use_hostname_resolution_(CASS_DEFAULT_HOSTNAME_RESOLUTION_ENABLED)
       , use_randomized_contact_points_(CASS_DEFAULT_USE_RANDOMIZED_CONTACT_POINTS)
       , max_reusable_write_objects_(CASS_DEFAULT_MAX_REUSABLE_WRITE_OBJECTS)
+      , token_map_build_threads_(CASS_DEFAULT_TOKEN_MAP_BUILD_THREADS)
+      , token_map_lazy_replicas_(CASS_DEFAULT_TOKEN_MAP_LAZY_REPLICAS)
       , prepare_on_all_hosts_(CASS_DEFAULT_PREPARE_ON_ALL_HOSTS)
       , prepare_on_up_or_add_host_(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST)
       , no_compact_(CASS_DEFAULT_NO_COMPACT)
+      , compression_(CASS_DEFAULT_COMPRESSION)
       , is_client_id_set_(false)
       , host_listener_(new DefaultHostListener())
       , monitor_reporting_interval_secs_(CASS_DEFAULT_CLIENT_MONITOR_EVENTS_INTERVAL_SECS)
@@ -119,6 +128,14 @@ public:
     core_connections_per_host_ = num_connections;
   }
 
+  bool power_of_two_choices_connection_selection() const {
+    return power_of_two_choices_connection_selection_;
+  }
+
+  void set_power_of_two_choices_connection_selection(bool enabled) {
+    power_of_two_choices_connection_selection_ = enabled;
+  }
+
   ReconnectionPolicy::Ptr reconnection_policy() const { return reconnection_policy_; }
 
   void set_constant_reconnect(uint64_t wait_time_ms) {
@@ -157,6 +174,18 @@ public:
 
   void set_new_request_ratio(int ratio) { new_request_ratio_ = ratio; }
 
+  bool coalesce_delay_adaptive() const { return coalesce_delay_adaptive_; }
+
+  void set_coalesce_delay_adaptive(bool enabled) { coalesce_delay_adaptive_ = enabled; }
+
+  bool request_timing() const { return request_timing_; }
+
+  void set_request_timing(bool enabled) { request_timing_ = enabled; }
+
+  bool detailed_latency_metrics() const { return detailed_latency_metrics_; }
+
+  void set_detailed_latency_metrics(bool enabled) { detailed_latency_metrics_ = enabled; }
+
   unsigned request_timeout() { return default_profile_.request_timeout_ms(); }
   void set_request_timeout(unsigned timeout_ms) {
     default_profile_.set_request_timeout(timeout_ms);
@@ -247,6 +276,10 @@ public:
     default_profile_.set_latency_aware_routing(is_latency_aware);
   }
 
+  void set_power_of_two_choices_routing(bool is_power_of_two_choices) {
+    default_profile_.set_power_of_two_choices_routing(is_power_of_two_choices);
+  }
+
   void set_host_targeting(bool is_host_targeting) {
     default_profile_.set_host_targeting(is_host_targeting);
   }
@@ -306,6 +339,15 @@ public:
     max_reusable_write_objects_ = max_reusable_write_objects;
   }
 
+  unsigned token_map_build_threads() const { return token_map_build_threads_; }
+  void set_token_map_build_threads(unsigned num_threads) { token_map_build_threads_ = num_threads; }
+
+  const StringVec& token_map_keyspaces() const { return token_map_keyspaces_; }
+  StringVec& token_map_keyspaces() { return token_map_keyspaces_; }
+
+  bool token_map_lazy_replicas() const { return token_map_lazy_replicas_; }
+  void set_token_map_lazy_replicas(bool enabled) { token_map_lazy_replicas_ = enabled; }
+
   const ExecutionProfile& default_profile() const { return default_profile_; }
 
   ExecutionProfile& default_profile() { return default_profile_; }
@@ -337,6 +379,10 @@ public:
 
   void set_no_compact(bool enabled) { no_compact_ = enabled; }
 
+  CassCompression compression() const { return compression_; }
+
+  void set_compression(CassCompression compression) { compression_ = compression; }
+
   const String& application_name() const { return application_name_; }
 
   void set_application_name(const String& application_name) {
@@ -419,6 +465,10 @@ private:
   CassConsistency tracing_consistency_;
   uint64_t coalesce_delay_us_;
   int new_request_ratio_;
+  bool coalesce_delay_adaptive_;
+  bool request_timing_;
+  bool detailed_latency_metrics_;
+  bool power_of_two_choices_connection_selection_;
   CassLogLevel log_level_;
   CassLogCallback log_callback_;
   void* log_data_;
@@ -434,12 +484,16 @@ private:
   bool use_hostname_resolution_;
   bool use_randomized_contact_points_;
   unsigned max_reusable_write_objects_;
+  unsigned token_map_build_threads_;
+  StringVec token_map_keyspaces_;
+  bool token_map_lazy_replicas_;
   ExecutionProfile default_profile_;
   ExecutionProfile::Map profiles_;
   bool prepare_on_all_hosts_;
   bool prepare_on_up_or_add_host_;
   Address local_address_;
   bool no_compact_;
+  CassCompression compression_;
   String application_name_;
   String application_version_;
   bool is_client_id_set_;
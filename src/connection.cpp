@@ -71,8 +71,20 @@ class NopConnectionListener : public ConnectionListener {
 
 static NopConnectionListener nop_listener__;
 
+void ConnectionHandler::alloc_buffer(size_t suggested_size, uv_buf_t* buf) {
+  is_direct_read_ = connection_->alloc_direct_buffer(suggested_size, buf);
+  if (!is_direct_read_) {
+    SocketHandler::alloc_buffer(suggested_size, buf);
+  }
+}
+
 void ConnectionHandler::on_read(Socket* socket, ssize_t nread, const uv_buf_t* buf) {
-  connection_->on_read(buf->base, nread);
+  if (is_direct_read_) { // The data was read directly into a response body
+    is_direct_read_ = false;
+    connection_->on_read(buf->base, nread);
+    return;
+  }
+  connection_->on_read(buf->base, nread, read_buffer(buf));
   free_buffer(buf);
 }
 
@@ -109,8 +121,13 @@ Connection::Connection(const Socket::Ptr& socket, const Host::Ptr& host,
     , host_(host)
     , inflight_request_count_(0)
     , response_(new ResponseMessage())
+    , is_request_timing_enabled_(false)
+    , read_time_ns_(0)
+    , response_time_ns_(0)
+    , decode_time_ns_(0)
     , listener_(&nop_listener__)
     , protocol_version_(protocol_version)
+    , compression_(CASS_COMPRESSION_NONE)
     , idle_timeout_secs_(idle_timeout_secs)
     , heartbeat_interval_secs_(heartbeat_interval_secs)
     , heartbeat_outstanding_(false) {
@@ -225,17 +242,51 @@ void Connection::on_write(int status, RequestCallback* request) {
   }
 }
 
-void Connection::on_read(const char* buf, size_t size) {
-  listener_->on_read();
+bool Connection::alloc_direct_buffer(size_t suggested_size, uv_buf_t* buf) {
+  if (segment_decoder_) return false;
 
-  const char* pos = buf;
-  size_t remaining = size;
+  // Only large bodies are read directly, smaller reads are more efficient when
+  // several responses can be read at once.
+  size_t size = 0;
+  char* body = response_->remaining_body(&size);
+  if (body == NULL || size < suggested_size) return false;
+
+  *buf = uv_buf_init(body, size);
+  return true;
+}
+
+void Connection::on_read(const char* buf, size_t size, RefBuffer* owner) {
+  listener_->on_read();
 
   // A successful read means the connection is still responsive
   restart_terminate_timer();
 
+  // Shared by all the responses started and decoded in this read
+  if (is_request_timing_enabled_) {
+    read_time_ns_ = uv_hrtime();
+    decode_time_ns_ = 0;
+  }
+
+  if (segment_decoder_) {
+    decode_segments(buf, size);
+  } else {
+    size_t consumed = decode_frames(buf, size, owner);
+    // The connection can switch to segments in the middle of a read
+    if (consumed < size && segment_decoder_) {
+      decode_segments(buf + consumed, size - consumed);
+    }
+  }
+}
+
+size_t Connection::decode_frames(const char* buf, size_t size, RefBuffer* owner) {
+  const char* pos = buf;
+  size_t remaining = size;
+  bool is_segmented = segment_decoder_.get() != NULL;
+
   while (remaining != 0 && !socket_->is_closing()) {
-    ssize_t consumed = response_->decode(pos, remaining);
+    if (response_time_ns_ == 0) response_time_ns_ = read_time_ns_;
+
+    ssize_t consumed = response_->decode(pos, remaining, owner);
     if (consumed <= 0) {
       LOG_ERROR("Error decoding/consuming message");
       defunct();
@@ -245,12 +296,21 @@ void Connection::on_read(const char* buf, size_t size) {
     if (response_->is_body_ready()) {
       ScopedPtr<ResponseMessage> response(response_.release());
       response_.reset(new ResponseMessage());
+      uint64_t response_time_ns = response_time_ns_;
+      response_time_ns_ = 0;
 
       LOG_TRACE("Consumed message type %s with stream %d, input %u, remaining %u on host %s",
                 opcode_to_string(response->opcode()).c_str(), static_cast<int>(response->stream()),
                 static_cast<unsigned int>(size), static_cast<unsigned int>(remaining),
                 host_->address_string().c_str());
 
+      // Everything after the handshake's final response is sent using segments
+      if (!is_segmented && protocol_version_.supports_segments() &&
+          (response->opcode() == CQL_OPCODE_READY ||
+           response->opcode() == CQL_OPCODE_AUTHENTICATE)) {
+        enable_segments();
+      }
+
       if (response->stream() < 0) {
         if (response->opcode() == CQL_OPCODE_EVENT) {
           listener_->on_event(response->response_body());
@@ -264,6 +324,13 @@ void Connection::on_read(const char* buf, size_t size) {
         RequestCallback::Ptr callback;
 
         if (stream_manager_.get(response->stream(), callback)) {
+          RequestTiming* timing = callback->timing();
+          if (timing) {
+            timing->first_byte = response_time_ns;
+            if (decode_time_ns_ == 0) decode_time_ns_ = uv_hrtime();
+            timing->decode = decode_time_ns_;
+          }
+
           switch (callback->state()) {
             case RequestCallback::REQUEST_STATE_READING:
               pending_reads_.remove(callback.get());
@@ -296,7 +363,41 @@ void Connection::on_read(const char* buf, size_t size) {
     }
     remaining -= consumed;
     pos += consumed;
+
+    if (!is_segmented && segment_decoder_) break;
   }
+
+  return size - remaining;
+}
+
+void Connection::decode_segments(const char* buf, size_t size) {
+  const char* pos = buf;
+  size_t remaining = size;
+
+  while (remaining != 0 && !socket_->is_closing()) {
+    ssize_t consumed = segment_decoder_->decode(pos, remaining);
+    if (consumed <= 0) {
+      LOG_ERROR("Error decoding/consuming segment");
+      defunct();
+      continue;
+    }
+
+    if (segment_decoder_->is_payload_ready()) {
+      const String& payload = segment_decoder_->payload();
+      decode_frames(payload.data(), payload.size());
+    }
+
+    remaining -= consumed;
+    pos += consumed;
+  }
+}
+
+void Connection::enable_segments() {
+  bool is_compressed = compression_ != CASS_COMPRESSION_NONE;
+  LOG_DEBUG("Switching to %s segments on host %s", is_compressed ? "compressed" : "uncompressed",
+            host_->address_string().c_str());
+  socket_->set_segment_encoder(new SegmentEncoder(is_compressed));
+  segment_decoder_.reset(new SegmentDecoder(is_compressed));
 }
 
 void Connection::on_close() {
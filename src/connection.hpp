@@ -34,14 +34,17 @@ class Connection;
 class ConnectionHandler : public SocketHandler {
 public:
   ConnectionHandler(Connection* connection)
-      : connection_(connection) {}
+      : connection_(connection)
+      , is_direct_read_(false) {}
 
+  virtual void alloc_buffer(size_t suggested_size, uv_buf_t* buf);
   virtual void on_read(Socket* socket, ssize_t nread, const uv_buf_t* buf);
   virtual void on_write(Socket* socket, int status, SocketRequest* request);
   virtual void on_close();
 
 private:
   Connection* connection_;
+  bool is_direct_read_;
 };
 
 /**
@@ -201,25 +204,49 @@ public:
    */
   void start_heartbeats();
 
+  /**
+   * Set the compression used for frames written to the connection. This must
+   * only be enabled after the compression algorithm has been negotiated with
+   * the host using the startup request.
+   *
+   * @param compression The compression algorithm.
+   */
+  void set_compression(CassCompression compression) { compression_ = compression; }
+
+  /**
+   * Enable timestamping reads so that the first byte and decode times of
+   * responses can be recorded.
+   *
+   * @param enabled
+   */
+  void set_request_timing(bool enabled) { is_request_timing_enabled_ = enabled; }
+
 public:
   const Address& address() const { return host_->address(); }
   const String& address_string() const { return host_->address_string(); }
   const Address& resolved_address() const { return socket_->address(); }
   const Host::Ptr& host() const { return host_; }
   ProtocolVersion protocol_version() const { return protocol_version_; }
+  CassCompression compression() const { return compression_; }
   const String& keyspace() { return keyspace_; }
   uv_loop_t* loop() { return socket_->loop(); }
   const uv_tcp_t* handle() const { return socket_->handle(); }
 
   int inflight_request_count() const { return inflight_request_count_.load(MEMORY_ORDER_RELAXED); }
+  size_t pending_write_bytes() const { return socket_->pending_write_bytes(); }
 
 private:
   void maybe_set_keyspace(ResponseMessage* response);
 
   void on_write(int status, RequestCallback* request);
-  void on_read(const char* buf, size_t size);
+  bool alloc_direct_buffer(size_t suggested_size, uv_buf_t* buf);
+  void on_read(const char* buf, size_t size, RefBuffer* owner = NULL);
   void on_close();
 
+  size_t decode_frames(const char* buf, size_t size, RefBuffer* owner = NULL);
+  void decode_segments(const char* buf, size_t size);
+  void enable_segments();
+
 private:
   void restart_heartbeat_timer();
   void on_heartbeat(Timer* timer);
@@ -235,10 +262,16 @@ private:
 
   List<SocketRequest> pending_reads_;
   ScopedPtr<ResponseMessage> response_;
+  ScopedPtr<SegmentDecoder> segment_decoder_;
+  bool is_request_timing_enabled_;
+  uint64_t read_time_ns_;     // The time of the current read
+  uint64_t response_time_ns_; // The time the current response's first bytes were read
+  uint64_t decode_time_ns_;   // The time the current read's first response was decoded
 
   ConnectionListener* listener_;
 
   ProtocolVersion protocol_version_;
+  CassCompression compression_;
   String keyspace_;
 
   unsigned int idle_timeout_secs_;
@@ -19,6 +19,7 @@
 #include "config.hpp"
 #include "connection_pool_manager.hpp"
 #include "metrics.hpp"
+#include "random.hpp"
 #include "utils.hpp"
 
 #include <algorithm>
@@ -37,14 +38,38 @@ static inline bool least_busy_comp(const PooledConnection::Ptr& a, const PooledC
   return a->inflight_request_count() < b->inflight_request_count();
 }
 
+// The number of pending write bytes that count as much as a single in-flight
+// request when comparing connections.
+#define PENDING_WRITE_BYTES_PER_REQUEST 1024
+
+static inline size_t connection_load(const PooledConnection::Ptr& connection) {
+  return static_cast<size_t>(connection->inflight_request_count()) +
+         connection->pending_write_bytes() / PENDING_WRITE_BYTES_PER_REQUEST;
+}
+
+// A xorshift64* generator. The pool is only used from its event loop thread so
+// this avoids the lock in Random.
+static inline uint64_t next_random(uint64_t* state) {
+  uint64_t x = *state;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  *state = x;
+  return x * 0x2545F4914F6CDD1DULL;
+}
+
 ConnectionPoolSettings::ConnectionPoolSettings()
     : num_connections_per_host(CASS_DEFAULT_NUM_CONNECTIONS_PER_HOST)
-    , reconnection_policy(new ExponentialReconnectionPolicy()) {}
+    , reconnection_policy(new ExponentialReconnectionPolicy())
+    , power_of_two_choices_connection_selection(
+          CASS_DEFAULT_POWER_OF_TWO_CHOICES_CONNECTION_SELECTION) {}
 
 ConnectionPoolSettings::ConnectionPoolSettings(const Config& config)
     : connection_settings(config)
     , num_connections_per_host(config.core_connections_per_host())
-    , reconnection_policy(config.reconnection_policy()) {}
+    , reconnection_policy(config.reconnection_policy())
+    , power_of_two_choices_connection_selection(
+          config.power_of_two_choices_connection_selection()) {}
 
 class NopConnectionPoolListener : public ConnectionPoolListener {
 public:
@@ -72,7 +97,8 @@ ConnectionPool::ConnectionPool(const Connection::Vec& connections, ConnectionPoo
     , settings_(settings)
     , metrics_(metrics)
     , close_state_(CLOSE_STATE_OPEN)
-    , notify_state_(NOTIFY_STATE_NEW) {
+    , notify_state_(NOTIFY_STATE_NEW)
+    , random_state_(get_random_seed(uv_hrtime()) | 1) {
   inc_ref(); // Reference for the lifetime of the pooled connections
   set_pointer_keys(reconnection_schedules_);
   set_pointer_keys(to_flush_);
@@ -96,6 +122,12 @@ ConnectionPool::ConnectionPool(const Connection::Vec& connections, ConnectionPoo
 }
 
 PooledConnection::Ptr ConnectionPool::find_least_busy() const {
+  if (settings_.power_of_two_choices_connection_selection && connections_.size() > 1) {
+    PooledConnection::Ptr connection(find_least_busy_of_two());
+    if (connection) return connection;
+    // Both choices were closing, fallback to checking all the connections.
+  }
+
   PooledConnection::Vec::const_iterator it =
       std::min_element(connections_.begin(), connections_.end(), least_busy_comp);
   if (it == connections_.end() || (*it)->is_closing()) {
@@ -104,6 +136,22 @@ PooledConnection::Ptr ConnectionPool::find_least_busy() const {
   return *it;
 }
 
+PooledConnection::Ptr ConnectionPool::find_least_busy_of_two() const {
+  size_t size = connections_.size();
+  size_t i = next_random(&random_state_) % size;
+  size_t j = next_random(&random_state_) % (size - 1);
+  if (j >= i) ++j; // Make sure the two choices are distinct
+
+  const PooledConnection::Ptr& a = connections_[i];
+  const PooledConnection::Ptr& b = connections_[j];
+  if (a->is_closing()) {
+    return b->is_closing() ? PooledConnection::Ptr() : b;
+  } else if (b->is_closing()) {
+    return a;
+  }
+  return connection_load(b) < connection_load(a) ? b : a;
+}
+
 bool ConnectionPool::has_connections() const { return !connections_.empty(); }
 
 void ConnectionPool::flush() {
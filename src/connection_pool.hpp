@@ -94,6 +94,7 @@ struct ConnectionPoolSettings {
   ConnectionSettings connection_settings;
   size_t num_connections_per_host;
   ReconnectionPolicy::Ptr reconnection_policy;
+  bool power_of_two_choices_connection_selection;
 };
 
 /**
@@ -133,6 +134,10 @@ public:
    * Find the least busy connection for the pool. The least busy connection has
    * the lowest number of outstanding requests and is not closed.
    *
+   * If power of two choices selection is enabled then only two randomly
+   * chosen connections are compared. Their load also includes the bytes
+   * waiting to be written to the network.
+   *
    * @return The least busy connection or null if no connection is available.
    */
   PooledConnection::Ptr find_least_busy() const;
@@ -218,6 +223,8 @@ private:
   void internal_close();
   void maybe_closed();
 
+  PooledConnection::Ptr find_least_busy_of_two() const;
+
   void on_reconnect(DelayedConnector* connector);
 
 private:
@@ -235,6 +242,7 @@ private:
   PooledConnection::Vec connections_;
   DelayedConnector::Vec pending_connections_;
   DenseHashSet<PooledConnection*> to_flush_;
+  mutable uint64_t random_state_;
 };
 
 }}} // namespace datastax::internal::core
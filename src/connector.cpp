@@ -34,6 +34,7 @@
 #include "response.hpp"
 #include "result_response.hpp"
 
+#include <algorithm>
 #include <iomanip>
 
 using namespace datastax;
@@ -154,7 +155,9 @@ ConnectionSettings::ConnectionSettings()
     , auth_provider(new AuthProvider())
     , idle_timeout_secs(CASS_DEFAULT_IDLE_TIMEOUT_SECS)
     , heartbeat_interval_secs(CASS_DEFAULT_HEARTBEAT_INTERVAL_SECS)
-    , no_compact(CASS_DEFAULT_NO_COMPACT) {}
+    , no_compact(CASS_DEFAULT_NO_COMPACT)
+    , compression(CASS_DEFAULT_COMPRESSION)
+    , request_timing(CASS_DEFAULT_REQUEST_TIMING) {}
 
 ConnectionSettings::ConnectionSettings(const Config& config)
     : socket_settings(config)
@@ -163,6 +166,8 @@ ConnectionSettings::ConnectionSettings(const Config& config)
     , idle_timeout_secs(config.connection_idle_timeout_secs())
     , heartbeat_interval_secs(config.connection_heartbeat_interval_secs())
     , no_compact(config.no_compact())
+    , compression(config.compression())
+    , request_timing(config.request_timing())
     , application_name(config.application_name())
     , application_version(config.application_version()) {}
 
@@ -282,10 +287,28 @@ void Connector::on_supported(ResponseMessage* response) {
   SupportedResponse* supported = static_cast<SupportedResponse*>(response->response_body().get());
   supported_options_ = supported->supported_options();
 
+  String compression;
+  if (settings_.compression == CASS_COMPRESSION_LZ4) {
+    StringMultimap::const_iterator it = supported_options_.find("COMPRESSION");
+    if (it != supported_options_.end() &&
+        std::find(it->second.begin(), it->second.end(), "lz4") != it->second.end()) {
+      compression = "lz4";
+    } else {
+      LOG_WARN("LZ4 compression is not supported by host %s. Using uncompressed frames.",
+               host_->address_string().c_str());
+    }
+  }
+
   connection_->write_and_flush(RequestCallback::Ptr(new StartupCallback(
       this, Request::ConstPtr(new StartupRequest(settings_.application_name,
                                                  settings_.application_version, settings_.client_id,
-                                                 settings_.no_compact)))));
+                                                 settings_.no_compact, compression)))));
+
+  // Compression applies to all frames written after the startup request.
+  if (!compression.empty()) {
+    connection_->set_compression(settings_.compression);
+  }
+  connection_->set_request_timing(settings_.request_timing);
 }
 
 void Connector::on_authenticate(const String& class_name) {
@@ -51,6 +51,8 @@ struct ConnectionSettings {
   unsigned int idle_timeout_secs;
   unsigned int heartbeat_interval_secs;
   bool no_compact;
+  CassCompression compression;
+  bool request_timing;
   String application_name;
   String application_version;
   String client_id;
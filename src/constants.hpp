@@ -113,6 +113,7 @@
 #define CASS_DEFAULT_HOSTNAME_RESOLUTION_ENABLED false
 #define CASS_DEFAULT_IDLE_TIMEOUT_SECS 60
 #define CASS_DEFAULT_LOG_LEVEL CASS_LOG_WARN
+#define CASS_DEFAULT_LOG_QUEUE_SIZE 2048
 #define CASS_DEFAULT_MAX_PREPARES_PER_FLUSH 128
 #define CASS_DEFAULT_MAX_REUSABLE_WRITE_OBJECTS UINT_MAX
 #define CASS_DEFAULT_MAX_SCHEMA_WAIT_TIME_MS 10000
@@ -130,6 +131,8 @@
 #define CASS_DEFAULT_TCP_KEEPALIVE_ENABLED true
 #define CASS_DEFAULT_TCP_NO_DELAY_ENABLED true
 #define CASS_DEFAULT_THREAD_COUNT_IO 1
+#define CASS_DEFAULT_TOKEN_MAP_BUILD_THREADS 1
+#define CASS_DEFAULT_TOKEN_MAP_LAZY_REPLICAS false
 #define CASS_DEFAULT_USE_TOKEN_AWARE_ROUTING true
 #define CASS_DEFAULT_USE_SNI_ROUTING false
 #define CASS_DEFAULT_USE_BETA_PROTOCOL_VERSION false
@@ -137,7 +140,12 @@
 #define CASS_DEFAULT_USE_SCHEMA true
 #define CASS_DEFAULT_COALESCE_DELAY 200
 #define CASS_DEFAULT_NEW_REQUEST_RATIO 50
+#define CASS_DEFAULT_COALESCE_DELAY_ADAPTIVE false
+#define CASS_DEFAULT_REQUEST_TIMING false
+#define CASS_DEFAULT_DETAILED_LATENCY_METRICS false
+#define CASS_DEFAULT_POWER_OF_TWO_CHOICES_CONNECTION_SELECTION false
 #define CASS_DEFAULT_NO_COMPACT false
+#define CASS_DEFAULT_COMPRESSION CASS_COMPRESSION_NONE
 #define CASS_DEFAULT_CQL_VERSION "3.0.0"
 #define CASS_DEFAULT_MAX_TRACING_DATA_WAIT_TIME_MS 15
 #define CASS_DEFAULT_RETRY_TRACING_DATA_WAIT_TIME_MS 3
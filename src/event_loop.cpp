@@ -21,6 +21,10 @@
 #include <signal.h>
 #endif
 
+#if UV_VERSION_HEX >= 0x012700
+#define HAVE_UV_METRICS_IDLE_TIME
+#endif
+
 using namespace datastax;
 using namespace datastax::internal::core;
 
@@ -47,9 +51,17 @@ static void consume_blocked_sigpipe() {
 EventLoop::EventLoop()
     : is_loop_initialized_(false)
     , is_joinable_(false)
+    , stats_(new EventLoopStats())
+    , tasks_(stats_.get())
     , is_closing_(false)
     , io_time_start_(0)
-    , io_time_elapsed_(0) {
+    , io_time_elapsed_(0)
+    , cached_time_(0)
+    , iteration_start_(0)
+    , poll_start_(0)
+    , poll_end_(0)
+    , poll_time_(0)
+    , idle_time_(0) {
   // Set user data for PooledConnection to start the I/O elapsed time.
   loop_.data = this;
 }
@@ -73,9 +85,15 @@ int EventLoop::init(const String& thread_name /*= ""*/) {
   int rc = 0;
   rc = uv_loop_init(&loop_);
   if (rc != 0) return rc;
+#ifdef HAVE_UV_METRICS_IDLE_TIME
+  rc = uv_loop_configure(&loop_, UV_METRICS_IDLE_TIME);
+  if (rc != 0) return rc;
+#endif
   rc = async_.start(loop(), bind_callback(&EventLoop::on_task, this));
   if (rc != 0) return rc;
   rc = check_.start(loop(), bind_callback(&EventLoop::on_check, this));
+  if (rc != 0) return rc;
+  rc = before_poll_.start(loop(), bind_callback(&EventLoop::on_before_poll, this));
   is_loop_initialized_ = true;
 
 #if defined(HAVE_SIGTIMEDWAIT) && !defined(HAVE_NOSIGPIPE)
@@ -117,9 +135,15 @@ void EventLoop::add(Task* task) {
 void EventLoop::maybe_start_io_time() {
   if (io_time_start_ == 0) {
     io_time_start_ = uv_hrtime();
+    mark_poll_end(io_time_start_);
   }
 }
 
+void EventLoop::record_timer_lag(uint64_t lag_ns) {
+  mark_poll_end(uv_hrtime());
+  stats_->record_timer_lag(lag_ns);
+}
+
 bool EventLoop::is_running_on() const { return uv_thread_self() == thread_; }
 
 void EventLoop::on_run() {
@@ -133,13 +157,17 @@ void EventLoop::on_run() {
   set_thread_name(name_);
 }
 
-EventLoop::TaskQueue::TaskQueue() { uv_mutex_init(&lock_); }
+EventLoop::TaskQueue::TaskQueue(EventLoopStats* stats)
+    : stats_(stats) {
+  uv_mutex_init(&lock_);
+}
 
 EventLoop::TaskQueue::~TaskQueue() { uv_mutex_destroy(&lock_); }
 
 bool EventLoop::TaskQueue::enqueue(Task* task) {
   ScopedMutex l(&lock_);
   queue_.push_back(task);
+  stats_->set_task_queue_depth(queue_.size());
   return true;
 }
 
@@ -150,6 +178,7 @@ bool EventLoop::TaskQueue::dequeue(Task*& task) {
   }
   task = queue_.front();
   queue_.pop_front();
+  stats_->set_task_queue_depth(queue_.size());
   return true;
 }
 
@@ -170,8 +199,37 @@ void EventLoop::handle_run() {
   SslContextFactory::thread_cleanup();
 }
 
+void EventLoop::on_before_poll(Prepare* prepare) {
+  // The prepare callback marks the boundary between loop iterations.
+  uint64_t now = uv_hrtime();
+  if (iteration_start_ > 0) {
+#ifdef HAVE_UV_METRICS_IDLE_TIME
+    uint64_t idle_time = uv_metrics_idle_time(loop());
+    poll_time_ = idle_time - idle_time_;
+    idle_time_ = idle_time;
+#endif
+    stats_->record_iteration(now - iteration_start_, poll_time_);
+  }
+  iteration_start_ = poll_start_ = now;
+  poll_end_ = poll_time_ = 0;
+}
+
+void EventLoop::mark_poll_end(uint64_t now) {
+#ifndef HAVE_UV_METRICS_IDLE_TIME
+  // Without libuv's idle time metrics the time spent blocked in poll is
+  // approximated as the time from the prepare callback until the first I/O,
+  // timer or task callback (or the check callback if nothing ran).
+  if (poll_start_ > 0 && poll_end_ == 0) {
+    poll_end_ = now;
+    poll_time_ = now > poll_start_ ? now - poll_start_ : 0;
+  }
+#endif
+}
+
 void EventLoop::on_check(Check* check) {
   uint64_t now = uv_hrtime();
+  mark_poll_end(now);
+  poll_start_ = 0;
   if (io_time_start_ > 0) {
     io_time_elapsed_ = now - io_time_start_;
     io_time_start_ = 0;
@@ -181,6 +239,8 @@ void EventLoop::on_check(Check* check) {
 }
 
 void EventLoop::on_task(Async* async) {
+  mark_poll_end(uv_hrtime());
+
   Task* task = NULL;
   while (tasks_.dequeue(task)) {
     if (task) {
@@ -192,6 +252,7 @@ void EventLoop::on_task(Async* async) {
   if (is_closing_.load() && tasks_.is_empty()) {
     async_.close_handle();
     check_.close_handle();
+    before_poll_.close_handle();
 #if defined(HAVE_SIGTIMEDWAIT) && !defined(HAVE_NOSIGPIPE)
     uv_prepare_stop(&prepare_);
     uv_close(reinterpret_cast<uv_handle_t*>(&prepare_), NULL);
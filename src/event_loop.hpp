@@ -22,6 +22,7 @@
 #include "atomic.hpp"
 #include "deque.hpp"
 #include "driver_config.hpp"
+#include "event_loop_stats.hpp"
 #include "logger.hpp"
 #include "loop_watcher.hpp"
 #include "macros.hpp"
@@ -101,6 +102,39 @@ public:
    */
   uint64_t io_time_elapsed() const { return io_time_elapsed_; }
 
+  /**
+   * Get a cached time that's used to cheaply timestamp requests. Times taken
+   * from the cached time on the same event loop are always ordered.
+   *
+   * @return The time (from uv_hrtime()) of the last update.
+   */
+  uint64_t cached_time() const { return cached_time_; }
+
+  /**
+   * Refresh the cached time (e.g. once for each batch of requests processed).
+   *
+   * @return The updated time (from uv_hrtime()).
+   */
+  uint64_t update_cached_time() {
+    cached_time_ = uv_hrtime();
+    return cached_time_;
+  }
+
+  /**
+   * Record the scheduling lag of a timer that ran on this event loop.
+   *
+   * @param lag_ns The time between the timer's requested timeout and when its
+   * callback actually ran (in nanoseconds).
+   */
+  void record_timer_lag(uint64_t lag_ns);
+
+  /**
+   * Get the utilization statistics for this event loop (thread-safe).
+   *
+   * @return The event loop's statistics.
+   */
+  const EventLoopStats::Ptr& stats() const { return stats_; }
+
   /**
    * Determines if we're running on this event loop.
    *
@@ -129,7 +163,7 @@ protected:
 private:
   class TaskQueue {
   public:
-    TaskQueue();
+    TaskQueue(EventLoopStats* stats);
     ~TaskQueue();
 
     bool enqueue(Task* task);
@@ -139,14 +173,17 @@ private:
   private:
     uv_mutex_t lock_;
     Deque<Task*> queue_;
+    EventLoopStats* const stats_;
   };
 
 private:
   static void internal_on_run(void* arg);
   void handle_run();
 
+  void on_before_poll(Prepare* prepare);
   void on_check(Check* check);
   void on_task(Async* async);
+  void mark_poll_end(uint64_t now);
 
   uv_loop_t loop_;
   bool is_loop_initialized_;
@@ -160,6 +197,7 @@ private:
   uv_thread_t thread_;
   bool is_joinable_;
   Async async_;
+  EventLoopStats::Ptr stats_;
   TaskQueue tasks_;
 
   Atomic<bool> is_closing_;
@@ -167,6 +205,14 @@ private:
   Check check_;
   uint64_t io_time_start_;
   uint64_t io_time_elapsed_;
+  uint64_t cached_time_;
+
+  Prepare before_poll_;
+  uint64_t iteration_start_;
+  uint64_t poll_start_;
+  uint64_t poll_end_;
+  uint64_t poll_time_;
+  uint64_t idle_time_;
 
   String name_;
 };
@@ -0,0 +1,132 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_EVENT_LOOP_STATS_HPP
+#define DATASTAX_INTERNAL_EVENT_LOOP_STATS_HPP
+
+#include "atomic.hpp"
+#include "ref_counted.hpp"
+
+#include <stdint.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Utilization statistics for a single event loop thread. The values are
+ * written by the event loop thread (and the task queue's producers) and can be
+ * read from any thread. The object is reference counted so that a snapshot can
+ * still be taken after the event loop has been destroyed.
+ */
+class EventLoopStats : public RefCounted<EventLoopStats> {
+public:
+  typedef SharedRefPtr<EventLoopStats> Ptr;
+
+  struct Snapshot {
+    uint64_t iterations;
+    uint64_t loop_time_ns;
+    uint64_t poll_time_ns;
+    uint64_t max_iteration_time_ns;
+    uint64_t task_queue_depth;
+    uint64_t max_task_queue_depth;
+    uint64_t timer_fires;
+    uint64_t timer_lag_ns;
+    uint64_t max_timer_lag_ns;
+  };
+
+  EventLoopStats()
+      : iterations_(0)
+      , loop_time_ns_(0)
+      , poll_time_ns_(0)
+      , max_iteration_time_ns_(0)
+      , task_queue_depth_(0)
+      , max_task_queue_depth_(0)
+      , timer_fires_(0)
+      , timer_lag_ns_(0)
+      , max_timer_lag_ns_(0) {}
+
+  /**
+   * Record a completed loop iteration (event loop thread only).
+   *
+   * @param iteration_time_ns The total time of the iteration.
+   * @param poll_time_ns The part of the iteration spent blocked waiting for
+   * events.
+   */
+  void record_iteration(uint64_t iteration_time_ns, uint64_t poll_time_ns) {
+    iterations_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    loop_time_ns_.fetch_add(iteration_time_ns, MEMORY_ORDER_RELAXED);
+    poll_time_ns_.fetch_add(poll_time_ns, MEMORY_ORDER_RELAXED);
+    if (iteration_time_ns > max_iteration_time_ns_.load(MEMORY_ORDER_RELAXED)) {
+      max_iteration_time_ns_.store(iteration_time_ns, MEMORY_ORDER_RELAXED);
+    }
+  }
+
+  /**
+   * Update the current depth of the task queue. This must be called while
+   * holding the task queue's lock.
+   *
+   * @param depth The number of tasks waiting to be run.
+   */
+  void set_task_queue_depth(size_t depth) {
+    task_queue_depth_.store(depth, MEMORY_ORDER_RELAXED);
+    if (depth > max_task_queue_depth_.load(MEMORY_ORDER_RELAXED)) {
+      max_task_queue_depth_.store(depth, MEMORY_ORDER_RELAXED);
+    }
+  }
+
+  /**
+   * Record how late a timer callback ran compared to its requested timeout
+   * (event loop thread only).
+   *
+   * @param lag_ns The scheduling lag.
+   */
+  void record_timer_lag(uint64_t lag_ns) {
+    timer_fires_.fetch_add(1, MEMORY_ORDER_RELAXED);
+    timer_lag_ns_.fetch_add(lag_ns, MEMORY_ORDER_RELAXED);
+    if (lag_ns > max_timer_lag_ns_.load(MEMORY_ORDER_RELAXED)) {
+      max_timer_lag_ns_.store(lag_ns, MEMORY_ORDER_RELAXED);
+    }
+  }
+
+  void get_snapshot(Snapshot* snapshot) const {
+    snapshot->iterations = iterations_.load(MEMORY_ORDER_RELAXED);
+    snapshot->loop_time_ns = loop_time_ns_.load(MEMORY_ORDER_RELAXED);
+    snapshot->poll_time_ns = poll_time_ns_.load(MEMORY_ORDER_RELAXED);
+    snapshot->max_iteration_time_ns = max_iteration_time_ns_.load(MEMORY_ORDER_RELAXED);
+    snapshot->task_queue_depth = task_queue_depth_.load(MEMORY_ORDER_RELAXED);
+    snapshot->max_task_queue_depth = max_task_queue_depth_.load(MEMORY_ORDER_RELAXED);
+    snapshot->timer_fires = timer_fires_.load(MEMORY_ORDER_RELAXED);
+    snapshot->timer_lag_ns = timer_lag_ns_.load(MEMORY_ORDER_RELAXED);
+    snapshot->max_timer_lag_ns = max_timer_lag_ns_.load(MEMORY_ORDER_RELAXED);
+  }
+
+private:
+  Atomic<uint64_t> iterations_;
+  Atomic<uint64_t> loop_time_ns_;
+  Atomic<uint64_t> poll_time_ns_;
+  Atomic<uint64_t> max_iteration_time_ns_;
+  Atomic<size_t> task_queue_depth_;
+  Atomic<size_t> max_task_queue_depth_;
+  Atomic<uint64_t> timer_fires_;
+  Atomic<uint64_t> timer_lag_ns_;
+  Atomic<uint64_t> max_timer_lag_ns_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(EventLoopStats);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -96,6 +96,12 @@ CassError cass_execution_profile_set_latency_aware_routing_settings(
   return CASS_OK;
 }
 
+CassError cass_execution_profile_set_power_of_two_choices_routing(CassExecProfile* profile,
+                                                                  cass_bool_t enabled) {
+  profile->set_power_of_two_choices_routing(enabled == cass_true);
+  return CASS_OK;
+}
+
 CassError cass_execution_profile_set_whitelist_filtering(CassExecProfile* profile,
                                                          const char* hosts) {
   return cass_execution_profile_set_whitelist_filtering_n(profile, hosts, SAFE_STRLEN(hosts));
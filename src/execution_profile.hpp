@@ -17,6 +17,7 @@
 #include "dense_hash_map.hpp"
 #include "host_targeting_policy.hpp"
 #include "latency_aware_policy.hpp"
+#include "power_of_two_choices_policy.hpp"
 #include "string.hpp"
 #include "token_aware_policy.hpp"
 #include "utils.hpp"
@@ -35,6 +36,7 @@ public:
       , serial_consistency_(CASS_CONSISTENCY_UNKNOWN)
       , host_targeting_(false)
       , latency_aware_routing_(false)
+      , power_of_two_choices_routing_(false)
       , token_aware_routing_(true)
       , token_aware_routing_shuffle_replicas_(true)
       , load_balancing_policy_(NULL)
@@ -78,6 +80,12 @@ public:
     return latency_aware_routing_settings_;
   }
 
+  bool power_of_two_choices_routing() const { return power_of_two_choices_routing_; }
+
+  void set_power_of_two_choices_routing(bool is_power_of_two_choices) {
+    power_of_two_choices_routing_ = is_power_of_two_choices;
+  }
+
   bool token_aware_routing() const { return token_aware_routing_; }
 
   void set_token_aware_routing(bool is_token_aware) { token_aware_routing_ = is_token_aware; }
@@ -102,7 +110,7 @@ public:
 
   void build_load_balancing_policy() {
     // The base LBP can be augmented by special wrappers (whitelist,
-    // token aware, latency aware)
+    // token aware, power of two choices, latency aware)
     if (load_balancing_policy_) {
       LoadBalancingPolicy* chain = load_balancing_policy_->new_instance();
 
@@ -121,6 +129,9 @@ public:
       if (token_aware_routing()) {
         chain = new TokenAwarePolicy(chain, token_aware_routing_shuffle_replicas_);
       }
+      if (power_of_two_choices_routing()) {
+        chain = new PowerOfTwoChoicesPolicy(chain);
+      }
       if (latency_aware()) {
         chain = new LatencyAwarePolicy(chain, latency_aware_routing_settings_);
       }
@@ -154,6 +165,7 @@ private:
   bool host_targeting_;
   bool latency_aware_routing_;
   LatencyAwarePolicy::Settings latency_aware_routing_settings_;
+  bool power_of_two_choices_routing_;
   bool token_aware_routing_;
   bool token_aware_routing_shuffle_replicas_;
   ContactPointList whitelist_;
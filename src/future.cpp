@@ -20,8 +20,11 @@
 #include "prepared.hpp"
 #include "request_handler.hpp"
 #include "result_response.hpp"
+#include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 
+#include <uv.h>
+
 using namespace datastax;
 using namespace datastax::internal;
 using namespace datastax::internal::core;
@@ -41,6 +44,14 @@ CassError cass_future_set_callback(CassFuture* future, CassFutureCallback callba
   return CASS_OK;
 }
 
+CassError cass_future_set_completion_queue(CassFuture* future, CassCompletionQueue* queue,
+                                           void* tag) {
+  if (!future->set_completion_queue(queue->from(), tag)) {
+    return CASS_ERROR_LIB_CALLBACK_ALREADY_SET;
+  }
+  return CASS_OK;
+}
+
 cass_bool_t cass_future_ready(CassFuture* future) {
   return static_cast<cass_bool_t>(future->ready());
 }
@@ -117,6 +128,21 @@ void cass_future_error_message(CassFuture* future, const char** message, size_t*
   }
 }
 
+CassError cass_future_timing(CassFuture* future, CassRequestTiming* timing) {
+  if (future->type() != Future::FUTURE_TYPE_RESPONSE) {
+    return CASS_ERROR_LIB_INVALID_FUTURE_TYPE;
+  }
+
+  const RequestTiming* request_timing = static_cast<ResponseFuture*>(future->from())->timing();
+  if (request_timing == NULL) {
+    return CASS_ERROR_LIB_NO_REQUEST_TIMING;
+  }
+
+  request_timing->to_cass_request_timing(timing);
+
+  return CASS_OK;
+}
+
 CassError cass_future_tracing_id(CassFuture* future, CassUuid* tracing_id) {
   if (future->type() != Future::FUTURE_TYPE_RESPONSE) {
     return CASS_ERROR_LIB_INVALID_FUTURE_TYPE;
@@ -165,31 +191,146 @@ CassError cass_future_custom_payload_item(CassFuture* future, size_t index, cons
 
 } // extern "C"
 
+namespace {
+
+// Blocked waiters are parked on a condition variable shared by all the
+// futures that hash to the same bucket. This keeps synchronization
+// primitives out of futures that are only polled or use a callback. The
+// buckets are statically allocated and initialized on first use.
+class ParkingLot {
+public:
+  struct Bucket {
+    uv_mutex_t mutex;
+    uv_cond_t cond;
+  };
+
+  static Bucket* bucket(const void* address) {
+    uv_once(&init_guard_, init);
+    size_t hash = reinterpret_cast<size_t>(address) / sizeof(void*);
+    return &buckets_[(hash ^ (hash >> 7)) % NUM_BUCKETS];
+  }
+
+private:
+  static void init() {
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+      uv_mutex_init(&buckets_[i].mutex);
+      uv_cond_init(&buckets_[i].cond);
+    }
+  }
+
+private:
+  static const size_t NUM_BUCKETS = 61;
+  static uv_once_t init_guard_;
+  static Bucket buckets_[NUM_BUCKETS];
+};
+
+uv_once_t ParkingLot::init_guard_ = UV_ONCE_INIT;
+ParkingLot::Bucket ParkingLot::buckets_[ParkingLot::NUM_BUCKETS];
+
+} // namespace
+
 bool Future::set_callback(Future::Callback callback, void* data) {
-  ScopedMutex lock(&mutex_);
-  if (callback_) {
+  if (update_state(STATE_CALLBACK_CLAIMED) & STATE_CALLBACK_CLAIMED) {
     return false; // Callback is already set
   }
   callback_ = callback;
   data_ = data;
-  if (is_set_) {
+  if (update_state(STATE_CALLBACK) & STATE_SET) {
     // Run the callback if the future is already set
-    lock.unlock();
     callback(CassFuture::to(this), data);
   }
   return true;
 }
 
-void Future::internal_set(ScopedMutex& lock) {
-  is_set_ = true;
-  if (callback_) {
-    Callback callback = callback_;
-    void* data = data_;
-    lock.unlock();
-    callback(CassFuture::to(this), data);
-    lock.lock();
+bool Future::set_completion_queue(CompletionQueue* queue, void* tag) {
+  if (update_state(STATE_QUEUE_CLAIMED) & STATE_QUEUE_CLAIMED) {
+    return false; // Completion queue is already set
+  }
+  completion_queue_.reset(queue);
+  completion_tag_ = tag;
+  if (update_state(STATE_QUEUE) & STATE_SET) {
+    // Add to the queue now if the future is already set
+    completion_queue_.reset();
+    inc_ref();
+    queue->push(this, tag);
+  }
+  return true;
+}
+
+void Future::internal_set() {
+  int state = update_state(STATE_SET);
+  if (state & STATE_CALLBACK) {
+    callback_(CassFuture::to(this), data_);
+  }
+  if (parent_) {
+    Ptr parent(parent_);
+    parent_.reset();
+    parent->on_child_set(error_.get());
+  }
+  // The queue's reference to the future is taken before the future is done
+  // because a waiter could release the last reference afterwards. The
+  // future's reference to the queue is released so that a queue holding
+  // unretrieved futures can be freed.
+  CompletionQueue::Ptr queue;
+  if (state & STATE_QUEUE) {
+    queue = completion_queue_;
+    completion_queue_.reset();
+    inc_ref();
+  }
+  void* tag = completion_tag_;
+  // Wake waiters after we've run the callback so that threads waiting
+  // on this future see the side effects of the callback. The future can be
+  // freed by a waiter as soon as it's done so only its address is used.
+  const void* address = this;
+  if (update_state(STATE_DONE) & STATE_WAITERS) {
+    unpark(address);
+  }
+  if (queue) {
+    queue->push(this, tag);
+  }
+}
+
+bool Future::park(uint64_t timeout_us) {
+  ParkingLot::Bucket* bucket = ParkingLot::bucket(this);
+  uint64_t deadline = uv_hrtime() + timeout_us * 1000;
+  ScopedMutex lock(&bucket->mutex);
+  // Registering as a waiter and checking the state is a single atomic
+  // operation so either the setter sees the waiter or the waiter sees
+  // that the future is done.
+  while ((update_state(STATE_WAITERS) & STATE_DONE) == 0) {
+    if (timeout_us == 0) {
+      uv_cond_wait(&bucket->cond, lock.get());
+    } else {
+      uint64_t now = uv_hrtime();
+      if (now >= deadline ||
+          uv_cond_timedwait(&bucket->cond, lock.get(), deadline - now) != 0) { // Expects nanos
+        return is_set();
+      }
+    }
+  }
+  return true;
+}
+
+void Future::unpark(const void* address) {
+  ParkingLot::Bucket* bucket = ParkingLot::bucket(address);
+  ScopedMutex lock(&bucket->mutex);
+  uv_cond_broadcast(&bucket->cond);
+}
+
+void AggregateFuture::on_child_set(const Error* error) {
+  if (error) {
+    bool expected = false;
+    if (has_error_.compare_exchange_strong(expected, true)) {
+      first_error_.reset(new Error(error->code, error->message));
+    }
+  }
+  size_t remaining = remaining_.fetch_sub(1, MEMORY_ORDER_ACQ_REL);
+  assert(remaining > 0 && "Aggregate future has too many children");
+  if (remaining == 1 && claim()) {
+    if (first_error_) {
+      internal_set_error(first_error_->code, first_error_->message);
+    } else {
+      internal_set();
+    }
   }
-  // Broadcast after we've run the callback so that threads waiting
-  // on this future see the side effects of the callback.
-  uv_cond_broadcast(&cond_);
 }
@@ -19,16 +19,16 @@
 
 #include "atomic.hpp"
 #include "cassandra.h"
+#include "completion_queue.hpp"
 #include "external.hpp"
 #include "host.hpp"
 #include "macros.hpp"
 #include "ref_counted.hpp"
-#include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 #include "string.hpp"
+#include "vector.hpp"
 
 #include <assert.h>
-#include <uv.h>
 
 namespace datastax { namespace internal { namespace core {
 
@@ -37,6 +37,7 @@ struct Error;
 class Future : public RefCounted<Future> {
 public:
   typedef SharedRefPtr<Future> Ptr;
+  typedef Vector<Ptr> Vec;
   typedef void (*Callback)(CassFuture*, void*);
 
   enum Type { FUTURE_TYPE_GENERIC, FUTURE_TYPE_SESSION, FUTURE_TYPE_RESPONSE };
@@ -51,50 +52,36 @@ public:
   };
 
   Future(Type type)
-      : is_set_(false)
+      : state_(0)
       , type_(type)
-      , callback_(NULL) {
-    uv_mutex_init(&mutex_);
-    uv_cond_init(&cond_);
-  }
+      , callback_(NULL)
+      , data_(NULL)
+      , completion_tag_(NULL) {}
 
-  virtual ~Future() {
-    uv_mutex_destroy(&mutex_);
-    uv_cond_destroy(&cond_);
-  }
+  virtual ~Future() {}
 
   Type type() const { return type_; }
 
-  bool ready() {
-    ScopedMutex lock(&mutex_);
-    return is_set_;
-  }
+  bool ready() const { return is_set(); }
 
-  virtual void wait() {
-    ScopedMutex lock(&mutex_);
-    internal_wait(lock);
-  }
+  virtual void wait() { internal_wait(); }
 
-  virtual bool wait_for(uint64_t timeout_us) {
-    ScopedMutex lock(&mutex_);
-    return internal_wait_for(lock, timeout_us);
-  }
+  virtual bool wait_for(uint64_t timeout_us) { return internal_wait_for(timeout_us); }
 
   Error* error() {
-    ScopedMutex lock(&mutex_);
-    internal_wait(lock);
+    internal_wait();
     return error_.get();
   }
 
   void set() {
-    ScopedMutex lock(&mutex_);
-    internal_set(lock);
+    if (claim()) {
+      internal_set();
+    }
   }
 
   bool set_error(CassError code, const String& message) {
-    ScopedMutex lock(&mutex_);
-    if (!is_set_) {
-      internal_set_error(code, message, lock);
+    if (claim()) {
+      internal_set_error(code, message);
       return true;
     }
     return false;
@@ -102,45 +89,126 @@ public:
 
   bool set_callback(Callback callback, void* data);
 
-protected:
-  bool is_set() const { return is_set_; }
+  /**
+   * Add the future to a completion queue after it's set (or immediately if
+   * it's already set).
+   *
+   * @param queue The completion queue.
+   * @param tag User defined data returned with the completion.
+   * @return false if the future was already added to a completion queue.
+   */
+  bool set_completion_queue(CompletionQueue* queue, void* tag);
+
+  /**
+   * Notify another future after this future is set. This must be called
+   * before the future can be set.
+   *
+   * @param parent The future to notify.
+   */
+  void set_parent(const Ptr& parent) { parent_ = parent; }
 
-  void internal_wait(ScopedMutex& lock) {
-    while (!is_set_) {
-      uv_cond_wait(&cond_, lock.get());
-    }
+protected:
+  /**
+   * Called when a child future (see `set_parent()`) is set.
+   *
+   * @param error The child's error or NULL if it was successful.
+   */
+  virtual void on_child_set(const Error* error) {}
+
+  bool is_set() const { return (state_.load(MEMORY_ORDER_ACQUIRE) & STATE_SET) != 0; }
+
+  /**
+   * Claim the right to set the future. Only a single thread is able to claim
+   * the future and it must set the future's result (if any) then call
+   * `internal_set()` or `internal_set_error()`.
+   *
+   * @return true if the future was claimed, otherwise it was already claimed.
+   */
+  bool claim() { return (update_state(STATE_CLAIMED) & STATE_CLAIMED) == 0; }
+
+  void internal_wait() {
+    if (!is_set()) park(0);
   }
 
-  bool internal_wait_for(ScopedMutex& lock, uint64_t timeout_us) {
-    if (!is_set_) {
-      if (uv_cond_timedwait(&cond_, lock.get(), timeout_us * 1000) != 0) { // Expects nanos
-        return false;
-      }
-    }
-    return is_set_;
+  bool internal_wait_for(uint64_t timeout_us) {
+    return is_set() || park(timeout_us > 0 ? timeout_us : 1);
   }
 
-  void internal_set(ScopedMutex& lock);
+  void internal_set();
 
-  void internal_set_error(CassError code, const String& message, ScopedMutex& lock) {
+  void internal_set_error(CassError code, const String& message) {
     error_.reset(new Error(code, message));
-    internal_set(lock);
+    internal_set();
+  }
+
+private:
+  enum {
+    STATE_CLAIMED = 0x01,          // A thread is setting the result
+    STATE_SET = 0x02,              // The result is available
+    STATE_DONE = 0x04,             // The callback has run and waiters can be woken
+    STATE_CALLBACK_CLAIMED = 0x08, // A thread is setting the callback
+    STATE_CALLBACK = 0x10,         // The callback is available
+    STATE_WAITERS = 0x20,          // Threads are blocked waiting for the result
+    STATE_QUEUE_CLAIMED = 0x40,    // A thread is setting the completion queue
+    STATE_QUEUE = 0x80             // The completion queue is available
+  };
+
+  int update_state(int flags) {
+    int state = state_.load(MEMORY_ORDER_RELAXED);
+    while (!state_.compare_exchange_weak(state, state | flags, MEMORY_ORDER_ACQ_REL)) {
+    }
+    return state;
   }
 
-  uv_mutex_t mutex_;
+  bool park(uint64_t timeout_us);
+  static void unpark(const void* address);
 
 private:
-  bool is_set_;
-  uv_cond_t cond_;
+  Atomic<int> state_;
   Type type_;
   ScopedPtr<Error> error_;
   Callback callback_;
   void* data_;
+  CompletionQueue::Ptr completion_queue_;
+  void* completion_tag_;
+  Ptr parent_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Future);
 };
 
+/**
+ * A future that's set after all of its child futures are set. If any of the
+ * children fail, the error of the first failure is used.
+ */
+class AggregateFuture : public Future {
+public:
+  typedef SharedRefPtr<AggregateFuture> Ptr;
+
+  AggregateFuture(size_t count)
+      : Future(FUTURE_TYPE_GENERIC)
+      , remaining_(count)
+      , has_error_(false) {
+    if (count == 0) set();
+  }
+
+  /**
+   * Add a child future. The number of children must not exceed the count
+   * provided to the constructor.
+   *
+   * @param future The child future.
+   */
+  void add(Future* future) { future->set_parent(Future::Ptr(this)); }
+
+protected:
+  virtual void on_child_set(const Error* error);
+
+private:
+  Atomic<size_t> remaining_;
+  Atomic<bool> has_error_;
+  ScopedPtr<Error> first_error_;
+};
+
 }}} // namespace datastax::internal::core
 
 EXTERNAL_TYPE(datastax::internal::core::Future, CassFuture)
@@ -97,8 +97,6 @@ public:
   Host(const Address& address)
       : address_(address)
       , rpc_address_(address)
-      , rack_id_(0)
-      , dc_id_(0)
       , address_string_(address.to_string())
       , connection_count_(0)
       , inflight_request_count_(0) {}
@@ -117,13 +115,6 @@ public:
     dc_ = dc;
   }
 
-  uint32_t rack_id() const { return rack_id_; }
-  uint32_t dc_id() const { return dc_id_; }
-  void set_rack_and_dc_ids(uint32_t rack_id, uint32_t dc_id) {
-    rack_id_ = rack_id;
-    dc_id_ = dc_id;
-  }
-
   const String& partitioner() const { return partitioner_; }
 
   const Vector<String>& tokens() const { return tokens_; }
@@ -201,8 +192,6 @@ private:
 private:
   Address address_;
   Address rpc_address_;
-  uint32_t rack_id_;
-  uint32_t dc_id_;
   String address_string_;
   VersionNumber server_version_;
   VersionNumber dse_server_version_;
@@ -0,0 +1,92 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_HOST_METRICS_ITERATOR_HPP
+#define DATASTAX_INTERNAL_HOST_METRICS_ITERATOR_HPP
+
+#include "iterator.hpp"
+#include "metrics.hpp"
+#include "vector.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+inline void copy_latency_metrics(const Metrics::Histogram::Snapshot& snapshot,
+                                 CassLatencyMetrics* output) {
+  output->count = snapshot.count;
+  output->min = snapshot.min;
+  output->max = snapshot.max;
+  output->mean = snapshot.mean;
+  output->stddev = snapshot.stddev;
+  output->median = snapshot.median;
+  output->percentile_75th = snapshot.percentile_75th;
+  output->percentile_95th = snapshot.percentile_95th;
+  output->percentile_98th = snapshot.percentile_98th;
+  output->percentile_99th = snapshot.percentile_99th;
+  output->percentile_999th = snapshot.percentile_999th;
+}
+
+inline void copy_latency_metrics(const Metrics::Histogram& histogram, CassLatencyMetrics* output) {
+  Metrics::Histogram::Snapshot snapshot;
+  histogram.get_snapshot(&snapshot);
+  copy_latency_metrics(snapshot, output);
+}
+
+/**
+ * An iterator over a snapshot of the per-host request latencies. The
+ * snapshot is taken when the iterator is created.
+ */
+class HostMetricsIterator : public Iterator {
+public:
+  HostMetricsIterator(const Metrics* metrics)
+      : Iterator(CASS_ITERATOR_TYPE_HOST_METRICS)
+      , index_(-1) {
+    if (metrics == NULL || metrics->host_request_latencies() == NULL) return;
+
+    Metrics::HostHistograms::SnapshotVec snapshots;
+    metrics->host_request_latencies()->get_snapshots(&snapshots);
+    host_metrics_.reserve(snapshots.size());
+    for (Metrics::HostHistograms::SnapshotVec::const_iterator it = snapshots.begin(),
+                                                              end = snapshots.end();
+         it != end; ++it) {
+      CassHostMetrics host_metrics;
+      host_metrics.address.address_length = it->address.to_inet(host_metrics.address.address);
+      host_metrics.port = it->address.port();
+      copy_latency_metrics(it->latencies, &host_metrics.requests);
+      host_metrics_.push_back(host_metrics);
+    }
+  }
+
+  virtual bool next() {
+    if (static_cast<size_t>(index_ + 1) >= host_metrics_.size()) {
+      return false;
+    }
+    ++index_;
+    return true;
+  }
+
+  const CassHostMetrics* host_metrics() const {
+    assert(index_ >= 0 && static_cast<size_t>(index_) < host_metrics_.size());
+    return &host_metrics_[index_];
+  }
+
+private:
+  Vector<CassHostMetrics> host_metrics_;
+  int32_t index_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -0,0 +1,90 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_IO_THREAD_METRICS_ITERATOR_HPP
+#define DATASTAX_INTERNAL_IO_THREAD_METRICS_ITERATOR_HPP
+
+#include "event_loop_stats.hpp"
+#include "iterator.hpp"
+#include "metrics.hpp"
+#include "vector.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+inline void copy_io_thread_metrics(unsigned thread_index, const EventLoopStats::Snapshot& snapshot,
+                                   CassIoThreadMetrics* output) {
+  // Final measurements are in microseconds
+  uint64_t busy_time_ns =
+      snapshot.loop_time_ns > snapshot.poll_time_ns ? snapshot.loop_time_ns - snapshot.poll_time_ns
+                                                    : 0;
+  output->thread_index = thread_index;
+  output->iterations = snapshot.iterations;
+  output->loop_time = snapshot.loop_time_ns / 1000;
+  output->poll_time = snapshot.poll_time_ns / 1000;
+  output->busy_time = busy_time_ns / 1000;
+  output->max_iteration_time = snapshot.max_iteration_time_ns / 1000;
+  output->utilization = snapshot.loop_time_ns > 0 ? static_cast<double>(busy_time_ns) /
+                                                        static_cast<double>(snapshot.loop_time_ns)
+                                                  : 0.0;
+  output->task_queue_depth = snapshot.task_queue_depth;
+  output->max_task_queue_depth = snapshot.max_task_queue_depth;
+  output->timer_fires = snapshot.timer_fires;
+  output->mean_timer_lag =
+      snapshot.timer_fires > 0 ? (snapshot.timer_lag_ns / snapshot.timer_fires) / 1000 : 0;
+  output->max_timer_lag = snapshot.max_timer_lag_ns / 1000;
+}
+
+/**
+ * An iterator over a snapshot of the utilization of the session's I/O
+ * threads. The snapshot is taken when the iterator is created.
+ */
+class IoThreadMetricsIterator : public Iterator {
+public:
+  IoThreadMetricsIterator(const Metrics* metrics)
+      : Iterator(CASS_ITERATOR_TYPE_IO_THREAD_METRICS)
+      , index_(-1) {
+    if (metrics == NULL) return;
+
+    Metrics::EventLoopStatsVec stats(metrics->io_thread_stats());
+    io_thread_metrics_.resize(stats.size());
+    for (size_t i = 0; i < stats.size(); ++i) {
+      EventLoopStats::Snapshot snapshot;
+      stats[i]->get_snapshot(&snapshot);
+      copy_io_thread_metrics(static_cast<unsigned>(i), snapshot, &io_thread_metrics_[i]);
+    }
+  }
+
+  virtual bool next() {
+    if (static_cast<size_t>(index_ + 1) >= io_thread_metrics_.size()) {
+      return false;
+    }
+    ++index_;
+    return true;
+  }
+
+  const CassIoThreadMetrics* io_thread_metrics() const {
+    assert(index_ >= 0 && static_cast<size_t>(index_) < io_thread_metrics_.size());
+    return &io_thread_metrics_[index_];
+  }
+
+private:
+  Vector<CassIoThreadMetrics> io_thread_metrics_;
+  int32_t index_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -0,0 +1,106 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "lane_queue.hpp"
+
+#include "scoped_lock.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <uv.h>
+
+#if defined(WIN32) || defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+uv_once_t thread_id_key_guard = UV_ONCE_INIT;
+uv_mutex_t thread_id_mutex;
+size_t thread_count = 0;
+// A min-heap of the IDs released by exited threads
+Vector<size_t>* free_thread_ids = NULL;
+
+#if defined(WIN32) || defined(_WIN32)
+#define THREAD_ID_DESTRUCTOR_CALL NTAPI
+#else
+#define THREAD_ID_DESTRUCTOR_CALL
+#endif
+
+// Called when a thread exits so that its ID can be reused by a new thread
+void THREAD_ID_DESTRUCTOR_CALL release_thread_id(void* id) {
+  if (id == NULL) return;
+  ScopedMutex l(&thread_id_mutex);
+  free_thread_ids->push_back(reinterpret_cast<size_t>(id) - 1);
+  std::push_heap(free_thread_ids->begin(), free_thread_ids->end(), std::greater<size_t>());
+}
+
+// Thread local storage with a destructor is used (instead of uv_key_t) so that
+// a thread's ID is released when it exits. The stored ID is offset by one so
+// that the first ID isn't confused with an unset key.
+#if defined(WIN32) || defined(_WIN32)
+DWORD thread_id_key;
+
+void init_thread_id_key_storage() { thread_id_key = FlsAlloc(release_thread_id); }
+void* get_thread_id_key() { return FlsGetValue(thread_id_key); }
+void set_thread_id_key(void* id) { FlsSetValue(thread_id_key, id); }
+#else
+pthread_key_t thread_id_key;
+
+void init_thread_id_key_storage() { pthread_key_create(&thread_id_key, release_thread_id); }
+void* get_thread_id_key() { return pthread_getspecific(thread_id_key); }
+void set_thread_id_key(void* id) { pthread_setspecific(thread_id_key, id); }
+#endif
+
+void init_thread_id_key() {
+  uv_mutex_init(&thread_id_mutex);
+  free_thread_ids = new Vector<size_t>();
+  init_thread_id_key_storage();
+}
+
+size_t acquire_thread_id() {
+  ScopedMutex l(&thread_id_mutex);
+  if (free_thread_ids->empty()) {
+    return thread_count++;
+  }
+  // Reuse the smallest free ID so that IDs stay small
+  std::pop_heap(free_thread_ids->begin(), free_thread_ids->end(), std::greater<size_t>());
+  size_t id = free_thread_ids->back();
+  free_thread_ids->pop_back();
+  return id;
+}
+
+} // namespace
+
+namespace datastax { namespace internal { namespace core {
+
+size_t lane_queue_thread_id() {
+  uv_once(&thread_id_key_guard, init_thread_id_key);
+  void* id = get_thread_id_key();
+  if (id == NULL) {
+    id = reinterpret_cast<void*>(acquire_thread_id() + 1);
+    set_thread_id_key(id);
+  }
+  return reinterpret_cast<size_t>(id) - 1;
+}
+
+}}} // namespace datastax::internal::core
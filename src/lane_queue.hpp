@@ -0,0 +1,219 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_LANE_QUEUE_HPP
+#define DATASTAX_INTERNAL_LANE_QUEUE_HPP
+
+#include "allocated.hpp"
+#include "atomic.hpp"
+#include "macros.hpp"
+#include "scoped_ptr.hpp"
+#include "spsc_queue.hpp"
+
+#include <algorithm>
+
+// The maximum number of lanes that are owned by a single producer thread.
+// Producer threads are assigned to lanes using their thread ID so threads only
+// share a lane when there are more producers than this.
+#define CASS_LANE_QUEUE_MAX_LANES 64
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Returns a small, unique, process-wide ID for the calling thread. IDs are
+ * assigned on first use and are recycled when a thread exits so that the
+ * smallest free ID is always used next.
+ *
+ * @return The ID for the current thread.
+ */
+size_t lane_queue_thread_id();
+
+/**
+ * A bounded multi-producer, single-consumer queue made up of a single-producer
+ * queue (lane) per producer thread. Producers never contend with each other
+ * unless they share a lane and the consumer drains the lanes round-robin.
+ *
+ * Lanes are created on first use by a producer thread and the queue's size is
+ * split between them: a lane only accepts items while it holds less than its
+ * share of the size, so a single producer can use the full size and the total
+ * stays (approximately) bounded by the size as producers are added. The
+ * producer threads with the first `max_lanes` thread IDs each own a lane and
+ * enqueue without locking. Any other producers share a second set of lanes,
+ * which are protected by a spin lock. The order of items is only preserved
+ * for items enqueued by the same thread.
+ */
+template <typename T>
+class LaneQueue {
+public:
+  /**
+   * Constructor
+   *
+   * @param size The size of the queue. This is split evenly between the
+   * lanes, with each lane allowed at least one item.
+   * @param max_lanes The maximum number of lanes owned by a single producer
+   * (and the maximum number of shared lanes).
+   */
+  LaneQueue(size_t size, size_t max_lanes = CASS_LANE_QUEUE_MAX_LANES)
+      : size_(size)
+      , max_lanes_(max_lanes)
+      , lanes_(new Atomic<Lane*>[2 * max_lanes])
+      , active_lanes_(new Atomic<Lane*>[2 * max_lanes])
+      , active_count_(0)
+      , next_(0) {
+    for (size_t i = 0; i < 2 * max_lanes_; ++i) {
+      lanes_[i].store(NULL, MEMORY_ORDER_RELAXED);
+      active_lanes_[i].store(NULL, MEMORY_ORDER_RELAXED);
+    }
+  }
+
+  ~LaneQueue() {
+    for (size_t i = 0; i < 2 * max_lanes_; ++i) {
+      delete lanes_[i].load(MEMORY_ORDER_RELAXED);
+    }
+  }
+
+  /**
+   * Enqueue an item into the current thread's lane (producer threads).
+   *
+   * @param data The item to enqueue.
+   * @return true if the item was enqueued, otherwise the lane is full.
+   */
+  bool enqueue(const T& data) {
+    Lane* lane = current_lane();
+    if (!lane->is_shared) {
+      return !is_full(lane) && lane->queue.enqueue(data);
+    }
+    lane->lock();
+    bool result = !is_full(lane) && lane->queue.enqueue(data);
+    lane->unlock();
+    return result;
+  }
+
+  /**
+   * Dequeue an item from the next non-empty lane (consumer thread only).
+   *
+   * @param data The dequeued item.
+   * @return true if an item was dequeued, otherwise all lanes are empty.
+   */
+  bool dequeue(T& data) {
+    size_t count = active_count_.load(MEMORY_ORDER_ACQUIRE);
+    for (size_t i = 0; i < count; ++i) {
+      Lane* lane = active_lanes_[next_].load(MEMORY_ORDER_ACQUIRE);
+      if (++next_ >= count) next_ = 0;
+      if (lane && lane->queue.dequeue(data)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Determine if all lanes are empty (consumer thread only).
+   */
+  bool is_empty() const {
+    size_t count = active_count_.load(MEMORY_ORDER_ACQUIRE);
+    for (size_t i = 0; i < count; ++i) {
+      Lane* lane = active_lanes_[i].load(MEMORY_ORDER_ACQUIRE);
+      if (lane && !lane->queue.is_empty()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * The number of items in all lanes. This is only an estimate when there
+   * are concurrent producers.
+   */
+  size_t approx_size() const {
+    size_t size = 0;
+    size_t count = active_count_.load(MEMORY_ORDER_ACQUIRE);
+    for (size_t i = 0; i < count; ++i) {
+      Lane* lane = active_lanes_[i].load(MEMORY_ORDER_ACQUIRE);
+      if (lane) size += lane->queue.approx_size();
+    }
+    return size;
+  }
+
+  /**
+   * The number of lanes created by producer threads.
+   */
+  size_t lane_count() const { return active_count_.load(MEMORY_ORDER_ACQUIRE); }
+
+private:
+  struct Lane : public Allocated {
+    Lane(size_t size, bool is_shared)
+        : queue(size) // Rounded up to a power of two
+        , is_shared(is_shared)
+        , is_locked(false) {}
+
+    // Only used when the lane is shared by multiple producers
+    void lock() {
+      bool expected = false;
+      while (!is_locked.compare_exchange_weak(expected, true, MEMORY_ORDER_ACQUIRE)) {
+        expected = false;
+      }
+    }
+
+    void unlock() { is_locked.store(false, MEMORY_ORDER_RELEASE); }
+
+    SPSCQueue<T> queue;
+    const bool is_shared;
+    Atomic<bool> is_locked;
+  };
+
+  // A lane is full when it holds its share of the queue's size
+  bool is_full(const Lane* lane) const {
+    size_t share = size_ / active_count_.load(MEMORY_ORDER_RELAXED);
+    return lane->queue.approx_size() >= std::max<size_t>(share, 1);
+  }
+
+  Lane* current_lane() {
+    // Thread IDs are unique so the first lanes are each owned by a single
+    // thread. The remaining threads are spread over the shared lanes.
+    size_t thread_id = lane_queue_thread_id();
+    bool is_shared = thread_id >= max_lanes_;
+    size_t slot = is_shared ? max_lanes_ + thread_id % max_lanes_ : thread_id;
+    Lane* lane = lanes_[slot].load(MEMORY_ORDER_ACQUIRE);
+    if (lane) return lane;
+
+    // The lane's share of the queue's size only shrinks as lanes are added so
+    // its buffer only needs to fit its share when it's created. Another thread
+    // that shares the slot could be racing to create the lane.
+    size_t share = size_ / (active_count_.load(MEMORY_ORDER_ACQUIRE) + 1);
+    ScopedPtr<Lane> new_lane(new Lane(std::max<size_t>(share, 1) + 1, is_shared));
+    Lane* expected = NULL;
+    if (!lanes_[slot].compare_exchange_strong(expected, new_lane.get())) {
+      return expected;
+    }
+    active_lanes_[active_count_.fetch_add(1)].store(new_lane.get(), MEMORY_ORDER_RELEASE);
+    return new_lane.release();
+  }
+
+private:
+  const size_t size_;
+  const size_t max_lanes_;
+  ScopedArray<Atomic<Lane*> > lanes_;
+  ScopedArray<Atomic<Lane*> > active_lanes_;
+  Atomic<size_t> active_count_;
+  size_t next_;
+
+  DISALLOW_COPY_AND_ASSIGN(LaneQueue);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -16,6 +16,12 @@
 
 #include "logger.hpp"
 
+#include "constants.hpp"
+#include "mpmc_queue.hpp"
+#include "utils.hpp"
+
+#include <uv.h>
+
 using namespace datastax::internal;
 
 extern "C" {
@@ -30,9 +36,11 @@ void cass_log_set_callback(CassLogCallback callback, void* data) {
   Logger::set_callback(callback, data);
 }
 
-void cass_log_set_queue_size(size_t queue_size) {
-  // Deprecated
-}
+void cass_log_set_queue_size(size_t queue_size) { Logger::set_queue_size(queue_size); }
+
+void cass_log_set_async(cass_bool_t enabled) { Logger::set_async(enabled == cass_true); }
+
+cass_uint64_t cass_log_dropped_count() { return Logger::dropped_count(); }
 
 } // extern "C"
 
@@ -49,14 +57,131 @@ void stderr_log_callback(const CassLogMessage* message, void* data) {
 
 void noop_log_callback(const CassLogMessage* message, void* data) {}
 
+// Messages are formatted by the logging thread and queued in a bounded,
+// lock-free queue. A background thread runs the log callback so that a slow
+// callback doesn't block the driver's I/O threads. Messages are dropped, and
+// counted, when the queue is full.
+class Logger::AsyncQueue {
+public:
+  AsyncQueue(size_t queue_size)
+      : queue_size_(queue_size)
+      , queue_(queue_size)
+      , is_running_(false)
+      , is_sleeping_(false)
+      , reported_count_(Logger::dropped_count_.load()) {
+    uv_sem_init(&sem_, 0);
+  }
+
+  ~AsyncQueue() {
+    if (is_running_.load()) stop();
+    uv_sem_destroy(&sem_);
+  }
+
+  size_t queue_size() const { return queue_size_; }
+
+  void start() {
+    is_running_.store(true);
+    uv_thread_create(&thread_, on_run, this);
+  }
+
+  // Delivers the remaining messages then waits for the background thread
+  void stop() {
+    is_running_.store(false);
+    wake();
+    uv_thread_join(&thread_);
+  }
+
+  void enqueue(const CassLogMessage& message) {
+    if (!queue_.enqueue(message)) {
+      Logger::dropped_count_.fetch_add(1, MEMORY_ORDER_RELAXED);
+      return;
+    }
+    // The enqueue must be visible before checking if the background thread
+    // is sleeping (it checks the queue after marking itself as sleeping).
+    core::MPMCQueue<CassLogMessage>::memory_fence();
+    if (is_sleeping_.load()) wake();
+  }
+
+private:
+  static void on_run(void* arg) { static_cast<AsyncQueue*>(arg)->run(); }
+
+  void run() {
+    for (;;) {
+      drain();
+      is_sleeping_.store(true);
+      core::MPMCQueue<CassLogMessage>::memory_fence();
+      if (!is_running_.load()) {
+        is_sleeping_.store(false);
+        drain();
+        break;
+      }
+      if (queue_.is_empty()) {
+        uv_sem_wait(&sem_);
+      }
+      is_sleeping_.store(false);
+    }
+  }
+
+  void wake() {
+    // Only a single thread posts for each time the background thread sleeps
+    if (is_sleeping_.exchange(false)) {
+      uv_sem_post(&sem_);
+    }
+  }
+
+  void drain() {
+    CassLogMessage message;
+    while (queue_.dequeue(message)) {
+      Logger::cb_(&message, Logger::data_);
+    }
+
+    uint64_t dropped_count = Logger::dropped_count_.load(MEMORY_ORDER_RELAXED);
+    if (dropped_count > reported_count_) {
+      CassLogMessage warning = {
+        get_time_since_epoch_ms(), CASS_LOG_WARN, LOG_FILE_, __LINE__, LOG_FUNCTION_, ""
+      };
+      snprintf(warning.message, sizeof(warning.message),
+               "Dropped %llu log message(s) because the log queue was full",
+               static_cast<unsigned long long>(dropped_count - reported_count_));
+      reported_count_ = dropped_count;
+      Logger::cb_(&warning, Logger::data_);
+    }
+  }
+
+private:
+  const size_t queue_size_;
+  core::MPMCQueue<CassLogMessage> queue_;
+  uv_thread_t thread_;
+  uv_sem_t sem_;
+  Atomic<bool> is_running_;
+  Atomic<bool> is_sleeping_;
+  uint64_t reported_count_;
+};
+
 CassLogLevel Logger::log_level_ = CASS_LOG_WARN;
 CassLogCallback Logger::cb_ = core::stderr_log_callback;
 void* Logger::data_ = NULL;
+size_t Logger::queue_size_ = CASS_DEFAULT_LOG_QUEUE_SIZE;
+ScopedPtr<Logger::AsyncQueue> Logger::async_queue_;
+Atomic<bool> Logger::is_async_(false);
+Atomic<size_t> Logger::async_log_count_(0);
+Atomic<uint64_t> Logger::dropped_count_(0);
 
 void Logger::internal_log(CassLogLevel severity, const char* file, int line, const char* function,
                           const char* format, va_list args) {
   CassLogMessage message = { get_time_since_epoch_ms(), severity, file, line, function, "" };
   vsnprintf(message.message, sizeof(message.message), format, args);
+  if (is_async_.load(MEMORY_ORDER_ACQUIRE)) {
+    // Asynchronous logging can't be disabled (and the queue stopped) between
+    // the second check and the enqueue because it waits for this count.
+    async_log_count_.fetch_add(1);
+    if (is_async_.load()) {
+      async_queue_->enqueue(message);
+      async_log_count_.fetch_sub(1);
+      return;
+    }
+    async_log_count_.fetch_sub(1);
+  }
   Logger::cb_(&message, Logger::data_);
 }
 
@@ -66,3 +191,27 @@ void Logger::set_callback(CassLogCallback cb, void* data) {
   cb_ = cb == NULL ? noop_log_callback : cb;
   data_ = data;
 }
+
+void Logger::set_queue_size(size_t queue_size) { queue_size_ = queue_size; }
+
+void Logger::set_async(bool enabled) {
+  if (enabled == is_async_.load()) return;
+  if (enabled) {
+    // The previous queue is stopped and no longer used by logging threads
+    if (!async_queue_ || async_queue_->queue_size() != queue_size_) {
+      async_queue_.reset(new AsyncQueue(queue_size_));
+    }
+    async_queue_->start();
+    is_async_.store(true, MEMORY_ORDER_RELEASE);
+  } else {
+    // Wait for threads that are enqueuing messages so that their messages are
+    // delivered before the queue is stopped.
+    is_async_.store(false);
+    while (async_log_count_.load() > 0) {
+      thread_yield();
+    }
+    async_queue_->stop();
+  }
+}
+
+uint64_t Logger::dropped_count() { return dropped_count_.load(); }
@@ -17,8 +17,10 @@
 #ifndef DATASTAX_INTERNAL_LOGGER_HPP
 #define DATASTAX_INTERNAL_LOGGER_HPP
 
+#include "atomic.hpp"
 #include "cassandra.h"
 #include "get_time.hpp"
+#include "scoped_ptr.hpp"
 #include "string.hpp"
 
 #include <cstring>
@@ -31,6 +33,23 @@ class Logger {
 public:
   static void set_log_level(CassLogLevel level);
   static void set_callback(CassLogCallback cb, void* data);
+  static void set_queue_size(size_t queue_size);
+
+  /**
+   * Enable or disable asynchronous logging. When enabled, messages are
+   * formatted by the logging thread then queued and the log callback is run
+   * on a background thread. Disabling waits for queued messages to be
+   * delivered.
+   *
+   * @param enabled
+   */
+  static void set_async(bool enabled);
+
+  /**
+   * The number of messages dropped because the asynchronous log queue was
+   * full.
+   */
+  static uint64_t dropped_count();
 
 #if defined(__GNUC__) || defined(__clang__)
 #define ATTR_FORMAT(string, first) __attribute__((__format__(__printf__, string, first)))
@@ -55,9 +74,16 @@ private:
                            const char* format, va_list args);
 
 private:
+  class AsyncQueue;
+
   static CassLogLevel log_level_;
   static CassLogCallback cb_;
   static void* data_;
+  static size_t queue_size_;
+  static ScopedPtr<AsyncQueue> async_queue_;
+  static Atomic<bool> is_async_;
+  static Atomic<size_t> async_log_count_; // Threads enqueuing messages
+  static Atomic<uint64_t> dropped_count_;
 
   Logger(); // Keep this object from being created
 };
@@ -0,0 +1,191 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "lz4.hpp"
+
+#include <string.h>
+
+#define LZ4_MIN_MATCH 4
+#define LZ4_LAST_LITERALS 5 // The last 5 bytes of a block are always literals
+#define LZ4_MF_LIMIT 12     // The last match must start at least 12 bytes before the end
+#define LZ4_MAX_DISTANCE 65535
+#define LZ4_HASH_LOG 12
+#define LZ4_RUN_MASK 15
+
+using namespace datastax::internal;
+
+static inline uint32_t read32(const uint8_t* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static inline uint32_t hash32(uint32_t sequence) {
+  return (sequence * 2654435761U) >> (32 - LZ4_HASH_LOG);
+}
+
+static inline uint8_t* encode_length(uint8_t* op, size_t length) {
+  while (length >= 255) {
+    *op++ = 255;
+    length -= 255;
+  }
+  *op++ = static_cast<uint8_t>(length);
+  return op;
+}
+
+static inline uint8_t* encode_sequence(uint8_t* op, const uint8_t* literals, size_t literal_length,
+                                       size_t offset, size_t match_length) {
+  uint8_t* token = op++;
+  size_t ml = match_length > 0 ? match_length - LZ4_MIN_MATCH : 0;
+
+  *token = static_cast<uint8_t>(
+      ((literal_length < LZ4_RUN_MASK ? literal_length : LZ4_RUN_MASK) << 4) |
+      (ml < LZ4_RUN_MASK ? ml : LZ4_RUN_MASK));
+
+  if (literal_length >= LZ4_RUN_MASK) {
+    op = encode_length(op, literal_length - LZ4_RUN_MASK);
+  }
+  memcpy(op, literals, literal_length);
+  op += literal_length;
+
+  if (match_length == 0) return op; // Last literals
+
+  *op++ = static_cast<uint8_t>(offset & 0xFF);
+  *op++ = static_cast<uint8_t>(offset >> 8);
+
+  if (ml >= LZ4_RUN_MASK) {
+    op = encode_length(op, ml - LZ4_RUN_MASK);
+  }
+
+  return op;
+}
+
+static inline bool decode_length(const uint8_t** ip, const uint8_t* iend, size_t* length) {
+  uint8_t b;
+  do {
+    if (*ip >= iend) return false;
+    b = *(*ip)++;
+    *length += b;
+  } while (b == 255);
+  return true;
+}
+
+size_t Lz4::compress(const char* input, size_t size, char* output) {
+  const uint8_t* src = reinterpret_cast<const uint8_t*>(input);
+  uint8_t* op = reinterpret_cast<uint8_t*>(output);
+
+  const uint8_t* anchor = src;
+
+  if (size > LZ4_MF_LIMIT) {
+    // Positions are stored relative to the start of the input (+1 so that zero
+    // can be used to indicate an empty slot).
+    uint32_t table[1 << LZ4_HASH_LOG];
+    memset(table, 0, sizeof(table));
+
+    const uint8_t* ip = src;
+    const uint8_t* mflimit = src + size - LZ4_MF_LIMIT;
+    const uint8_t* matchlimit = src + size - LZ4_LAST_LITERALS;
+
+    while (ip < mflimit) {
+      uint32_t sequence = read32(ip);
+      uint32_t h = hash32(sequence);
+      uint32_t candidate = table[h];
+      table[h] = static_cast<uint32_t>(ip - src) + 1;
+
+      if (candidate == 0) {
+        ++ip;
+        continue;
+      }
+
+      const uint8_t* ref = src + candidate - 1;
+      if (static_cast<size_t>(ip - ref) > LZ4_MAX_DISTANCE || read32(ref) != sequence) {
+        ++ip;
+        continue;
+      }
+
+      // Extend the match backwards into pending literals
+      while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+        --ip;
+        --ref;
+      }
+
+      const uint8_t* match_end = ip + LZ4_MIN_MATCH;
+      const uint8_t* ref_end = ref + LZ4_MIN_MATCH;
+      while (match_end < matchlimit && *match_end == *ref_end) {
+        ++match_end;
+        ++ref_end;
+      }
+
+      op = encode_sequence(op, anchor, static_cast<size_t>(ip - anchor),
+                           static_cast<size_t>(ip - ref), static_cast<size_t>(match_end - ip));
+      ip = anchor = match_end;
+    }
+  }
+
+  op = encode_sequence(op, anchor, static_cast<size_t>(src + size - anchor), 0, 0);
+
+  return static_cast<size_t>(op - reinterpret_cast<uint8_t*>(output));
+}
+
+bool Lz4::decompress(const char* input, size_t size, char* output, size_t output_size) {
+  const uint8_t* ip = reinterpret_cast<const uint8_t*>(input);
+  const uint8_t* iend = ip + size;
+  uint8_t* dst = reinterpret_cast<uint8_t*>(output);
+  uint8_t* op = dst;
+  uint8_t* oend = dst + output_size;
+
+  while (ip < iend) {
+    uint8_t token = *ip++;
+
+    size_t literal_length = token >> 4;
+    if (literal_length == LZ4_RUN_MASK && !decode_length(&ip, iend, &literal_length)) {
+      return false;
+    }
+    if (literal_length > static_cast<size_t>(iend - ip) ||
+        literal_length > static_cast<size_t>(oend - op)) {
+      return false;
+    }
+    memcpy(op, ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+
+    if (ip == iend) break; // The last sequence only contains literals
+
+    if (iend - ip < 2) return false;
+    size_t offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+      return false;
+    }
+
+    size_t match_length = token & LZ4_RUN_MASK;
+    if (match_length == LZ4_RUN_MASK && !decode_length(&ip, iend, &match_length)) {
+      return false;
+    }
+    match_length += LZ4_MIN_MATCH;
+    if (match_length > static_cast<size_t>(oend - op)) {
+      return false;
+    }
+
+    // Matches can overlap the output so this is copied a byte at a time
+    const uint8_t* ref = op - offset;
+    for (size_t i = 0; i < match_length; ++i) {
+      *op++ = *ref++;
+    }
+  }
+
+  return op == oend;
+}
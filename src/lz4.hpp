@@ -0,0 +1,69 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+// An implementation of the LZ4 block format. The format is described here:
+// https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+
+#ifndef DATASTAX_INTERNAL_LZ4_HPP
+#define DATASTAX_INTERNAL_LZ4_HPP
+
+#include "macros.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace datastax { namespace internal {
+
+class Lz4 {
+public:
+  /**
+   * The worst case size of a compressed block.
+   *
+   * @param size The size of the uncompressed input.
+   * @return The number of bytes required to hold the compressed output.
+   */
+  static size_t compress_bound(size_t size) { return size + (size / 255) + 16; }
+
+  /**
+   * Compress a block of data.
+   *
+   * @param input The uncompressed input.
+   * @param size The size of the uncompressed input.
+   * @param output The output buffer, it must be at least `compress_bound(size)` bytes.
+   * @return The size of the compressed output.
+   */
+  static size_t compress(const char* input, size_t size, char* output);
+
+  /**
+   * Decompress a block of data.
+   *
+   * @param input The compressed input.
+   * @param size The size of the compressed input.
+   * @param output The output buffer.
+   * @param output_size The exact size of the uncompressed data.
+   * @return true if the input was a valid block that decompressed to exactly
+   * `output_size` bytes, otherwise false.
+   */
+  static bool decompress(const char* input, size_t size, char* output, size_t output_size);
+
+private:
+  Lz4();
+  DISALLOW_COPY_AND_ASSIGN(Lz4);
+};
+
+}} // namespace datastax::internal
+
+#endif
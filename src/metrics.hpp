@@ -20,24 +20,32 @@
 #ifndef DATASTAX_INTERNAL_METRICS_HPP
 #define DATASTAX_INTERNAL_METRICS_HPP
 
+#include "address.hpp"
 #include "allocated.hpp"
 #include "atomic.hpp"
 #include "constants.hpp"
+#include "event_loop_stats.hpp"
+#include "ref_counted.hpp"
+#include "request_timing.hpp"
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 #include "utils.hpp"
+#include "vector.hpp"
 
 #include "third_party/hdr_histogram/hdr_histogram.hpp"
 
 #include <stdlib.h>
 #include <uv.h>
 
+#include <algorithm>
 #include <math.h>
 
 namespace datastax { namespace internal { namespace core {
 
-class Metrics : public Allocated {
+class Metrics : public RefCounted<Metrics> {
 public:
+  typedef SharedRefPtr<Metrics> Ptr;
+
   class ThreadState {
   public:
     ThreadState(size_t max_threads)
@@ -251,11 +259,70 @@ public:
     DISALLOW_COPY_AND_ASSIGN(Meter);
   };
 
-  class Histogram {
+  /**
+   * Allows many lock-free writers to safely coordinate with a reader. After
+   * flip_phase() returns every writer critical section that was entered
+   * before the flip has ended.
+   */
+  class WriterReaderPhaser {
+  public:
+    WriterReaderPhaser()
+        : start_epoch_(0)
+        , even_end_epoch_(0)
+        , odd_end_epoch_(CASS_INT64_MIN) {}
+
+    int64_t writer_critical_section_enter() { return start_epoch_.fetch_add(1); }
+
+    void writer_critical_section_end(int64_t critical_value_enter) {
+      if (critical_value_enter < 0) {
+        odd_end_epoch_.fetch_add(1);
+      } else {
+        even_end_epoch_.fetch_add(1);
+      }
+    }
+
+    // Readers must be serialized by the caller (e.g. using a mutex)
+    void flip_phase() {
+      bool is_next_phase_even = (start_epoch_.load() < 0);
+
+      int64_t initial_start_value;
+
+      if (is_next_phase_even) {
+        initial_start_value = 0;
+        even_end_epoch_.store(initial_start_value, MEMORY_ORDER_RELAXED);
+      } else {
+        initial_start_value = CASS_INT64_MIN;
+        odd_end_epoch_.store(initial_start_value, MEMORY_ORDER_RELAXED);
+      }
+
+      int64_t start_value_at_flip = start_epoch_.exchange(initial_start_value);
+
+      bool is_caught_up = false;
+      do {
+        if (is_next_phase_even) {
+          is_caught_up = (odd_end_epoch_.load() == start_value_at_flip);
+        } else {
+          is_caught_up = (even_end_epoch_.load() == start_value_at_flip);
+        }
+        if (!is_caught_up) {
+          thread_yield();
+        }
+      } while (!is_caught_up);
+    }
+
+  private:
+    Atomic<int64_t> start_epoch_;
+    Atomic<int64_t> even_end_epoch_;
+    Atomic<int64_t> odd_end_epoch_;
+  };
+
+  class Histogram : public Allocated {
   public:
     static const int64_t HIGHEST_TRACKABLE_VALUE = 3600LL * 1000LL * 1000LL;
+    static const int DEFAULT_SIGNIFICANT_FIGURES = 3;
 
     struct Snapshot {
+      int64_t count;
       int64_t min;
       int64_t max;
       int64_t mean;
@@ -268,10 +335,22 @@ public:
       int64_t percentile_999th;
     };
 
-    Histogram(ThreadState* thread_state)
+    /**
+     * Constructor
+     *
+     * @param thread_state The thread state used to select the per-thread
+     * histogram.
+     * @param significant_figures The number of significant figures maintained
+     * by the histogram. Each additional figure increases the memory used by
+     * the histogram by about an order of magnitude.
+     */
+    Histogram(ThreadState* thread_state, int significant_figures = DEFAULT_SIGNIFICANT_FIGURES)
         : thread_state_(thread_state)
         , histograms_(new PerThreadHistogram[thread_state->max_threads()]) {
-      hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histogram_);
+      hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, significant_figures, &histogram_);
+      for (size_t i = 0; i < thread_state->max_threads(); ++i) {
+        histograms_[i].init(significant_figures);
+      }
       uv_mutex_init(&mutex_);
     }
 
@@ -291,6 +370,7 @@ public:
         histograms_[i].add(h);
       }
 
+      snapshot->count = h->total_count;
       if (h->total_count == 0) {
         // There is no data; default to 0 for the stats.
         snapshot->max = 0;
@@ -318,64 +398,16 @@ public:
     }
 
   private:
-    class WriterReaderPhaser {
-    public:
-      WriterReaderPhaser()
-          : start_epoch_(0)
-          , even_end_epoch_(0)
-          , odd_end_epoch_(CASS_INT64_MIN) {}
-
-      int64_t writer_critical_section_enter() { return start_epoch_.fetch_add(1); }
-
-      void writer_critical_section_end(int64_t critical_value_enter) {
-        if (critical_value_enter < 0) {
-          odd_end_epoch_.fetch_add(1);
-        } else {
-          even_end_epoch_.fetch_add(1);
-        }
-      }
-
-      // The reader is protected by a mutex in Histogram
-      void flip_phase() {
-        bool is_next_phase_even = (start_epoch_.load() < 0);
-
-        int64_t initial_start_value;
-
-        if (is_next_phase_even) {
-          initial_start_value = 0;
-          even_end_epoch_.store(initial_start_value, MEMORY_ORDER_RELAXED);
-        } else {
-          initial_start_value = CASS_INT64_MIN;
-          odd_end_epoch_.store(initial_start_value, MEMORY_ORDER_RELAXED);
-        }
-
-        int64_t start_value_at_flip = start_epoch_.exchange(initial_start_value);
-
-        bool is_caught_up = false;
-        do {
-          if (is_next_phase_even) {
-            is_caught_up = (odd_end_epoch_.load() == start_value_at_flip);
-          } else {
-            is_caught_up = (even_end_epoch_.load() == start_value_at_flip);
-          }
-          if (!is_caught_up) {
-            thread_yield();
-          }
-        } while (!is_caught_up);
-      }
-
-    private:
-      Atomic<int64_t> start_epoch_;
-      Atomic<int64_t> even_end_epoch_;
-      Atomic<int64_t> odd_end_epoch_;
-    };
-
     class PerThreadHistogram : public Allocated {
     public:
       PerThreadHistogram()
           : active_index_(0) {
-        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histograms_[0]);
-        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histograms_[1]);
+        histograms_[0] = histograms_[1] = NULL;
+      }
+
+      void init(int significant_figures) {
+        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, significant_figures, &histograms_[0]);
+        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, significant_figures, &histograms_[1]);
       }
 
       ~PerThreadHistogram() {
@@ -413,7 +445,156 @@ public:
     DISALLOW_COPY_AND_ASSIGN(Histogram);
   };
 
-  Metrics(size_t max_threads)
+  /**
+   * Request latency histograms for each host. A host's histogram is added
+   * when the host is added to the cluster and is removed when the host is
+   * removed. Latencies for hosts that don't have a histogram (e.g. a late
+   * response from a removed host) are dropped. Recording is lock-free: the
+   * table of histograms is immutable and changes publish a new copy of the
+   * table. A replaced table (and a removed histogram) is freed as soon as
+   * the recording threads that could still be using it have finished.
+   */
+  class HostHistograms : public Allocated {
+  public:
+    // Per-host histograms use less precision to limit their memory usage
+    static const int SIGNIFICANT_FIGURES = 2;
+
+    struct Snapshot {
+      Address address;
+      Histogram::Snapshot latencies;
+    };
+
+    typedef Vector<Snapshot> SnapshotVec;
+
+    HostHistograms(ThreadState* thread_state)
+        : thread_state_(thread_state)
+        , entries_(new EntryVec()) {
+      uv_mutex_init(&mutex_);
+    }
+
+    ~HostHistograms() {
+      const EntryVec* entries = entries_.load();
+      for (EntryVec::const_iterator it = entries->begin(), end = entries->end(); it != end; ++it) {
+        delete it->histogram;
+      }
+      delete entries;
+      uv_mutex_destroy(&mutex_);
+    }
+
+    void record_value(const Address& address, int64_t value) {
+      int64_t critical_value_enter = phaser_.writer_critical_section_enter();
+      Histogram* histogram = find(*entries_.load(MEMORY_ORDER_ACQUIRE), address);
+      if (histogram != NULL) {
+        histogram->record_value(value);
+      }
+      phaser_.writer_critical_section_end(critical_value_enter);
+    }
+
+    /**
+     * Add a host's histogram. This does nothing if the host already has one.
+     *
+     * @param address The address of the host.
+     */
+    void add(const Address& address) {
+      ScopedMutex l(&mutex_);
+      const EntryVec* entries = entries_.load(MEMORY_ORDER_ACQUIRE);
+      if (find(*entries, address) != NULL) return;
+
+      EntryVec* new_entries = new EntryVec(*entries);
+      new_entries->insert(
+          std::upper_bound(new_entries->begin(), new_entries->end(), Entry(address, NULL)),
+          Entry(address, new Histogram(thread_state_, SIGNIFICANT_FIGURES)));
+      replace(entries, new_entries);
+    }
+
+    /**
+     * Remove a host's histogram.
+     *
+     * @param address The address of the host.
+     */
+    void remove(const Address& address) {
+      ScopedMutex l(&mutex_);
+      const EntryVec* entries = entries_.load(MEMORY_ORDER_ACQUIRE);
+      EntryVec::const_iterator it =
+          std::lower_bound(entries->begin(), entries->end(), Entry(address, NULL));
+      if (it == entries->end() || it->address != address) return;
+
+      Histogram* histogram = it->histogram;
+      EntryVec* new_entries = new EntryVec(*entries);
+      new_entries->erase(new_entries->begin() + (it - entries->begin()));
+      replace(entries, new_entries);
+      delete histogram;
+    }
+
+    /**
+     * Get a snapshot of each host's histogram.
+     *
+     * @param snapshots The snapshots, sorted by address.
+     */
+    void get_snapshots(SnapshotVec* snapshots) const {
+      ScopedMutex l(&mutex_);
+      const EntryVec* entries = entries_.load(MEMORY_ORDER_ACQUIRE);
+      snapshots->resize(entries->size());
+      for (size_t i = 0; i < entries->size(); ++i) {
+        (*snapshots)[i].address = (*entries)[i].address;
+        (*entries)[i].histogram->get_snapshot(&(*snapshots)[i].latencies);
+      }
+    }
+
+  private:
+    struct Entry {
+      Entry(const Address& address, Histogram* histogram)
+          : address(address)
+          , histogram(histogram) {}
+
+      bool operator<(const Entry& other) const { return address < other.address; }
+
+      Address address;
+      Histogram* histogram;
+    };
+
+    typedef Vector<Entry> EntryVec;
+
+    static Histogram* find(const EntryVec& entries, const Address& address) {
+      EntryVec::const_iterator it =
+          std::lower_bound(entries.begin(), entries.end(), Entry(address, NULL));
+      if (it != entries.end() && it->address == address) {
+        return it->histogram;
+      }
+      return NULL;
+    }
+
+    // Must be called with the mutex held
+    void replace(const EntryVec* entries, const EntryVec* new_entries) {
+      entries_.store(new_entries, MEMORY_ORDER_RELEASE);
+      // Wait for the threads that could still be using the old table
+      phaser_.flip_phase();
+      delete entries;
+    }
+
+  private:
+    ThreadState* thread_state_;
+    Atomic<const EntryVec*> entries_;
+    WriterReaderPhaser phaser_;
+    mutable uv_mutex_t mutex_;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(HostHistograms);
+  };
+
+  typedef Vector<EventLoopStats::Ptr> EventLoopStatsVec;
+
+  /**
+   * Constructor
+   *
+   * @param max_threads The maximum number of threads that record metrics.
+   * @param detailed_latencies If true, request latencies are also tracked by
+   * host and by request type. Each of these histograms uses memory for each
+   * thread so they're only allocated when enabled.
+   * @param request_timing If true, the latencies of each stage of request
+   * processing are tracked.
+   */
+  Metrics(size_t max_threads, bool detailed_latencies = false, bool request_timing = false)
       : thread_state_(max_threads)
       , request_latencies(&thread_state_)
       , speculative_request_latencies(&thread_state_)
@@ -421,7 +602,23 @@ public:
       , total_connections(&thread_state_)
       , connection_timeouts(&thread_state_)
       , pending_request_timeouts(&thread_state_)
-      , request_timeouts(&thread_state_) {}
+      , request_timeouts(&thread_state_) {
+    uv_mutex_init(&io_thread_stats_mutex_);
+    if (detailed_latencies) {
+      query_request_latencies_.reset(new Histogram(&thread_state_));
+      execute_request_latencies_.reset(new Histogram(&thread_state_));
+      batch_request_latencies_.reset(new Histogram(&thread_state_));
+      prepare_request_latencies_.reset(new Histogram(&thread_state_));
+      host_request_latencies_.reset(new HostHistograms(&thread_state_));
+    }
+    if (request_timing) {
+      for (size_t i = 0; i < NUM_REQUEST_STAGES; ++i) {
+        stage_latencies_[i].reset(new Histogram(&thread_state_));
+      }
+    }
+  }
+
+  ~Metrics() { uv_mutex_destroy(&io_thread_stats_mutex_); }
 
   void record_request(uint64_t latency_ns) {
     // Final measurement is in microseconds
@@ -429,14 +626,116 @@ public:
     request_rates.mark();
   }
 
+  void record_request(uint64_t latency_ns, const Address& address, uint8_t opcode) {
+    record_request(latency_ns);
+
+    int64_t latency_us = latency_ns / 1000;
+    if (host_request_latencies_) {
+      host_request_latencies_->record_value(address, latency_us);
+    }
+    Histogram* histogram = request_latencies_by_opcode(opcode);
+    if (histogram) {
+      histogram->record_value(latency_us);
+    }
+  }
+
+  /**
+   * Get the request latency histogram for a request opcode.
+   *
+   * @param opcode A request opcode (query, execute, batch or prepare).
+   * @return The histogram or NULL if latencies aren't tracked for the opcode
+   * (or detailed latencies aren't enabled).
+   */
+  Histogram* request_latencies_by_opcode(uint8_t opcode) {
+    switch (opcode) {
+      case CQL_OPCODE_QUERY:
+        return query_request_latencies_.get();
+      case CQL_OPCODE_EXECUTE:
+        return execute_request_latencies_.get();
+      case CQL_OPCODE_BATCH:
+        return batch_request_latencies_.get();
+      case CQL_OPCODE_PREPARE:
+        return prepare_request_latencies_.get();
+      default:
+        return NULL;
+    }
+  }
+
+  const Histogram* request_latencies_by_opcode(uint8_t opcode) const {
+    return const_cast<Metrics*>(this)->request_latencies_by_opcode(opcode);
+  }
+
+  /**
+   * Get the request latency histograms for each host.
+   *
+   * @return The histograms or NULL if detailed latencies aren't enabled.
+   */
+  HostHistograms* host_request_latencies() { return host_request_latencies_.get(); }
+  const HostHistograms* host_request_latencies() const { return host_request_latencies_.get(); }
+
+  /**
+   * Get the latency histogram for a stage of request processing.
+   *
+   * @param stage A request stage.
+   * @return The histogram or NULL if the stage is invalid (or request timing
+   * isn't enabled).
+   */
+  Histogram* request_latencies_by_stage(CassRequestStage stage) {
+    if (stage < CASS_REQUEST_STAGE_QUEUE || stage > CASS_REQUEST_STAGE_DISPATCH) {
+      return NULL;
+    }
+    return stage_latencies_[stage - CASS_REQUEST_STAGE_QUEUE].get();
+  }
+
+  const Histogram* request_latencies_by_stage(CassRequestStage stage) const {
+    return const_cast<Metrics*>(this)->request_latencies_by_stage(stage);
+  }
+
+  void record_request_timing(const RequestTiming& timing) {
+    for (int i = CASS_REQUEST_STAGE_QUEUE; i <= CASS_REQUEST_STAGE_DISPATCH; ++i) {
+      CassRequestStage stage = static_cast<CassRequestStage>(i);
+      Histogram* histogram = request_latencies_by_stage(stage);
+      uint64_t duration_ns;
+      if (histogram && timing.stage_duration(stage, &duration_ns)) {
+        // Final measurement is in microseconds
+        histogram->record_value(duration_ns / 1000);
+      }
+    }
+  }
+
   void record_speculative_request(uint64_t latency_ns) {
     // Final measurement is in microseconds
     speculative_request_latencies.record_value(latency_ns / 1000);
     request_rates.mark_speculative();
   }
 
+  /**
+   * Set the utilization statistics of the session's I/O threads.
+   *
+   * @param stats The statistics for each I/O thread in thread order.
+   */
+  void set_io_thread_stats(const EventLoopStatsVec& stats) {
+    ScopedMutex l(&io_thread_stats_mutex_);
+    io_thread_stats_ = stats;
+  }
+
+  EventLoopStatsVec io_thread_stats() const {
+    ScopedMutex l(&io_thread_stats_mutex_);
+    return io_thread_stats_;
+  }
+
 private:
   ThreadState thread_state_;
+  EventLoopStatsVec io_thread_stats_;
+  mutable uv_mutex_t io_thread_stats_mutex_;
+  ScopedPtr<Histogram> query_request_latencies_;
+  ScopedPtr<Histogram> execute_request_latencies_;
+  ScopedPtr<Histogram> batch_request_latencies_;
+  ScopedPtr<Histogram> prepare_request_latencies_;
+  ScopedPtr<HostHistograms> host_request_latencies_;
+  static const size_t NUM_REQUEST_STAGES =
+      CASS_REQUEST_STAGE_DISPATCH - CASS_REQUEST_STAGE_QUEUE + 1;
+  ScopedPtr<Histogram> stage_latencies_[NUM_REQUEST_STAGES];
 
 public:
   Histogram request_latencies;
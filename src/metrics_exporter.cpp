@@ -0,0 +1,348 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "metrics_exporter.hpp"
+
+#include "external.hpp"
+#include "logger.hpp"
+#include "session.hpp"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+size_t cass_session_metrics_export(const CassSession* session, CassMetricsFormat format,
+                                   char* buffer, size_t buffer_size) {
+  Metrics::Ptr internal_metrics(session->current_metrics());
+
+  if (!internal_metrics) {
+    LOG_WARN("Attempted to export metrics before connecting session object");
+  }
+
+  String output;
+  MetricsExporter(format).export_metrics(internal_metrics.get(), &output);
+
+  if (buffer != NULL && buffer_size > 0) {
+    size_t length = std::min(output.size(), buffer_size - 1);
+    memcpy(buffer, output.data(), length);
+    buffer[length] = '\0';
+  }
+  return output.size();
+}
+
+} // extern "C"
+
+namespace {
+
+struct Quantile {
+  const char* label;
+  int64_t Metrics::Histogram::Snapshot::*value;
+};
+
+const Quantile QUANTILES[] = { { "0.5", &Metrics::Histogram::Snapshot::median },
+                               { "0.75", &Metrics::Histogram::Snapshot::percentile_75th },
+                               { "0.95", &Metrics::Histogram::Snapshot::percentile_95th },
+                               { "0.98", &Metrics::Histogram::Snapshot::percentile_98th },
+                               { "0.99", &Metrics::Histogram::Snapshot::percentile_99th },
+                               { "0.999", &Metrics::Histogram::Snapshot::percentile_999th } };
+
+struct IoThreadMetric {
+  const char* name;
+  const char* type;
+  const char* unit;
+  const char* help;
+  uint64_t EventLoopStats::Snapshot::*value;
+  uint64_t divisor;
+};
+
+const IoThreadMetric IO_THREAD_METRICS[] = {
+  { "cass_io_thread_iterations", "counter", NULL, "Event loop iterations of I/O threads",
+    &EventLoopStats::Snapshot::iterations, 1 },
+  { "cass_io_thread_loop_time_microseconds", "counter", "microseconds",
+    "Time I/O threads spent in event loop iterations", &EventLoopStats::Snapshot::loop_time_ns,
+    1000 },
+  { "cass_io_thread_poll_time_microseconds", "counter", "microseconds",
+    "Time I/O threads spent blocked waiting for events", &EventLoopStats::Snapshot::poll_time_ns,
+    1000 },
+  { "cass_io_thread_max_iteration_time_microseconds", "gauge", "microseconds",
+    "Longest event loop iteration of I/O threads",
+    &EventLoopStats::Snapshot::max_iteration_time_ns, 1000 },
+  { "cass_io_thread_task_queue_depth", "gauge", NULL, "Tasks waiting to be run by I/O threads",
+    &EventLoopStats::Snapshot::task_queue_depth, 1 },
+  { "cass_io_thread_max_task_queue_depth", "gauge", NULL,
+    "Largest number of tasks waiting to be run by I/O threads",
+    &EventLoopStats::Snapshot::max_task_queue_depth, 1 },
+  { "cass_io_thread_timer_fires", "counter", NULL, "Request coalescing timeouts of I/O threads",
+    &EventLoopStats::Snapshot::timer_fires, 1 },
+  { "cass_io_thread_timer_lag_microseconds", "counter", "microseconds",
+    "Total lag of the request coalescing timer of I/O threads",
+    &EventLoopStats::Snapshot::timer_lag_ns, 1000 },
+  { "cass_io_thread_max_timer_lag_microseconds", "gauge", "microseconds",
+    "Maximum lag of the request coalescing timer of I/O threads",
+    &EventLoopStats::Snapshot::max_timer_lag_ns, 1000 }
+};
+
+void append_uint64(uint64_t value, String* output) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%llu", static_cast<unsigned long long>(value));
+  output->append(buf);
+}
+
+void append_double(double value, String* output) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.10g", value);
+  output->append(buf);
+}
+
+// Label values must escape backslashes, double quotes and newlines
+String escape_label_value(const String& value) {
+  String escaped;
+  escaped.reserve(value.size());
+  for (String::const_iterator it = value.begin(), end = value.end(); it != end; ++it) {
+    switch (*it) {
+      case '\\':
+        escaped.append("\\\\");
+        break;
+      case '"':
+        escaped.append("\\\"");
+        break;
+      case '\n':
+        escaped.append("\\n");
+        break;
+      default:
+        escaped.push_back(*it);
+        break;
+    }
+  }
+  return escaped;
+}
+
+} // namespace
+
+const char* MetricsExporter::content_type() const {
+  if (format_ == CASS_METRICS_FORMAT_OPENMETRICS) {
+    return "application/openmetrics-text; version=1.0.0; charset=utf-8";
+  }
+  return "text/plain; version=0.0.4; charset=utf-8";
+}
+
+void MetricsExporter::export_metrics(const Metrics* metrics, String* output) const {
+  if (metrics != NULL) {
+    add_header("cass_request_latency_microseconds", "summary", "microseconds",
+               "Latency of requests", output);
+    add_summary("cass_request_latency_microseconds", "", metrics->request_latencies, output);
+
+    if (metrics->request_latencies_by_opcode(CQL_OPCODE_QUERY)) {
+      add_header("cass_request_type_latency_microseconds", "summary", "microseconds",
+                 "Latency of requests by request type", output);
+      const struct {
+        const char* label;
+        uint8_t opcode;
+      } types[] = { { "type=\"query\"", CQL_OPCODE_QUERY },
+                    { "type=\"execute\"", CQL_OPCODE_EXECUTE },
+                    { "type=\"batch\"", CQL_OPCODE_BATCH },
+                    { "type=\"prepare\"", CQL_OPCODE_PREPARE } };
+      for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); ++i) {
+        add_summary("cass_request_type_latency_microseconds", types[i].label,
+                    *metrics->request_latencies_by_opcode(types[i].opcode), output);
+      }
+    }
+
+    if (metrics->request_latencies_by_stage(CASS_REQUEST_STAGE_QUEUE)) {
+      add_header("cass_request_stage_latency_microseconds", "summary", "microseconds",
+                 "Latency of request processing stages (requires request timing)", output);
+      const struct {
+        const char* label;
+        CassRequestStage stage;
+      } stages[] = { { "stage=\"queue\"", CASS_REQUEST_STAGE_QUEUE },
+                     { "stage=\"write\"", CASS_REQUEST_STAGE_WRITE },
+                     { "stage=\"coalesce\"", CASS_REQUEST_STAGE_COALESCE },
+                     { "stage=\"server\"", CASS_REQUEST_STAGE_SERVER },
+                     { "stage=\"decode\"", CASS_REQUEST_STAGE_DECODE },
+                     { "stage=\"dispatch\"", CASS_REQUEST_STAGE_DISPATCH } };
+      for (size_t i = 0; i < sizeof(stages) / sizeof(stages[0]); ++i) {
+        add_summary("cass_request_stage_latency_microseconds", stages[i].label,
+                    *metrics->request_latencies_by_stage(stages[i].stage), output);
+      }
+    }
+
+    if (metrics->host_request_latencies()) {
+      add_header("cass_host_request_latency_microseconds", "summary", "microseconds",
+                 "Latency of requests by the host that responded", output);
+      Metrics::HostHistograms::SnapshotVec hosts;
+      metrics->host_request_latencies()->get_snapshots(&hosts);
+      for (Metrics::HostHistograms::SnapshotVec::const_iterator it = hosts.begin(),
+                                                                end = hosts.end();
+           it != end; ++it) {
+        add_summary("cass_host_request_latency_microseconds",
+                    "host=\"" + escape_label_value(it->address.to_string(true)) + "\"",
+                    it->latencies, output);
+      }
+    }
+
+    add_header("cass_speculative_request_latency_microseconds", "summary", "microseconds",
+               "Latency of aborted speculative executions", output);
+    add_summary("cass_speculative_request_latency_microseconds", "",
+                metrics->speculative_request_latencies, output);
+
+    Metrics::EventLoopStatsVec io_thread_stats(metrics->io_thread_stats());
+    Vector<EventLoopStats::Snapshot> io_threads(io_thread_stats.size());
+    for (size_t i = 0; i < io_thread_stats.size(); ++i) {
+      io_thread_stats[i]->get_snapshot(&io_threads[i]);
+    }
+    for (size_t i = 0; i < sizeof(IO_THREAD_METRICS) / sizeof(IO_THREAD_METRICS[0]); ++i) {
+      const IoThreadMetric& metric = IO_THREAD_METRICS[i];
+      bool is_counter = strcmp(metric.type, "counter") == 0;
+      add_header(metric.name, metric.type, metric.unit, metric.help, output);
+      for (size_t j = 0; j < io_threads.size(); ++j) {
+        output->append(metric.name);
+        if (is_counter) output->append("_total");
+        output->append("{thread=\"");
+        append_uint64(j, output);
+        output->append("\"} ");
+        append_uint64(io_threads[j].*metric.value / metric.divisor, output);
+        output->append("\n");
+      }
+    }
+
+    add_counter("cass_requests", "Requests completed", metrics->request_rates.count(), output);
+    add_counter("cass_speculative_requests", "Aborted speculative executions",
+                metrics->request_rates.speculative_request_count(), output);
+    add_gauge("cass_speculative_request_ratio",
+              "Fraction of requests that are aborted speculative executions",
+              metrics->request_rates.speculative_request_percent() / 100.0, output);
+
+    add_header("cass_request_rate", "gauge", NULL, "Rate of requests per second", output);
+    const struct {
+      const char* window;
+      double rate;
+    } rates[] = { { "1m", metrics->request_rates.one_minute_rate() },
+                  { "5m", metrics->request_rates.five_minute_rate() },
+                  { "15m", metrics->request_rates.fifteen_minute_rate() },
+                  { "mean", metrics->request_rates.mean_rate() } };
+    for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); ++i) {
+      output->append("cass_request_rate{window=\"");
+      output->append(rates[i].window);
+      output->append("\"} ");
+      append_double(rates[i].rate, output);
+      output->append("\n");
+    }
+
+    add_gauge("cass_connections", "Connections to hosts",
+              static_cast<double>(metrics->total_connections.sum()), output);
+
+    add_counter("cass_connection_timeouts", "Connection timeouts",
+                metrics->connection_timeouts.sum(), output);
+    add_counter("cass_pending_request_timeouts",
+                "Requests that timed out waiting for a connection",
+                metrics->pending_request_timeouts.sum(), output);
+    add_counter("cass_request_timeouts", "Requests that timed out waiting for a response",
+                metrics->request_timeouts.sum(), output);
+  }
+
+  if (format_ == CASS_METRICS_FORMAT_OPENMETRICS) {
+    output->append("# EOF\n");
+  }
+}
+
+void MetricsExporter::add_header(const char* name, const char* type, const char* unit,
+                                 const char* help, String* output) const {
+  // The Prometheus text format names counters using the "_total" sample
+  // name and doesn't support units.
+  bool is_prometheus_counter =
+      format_ == CASS_METRICS_FORMAT_PROMETHEUS && strcmp(type, "counter") == 0;
+
+  output->append("# TYPE ");
+  output->append(name);
+  if (is_prometheus_counter) output->append("_total");
+  output->append(" ");
+  output->append(type);
+  output->append("\n");
+
+  if (unit != NULL && format_ == CASS_METRICS_FORMAT_OPENMETRICS) {
+    output->append("# UNIT ");
+    output->append(name);
+    output->append(" ");
+    output->append(unit);
+    output->append("\n");
+  }
+
+  output->append("# HELP ");
+  output->append(name);
+  if (is_prometheus_counter) output->append("_total");
+  output->append(" ");
+  output->append(help);
+  output->append("\n");
+}
+
+void MetricsExporter::add_counter(const char* name, const char* help, uint64_t value,
+                                  String* output) const {
+  add_header(name, "counter", NULL, help, output);
+  output->append(name);
+  output->append("_total ");
+  append_uint64(value, output);
+  output->append("\n");
+}
+
+void MetricsExporter::add_gauge(const char* name, const char* help, double value,
+                                String* output) const {
+  add_header(name, "gauge", NULL, help, output);
+  output->append(name);
+  output->append(" ");
+  append_double(value, output);
+  output->append("\n");
+}
+
+void MetricsExporter::add_summary(const char* name, const String& labels,
+                                  const Metrics::Histogram& histogram, String* output) const {
+  Metrics::Histogram::Snapshot snapshot;
+  histogram.get_snapshot(&snapshot);
+  add_summary(name, labels, snapshot, output);
+}
+
+void MetricsExporter::add_summary(const char* name, const String& labels,
+                                  const Metrics::Histogram::Snapshot& snapshot,
+                                  String* output) const {
+  String prefix(labels);
+  if (!prefix.empty()) prefix.push_back(',');
+
+  for (size_t i = 0; i < sizeof(QUANTILES) / sizeof(QUANTILES[0]); ++i) {
+    output->append(name);
+    output->append("{");
+    output->append(prefix);
+    output->append("quantile=\"");
+    output->append(QUANTILES[i].label);
+    output->append("\"} ");
+    append_uint64(snapshot.*QUANTILES[i].value, output);
+    output->append("\n");
+  }
+
+  output->append(name);
+  output->append("_count");
+  if (!labels.empty()) {
+    output->append("{");
+    output->append(labels);
+    output->append("}");
+  }
+  output->append(" ");
+  append_uint64(snapshot.count, output);
+  output->append("\n");
+}
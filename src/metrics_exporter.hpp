@@ -0,0 +1,67 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_METRICS_EXPORTER_HPP
+#define DATASTAX_INTERNAL_METRICS_EXPORTER_HPP
+
+#include "cassandra.h"
+#include "metrics.hpp"
+#include "string.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Renders a snapshot of the driver's metrics using a text exposition format
+ * (OpenMetrics or the Prometheus text format). The cost of an export is
+ * proportional to the number of metrics (histograms, hosts, etc.) and not to
+ * the number of requests recorded.
+ */
+class MetricsExporter {
+public:
+  MetricsExporter(CassMetricsFormat format)
+      : format_(format) {}
+
+  /**
+   * The HTTP content type for the format.
+   */
+  const char* content_type() const;
+
+  /**
+   * Render the metrics.
+   *
+   * @param metrics The metrics to render. If NULL only the format's
+   * terminator (if any) is rendered.
+   * @param output The string the metrics are appended to.
+   */
+  void export_metrics(const Metrics* metrics, String* output) const;
+
+private:
+  void add_header(const char* name, const char* type, const char* unit, const char* help,
+                  String* output) const;
+  void add_counter(const char* name, const char* help, uint64_t value, String* output) const;
+  void add_gauge(const char* name, const char* help, double value, String* output) const;
+  void add_summary(const char* name, const String& labels, const Metrics::Histogram& histogram,
+                   String* output) const;
+  void add_summary(const char* name, const String& labels,
+                   const Metrics::Histogram::Snapshot& snapshot, String* output) const;
+
+private:
+  CassMetricsFormat format_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -0,0 +1,268 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "metrics_server.hpp"
+
+#include "logger.hpp"
+#include "metrics_exporter.hpp"
+#include "session_base.hpp"
+#include "string_ref.hpp"
+
+#include <stdio.h>
+
+#define METRICS_SERVER_READ_BUFFER_SIZE 4096
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+// A single HTTP request and response. The connection is closed after the
+// response is written.
+class MetricsServer::Connection
+    : public Allocated
+    , public List<Connection>::Node {
+public:
+  Connection(MetricsServer* server)
+      : server_(server)
+      , is_header_field_accept_(false)
+      , is_closing_(false) {
+    tcp_.data = this;
+    write_req_.data = this;
+    http_parser_init(&parser_, HTTP_REQUEST);
+    http_parser_settings_init(&parser_settings_);
+    parser_.data = this;
+    parser_settings_.on_url = on_url;
+    parser_settings_.on_header_field = on_header_field;
+    parser_settings_.on_header_value = on_header_value;
+    parser_settings_.on_message_complete = on_message_complete;
+  }
+
+  int accept(uv_stream_t* server) {
+    int rc = uv_tcp_init(server->loop, &tcp_);
+    if (rc != 0) return rc;
+    server_->connections_.add_to_back(this);
+    rc = uv_accept(server, reinterpret_cast<uv_stream_t*>(&tcp_));
+    if (rc != 0) return rc;
+    return uv_read_start(reinterpret_cast<uv_stream_t*>(&tcp_), on_alloc, on_read);
+  }
+
+  void close() {
+    if (!is_closing_) {
+      is_closing_ = true;
+      uv_close(reinterpret_cast<uv_handle_t*>(&tcp_), on_close);
+    }
+  }
+
+private:
+  static void on_alloc(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf) {
+    Connection* connection = static_cast<Connection*>(handle->data);
+    buf->base = connection->read_buffer_;
+    buf->len = sizeof(connection->read_buffer_);
+  }
+
+  static void on_read(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf) {
+    Connection* connection = static_cast<Connection*>(stream->data);
+    if (nread < 0) {
+      connection->close();
+      return;
+    }
+    // Zero bytes is not EOF, but the parser would treat it as the end of the request
+    if (nread == 0) return;
+    size_t parsed =
+        http_parser_execute(&connection->parser_, &connection->parser_settings_, buf->base, nread);
+    if (parsed != static_cast<size_t>(nread)) {
+      enum http_errno err = HTTP_PARSER_ERRNO(&connection->parser_);
+      if (err != HPE_PAUSED) {
+        connection->write_response(400, "text/plain; charset=utf-8", "Bad request\n");
+      }
+    }
+  }
+
+  static void on_close(uv_handle_t* handle) {
+    Connection* connection = static_cast<Connection*>(handle->data);
+    connection->server_->connections_.remove(connection);
+    delete connection;
+  }
+
+  static void on_write(uv_write_t* req, int status) {
+    Connection* connection = static_cast<Connection*>(req->data);
+    connection->close();
+  }
+
+  static int on_url(http_parser* parser, const char* buf, size_t len) {
+    Connection* connection = static_cast<Connection*>(parser->data);
+    connection->url_.append(buf, len);
+    return 0;
+  }
+
+  static int on_header_field(http_parser* parser, const char* buf, size_t len) {
+    Connection* connection = static_cast<Connection*>(parser->data);
+    connection->header_field_.append(buf, len);
+    return 0;
+  }
+
+  static int on_header_value(http_parser* parser, const char* buf, size_t len) {
+    Connection* connection = static_cast<Connection*>(parser->data);
+    if (!connection->header_field_.empty()) {
+      connection->is_header_field_accept_ = iequals(connection->header_field_, "Accept");
+      connection->header_field_.clear();
+    }
+    if (connection->is_header_field_accept_) {
+      connection->accept_.append(buf, len);
+    }
+    return 0;
+  }
+
+  static int on_message_complete(http_parser* parser) {
+    Connection* connection = static_cast<Connection*>(parser->data);
+    connection->handle_request();
+    http_parser_pause(parser, 1); // Ignore anything after the first request
+    return 0;
+  }
+
+  void handle_request() {
+    String path(url_.substr(0, url_.find('?')));
+    if (parser_.method != HTTP_GET) {
+      write_response(405, "text/plain; charset=utf-8", "Method not allowed\n");
+    } else if (path != "/metrics" && path != "/") {
+      write_response(404, "text/plain; charset=utf-8", "Not found\n");
+    } else {
+      bool is_openmetrics = accept_.find("application/openmetrics-text") != String::npos;
+      MetricsExporter exporter(is_openmetrics ? CASS_METRICS_FORMAT_OPENMETRICS
+                                              : CASS_METRICS_FORMAT_PROMETHEUS);
+      String body;
+      // A reference is held because the session replaces its metrics when it reconnects
+      Metrics::Ptr metrics(server_->session_->current_metrics());
+      exporter.export_metrics(metrics.get(), &body);
+      write_response(200, exporter.content_type(), body);
+    }
+  }
+
+  void write_response(int status, const char* content_type, const String& body) {
+    const char* reason = "OK";
+    switch (status) {
+      case 400:
+        reason = "Bad Request";
+        break;
+      case 404:
+        reason = "Not Found";
+        break;
+      case 405:
+        reason = "Method Not Allowed";
+        break;
+    }
+
+    char header[256];
+    snprintf(header, sizeof(header),
+             "HTTP/1.1 %d %s\r\n"
+             "Content-Type: %s\r\n"
+             "Content-Length: %u\r\n"
+             "Connection: close\r\n\r\n",
+             status, reason, content_type, static_cast<unsigned>(body.size()));
+    response_.assign(header);
+    response_.append(body);
+
+    uv_read_stop(reinterpret_cast<uv_stream_t*>(&tcp_));
+    uv_buf_t buf = uv_buf_init(const_cast<char*>(response_.data()), response_.size());
+    if (uv_write(&write_req_, reinterpret_cast<uv_stream_t*>(&tcp_), &buf, 1, on_write) != 0) {
+      close();
+    }
+  }
+
+private:
+  MetricsServer* server_;
+  uv_tcp_t tcp_;
+  uv_write_t write_req_;
+  http_parser parser_;
+  http_parser_settings parser_settings_;
+  char read_buffer_[METRICS_SERVER_READ_BUFFER_SIZE];
+  String url_;
+  String header_field_;
+  String accept_;
+  String response_;
+  bool is_header_field_accept_;
+  bool is_closing_;
+};
+
+class MetricsServer::CloseTask : public Task {
+public:
+  virtual void run(EventLoop* event_loop) {
+    static_cast<MetricsServer*>(event_loop)->close_server();
+  }
+};
+
+MetricsServer::MetricsServer(const SessionBase* session)
+    : session_(session)
+    , is_started_(false) {}
+
+MetricsServer::~MetricsServer() { stop(); }
+
+int MetricsServer::start(const Address& address) {
+  int rc = init("Metrics Server");
+  if (rc != 0) return rc;
+
+  rc = uv_tcp_init(loop(), &tcp_);
+  if (rc != 0) return rc;
+  tcp_.data = this;
+  is_started_ = true; // The handle must be closed from now on
+
+  Address::SocketStorage storage;
+  rc = uv_tcp_bind(&tcp_, address.to_sockaddr(&storage), 0);
+  if (rc == 0) {
+    rc = uv_listen(reinterpret_cast<uv_stream_t*>(&tcp_), 128, on_connection);
+  }
+  if (rc != 0) {
+    LOG_ERROR("Unable to start metrics server on %s: %s", address.to_string(true).c_str(),
+              uv_strerror(rc));
+  }
+
+  // The loop is run even if listening failed so that the handle is closed
+  int run_rc = run();
+  return rc != 0 ? rc : run_rc;
+}
+
+void MetricsServer::stop() {
+  if (is_started_) {
+    is_started_ = false;
+    add(new CloseTask());
+    close_handles();
+    join();
+  }
+}
+
+void MetricsServer::on_connection(uv_stream_t* server, int status) {
+  MetricsServer* metrics_server = static_cast<MetricsServer*>(server->data);
+  if (status != 0) {
+    LOG_WARN("Metrics server connection error: %s", uv_strerror(status));
+    return;
+  }
+  metrics_server->handle_connection();
+}
+
+void MetricsServer::handle_connection() {
+  Connection* connection = new Connection(this);
+  if (connection->accept(reinterpret_cast<uv_stream_t*>(&tcp_)) != 0) {
+    connection->close();
+  }
+}
+
+void MetricsServer::close_server() {
+  List<Connection>::Iterator<Connection> it = connections_.iterator();
+  while (it.has_next()) {
+    it.next()->close();
+  }
+  uv_close(reinterpret_cast<uv_handle_t*>(&tcp_), NULL);
+}
@@ -0,0 +1,75 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_METRICS_SERVER_HPP
+#define DATASTAX_INTERNAL_METRICS_SERVER_HPP
+
+#include "address.hpp"
+#include "event_loop.hpp"
+#include "http_parser.h"
+#include "list.hpp"
+#include "string.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class SessionBase;
+
+/**
+ * A minimal HTTP server, running on its own event loop thread, that serves
+ * the session's metrics for scraping (e.g. by Prometheus). Every request for
+ * "/metrics" (or "/") receives the current metrics and the connection is
+ * closed after the response. OpenMetrics is used if the client accepts it,
+ * otherwise the Prometheus text format is used.
+ */
+class MetricsServer : public EventLoop {
+public:
+  MetricsServer(const SessionBase* session);
+  ~MetricsServer();
+
+  /**
+   * Bind to the address and start serving requests.
+   *
+   * @param address The address to listen on.
+   * @return 0 if successful, otherwise a libuv error code.
+   */
+  int start(const Address& address);
+
+  /**
+   * Stop serving requests and wait for the server's thread to exit.
+   */
+  void stop();
+
+private:
+  class Connection;
+  class CloseTask;
+
+  static void on_connection(uv_stream_t* server, int status);
+  void handle_connection();
+
+  void close_server();
+
+private:
+  const SessionBase* session_;
+  uv_tcp_t tcp_;
+  List<Connection> connections_;
+  bool is_started_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -29,7 +29,9 @@ using namespace datastax::internal::core;
 MicroTimer::MicroTimer()
     : handle_(NULL)
     , fd_(-1)
-    , state_(CLOSED) {}
+    , state_(CLOSED)
+    , timeout_ns_(0)
+    , lag_ns_(0) {}
 
 int MicroTimer::start(uv_loop_t* loop, uint64_t timeout_us, const Callback& callback) {
   int rc = 0;
@@ -62,6 +64,7 @@ int MicroTimer::start(uv_loop_t* loop, uint64_t timeout_us, const Callback& call
       ts.it_value.tv_nsec = 1;
     }
     timerfd_settime(fd_, 0, &ts, NULL);
+    timeout_ns_ = uv_hrtime() + timeout_us * 1000; // Convert to nanoseconds
     state_ = STARTED;
   }
   callback_ = callback;
@@ -97,6 +100,8 @@ void MicroTimer::handle_timeout() {
   UNUSED_(result);
   state_ = STOPPED;
   uv_poll_stop(handle_);
+  uint64_t now = uv_hrtime();
+  lag_ns_ = now > timeout_ns_ ? now - timeout_ns_ : 0;
   callback_(this);
 }
 
@@ -106,7 +111,8 @@ void MicroTimer::on_close(uv_handle_t* handle) {
 #else
 
 MicroTimer::MicroTimer()
-    : timeout_ns_(0) {}
+    : timeout_ns_(0)
+    , lag_ns_(0) {}
 
 int MicroTimer::start(uv_loop_t* loop, uint64_t timeout_us, const Callback& callback) {
   if (is_running()) {
@@ -140,6 +146,7 @@ void MicroTimer::on_timeout(Timer* timer) {
   uint64_t now = uv_hrtime();
   if (now >= timeout_ns_) {
     // The goal timeout was reached, trigger the callback.
+    lag_ns_ = now - timeout_ns_;
     callback_(this);
   } else {
     // There's still a sub-millisecond part to wait for so spin the loop until
@@ -78,6 +78,15 @@ public:
    */
   bool is_running() const;
 
+  /**
+   * Gets the scheduling lag of the most recent timeout, the time between the
+   * requested timeout and when the callback was run. This is only valid while
+   * the callback is running.
+   *
+   * @return The lag in nanoseconds.
+   */
+  uint64_t lag_ns() const { return lag_ns_; }
+
 private:
 #ifdef HAVE_TIMERFD
 private:
@@ -97,10 +106,12 @@ private:
   int fd_;
   State state_;
 #else
-  uint64_t timeout_ns_; // Nanoseconds
   Timer timer_;
 #endif
 
+  uint64_t timeout_ns_; // Nanoseconds
+  uint64_t lag_ns_;
+
   Callback callback_;
 
 private:
@@ -0,0 +1,112 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "parallel_task_pool.hpp"
+
+using namespace datastax::internal::core;
+
+ParallelTaskPool::ParallelTaskPool(size_t num_threads)
+    : tasks_(NULL)
+    , next_task_(0)
+    , num_running_threads_(0)
+    , generation_(0)
+    , is_stopping_(false) {
+  uv_mutex_init(&run_mutex_);
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&start_cond_);
+  uv_cond_init(&done_cond_);
+
+  // The thread calling run() also runs tasks
+  size_t num_extra_threads = num_threads > 0 ? num_threads - 1 : 0;
+  threads_.reserve(num_extra_threads);
+  for (size_t i = 0; i < num_extra_threads; ++i) {
+    uv_thread_t thread;
+    if (uv_thread_create(&thread, on_thread, this) == 0) {
+      threads_.push_back(thread);
+    }
+  }
+}
+
+ParallelTaskPool::~ParallelTaskPool() {
+  {
+    ScopedMutex l(&mutex_);
+    is_stopping_ = true;
+    uv_cond_broadcast(&start_cond_);
+  }
+
+  for (Vector<uv_thread_t>::iterator it = threads_.begin(), end = threads_.end(); it != end;
+       ++it) {
+    uv_thread_join(&*it);
+  }
+
+  uv_cond_destroy(&done_cond_);
+  uv_cond_destroy(&start_cond_);
+  uv_mutex_destroy(&mutex_);
+  uv_mutex_destroy(&run_mutex_);
+}
+
+void ParallelTaskPool::run(const ParallelTaskVec& tasks) {
+  ScopedMutex run_lock(&run_mutex_);
+  ScopedMutex l(&mutex_);
+
+  tasks_ = &tasks;
+  next_task_ = 0;
+  if (tasks.size() > 1 && !threads_.empty()) {
+    num_running_threads_ = threads_.size();
+    ++generation_;
+    uv_cond_broadcast(&start_cond_);
+  }
+
+  run_tasks(&l);
+
+  while (num_running_threads_ > 0) {
+    uv_cond_wait(&done_cond_, l.get());
+  }
+  tasks_ = NULL;
+}
+
+void ParallelTaskPool::on_thread(void* data) {
+  static_cast<ParallelTaskPool*>(data)->handle_thread();
+}
+
+void ParallelTaskPool::handle_thread() {
+  ScopedMutex l(&mutex_);
+  unsigned generation = 0;
+  while (true) {
+    while (!is_stopping_ && generation == generation_) {
+      uv_cond_wait(&start_cond_, l.get());
+    }
+    if (is_stopping_) break;
+    generation = generation_;
+
+    run_tasks(&l);
+
+    if (--num_running_threads_ == 0) {
+      uv_cond_signal(&done_cond_);
+    }
+  }
+}
+
+void ParallelTaskPool::run_tasks(ScopedMutex* lock) {
+  // There are only a few tasks and each one is expensive so handing them out
+  // under the lock is cheap in comparison.
+  while (next_task_ < tasks_->size()) {
+    ParallelTask* task = (*tasks_)[next_task_++];
+    lock->unlock();
+    task->run();
+    lock->lock();
+  }
+}
@@ -0,0 +1,97 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_PARALLEL_TASK_POOL_HPP
+#define DATASTAX_INTERNAL_PARALLEL_TASK_POOL_HPP
+
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "scoped_lock.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A task run by ParallelTaskPool::run().
+ */
+class ParallelTask {
+public:
+  virtual ~ParallelTask() {}
+  virtual void run() = 0;
+};
+
+typedef Vector<ParallelTask*> ParallelTaskVec;
+
+/**
+ * A fixed set of threads used to run independent tasks in parallel. The
+ * threads are created once and then wait for tasks so that the cost of
+ * creating threads isn't paid every time tasks are run (e.g. for every token
+ * map update).
+ */
+class ParallelTaskPool : public RefCounted<ParallelTaskPool> {
+public:
+  typedef SharedRefPtr<ParallelTaskPool> Ptr;
+
+  /**
+   * Constructor.
+   *
+   * @param num_threads The number of threads that run tasks, including the
+   * thread calling run(). If a thread can't be created then its tasks are run
+   * by the other threads.
+   */
+  ParallelTaskPool(size_t num_threads);
+
+  /**
+   * Stops and joins the threads.
+   */
+  ~ParallelTaskPool();
+
+  /**
+   * Run the tasks using the pool's threads and the calling thread. The tasks
+   * are handed out to the threads as they become available. This returns
+   * once all the tasks have run. Calls from different threads are run one
+   * at a time.
+   *
+   * @param tasks The tasks to run.
+   */
+  void run(const ParallelTaskVec& tasks);
+
+private:
+  static void on_thread(void* data);
+  void handle_thread();
+  void run_tasks(ScopedMutex* lock);
+
+private:
+  Vector<uv_thread_t> threads_;
+  uv_mutex_t run_mutex_;
+  uv_mutex_t mutex_;
+  uv_cond_t start_cond_;
+  uv_cond_t done_cond_;
+  const ParallelTaskVec* tasks_;
+  size_t next_task_;
+  size_t num_running_threads_;
+  unsigned generation_;
+  bool is_stopping_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ParallelTaskPool);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
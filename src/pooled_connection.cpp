@@ -120,6 +120,8 @@ int32_t PooledConnection::write(RequestCallback* callback) {
   }
 
   if (result > 0) {
+    RequestTiming* timing = callback->timing();
+    if (timing && event_loop_) timing->write = event_loop_->cached_time();
     pool_->requires_flush(this, ConnectionPool::Protected());
   }
 
@@ -143,6 +145,10 @@ int PooledConnection::inflight_request_count() const {
   return connection_->inflight_request_count();
 }
 
+size_t PooledConnection::pending_write_bytes() const {
+  return connection_->pending_write_bytes();
+}
+
 bool PooledConnection::is_closing() const { return connection_->is_closing(); }
 
 void PooledConnection::on_read() {
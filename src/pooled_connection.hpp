@@ -72,6 +72,14 @@ public:
    */
   int inflight_request_count() const;
 
+  /**
+   * Get the number of bytes written to the connection that haven't been
+   * written to the network yet.
+   *
+   * @return The number of pending bytes.
+   */
+  size_t pending_write_bytes() const;
+
   /**
    * Determine if the connection is closing.
    *
@@ -0,0 +1,96 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "power_of_two_choices_policy.hpp"
+
+#include <uv.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+void PowerOfTwoChoicesPolicy::init(const Host::Ptr& connected_host, const HostMap& hosts,
+                                   Random* random, const String& local_dc) {
+  for (HostMap::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
+    i->second->enable_latency_tracking(settings_.scale_ns, settings_.min_measured);
+  }
+  ChainedLoadBalancingPolicy::init(connected_host, hosts, random, local_dc);
+}
+
+QueryPlan* PowerOfTwoChoicesPolicy::new_query_plan(const String& keyspace,
+                                                   RequestHandler* request_handler,
+                                                   const TokenMap* token_map) {
+  return new PowerOfTwoChoicesQueryPlan(
+      this, child_policy_->new_query_plan(keyspace, request_handler, token_map));
+}
+
+void PowerOfTwoChoicesPolicy::on_host_added(const Host::Ptr& host) {
+  host->enable_latency_tracking(settings_.scale_ns, settings_.min_measured);
+  ChainedLoadBalancingPolicy::on_host_added(host);
+}
+
+bool PowerOfTwoChoicesPolicy::is_less_loaded(const Host::Ptr& a, const Host::Ptr& b,
+                                             uint64_t now) const {
+  int64_t inflight_a = a->inflight_request_count() + 1;
+  int64_t inflight_b = b->inflight_request_count() + 1;
+
+  int64_t latency_a = average_latency(a, now);
+  int64_t latency_b = average_latency(b, now);
+
+  // Only weight by latency when both hosts have a usable average, otherwise a
+  // host without measurements (e.g. newly added) can't be compared fairly.
+  if (latency_a < 0 || latency_b < 0) {
+    return inflight_a < inflight_b;
+  }
+
+  // The averages are converted to microseconds to keep the products well
+  // within range.
+  return inflight_a * (latency_a / 1000 + 1) < inflight_b * (latency_b / 1000 + 1);
+}
+
+int64_t PowerOfTwoChoicesPolicy::average_latency(const Host::Ptr& host, uint64_t now) const {
+  TimestampedAverage latency = host->get_current_average();
+  if (latency.average < 0 || latency.num_measured < settings_.min_measured ||
+      (now - latency.timestamp) > settings_.stale_period_ns) {
+    return -1;
+  }
+  return latency.average;
+}
+
+Host::Ptr PowerOfTwoChoicesPolicy::PowerOfTwoChoicesQueryPlan::compute_next() {
+  if (is_first_) {
+    is_first_ = false;
+
+    Host::Ptr first(child_plan_->compute_next());
+    if (!first) return first;
+
+    second_ = child_plan_->compute_next();
+    if (second_ && policy_->is_less_loaded(second_, first, uv_hrtime())) {
+      Host::Ptr temp(first);
+      first = second_;
+      second_ = temp;
+    }
+    return first;
+  }
+
+  if (second_) {
+    Host::Ptr host(second_);
+    second_.reset();
+    return host;
+  }
+
+  return child_plan_->compute_next();
+}
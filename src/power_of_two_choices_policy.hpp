@@ -0,0 +1,106 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_POWER_OF_TWO_CHOICES_POLICY_HPP
+#define DATASTAX_INTERNAL_POWER_OF_TWO_CHOICES_POLICY_HPP
+
+#include "load_balancing.hpp"
+#include "macros.hpp"
+#include "scoped_ptr.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A load balancing policy that takes the first two hosts from the child
+ * policy's query plan (e.g. two replicas when wrapping the token-aware policy)
+ * and tries the least loaded of the two first. A host's load is its number of
+ * in-flight requests weighted by its recent average latency. The remaining
+ * hosts are returned in the child policy's order.
+ *
+ * Unlike the latency-aware policy this doesn't require a periodic timer; the
+ * decision is made per query plan from the hosts' current metrics.
+ */
+class PowerOfTwoChoicesPolicy : public ChainedLoadBalancingPolicy {
+public:
+  struct Settings {
+    Settings()
+        : scale_ns(100LL * 1000LL * 1000LL)
+        , stale_period_ns(10LL * 1000LL * 1000LL * 1000LL)
+        , min_measured(50LL) {}
+
+    uint64_t scale_ns;
+    uint64_t stale_period_ns;
+    uint64_t min_measured;
+  };
+
+  PowerOfTwoChoicesPolicy(LoadBalancingPolicy* child_policy,
+                          const Settings& settings = Settings())
+      : ChainedLoadBalancingPolicy(child_policy)
+      , settings_(settings) {}
+
+  virtual ~PowerOfTwoChoicesPolicy() {}
+
+  virtual void init(const Host::Ptr& connected_host, const HostMap& hosts, Random* random,
+                    const String& local_dc);
+
+  virtual QueryPlan* new_query_plan(const String& keyspace, RequestHandler* request_handler,
+                                    const TokenMap* token_map);
+
+  virtual LoadBalancingPolicy* new_instance() {
+    return new PowerOfTwoChoicesPolicy(child_policy_->new_instance(), settings_);
+  }
+
+  virtual void on_host_added(const Host::Ptr& host);
+
+public:
+  /**
+   * Determine whether the first host is less loaded than the second.
+   *
+   * @param a The first host.
+   * @param b The second host.
+   * @param now The current time (in nanoseconds).
+   * @return true if "a" should be tried before "b", otherwise false.
+   */
+  bool is_less_loaded(const Host::Ptr& a, const Host::Ptr& b, uint64_t now) const;
+
+private:
+  class PowerOfTwoChoicesQueryPlan : public QueryPlan {
+  public:
+    PowerOfTwoChoicesQueryPlan(const PowerOfTwoChoicesPolicy* policy, QueryPlan* child_plan)
+        : policy_(policy)
+        , child_plan_(child_plan)
+        , is_first_(true) {}
+
+    Host::Ptr compute_next();
+
+  private:
+    const PowerOfTwoChoicesPolicy* policy_;
+    ScopedPtr<QueryPlan> child_plan_;
+    Host::Ptr second_;
+    bool is_first_;
+  };
+
+  int64_t average_latency(const Host::Ptr& host, uint64_t now) const;
+
+  Settings settings_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PowerOfTwoChoicesPolicy);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
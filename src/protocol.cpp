@@ -105,3 +105,9 @@ bool ProtocolVersion::supports_result_metadata_id() const {
   return false;
   // return version_ >= CASS_PROTOCOL_VERSION_V5;
 }
+
+bool ProtocolVersion::supports_segments() const {
+  assert(value_ > 0 && "Invalid protocol version");
+  // DSE protocol versions don't use segments
+  return value_ >= CASS_PROTOCOL_VERSION_V5 && value_ < CASS_PROTOCOL_VERSION_DSEV1;
+}
@@ -130,6 +130,14 @@ public:
    */
   bool supports_result_metadata_id() const;
 
+  /**
+   * Check to see if frames are packed into checksummed segments after the
+   * protocol handshake.
+   *
+   * @return true if supported, otherwise false.
+   */
+  bool supports_segments() const;
+
 public:
   bool operator<(ProtocolVersion version) const { return value_ < version.value_; }
   bool operator>(ProtocolVersion version) const { return value_ > version.value_; }
@@ -138,6 +138,16 @@ public:
 
   char* data() { return reinterpret_cast<char*>(this) + sizeof(RefBuffer); }
 
+  /**
+   * Get the buffer that owns data previously returned by `data()`.
+   *
+   * @param data A pointer to the start of a buffer's data.
+   * @return The owning buffer.
+   */
+  static RefBuffer* from_data(char* data) {
+    return reinterpret_cast<RefBuffer*>(data - sizeof(RefBuffer));
+  }
+
   void operator delete(void* ptr) { Memory::free(ptr); }
 
 private:
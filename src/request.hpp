@@ -27,6 +27,7 @@
 #include "retry_policy.hpp"
 #include "socket.hpp"
 #include "string_ref.hpp"
+#include "vector.hpp"
 
 #include <stdint.h>
 #include <utility>
@@ -76,6 +77,7 @@ struct RequestSettings {
 class Request : public RefCounted<Request> {
 public:
   typedef SharedRefPtr<const Request> ConstPtr;
+  typedef Vector<ConstPtr> ConstVec;
 
   enum {
     REQUEST_ERROR_UNSUPPORTED_PROTOCOL = SocketRequest::SOCKET_REQUEST_ERROR_LAST_ENTRY,
@@ -21,6 +21,7 @@
 #include "execute_request.hpp"
 #include "execution_profile.hpp"
 #include "logger.hpp"
+#include "lz4.hpp"
 #include "metrics.hpp"
 #include "query_request.hpp"
 #include "request.hpp"
@@ -28,8 +29,37 @@
 #include "serialization.hpp"
 
 using namespace datastax;
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
+/**
+ * Compress a frame's body using the native protocol's LZ4 format: the
+ * uncompressed length as an [int] followed by an LZ4 block.
+ *
+ * @param bufs The encoded frame buffers.
+ * @param first The index of the first buffer of the body.
+ * @param length The total length of the body.
+ * @return A buffer containing the compressed body.
+ */
+static Buffer compress_lz4(const BufferVec* bufs, size_t first, int32_t length) {
+  Buffer body;
+  if (bufs->size() - first == 1) {
+    body = (*bufs)[first];
+  } else {
+    body = Buffer(length);
+    size_t pos = 0;
+    for (BufferVec::const_iterator it = bufs->begin() + first, end = bufs->end(); it != end;
+         ++it) {
+      pos = body.copy(pos, it->data(), it->size());
+    }
+  }
+
+  Buffer compressed(sizeof(int32_t) + Lz4::compress_bound(length));
+  size_t pos = compressed.encode_int32(0, length);
+  compressed.truncate(pos + Lz4::compress(body.data(), length, compressed.data() + pos));
+  return compressed;
+}
+
 void RequestWrapper::set_prepared_metadata(const PreparedMetadata::Entry::Ptr& entry) {
   prepared_metadata_entry_ = entry;
 }
@@ -45,10 +75,15 @@ void RequestWrapper::init(const ExecutionProfile& profile,
 
 void RequestCallback::notify_write(Connection* connection, int stream) {
   protocol_version_ = connection->protocol_version();
+  compression_ = connection->compression();
   stream_ = stream;
   on_write(connection);
 }
 
+void RequestCallback::on_flush(uint64_t time_ns) {
+  if (timing_) timing_->flush = time_ns;
+}
+
 bool RequestCallback::skip_metadata() const {
   // Skip the metadata if this an execute request and we have an entry cached
   return request()->opcode() == CQL_OPCODE_EXECUTE && prepared_metadata_entry() &&
@@ -82,6 +117,15 @@ int32_t RequestCallback::encode(BufferVec* bufs) {
   if (result < 0) return result;
   length += result;
 
+  // Protocol v5 and higher compress whole segments instead of individual frames
+  if (compression_ == CASS_COMPRESSION_LZ4 && length > 0 && !version.supports_segments()) {
+    Buffer compressed(compress_lz4(bufs, index + 1, length));
+    bufs->resize(index + 1);
+    bufs->push_back(compressed);
+    flags |= CASS_FLAG_COMPRESSION;
+    length = static_cast<int32_t>(compressed.size());
+  }
+
   const size_t header_size = CASS_HEADER_SIZE_V3;
 
   Buffer buf(header_size);
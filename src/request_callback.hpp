@@ -24,6 +24,7 @@
 #include "list.hpp"
 #include "prepared.hpp"
 #include "request.hpp"
+#include "request_timing.hpp"
 #include "response.hpp"
 #include "scoped_ptr.hpp"
 #include "socket.hpp"
@@ -135,6 +136,7 @@ public:
 
   RequestCallback(const RequestWrapper& wrapper)
       : wrapper_(wrapper)
+      , compression_(CASS_COMPRESSION_NONE)
       , stream_(-1)
       , state_(REQUEST_STATE_NEW)
       , retry_consistency_(CASS_CONSISTENCY_UNKNOWN) {}
@@ -195,17 +197,33 @@ public:
     read_before_write_response_.reset(response);
   }
 
+  /**
+   * Record the times the request is written, flushed and its response is
+   * read and decoded.
+   */
+  void enable_timing() { timing_.reset(new RequestTiming()); }
+
+  /**
+   * The times recorded for the request.
+   *
+   * @return The request's timing or NULL if timing isn't enabled.
+   */
+  RequestTiming* timing() const { return timing_.get(); }
+
 private:
   virtual int32_t encode(BufferVec* bufs);
+  virtual void on_flush(uint64_t time_ns);
   virtual void on_close();
 
 private:
   const RequestWrapper wrapper_;
   ProtocolVersion protocol_version_;
+  CassCompression compression_;
   int stream_;
   State state_;
   CassConsistency retry_consistency_;
   ScopedPtr<ResponseMessage> read_before_write_response_;
+  ScopedPtr<RequestTiming> timing_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(RequestCallback);
@@ -161,6 +161,7 @@ RequestHandler::RequestHandler(const Request::ConstPtr& request, const ResponseF
     : wrapper_(request)
     , future_(future)
     , is_done_(false)
+    , is_timing_enabled_(false)
     , running_executions_(0)
     , start_time_ns_(uv_hrtime())
     , listener_(&nop_request_listener__)
@@ -172,6 +173,19 @@ void RequestHandler::set_prepared_metadata(const PreparedMetadata::Entry::Ptr& e
   wrapper_.set_prepared_metadata(entry);
 }
 
+void RequestHandler::enable_timing() {
+  is_timing_enabled_ = true;
+  future_->enable_timing();
+  future_->mutable_timing()->enqueue = start_time_ns_;
+}
+
+void RequestHandler::set_dequeue_time(uint64_t time_ns) {
+  if (is_timing_enabled_) {
+    RequestTiming* timing = future_->mutable_timing();
+    if (timing) timing->dequeue = time_ns;
+  }
+}
+
 void RequestHandler::init(const ExecutionProfile& profile, ConnectionPoolManager* manager,
                           const TokenMap* token_map, TimestampGenerator* timestamp_generator,
                           RequestListener* listener) {
@@ -224,6 +238,11 @@ void RequestHandler::add_attempted_address(const Address& address, Protected) {
   future_->add_attempted_address(address);
 }
 
+void RequestHandler::set_execution_timing(const RequestTiming& timing, Protected) {
+  RequestTiming* request_timing = future_->mutable_timing();
+  if (request_timing) request_timing->set_execution(timing);
+}
+
 void RequestHandler::notify_result_metadata_changed(const String& prepared_id, const String& query,
                                                     const String& keyspace,
                                                     const String& result_metadata_id,
@@ -258,9 +277,12 @@ void RequestHandler::set_response(const Host::Ptr& host, const Response::Ptr& re
   stop_request();
   running_executions_--;
 
+  const RequestTiming* timing = complete_timing();
   if (future_->set_response(host->address(), response)) {
     if (metrics_) {
-      metrics_->record_request(uv_hrtime() - start_time_ns_);
+      metrics_->record_request(uv_hrtime() - start_time_ns_, host->address(),
+                               request()->opcode());
+      if (timing) metrics_->record_request_timing(*timing);
     }
   } else {
     // This request is a speculative execution for whom we already processed
@@ -276,6 +298,7 @@ void RequestHandler::set_error(CassError code, const String& message) {
   stop_request();
   bool skip = (code == CASS_ERROR_LIB_NO_HOSTS_AVAILABLE && --running_executions_ > 0);
   if (!skip) {
+    complete_timing();
     future_->set_error(code, message);
   }
 }
@@ -285,6 +308,7 @@ void RequestHandler::set_error(const Host::Ptr& host, CassError code, const Stri
   bool skip = (code == CASS_ERROR_LIB_NO_HOSTS_AVAILABLE && --running_executions_ > 0);
   if (!skip) {
     if (host) {
+      complete_timing();
       future_->set_error_with_address(host->address(), code, message);
     } else {
       set_error(code, message);
@@ -297,6 +321,7 @@ void RequestHandler::set_error_with_error_response(const Host::Ptr& host,
                                                    const String& message) {
   stop_request();
   running_executions_--;
+  complete_timing();
   future_->set_error_with_response(host->address(), error, code, message);
 }
 
@@ -318,6 +343,13 @@ void RequestHandler::stop_request() {
   timer_.stop();
 }
 
+const RequestTiming* RequestHandler::complete_timing() {
+  if (!is_timing_enabled_) return NULL;
+  RequestTiming* timing = future_->mutable_timing();
+  if (timing) timing->complete = uv_hrtime();
+  return timing;
+}
+
 void RequestHandler::internal_retry(RequestExecution* request_execution) {
   if (is_done_) {
     LOG_DEBUG("Canceling speculative execution (%p) for request (%p) on host %s",
@@ -386,7 +418,11 @@ RequestExecution::RequestExecution(RequestHandler* request_handler)
     , request_handler_(request_handler)
     , current_host_(request_handler->next_host(RequestHandler::Protected()))
     , num_retries_(0)
-    , start_time_ns_(uv_hrtime()) {}
+    , start_time_ns_(uv_hrtime()) {
+  if (request_handler->is_timing_enabled()) {
+    enable_timing();
+  }
+}
 
 void RequestExecution::on_execute_next(Timer* timer) { request_handler_->execute(); }
 
@@ -435,6 +471,10 @@ void RequestExecution::on_set(ResponseMessage* response) {
   current_host_->decrement_inflight_requests();
   Connection* connection = connection_;
 
+  if (timing()) {
+    request_handler_->set_execution_timing(*timing(), RequestHandler::Protected());
+  }
+
   switch (response->opcode()) {
     case CQL_OPCODE_RESULT:
       on_result_response(connection, response);
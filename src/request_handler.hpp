@@ -26,6 +26,7 @@
 #include "prepare_request.hpp"
 #include "request.hpp"
 #include "request_callback.hpp"
+#include "request_timing.hpp"
 #include "response.hpp"
 #include "result_response.hpp"
 #include "retry_policy.hpp"
@@ -34,6 +35,7 @@
 #include "speculative_execution.hpp"
 #include "string.hpp"
 #include "timestamp_generator.hpp"
+#include "vector.hpp"
 
 #include <uv.h>
 
@@ -59,27 +61,24 @@ public:
       , schema_metadata(new Metadata::SchemaSnapshot(schema_metadata)) {}
 
   bool set_response(Address address, const Response::Ptr& response) {
-    ScopedMutex lock(&mutex_);
-    if (!is_set()) {
+    if (claim()) {
       address_ = address;
       response_ = response;
-      internal_set(lock);
+      internal_set();
       return true;
     }
     return false;
   }
 
   const Response::Ptr& response() {
-    ScopedMutex lock(&mutex_);
-    internal_wait(lock);
+    internal_wait();
     return response_;
   }
 
   bool set_error_with_address(Address address, CassError code, const String& message) {
-    ScopedMutex lock(&mutex_);
-    if (!is_set()) {
+    if (claim()) {
       address_ = address;
-      internal_set_error(code, message, lock);
+      internal_set_error(code, message);
       return true;
     }
     return false;
@@ -87,44 +86,61 @@ public:
 
   bool set_error_with_response(Address address, const Response::Ptr& response, CassError code,
                                const String& message) {
-    ScopedMutex lock(&mutex_);
-    if (!is_set()) {
+    if (claim()) {
       address_ = address;
       response_ = response;
-      internal_set_error(code, message, lock);
+      internal_set_error(code, message);
       return true;
     }
     return false;
   }
 
   Address address() {
-    ScopedMutex lock(&mutex_);
-    internal_wait(lock);
+    internal_wait();
     return address_;
   }
 
   // Currently, used for testing only, but it could be exposed in the future.
   AddressVec attempted_addresses() {
-    ScopedMutex lock(&mutex_);
-    internal_wait(lock);
+    internal_wait();
     return attempted_addresses_;
   }
 
+  /**
+   * The times the request passed through each stage.
+   *
+   * @return The request's timing or NULL if timing isn't enabled.
+   */
+  const RequestTiming* timing() {
+    internal_wait();
+    return timing_.get();
+  }
+
   PrepareRequest::ConstPtr prepare_request;
   ScopedPtr<Metadata::SchemaSnapshot> schema_metadata;
 
 private:
   friend class RequestHandler;
 
+  // Attempted addresses are only added by the request handler's event loop
+  // thread before the future is set.
   void add_attempted_address(const Address& address) {
-    ScopedMutex lock(&mutex_);
-    attempted_addresses_.push_back(address);
+    if (!is_set()) {
+      attempted_addresses_.push_back(address);
+    }
   }
 
+  // Timing is enabled before the request is queued. Afterwards, times are only
+  // recorded by the request handler's event loop thread before the future is
+  // set.
+  void enable_timing() { timing_.reset(new RequestTiming()); }
+  RequestTiming* mutable_timing() { return !is_set() ? timing_.get() : NULL; }
+
 private:
   Address address_;
   Response::Ptr response_;
   AddressVec attempted_addresses_;
+  ScopedPtr<RequestTiming> timing_;
 };
 
 class RequestExecution;
@@ -135,12 +151,27 @@ class RequestHandler : public RefCounted<RequestHandler> {
 
 public:
   typedef SharedRefPtr<RequestHandler> Ptr;
+  typedef Vector<Ptr> Vec;
 
   RequestHandler(const Request::ConstPtr& request, const ResponseFuture::Ptr& future,
                  Metrics* metrics = NULL, const Address* preferred_address = NULL);
 
   void set_prepared_metadata(const PreparedMetadata::Entry::Ptr& entry);
 
+  /**
+   * Record the times the request passes through each stage. This must be
+   * called before the request is queued.
+   */
+  void enable_timing();
+  bool is_timing_enabled() const { return is_timing_enabled_; }
+
+  /**
+   * Record the time the request was removed from the request queue.
+   *
+   * @param time_ns A (possibly cached) time from uv_hrtime().
+   */
+  void set_dequeue_time(uint64_t time_ns);
+
   void init(const ExecutionProfile& profile, ConnectionPoolManager* manager,
             const TokenMap* token_map, TimestampGenerator* timestamp_generator,
             RequestListener* listener);
@@ -168,6 +199,8 @@ public:
 
   void add_attempted_address(const Address& address, Protected);
 
+  void set_execution_timing(const RequestTiming& timing, Protected);
+
   void notify_result_metadata_changed(const String& prepared_id, const String& query,
                                       const String& keyspace, const String& result_metadata_id,
                                       const ResultResponse::ConstPtr& result_response, Protected);
@@ -194,12 +227,14 @@ private:
 private:
   void stop_request();
   void internal_retry(RequestExecution* request_execution);
+  const RequestTiming* complete_timing();
 
 private:
   RequestWrapper wrapper_;
   SharedRefPtr<ResponseFuture> future_;
 
   bool is_done_;
+  bool is_timing_enabled_;
   int running_executions_;
 
   ScopedPtr<QueryPlan> query_plan_;
@@ -143,6 +143,7 @@ RequestProcessorSettings::RequestProcessorSettings()
     , request_queue_size(8192)
     , coalesce_delay_us(CASS_DEFAULT_COALESCE_DELAY)
     , new_request_ratio(CASS_DEFAULT_NEW_REQUEST_RATIO)
+    , coalesce_delay_adaptive(CASS_DEFAULT_COALESCE_DELAY_ADAPTIVE)
     , max_tracing_wait_time_ms(CASS_DEFAULT_MAX_TRACING_DATA_WAIT_TIME_MS)
     , retry_tracing_wait_time_ms(CASS_DEFAULT_RETRY_TRACING_DATA_WAIT_TIME_MS)
     , tracing_consistency(CASS_DEFAULT_TRACING_CONSISTENCY)
@@ -160,6 +161,7 @@ RequestProcessorSettings::RequestProcessorSettings(const Config& config)
     , request_queue_size(config.queue_size_io())
     , coalesce_delay_us(config.coalesce_delay_us())
     , new_request_ratio(config.new_request_ratio())
+    , coalesce_delay_adaptive(config.coalesce_delay_adaptive())
     , max_tracing_wait_time_ms(config.max_tracing_wait_time_ms())
     , retry_tracing_wait_time_ms(config.retry_tracing_wait_time_ms())
     , tracing_consistency(config.tracing_consistency())
@@ -178,11 +180,13 @@ RequestProcessor::RequestProcessor(RequestProcessorListener* listener, EventLoop
     , default_profile_(settings.default_profile)
     , profiles_(settings.profiles)
     , request_count_(0)
-    , request_queue_(new MPMCQueue<RequestHandler*>(settings.request_queue_size))
+    , request_queue_(new LaneQueue<RequestHandler*>(settings.request_queue_size))
     , is_closing_(false)
     , is_processing_(false)
     , attempts_without_requests_(0)
     , io_time_during_coalesce_(0)
+    , coalesce_delay_(settings.coalesce_delay_us)
+    , last_flush_time_(uv_hrtime())
 #ifdef CASS_INTERNAL_DIAGNOSTICS
     , reads_during_coalesce_(0)
     , writes_during_coalesce_(0)
@@ -275,6 +279,33 @@ void RequestProcessor::process_request(const RequestHandler::Ptr& request_handle
   }
 }
 
+void RequestProcessor::process_many(const RequestHandler::Vec& request_handlers) {
+  int enqueued = 0;
+  for (RequestHandler::Vec::const_iterator it = request_handlers.begin(),
+                                           end = request_handlers.end();
+       it != end; ++it) {
+    const RequestHandler::Ptr& request_handler(*it);
+    request_handler->inc_ref(); // Queue reference
+
+    if (request_queue_->enqueue(request_handler.get())) {
+      enqueued++;
+    } else {
+      request_handler->dec_ref();
+      request_handler->set_error(CASS_ERROR_LIB_REQUEST_QUEUE_FULL,
+                                 "The request queue has reached capacity");
+    }
+  }
+
+  if (enqueued > 0) {
+    request_count_.fetch_add(enqueued);
+    bool expected = false;
+    if (!is_processing_.load(MEMORY_ORDER_RELAXED) &&
+        is_processing_.compare_exchange_strong(expected, true)) {
+      async_.send();
+    }
+  }
+}
+
 int RequestProcessor::init(Protected) {
   int rc = async_.start(event_loop_->loop(), bind_callback(&RequestProcessor::on_async, this));
   if (rc != 0) return rc;
@@ -477,18 +508,34 @@ void RequestProcessor::internal_host_maybe_up(const Address& address) {
 
 void RequestProcessor::start_coalescing() {
   io_time_during_coalesce_ = 0;
-  timer_.start(event_loop_->loop(), settings_.coalesce_delay_us,
-               bind_callback(&RequestProcessor::on_timeout, this));
+  uint64_t delay_us = settings_.coalesce_delay_adaptive ? coalesce_delay_.delay_us()
+                                                        : settings_.coalesce_delay_us;
+  timer_.start(event_loop_->loop(), delay_us, bind_callback(&RequestProcessor::on_timeout, this));
+}
+
+void RequestProcessor::flush(int processed) {
+  connection_pool_manager_->flush();
+
+  if (settings_.coalesce_delay_adaptive) {
+    // Use the number of requests written since the previous flush and the
+    // requests still waiting to be processed to determine the next delay.
+    uint64_t now = uv_hrtime();
+    coalesce_delay_.record_flush(processed, (now - last_flush_time_) / 1000,
+                                 request_queue_->approx_size());
+    last_flush_time_ = now;
+  }
 }
 
 void RequestProcessor::on_timeout(MicroTimer* timer) {
+  event_loop_->record_timer_lag(timer->lag_ns());
+
   // Don't process for more time than the coalesce delay.
   uint64_t processing_time =
       std::min((io_time_during_coalesce_ * settings_.new_request_ratio) / 100,
                settings_.coalesce_delay_us * 1000);
   int processed = process_requests(processing_time);
 
-  connection_pool_manager_->flush();
+  flush(processed);
 
   if (processed > 0) {
     attempts_without_requests_ = 0;
@@ -519,9 +566,7 @@ void RequestProcessor::on_timeout(MicroTimer* timer) {
 }
 
 void RequestProcessor::on_async(Async* async) {
-  process_requests(0);
-
-  connection_pool_manager_->flush();
+  flush(process_requests(0));
 
   // Always attempt to coalesce even if no requests are written so that
   // processing is properly terminated.
@@ -541,12 +586,17 @@ void RequestProcessor::maybe_close(int request_count) {
 }
 
 int RequestProcessor::process_requests(uint64_t processing_time) {
-  uint64_t finish_time = uv_hrtime() + processing_time;
+  // The current time is cached, by the event loop, and only refreshed with the
+  // finish time check so that timestamping requests (when they're dequeued and
+  // written) doesn't add to the cost of each request.
+  uint64_t now = event_loop_->update_cached_time();
+  uint64_t finish_time = now + processing_time;
 
   int processed = 0;
   RequestHandler* request_handler = NULL;
   while (request_queue_->dequeue(request_handler)) {
     if (request_handler) {
+      request_handler->set_dequeue_time(now);
       const String& profile_name = request_handler->request()->execution_profile_name();
       const ExecutionProfile* profile(execution_profile(profile_name));
       if (profile) {
@@ -565,9 +615,9 @@ int RequestProcessor::process_requests(uint64_t processing_time) {
       request_handler->dec_ref();
     }
 
-    if ((processed & 0x3F) == 0 && // Check the finish time every 64 requests
-        uv_hrtime() >= finish_time) {
-      break;
+    if ((processed & 0x3F) == 0) { // Check the finish time every 64 requests
+      now = event_loop_->update_cached_time();
+      if (now >= finish_time) break;
     }
   }
 
@@ -17,15 +17,16 @@
 #ifndef DATASTAX_INTERNAL_REQUEST_PROCESSOR_HPP
 #define DATASTAX_INTERNAL_REQUEST_PROCESSOR_HPP
 
+#include "adaptive_coalesce_delay.hpp"
 #include "atomic.hpp"
 #include "config.hpp"
 #include "connection_pool_manager.hpp"
 #include "event_loop.hpp"
 #include "histogram_wrapper.hpp"
 #include "host.hpp"
+#include "lane_queue.hpp"
 #include "loop_watcher.hpp"
 #include "micro_timer.hpp"
-#include "mpmc_queue.hpp"
 #include "prepare_host_handler.hpp"
 #include "random.hpp"
 #include "schema_agreement_handler.hpp"
@@ -129,6 +130,8 @@ struct RequestProcessorSettings {
 
   int new_request_ratio;
 
+  bool coalesce_delay_adaptive;
+
   uint64_t max_tracing_wait_time_ms;
 
   uint64_t retry_tracing_wait_time_ms;
@@ -247,6 +250,15 @@ public:
    */
   void process_request(const RequestHandler::Ptr& request_handler);
 
+  /**
+   * Enqueue multiple requests to be processed. The event loop is only
+   * signaled once for all of the requests.
+   * (thread-safe, asynchronous)).
+   *
+   * @param request_handlers
+   */
+  void process_many(const RequestHandler::Vec& request_handlers);
+
   /**
    * Get the number of requests the processor is handling
    *
@@ -324,6 +336,7 @@ private:
   void internal_host_maybe_up(const Address& address);
 
   void start_coalescing();
+  void flush(int processed);
   void on_async(Async* async);
   void on_prepare(Prepare* prepare);
 
@@ -343,7 +356,7 @@ private:
   ExecutionProfile default_profile_;
   ExecutionProfile::Map profiles_;
   Atomic<int> request_count_;
-  ScopedPtr<MPMCQueue<RequestHandler*> > const request_queue_;
+  ScopedPtr<LaneQueue<RequestHandler*> > const request_queue_;
   TokenMap::Ptr token_map_;
 
   bool is_closing_;
@@ -353,6 +366,8 @@ private:
   Async async_;
   Prepare prepare_;
   MicroTimer timer_;
+  AdaptiveCoalesceDelay coalesce_delay_;
+  uint64_t last_flush_time_;
 
 #ifdef CASS_INTERNAL_DIAGNOSTICS
   int reads_during_coalesce_;
@@ -0,0 +1,120 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_REQUEST_TIMING_HPP
+#define DATASTAX_INTERNAL_REQUEST_TIMING_HPP
+
+#include "allocated.hpp"
+#include "cassandra.h"
+
+#include <stdint.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * The times (from uv_hrtime()) a request passed through each of the driver's
+ * stages. A time of zero means the stage wasn't reached. Times are recorded
+ * by the event loop thread that's processing the request, and where possible
+ * a single time is shared by all the requests handled in the same batch to
+ * keep the cost low: dequeue and write times come from the event loop's
+ * cached time (refreshed while processing a batch of requests), and the flush,
+ * first byte and decode times are shared by everything handled in the same
+ * flush or read.
+ */
+struct RequestTiming : public Allocated {
+  RequestTiming()
+      : enqueue(0)
+      , dequeue(0)
+      , write(0)
+      , flush(0)
+      , first_byte(0)
+      , decode(0)
+      , complete(0) {}
+
+  /**
+   * Copy the times recorded by a single execution (attempt) of a request.
+   *
+   * @param execution The execution's timing.
+   */
+  void set_execution(const RequestTiming& execution) {
+    write = execution.write;
+    flush = execution.flush;
+    first_byte = execution.first_byte;
+    decode = execution.decode;
+  }
+
+  /**
+   * Get the time spent in a stage.
+   *
+   * @param stage The stage.
+   * @param duration_ns The time spent in nanoseconds.
+   * @return false if the stage wasn't started or finished.
+   */
+  bool stage_duration(CassRequestStage stage, uint64_t* duration_ns) const {
+    uint64_t start = 0, end = 0;
+    switch (stage) {
+      case CASS_REQUEST_STAGE_QUEUE:
+        start = enqueue;
+        end = dequeue;
+        break;
+      case CASS_REQUEST_STAGE_WRITE:
+        start = dequeue;
+        end = write;
+        break;
+      case CASS_REQUEST_STAGE_COALESCE:
+        start = write;
+        end = flush;
+        break;
+      case CASS_REQUEST_STAGE_SERVER:
+        start = flush;
+        end = first_byte;
+        break;
+      case CASS_REQUEST_STAGE_DECODE:
+        start = first_byte;
+        end = decode;
+        break;
+      case CASS_REQUEST_STAGE_DISPATCH:
+        start = decode;
+        end = complete;
+        break;
+    }
+    if (start == 0 || end < start) return false;
+    *duration_ns = end - start;
+    return true;
+  }
+
+  void to_cass_request_timing(CassRequestTiming* output) const {
+    output->enqueue = enqueue;
+    output->dequeue = dequeue;
+    output->write = write;
+    output->flush = flush;
+    output->first_byte = first_byte;
+    output->decode = decode;
+    output->complete = complete;
+  }
+
+  uint64_t enqueue;
+  uint64_t dequeue;
+  uint64_t write;
+  uint64_t flush;
+  uint64_t first_byte;
+  uint64_t decode;
+  uint64_t complete;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -20,12 +20,17 @@
 #include "error_response.hpp"
 #include "event_response.hpp"
 #include "logger.hpp"
+#include "lz4.hpp"
 #include "ready_response.hpp"
 #include "result_response.hpp"
 #include "supported_response.hpp"
 
 #include <cstring>
 
+// Smaller bodies are copied so that they don't keep large read buffers alive
+#define MIN_ZERO_COPY_BODY_SIZE (16 * 1024)
+
+using namespace datastax::internal;
 using namespace datastax::internal::core;
 
 /**
@@ -43,7 +48,8 @@ public:
 };
 
 Response::Response(uint8_t opcode)
-    : opcode_(opcode) {
+    : opcode_(opcode)
+    , data_(NULL) {
   memset(&tracing_id_, 0, sizeof(CassUuid));
 }
 
@@ -98,7 +104,33 @@ bool ResponseMessage::allocate_body(int8_t opcode) {
   }
 }
 
-ssize_t ResponseMessage::decode(const char* input, size_t size) {
+bool ResponseMessage::decompress_body() {
+  // LZ4 is the only compression algorithm negotiated by the driver. The
+  // compressed body starts with the uncompressed length as an [int].
+  if (length_ < static_cast<int32_t>(sizeof(int32_t))) return false;
+
+  int32_t uncompressed_length = 0;
+  const char* pos = decode_int32(response_body_->data(), uncompressed_length);
+  if (uncompressed_length < 0) return false;
+
+  RefBuffer::Ptr buffer(RefBuffer::create(uncompressed_length));
+  if (!Lz4::decompress(pos, length_ - sizeof(int32_t), buffer->data(), uncompressed_length)) {
+    LOG_ERROR("Unable to decompress LZ4 compressed response body");
+    return false;
+  }
+
+  response_body_->set_buffer(buffer);
+  length_ = uncompressed_length;
+  return true;
+}
+
+char* ResponseMessage::remaining_body(size_t* size) const {
+  if (!is_header_received_ || is_body_ready_) return NULL;
+  *size = header_size_ + length_ - received_;
+  return body_buffer_pos_;
+}
+
+ssize_t ResponseMessage::decode(const char* input, size_t size, RefBuffer* owner) {
   const char* input_pos = input;
 
   received_ += size;
@@ -149,7 +181,13 @@ ssize_t ResponseMessage::decode(const char* input, size_t size) {
         return -1;
       }
 
-      response_body_->set_buffer(length_);
+      if (owner != NULL && length_ >= MIN_ZERO_COPY_BODY_SIZE &&
+          received_ >= header_size_ + length_) {
+        // The whole body is in the input so use it in place
+        response_body_->set_buffer(RefBuffer::Ptr(owner), const_cast<char*>(input_pos));
+      } else {
+        response_body_->set_buffer(length_);
+      }
       body_buffer_pos_ = response_body_->data();
     } else {
       // We haven't received all the data for the header. We consume the
@@ -168,10 +206,17 @@ ssize_t ResponseMessage::decode(const char* input, size_t size) {
     size_t overage = received_ - frame_size;
     size_t needed = remaining - overage;
 
-    memcpy(body_buffer_pos_, input_pos, needed);
+    if (body_buffer_pos_ != input_pos) { // The body may already be in place
+      memcpy(body_buffer_pos_, input_pos, needed);
+    }
     body_buffer_pos_ += needed;
     input_pos += needed;
     assert(body_buffer_pos_ == response_body_->data() + length_);
+
+    if (flags_ & CASS_FLAG_COMPRESSION) {
+      if (!decompress_body()) return -1;
+    }
+
     Decoder decoder(response_body_->data(), length_, ProtocolVersion(version_));
 
     if (flags_ & CASS_FLAG_TRACING) {
@@ -195,7 +240,9 @@ ssize_t ResponseMessage::decode(const char* input, size_t size) {
   } else {
     // We haven't received all the data for the frame. We consume the entire
     // buffer.
-    memcpy(body_buffer_pos_, input_pos, remaining);
+    if (body_buffer_pos_ != input_pos) {
+      memcpy(body_buffer_pos_, input_pos, remaining);
+    }
     body_buffer_pos_ += remaining;
     return size;
   }
@@ -42,11 +42,31 @@ public:
 
   uint8_t opcode() const { return opcode_; }
 
-  char* data() const { return buffer_->data(); }
+  char* data() const { return data_; }
 
   const RefBuffer::Ptr& buffer() const { return buffer_; }
 
-  void set_buffer(size_t size) { buffer_ = RefBuffer::Ptr(RefBuffer::create(size)); }
+  void set_buffer(size_t size) {
+    buffer_ = RefBuffer::Ptr(RefBuffer::create(size));
+    data_ = buffer_->data();
+  }
+
+  void set_buffer(const RefBuffer::Ptr& buffer) {
+    buffer_ = buffer;
+    data_ = buffer_->data();
+  }
+
+  /**
+   * Use data that's owned by a larger buffer, for example, a socket read
+   * buffer. The buffer is kept alive for the lifetime of the response.
+   *
+   * @param buffer The buffer that owns the data.
+   * @param data The start of the response's data within the buffer.
+   */
+  void set_buffer(const RefBuffer::Ptr& buffer, char* data) {
+    buffer_ = buffer;
+    data_ = data;
+  }
 
   bool has_tracing_id() const;
 
@@ -67,6 +87,7 @@ public:
 private:
   uint8_t opcode_;
   RefBuffer::Ptr buffer_;
+  char* data_;
   CassUuid tracing_id_;
   CustomPayloadVec custom_payload_;
   WarningVec warnings_;
@@ -101,10 +122,32 @@ public:
 
   bool is_body_ready() const { return is_body_ready_; }
 
-  ssize_t decode(const char* input, size_t size);
+  /**
+   * Decode a response from the input. This will consume at most a single
+   * response frame.
+   *
+   * @param input The input data.
+   * @param size The size of the input data.
+   * @param owner An optional buffer that owns the input. Large bodies that are
+   * contained entirely in the input reference the owner instead of being
+   * copied.
+   * @return The number of bytes consumed, or negative if an error occurred.
+   */
+  ssize_t decode(const char* input, size_t size, RefBuffer* owner = NULL);
+
+  /**
+   * Get the part of a partially received body that hasn't been filled yet.
+   * Socket data can be read directly into this space to avoid copying large
+   * bodies.
+   *
+   * @param size The number of bytes remaining in the body.
+   * @return A pointer to the remaining space or NULL if no body is pending.
+   */
+  char* remaining_body(size_t* size) const;
 
 private:
   bool allocate_body(int8_t opcode);
+  bool decompress_body();
 
 private:
   uint8_t version_;
@@ -0,0 +1,304 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "segment.hpp"
+
+#include "logger.hpp"
+#include "lz4.hpp"
+
+#include <algorithm>
+#include <string.h>
+
+#define CRC24_INIT 0x875060
+#define CRC24_POLY 0x1974F0B
+#define CRC32_POLY 0xEDB88320
+
+#define PAYLOAD_LENGTH_BITS 17
+#define PAYLOAD_LENGTH_MASK ((1 << PAYLOAD_LENGTH_BITS) - 1)
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+const size_t Segment::MAX_PAYLOAD_SIZE;
+
+namespace {
+
+class Crc32Table {
+public:
+  Crc32Table() {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int j = 0; j < 8; ++j) {
+        crc = (crc & 1) ? (crc >> 1) ^ CRC32_POLY : crc >> 1;
+      }
+      table_[i] = crc;
+    }
+  }
+
+  uint32_t update(uint32_t crc, const uint8_t* data, size_t size) const {
+    for (size_t i = 0; i < size; ++i) {
+      crc = table_[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+  }
+
+private:
+  uint32_t table_[256];
+};
+
+const Crc32Table crc32_table;
+
+// The CRC32 checksum of every payload is seeded with these bytes
+const uint8_t crc32_initial_bytes[] = { 0xFA, 0x2D, 0x55, 0xCA };
+
+// Reads sequential bytes from a vector of buffers
+class BufferCursor {
+public:
+  BufferCursor(const BufferVec& buffers)
+      : it_(buffers.begin())
+      , offset_(0) {}
+
+  void copy(char* output, size_t size) {
+    while (size > 0) {
+      size_t n = std::min(it_->size() - offset_, size);
+      memcpy(output, it_->data() + offset_, n);
+      output += n;
+      size -= n;
+      offset_ += n;
+      if (offset_ == it_->size()) {
+        ++it_;
+        offset_ = 0;
+      }
+    }
+  }
+
+private:
+  BufferVec::const_iterator it_;
+  size_t offset_;
+};
+
+inline void encode_uint_le(char* output, uint64_t value, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    output[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+  }
+}
+
+inline uint64_t decode_uint_le(const char* input, size_t length) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < length; ++i) {
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(input[i])) << (8 * i);
+  }
+  return value;
+}
+
+} // namespace
+
+uint32_t Segment::crc24(uint64_t value, size_t length) {
+  uint32_t crc = CRC24_INIT;
+  for (size_t i = 0; i < length; ++i) {
+    crc ^= static_cast<uint32_t>(value & 0xFF) << 16;
+    value >>= 8;
+    for (int j = 0; j < 8; ++j) {
+      crc <<= 1;
+      if (crc & 0x1000000) {
+        crc ^= CRC24_POLY;
+      }
+    }
+  }
+  return crc;
+}
+
+uint32_t Segment::crc32(const char* data, size_t size) {
+  uint32_t crc = crc32_table.update(0xFFFFFFFF, crc32_initial_bytes, sizeof(crc32_initial_bytes));
+  crc = crc32_table.update(crc, reinterpret_cast<const uint8_t*>(data), size);
+  return crc ^ 0xFFFFFFFF;
+}
+
+void SegmentEncoder::encode(const BufferVec& frames, const SizeVec& frame_sizes,
+                            BufferVec* segments) {
+  BufferCursor cursor(frames);
+  size_t pending = 0;
+
+  payload_.resize(Segment::MAX_PAYLOAD_SIZE);
+
+  for (SizeVec::const_iterator it = frame_sizes.begin(), end = frame_sizes.end(); it != end;
+       ++it) {
+    size_t size = *it;
+    if (size > Segment::MAX_PAYLOAD_SIZE) {
+      if (pending > 0) {
+        segments->push_back(encode_segment(&payload_[0], pending, true));
+        pending = 0;
+      }
+      // Large frames are split across multiple segments that aren't self-contained
+      while (size > 0) {
+        size_t n = std::min(size, Segment::MAX_PAYLOAD_SIZE);
+        cursor.copy(&payload_[0], n);
+        segments->push_back(encode_segment(&payload_[0], n, false));
+        size -= n;
+      }
+    } else {
+      if (pending + size > Segment::MAX_PAYLOAD_SIZE) {
+        segments->push_back(encode_segment(&payload_[0], pending, true));
+        pending = 0;
+      }
+      cursor.copy(&payload_[pending], size);
+      pending += size;
+    }
+  }
+
+  if (pending > 0) {
+    segments->push_back(encode_segment(&payload_[0], pending, true));
+  }
+}
+
+Buffer SegmentEncoder::encode_segment(const char* payload, size_t size,
+                                      bool is_self_contained) const {
+  assert(size <= Segment::MAX_PAYLOAD_SIZE);
+
+  if (!is_compressed_) {
+    Buffer buf(Segment::HEADER_SIZE + size + Segment::TRAILER_SIZE);
+    char* data = buf.data();
+
+    uint64_t header = size | (static_cast<uint64_t>(is_self_contained) << PAYLOAD_LENGTH_BITS);
+    encode_uint_le(data, header, 3);
+    encode_uint_le(data + 3, Segment::crc24(header, 3), 3);
+    memcpy(data + Segment::HEADER_SIZE, payload, size);
+    encode_uint_le(data + Segment::HEADER_SIZE + size, Segment::crc32(payload, size),
+                   Segment::TRAILER_SIZE);
+    return buf;
+  }
+
+  Buffer buf(Segment::COMPRESSED_HEADER_SIZE + Lz4::compress_bound(size) + Segment::TRAILER_SIZE);
+  char* data = buf.data();
+  char* body = data + Segment::COMPRESSED_HEADER_SIZE;
+
+  size_t compressed_size = Lz4::compress(payload, size, body);
+  size_t uncompressed_size = size;
+  if (compressed_size >= size) {
+    // Compression doesn't help so the payload is stored uncompressed. This is
+    // indicated using an uncompressed length of zero.
+    memcpy(body, payload, size);
+    compressed_size = size;
+    uncompressed_size = 0;
+  }
+
+  uint64_t header = compressed_size |
+                    (static_cast<uint64_t>(uncompressed_size) << PAYLOAD_LENGTH_BITS) |
+                    (static_cast<uint64_t>(is_self_contained) << (2 * PAYLOAD_LENGTH_BITS));
+  header |= static_cast<uint64_t>(Segment::crc24(header, 5)) << 40;
+  encode_uint_le(data, header, Segment::COMPRESSED_HEADER_SIZE);
+  encode_uint_le(body + compressed_size, Segment::crc32(body, compressed_size),
+                 Segment::TRAILER_SIZE);
+
+  buf.truncate(Segment::COMPRESSED_HEADER_SIZE + compressed_size + Segment::TRAILER_SIZE);
+  return buf;
+}
+
+SegmentDecoder::SegmentDecoder(bool is_compressed)
+    : is_compressed_(is_compressed)
+    , header_size_(is_compressed ? Segment::COMPRESSED_HEADER_SIZE : Segment::HEADER_SIZE)
+    , state_(HEADER)
+    , header_received_(0)
+    , payload_size_(0)
+    , uncompressed_size_(0)
+    , is_self_contained_(false) {}
+
+ssize_t SegmentDecoder::decode(const char* input, size_t size) {
+  const char* pos = input;
+  size_t remaining = size;
+
+  if (state_ == PAYLOAD_READY) { // Start a new segment
+    state_ = HEADER;
+    header_received_ = 0;
+    buffer_.clear();
+    payload_.clear();
+  }
+
+  if (state_ == HEADER) {
+    size_t n = std::min(header_size_ - header_received_, remaining);
+    memcpy(header_ + header_received_, pos, n);
+    header_received_ += n;
+    pos += n;
+    remaining -= n;
+
+    if (header_received_ < header_size_) {
+      return static_cast<ssize_t>(size);
+    }
+
+    if (!decode_header()) return -1;
+    state_ = PAYLOAD;
+    buffer_.reserve(payload_size_ + Segment::TRAILER_SIZE);
+  }
+
+  if (state_ == PAYLOAD) {
+    size_t n = std::min(payload_size_ + Segment::TRAILER_SIZE - buffer_.size(), remaining);
+    buffer_.append(pos, n);
+    pos += n;
+    remaining -= n;
+
+    if (buffer_.size() == payload_size_ + Segment::TRAILER_SIZE) {
+      if (!decode_payload()) return -1;
+      state_ = PAYLOAD_READY;
+    }
+  }
+
+  return static_cast<ssize_t>(size - remaining);
+}
+
+bool SegmentDecoder::decode_header() {
+  size_t header_length = header_size_ - 3;
+  uint64_t header = decode_uint_le(header_, header_length);
+  uint32_t crc = static_cast<uint32_t>(decode_uint_le(header_ + header_length, 3));
+
+  if (crc != Segment::crc24(header, header_length)) {
+    LOG_ERROR("Segment header checksum mismatch");
+    return false;
+  }
+
+  payload_size_ = static_cast<size_t>(header & PAYLOAD_LENGTH_MASK);
+  if (is_compressed_) {
+    uncompressed_size_ = static_cast<size_t>((header >> PAYLOAD_LENGTH_BITS) & PAYLOAD_LENGTH_MASK);
+    is_self_contained_ = ((header >> (2 * PAYLOAD_LENGTH_BITS)) & 1) != 0;
+  } else {
+    uncompressed_size_ = 0;
+    is_self_contained_ = ((header >> PAYLOAD_LENGTH_BITS) & 1) != 0;
+  }
+
+  return true;
+}
+
+bool SegmentDecoder::decode_payload() {
+  const char* data = buffer_.data();
+  uint32_t crc = static_cast<uint32_t>(decode_uint_le(data + payload_size_, Segment::TRAILER_SIZE));
+
+  if (crc != Segment::crc32(data, payload_size_)) {
+    LOG_ERROR("Segment payload checksum mismatch");
+    return false;
+  }
+
+  if (uncompressed_size_ == 0) {
+    buffer_.resize(payload_size_);
+    payload_.swap(buffer_);
+  } else {
+    payload_.resize(uncompressed_size_);
+    if (!Lz4::decompress(data, payload_size_, &payload_[0], uncompressed_size_)) {
+      LOG_ERROR("Unable to decompress segment payload");
+      return false;
+    }
+  }
+
+  return true;
+}
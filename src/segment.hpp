@@ -0,0 +1,174 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_SEGMENT_HPP
+#define DATASTAX_INTERNAL_SEGMENT_HPP
+
+#include "allocated.hpp"
+#include "buffer.hpp"
+#include "macros.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+typedef Vector<size_t> SizeVec;
+
+/**
+ * Native protocol v5 segments. After the protocol handshake frames are no
+ * longer written directly to the socket, instead they're packed into
+ * segments. A segment has a header protected by a CRC24 checksum and a payload
+ * protected by a CRC32 checksum. The payload of a segment can optionally be
+ * compressed using LZ4.
+ *
+ * A self-contained segment contains one or more complete frames. Frames
+ * larger than the maximum payload size are split across multiple segments
+ * that are not self-contained.
+ */
+class Segment {
+public:
+  static const size_t MAX_PAYLOAD_SIZE = 128 * 1024 - 1;
+  static const size_t HEADER_SIZE = 6;
+  static const size_t COMPRESSED_HEADER_SIZE = 8;
+  static const size_t TRAILER_SIZE = 4;
+
+  /**
+   * Compute the CRC24 checksum used to protect segment headers.
+   *
+   * @param value The header bytes packed into an integer (little-endian).
+   * @param length The number of header bytes.
+   * @return The checksum.
+   */
+  static uint32_t crc24(uint64_t value, size_t length);
+
+  /**
+   * Compute the CRC32 checksum used to protect segment payloads.
+   *
+   * @param data The payload.
+   * @param size The size of the payload.
+   * @return The checksum.
+   */
+  static uint32_t crc32(const char* data, size_t size);
+
+private:
+  Segment();
+  DISALLOW_COPY_AND_ASSIGN(Segment);
+};
+
+/**
+ * An encoder that packs frames into segments.
+ */
+class SegmentEncoder : public Allocated {
+public:
+  /**
+   * Constructor
+   *
+   * @param is_compressed If true segment payloads are compressed using LZ4.
+   */
+  SegmentEncoder(bool is_compressed)
+      : is_compressed_(is_compressed) {}
+
+  /**
+   * Pack encoded frames into as few segments as possible.
+   *
+   * @param frames The buffers of the encoded frames.
+   * @param frame_sizes The size of each of the frames contained in `frames`.
+   * @param segments The output segments.
+   */
+  void encode(const BufferVec& frames, const SizeVec& frame_sizes, BufferVec* segments);
+
+  /**
+   * Encode a single segment.
+   *
+   * @param payload The payload.
+   * @param size The size of the payload. It must not exceed `Segment::MAX_PAYLOAD_SIZE`.
+   * @param is_self_contained true if the payload only contains complete frames.
+   * @return The encoded segment.
+   */
+  Buffer encode_segment(const char* payload, size_t size, bool is_self_contained) const;
+
+private:
+  bool is_compressed_;
+  Vector<char> payload_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(SegmentEncoder);
+};
+
+/**
+ * A streaming decoder that unpacks segments and verifies their checksums.
+ */
+class SegmentDecoder : public Allocated {
+public:
+  /**
+   * Constructor
+   *
+   * @param is_compressed If true segment payloads are expected to be
+   * compressed using LZ4.
+   */
+  SegmentDecoder(bool is_compressed);
+
+  /**
+   * Decode a segment from the input. This will consume at most a single
+   * segment.
+   *
+   * @param input The input data.
+   * @param size The size of the input data.
+   * @return The number of bytes consumed, or negative if an error occurred.
+   */
+  ssize_t decode(const char* input, size_t size);
+
+  /**
+   * Determine if a complete segment has been decoded.
+   *
+   * @return true if the payload is ready.
+   */
+  bool is_payload_ready() const { return state_ == PAYLOAD_READY; }
+
+  /**
+   * The decoded (and decompressed) payload. Only valid if `is_payload_ready()`.
+   */
+  const String& payload() const { return payload_; }
+
+  bool is_self_contained() const { return is_self_contained_; }
+
+private:
+  enum State { HEADER, PAYLOAD, PAYLOAD_READY };
+
+  bool decode_header();
+  bool decode_payload();
+
+private:
+  const bool is_compressed_;
+  const size_t header_size_;
+  State state_;
+  char header_[Segment::COMPRESSED_HEADER_SIZE];
+  size_t header_received_;
+  size_t payload_size_;
+  size_t uncompressed_size_;
+  bool is_self_contained_;
+  String buffer_;
+  String payload_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(SegmentDecoder);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -21,6 +21,8 @@
 #include "constants.hpp"
 #include "execute_request.hpp"
 #include "external.hpp"
+#include "host_metrics_iterator.hpp"
+#include "io_thread_metrics_iterator.hpp"
 #include "logger.hpp"
 #include "metrics.hpp"
 #include "monitor_reporting.hpp"
@@ -99,10 +101,39 @@ CassFuture* cass_session_execute_batch(CassSession* session, const CassBatch* ba
   return CassFuture::to(future.get());
 }
 
+CassFuture* cass_session_execute_many(CassSession* session, const CassStatement* const* statements,
+                                      size_t statement_count, CassFuture** futures) {
+  Request::ConstVec requests;
+  requests.reserve(statement_count);
+  for (size_t i = 0; i < statement_count; ++i) {
+    requests.push_back(Request::ConstPtr(statements[i]->from()));
+  }
+
+  Future::Vec request_futures;
+  Future::Ptr future(session->execute_many(requests, futures ? &request_futures : NULL));
+
+  if (futures) {
+    for (size_t i = 0; i < statement_count; ++i) {
+      request_futures[i]->inc_ref();
+      futures[i] = CassFuture::to(request_futures[i].get());
+    }
+  }
+
+  future->inc_ref();
+  return CassFuture::to(future.get());
+}
+
 const CassSchemaMeta* cass_session_get_schema_meta(const CassSession* session) {
   return CassSchemaMeta::to(new Metadata::SchemaSnapshot(session->cluster()->schema_snapshot()));
 }
 
+const CassTokenMap* cass_session_get_token_map(const CassSession* session) {
+  TokenMap::Ptr token_map(session->token_map());
+  if (!token_map) return NULL;
+  token_map->inc_ref();
+  return CassTokenMap::to(token_map.get());
+}
+
 void cass_session_get_metrics(const CassSession* session, CassMetrics* metrics) {
   const Metrics* internal_metrics = session->metrics();
 
@@ -167,6 +198,102 @@ void cass_session_get_speculative_execution_metrics(const CassSession* session,
   metrics->percentage = internal_metrics->request_rates.speculative_request_percent();
 }
 
+CassIterator* cass_session_get_host_metrics(const CassSession* session) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get host metrics before connecting session object");
+  }
+
+  return CassIterator::to(new HostMetricsIterator(internal_metrics));
+}
+
+void cass_session_get_request_type_metrics(const CassSession* session, CassRequestType type,
+                                           CassLatencyMetrics* metrics) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get request type metrics before connecting session object");
+    memset(metrics, 0, sizeof(CassLatencyMetrics));
+    return;
+  }
+
+  const Metrics::Histogram* histogram = NULL;
+  switch (type) {
+    case CASS_REQUEST_TYPE_QUERY:
+      histogram = internal_metrics->request_latencies_by_opcode(CQL_OPCODE_QUERY);
+      break;
+    case CASS_REQUEST_TYPE_EXECUTE:
+      histogram = internal_metrics->request_latencies_by_opcode(CQL_OPCODE_EXECUTE);
+      break;
+    case CASS_REQUEST_TYPE_BATCH:
+      histogram = internal_metrics->request_latencies_by_opcode(CQL_OPCODE_BATCH);
+      break;
+    case CASS_REQUEST_TYPE_PREPARE:
+      histogram = internal_metrics->request_latencies_by_opcode(CQL_OPCODE_PREPARE);
+      break;
+  }
+
+  if (histogram == NULL) {
+    memset(metrics, 0, sizeof(CassLatencyMetrics));
+    return;
+  }
+
+  copy_latency_metrics(*histogram, metrics);
+}
+
+void cass_session_get_request_stage_metrics(const CassSession* session, CassRequestStage stage,
+                                            CassLatencyMetrics* metrics) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get request stage metrics before connecting session object");
+    memset(metrics, 0, sizeof(CassLatencyMetrics));
+    return;
+  }
+
+  const Metrics::Histogram* histogram = internal_metrics->request_latencies_by_stage(stage);
+  if (histogram == NULL) {
+    memset(metrics, 0, sizeof(CassLatencyMetrics));
+    return;
+  }
+
+  copy_latency_metrics(*histogram, metrics);
+}
+
+CassIterator* cass_session_get_io_thread_metrics(const CassSession* session) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get I/O thread metrics before connecting session object");
+  }
+
+  return CassIterator::to(new IoThreadMetricsIterator(internal_metrics));
+}
+
+CassError cass_session_start_metrics_server(CassSession* session, const char* address,
+                                            int port) {
+  Address listen_address(SAFE_STRLEN(address) > 0 ? address : "", port);
+  if (!listen_address.is_valid_and_resolved()) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  return session->start_metrics_server(listen_address);
+}
+
+const CassHostMetrics* cass_iterator_get_host_metrics(const CassIterator* iterator) {
+  if (iterator->type() != CASS_ITERATOR_TYPE_HOST_METRICS) {
+    return NULL;
+  }
+  return static_cast<const HostMetricsIterator*>(iterator->from())->host_metrics();
+}
+
+const CassIoThreadMetrics* cass_iterator_get_io_thread_metrics(const CassIterator* iterator) {
+  if (iterator->type() != CASS_ITERATOR_TYPE_IO_THREAD_METRICS) {
+    return NULL;
+  }
+  return static_cast<const IoThreadMetricsIterator*>(iterator->from())->io_thread_metrics();
+}
+
 } // extern "C"
 
 static inline bool least_busy_comp(const RequestProcessor::Ptr& a, const RequestProcessor::Ptr& b) {
@@ -276,11 +403,34 @@ Session::Session()
     : request_processor_count_(0)
     , is_closing_(false) {
   uv_mutex_init(&mutex_);
+  uv_mutex_init(&token_map_mutex_);
 }
 
 Session::~Session() {
+  metrics_server_.reset();
   join();
   uv_mutex_destroy(&mutex_);
+  uv_mutex_destroy(&token_map_mutex_);
+}
+
+TokenMap::Ptr Session::token_map() const {
+  ScopedMutex l(&token_map_mutex_);
+  return token_map_;
+}
+
+CassError Session::start_metrics_server(const Address& address) {
+  ScopedMutex l(&mutex_);
+  if (metrics_server_) {
+    LOG_ERROR("Metrics server has already been started");
+    return CASS_ERROR_LIB_UNABLE_TO_INIT;
+  }
+
+  metrics_server_.reset(new MetricsServer(this));
+  if (metrics_server_->start(address) != 0) {
+    metrics_server_.reset();
+    return CASS_ERROR_LIB_UNABLE_TO_INIT;
+  }
+  return CASS_OK;
 }
 
 Future::Ptr Session::prepare(const char* statement, size_t length) {
@@ -289,7 +439,7 @@ Future::Ptr Session::prepare(const char* statement, size_t length) {
   ResponseFuture::Ptr future(new ResponseFuture(cluster()->schema_snapshot()));
   future->prepare_request = PrepareRequest::ConstPtr(prepare);
 
-  execute(RequestHandler::Ptr(new RequestHandler(prepare, future, metrics())));
+  execute(create_request_handler(prepare, future));
 
   return future;
 }
@@ -312,25 +462,84 @@ Future::Ptr Session::prepare(const Statement* statement) {
   ResponseFuture::Ptr future(new ResponseFuture(cluster()->schema_snapshot()));
   future->prepare_request = PrepareRequest::ConstPtr(prepare);
 
-  execute(RequestHandler::Ptr(new RequestHandler(prepare, future, metrics())));
+  execute(create_request_handler(prepare, future));
 
   return future;
 }
 
 Future::Ptr Session::execute(const Request::ConstPtr& request, const Address* preferred_address) {
   ResponseFuture::Ptr future(new ResponseFuture());
+  execute(create_request_handler(request, future, preferred_address));
+  return future;
+}
+
+Future::Ptr Session::execute_many(const Request::ConstVec& requests, Future::Vec* futures) {
+  AggregateFuture::Ptr all(new AggregateFuture(requests.size()));
+  if (futures) {
+    futures->reserve(futures->size() + requests.size());
+  }
 
+  RequestHandler::Vec request_handlers;
+  request_handlers.reserve(requests.size());
+  for (Request::ConstVec::const_iterator it = requests.begin(), end = requests.end(); it != end;
+       ++it) {
+    ResponseFuture::Ptr future(new ResponseFuture());
+    all->add(future.get());
+    request_handlers.push_back(create_request_handler(*it, future));
+    if (futures) futures->push_back(future);
+  }
+
+  if (state() != SESSION_STATE_CONNECTED) {
+    for (RequestHandler::Vec::const_iterator it = request_handlers.begin(),
+                                             end = request_handlers.end();
+         it != end; ++it) {
+      (*it)->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is not connected");
+    }
+    return all;
+  }
+
+  size_t count = request_processors_.size();
+  if (count == 1 || request_handlers.size() <= 1) {
+    const RequestProcessor::Ptr& request_processor =
+        *std::min_element(request_processors_.begin(), request_processors_.end(), least_busy_comp);
+    request_processor->process_many(request_handlers);
+    return all;
+  }
+
+  // Divide the requests evenly between the processors starting with the least
+  // busy processor.
+  size_t start = std::min_element(request_processors_.begin(), request_processors_.end(),
+                                  least_busy_comp) -
+                 request_processors_.begin();
+  Vector<RequestHandler::Vec> partitions(count);
+  for (size_t i = 0; i < request_handlers.size(); ++i) {
+    partitions[(start + i) % count].push_back(request_handlers[i]);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (!partitions[i].empty()) {
+      request_processors_[i]->process_many(partitions[i]);
+    }
+  }
+
+  return all;
+}
+
+RequestHandler::Ptr Session::create_request_handler(const Request::ConstPtr& request,
+                                                    const ResponseFuture::Ptr& future,
+                                                    const Address* preferred_address) {
   RequestHandler::Ptr request_handler(
       new RequestHandler(request, future, metrics(), preferred_address));
 
+  if (config().request_timing()) {
+    request_handler->enable_timing();
+  }
+
   if (request_handler->request()->opcode() == CQL_OPCODE_EXECUTE) {
     const ExecuteRequest* execute = static_cast<const ExecuteRequest*>(request_handler->request());
     request_handler->set_prepared_metadata(cluster()->prepared(execute->prepared()->id()));
   }
 
-  execute(request_handler);
-
-  return future;
+  return request_handler;
 }
 
 void Session::execute(const RequestHandler::Ptr& request_handler) {
@@ -381,8 +590,16 @@ void Session::on_connect(const Host::Ptr& connected_host, ProtocolVersion protoc
     return;
   }
 
+  Metrics::EventLoopStatsVec io_thread_stats;
+  for (size_t i = 0; i < event_loop_group_->size(); ++i) {
+    io_thread_stats.push_back(event_loop_group_->get(i)->stats());
+  }
+  metrics()->set_io_thread_stats(io_thread_stats);
+
+  Metrics::HostHistograms* host_request_latencies = metrics()->host_request_latencies();
   for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
     const Host::Ptr& host = it->second;
+    if (host_request_latencies) host_request_latencies->add(host->address());
     config().host_listener()->on_host_added(host);
     config().host_listener()->on_host_up(
         host); // If host is down it will be marked down later in the connection process
@@ -391,6 +608,12 @@ void Session::on_connect(const Host::Ptr& connected_host, ProtocolVersion protoc
   request_processors_.clear();
   request_processor_count_ = 0;
   is_closing_ = false;
+
+  { // Protect the token map from concurrent access by the public API
+    ScopedMutex l(&token_map_mutex_);
+    token_map_ = token_map;
+  }
+
   SessionInitializer::Ptr initializer(new SessionInitializer(this));
   initializer->initialize(connected_host, protocol_version, hosts, token_map, local_dc);
 }
@@ -411,6 +634,14 @@ void Session::on_close() {
   }
 }
 
+void Session::on_close(Cluster* cluster) {
+  { // The token map is no longer available after the session is closed
+    ScopedMutex l(&token_map_mutex_);
+    token_map_.reset();
+  }
+  SessionBase::on_close(cluster);
+}
+
 void Session::on_host_up(const Host::Ptr& host) {
   // Ignore up events from the control connection; however external host
   // listeners should still be notified. The connection pools will reconnect
@@ -432,6 +663,9 @@ void Session::on_host_down(const Host::Ptr& host) {
 }
 
 void Session::on_host_added(const Host::Ptr& host) {
+  if (metrics() && metrics()->host_request_latencies()) {
+    metrics()->host_request_latencies()->add(host->address());
+  }
   { // Lock for request processor
     ScopedMutex l(&mutex_);
     for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
@@ -452,10 +686,18 @@ void Session::on_host_removed(const Host::Ptr& host) {
       (*it)->notify_host_removed(host);
     }
   }
+  if (metrics() && metrics()->host_request_latencies()) {
+    metrics()->host_request_latencies()->remove(host->address());
+  }
   config().host_listener()->on_host_removed(host);
 }
 
 void Session::on_token_map_updated(const TokenMap::Ptr& token_map) {
+  {
+    ScopedMutex l(&token_map_mutex_);
+    token_map_ = token_map;
+  }
+
   ScopedMutex l(&mutex_);
   for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
                                              end = request_processors_.end();
@@ -19,6 +19,7 @@
 
 #include "allocated.hpp"
 #include "metrics.hpp"
+#include "metrics_server.hpp"
 #include "mpmc_queue.hpp"
 #include "request_processor.hpp"
 #include "session_base.hpp"
@@ -44,7 +45,38 @@ public:
 
   Future::Ptr execute(const Request::ConstPtr& request, const Address* preferred_address = NULL);
 
+  /**
+   * Execute multiple requests. The requests are divided between the request
+   * processors and each processor's event loop is only signaled once.
+   *
+   * @param requests The requests to execute.
+   * @param futures An optional output for each request's future.
+   * @return A future that's set after all of the requests have finished.
+   */
+  Future::Ptr execute_many(const Request::ConstVec& requests, Future::Vec* futures = NULL);
+
+  /**
+   * Start serving the session's metrics over HTTP. The server is stopped when
+   * the session is destroyed.
+   *
+   * @param address The address to listen on.
+   * @return CASS_OK if successful, otherwise an error.
+   */
+  CassError start_metrics_server(const Address& address);
+
+  /**
+   * The most recent token map. This can be called from any thread.
+   *
+   * @return The token map or null if the session isn't connected or
+   * token-aware routing is disabled.
+   */
+  TokenMap::Ptr token_map() const;
+
 private:
+  RequestHandler::Ptr create_request_handler(const Request::ConstPtr& request,
+                                             const ResponseFuture::Ptr& future,
+                                             const Address* preferred_address = NULL);
+
   void execute(const RequestHandler::Ptr& request_handler);
 
   void join();
@@ -58,7 +90,7 @@ private:
 
   virtual void on_close();
 
-  using SessionBase::on_close; // Intentional overload
+  virtual void on_close(Cluster* cluster);
 
 private:
   // Cluster listener methods
@@ -102,7 +134,10 @@ private:
 
 private:
   ScopedPtr<RoundRobinEventLoopGroup> event_loop_group_;
+  ScopedPtr<MetricsServer> metrics_server_;
   uv_mutex_t mutex_;
+  mutable uv_mutex_t token_map_mutex_;
+  TokenMap::Ptr token_map_;
   RequestProcessor::Vec request_processors_;
   size_t request_processor_count_;
   bool is_closing_;
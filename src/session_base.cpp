@@ -97,7 +97,9 @@ Future::Ptr SessionBase::connect(const Config& config, const String& keyspace) {
     random_.reset();
   }
 
-  metrics_.reset(new Metrics(config.thread_count_io() + 1));
+  // The previous metrics are kept alive by anything still using them (e.g. the metrics server)
+  metrics_.reset(new Metrics(config.thread_count_io() + 1, config.detailed_latency_metrics(),
+                             config.request_timing()));
 
   cluster_.reset();
   ClusterConnector::Ptr connector(
@@ -117,6 +119,11 @@ Future::Ptr SessionBase::connect(const Config& config, const String& keyspace) {
   return future;
 }
 
+Metrics::Ptr SessionBase::current_metrics() const {
+  ScopedMutex l(&mutex_);
+  return metrics_;
+}
+
 Future::Ptr SessionBase::close() {
   Future::Ptr future(new SessionFuture());
 
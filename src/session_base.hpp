@@ -18,6 +18,7 @@
 #define DATASTAX_INTERNAL_SESSION_BASE_HPP
 
 #include "cluster_connector.hpp"
+#include "metrics.hpp"
 #include "prepared.hpp"
 #include "schema_agreement_handler.hpp"
 #include "token_map.hpp"
@@ -78,6 +79,15 @@ public:
   Cluster::Ptr cluster() const { return cluster_; }
   Random* random() const { return random_.get(); }
   Metrics* metrics() const { return metrics_.get(); }
+
+  /**
+   * Get the current metrics. Unlike metrics(), this is safe to call from
+   * threads that aren't managed by the session (e.g. while the session is
+   * connecting and replacing its metrics).
+   *
+   * @return The current metrics or null if the session has never connected.
+   */
+  Metrics::Ptr current_metrics() const;
   State state() const { return state_; }
 
 protected:
@@ -154,7 +164,7 @@ private:
   Cluster::Ptr cluster_;
   Config config_;
   ScopedPtr<Random> random_;
-  ScopedPtr<Metrics> metrics_;
+  Metrics::Ptr metrics_;
   String connect_keyspace_;
   CassError connect_error_code_;
   String connect_error_message_;
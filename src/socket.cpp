@@ -44,6 +44,8 @@ public:
 size_t SocketWrite::flush() {
   size_t total = 0;
   if (!is_flushed_ && !buffers_.empty()) {
+    encode_segments();
+
     UvBufVec bufs;
 
     bufs.reserve(buffers_.size());
@@ -56,14 +58,14 @@ size_t SocketWrite::flush() {
     is_flushed_ = true;
     uv_stream_t* sock_stream = reinterpret_cast<uv_stream_t*>(tcp());
     uv_write(&req_, sock_stream, bufs.data(), bufs.size(), SocketWrite::on_write);
+    notify_flush();
   }
   return total;
 }
 
 SocketHandler::~SocketHandler() {
   while (!buffer_reuse_list_.empty()) {
-    uv_buf_t buf = buffer_reuse_list_.top();
-    Memory::free(buf.base);
+    buffer_reuse_list_.top()->dec_ref();
     buffer_reuse_list_.pop();
   }
 }
@@ -73,25 +75,33 @@ SocketWriteBase* SocketHandler::new_pending_write(Socket* socket) {
 }
 
 void SocketHandler::alloc_buffer(size_t suggested_size, uv_buf_t* buf) {
+  RefBuffer* buffer;
   if (suggested_size <= BUFFER_REUSE_SIZE) {
+    suggested_size = BUFFER_REUSE_SIZE;
     if (!buffer_reuse_list_.empty()) {
-      *buf = buffer_reuse_list_.top();
+      buffer = buffer_reuse_list_.top();
       buffer_reuse_list_.pop();
     } else {
-      *buf = uv_buf_init(reinterpret_cast<char*>(Memory::malloc(BUFFER_REUSE_SIZE)),
-                         BUFFER_REUSE_SIZE);
+      buffer = RefBuffer::create(BUFFER_REUSE_SIZE);
+      buffer->inc_ref();
     }
   } else {
-    *buf = uv_buf_init(reinterpret_cast<char*>(Memory::malloc(suggested_size)), suggested_size);
+    buffer = RefBuffer::create(suggested_size);
+    buffer->inc_ref();
   }
+  *buf = uv_buf_init(buffer->data(), suggested_size);
 }
 
 void SocketHandler::free_buffer(const uv_buf_t* buf) {
-  if (buf->len == BUFFER_REUSE_SIZE && buffer_reuse_list_.size() < MAX_BUFFER_REUSE_NO) {
-    buffer_reuse_list_.push(*buf);
+  if (buf->base == NULL) return;
+  RefBuffer* buffer = read_buffer(buf);
+  // Buffers still referenced by decoded data can't be reused
+  if (buffer->ref_count() == 1 && buf->len == BUFFER_REUSE_SIZE &&
+      buffer_reuse_list_.size() < MAX_BUFFER_REUSE_NO) {
+    buffer_reuse_list_.push(buffer);
     return;
   }
-  Memory::free(buf->base);
+  buffer->dec_ref();
 }
 
 /**
@@ -121,6 +131,7 @@ size_t SslSocketWrite::flush() {
   if (!is_flushed_ && !buffers_.empty()) {
     rb::RingBuffer::Position prev_pos = ssl_session_->outgoing().write_position();
 
+    encode_segments();
     encrypt();
 
     SmallVector<uv_buf_t, SSL_ENCRYPTED_BUFS_COUNT> bufs;
@@ -130,6 +141,7 @@ size_t SslSocketWrite::flush() {
 
     uv_stream_t* sock_stream = reinterpret_cast<uv_stream_t*>(tcp());
     uv_write(&req_, sock_stream, bufs.data(), bufs.size(), SslSocketWrite::on_write);
+    notify_flush();
 
     is_flushed_ = true;
   }
@@ -240,10 +252,29 @@ int32_t SocketWriteBase::write(SocketRequest* request) {
   }
 
   requests_.push_back(request);
+  frame_sizes_.push_back(request_size);
+  size_ += request_size;
+  socket_->pending_write_bytes_ += request_size;
 
   return request_size;
 }
 
+void SocketWriteBase::encode_segments() {
+  SegmentEncoder* encoder = socket_->segment_encoder_.get();
+  if (encoder) {
+    BufferVec segments;
+    encoder->encode(buffers_, frame_sizes_, &segments);
+    buffers_.swap(segments);
+  }
+}
+
+void SocketWriteBase::notify_flush() {
+  uint64_t now = uv_hrtime();
+  for (RequestVec::iterator i = requests_.begin(), end = requests_.end(); i != end; ++i) {
+    (*i)->on_flush(now);
+  }
+}
+
 void SocketWriteBase::on_write(uv_write_t* req, int status) {
   SocketWriteBase* pending_write = static_cast<SocketWriteBase*>(req->data);
   pending_write->handle_write(req, status);
@@ -266,6 +297,7 @@ void SocketWriteBase::handle_write(uv_write_t* req, int status) {
   }
 
   socket->pending_writes_.remove(this);
+  socket->pending_write_bytes_ -= size_;
 
   if (socket->free_writes_.size() < socket->max_reusable_write_objects_) {
     clear();
@@ -280,6 +312,7 @@ void SocketWriteBase::handle_write(uv_write_t* req, int status) {
 Socket::Socket(const Address& address, size_t max_reusable_write_objects)
     : is_defunct_(false)
     , max_reusable_write_objects_(max_reusable_write_objects)
+    , pending_write_bytes_(0)
     , address_(address) {
   tcp_.data = this;
 }
@@ -381,6 +414,7 @@ void Socket::handle_close() {
     pending_write->on_close();
     delete pending_write;
   }
+  pending_write_bytes_ = 0;
 
   if (handler_) {
     handler_->on_close();
@@ -22,6 +22,7 @@
 #include "constants.hpp"
 #include "list.hpp"
 #include "scoped_ptr.hpp"
+#include "segment.hpp"
 #include "ssl.hpp"
 #include "stack.hpp"
 #include "tcp_connector.hpp"
@@ -60,6 +61,14 @@ public:
    */
   virtual int32_t encode(BufferVec* bufs) = 0;
 
+  /**
+   * Handle the request's data being flushed to the socket.
+   *
+   * @param time_ns The time of the flush (from uv_hrtime()). It's shared by
+   * all the requests in the flush.
+   */
+  virtual void on_flush(uint64_t time_ns) {}
+
   /**
    * Handle a socket closing during a request.
    */
@@ -141,6 +150,9 @@ public:
 
 /**
  * A basic socket handler that caches buffers used for reading socket data.
+ * Read buffers are reference counted so that decoded data can reference them
+ * directly instead of copying. A buffer is only cached for reuse if it's not
+ * referenced after the read.
  */
 class SocketHandler : public SocketHandlerBase {
 public:
@@ -156,8 +168,16 @@ public:
    */
   void free_buffer(const uv_buf_t* buf);
 
+  /**
+   * Get the reference counted buffer that owns a read buffer.
+   *
+   * @param buf A buffer created in alloc_buffer().
+   * @return The owning buffer.
+   */
+  static RefBuffer* read_buffer(const uv_buf_t* buf) { return RefBuffer::from_data(buf->base); }
+
 private:
-  Stack<uv_buf_t> buffer_reuse_list_;
+  Stack<RefBuffer*> buffer_reuse_list_;
 };
 
 /**
@@ -208,7 +228,8 @@ public:
    */
   SocketWriteBase(Socket* socket)
       : socket_(socket)
-      , is_flushed_(false) {
+      , is_flushed_(false)
+      , size_(0) {
     req_.data = this;
     buffers_.reserve(MIN_BUFFERS_SIZE);
   }
@@ -229,8 +250,10 @@ public:
    */
   void clear() {
     buffers_.clear();
+    frame_sizes_.clear();
     requests_.clear();
     is_flushed_ = false;
+    size_ = 0;
   }
 
   /**
@@ -255,12 +278,25 @@ protected:
   static void on_write(uv_write_t* req, int status);
   void handle_write(uv_write_t* req, int status);
 
+  /**
+   * Pack the buffered frames into segments if the socket has a segment
+   * encoder. This must be called before the buffers are written.
+   */
+  void encode_segments();
+
+  /**
+   * Notify the requests that they've been flushed.
+   */
+  void notify_flush();
+
   typedef Vector<SocketRequest*> RequestVec;
 
   Socket* socket_;
   uv_write_t req_;
   bool is_flushed_;
+  size_t size_;
   BufferVec buffers_;
+  SizeVec frame_sizes_;
   RequestVec requests_;
 };
 
@@ -298,6 +334,14 @@ public:
    */
   void set_handler(SocketHandlerBase* handler);
 
+  /**
+   * Set the segment encoder. Once set, all subsequent writes are packed into
+   * segments (native protocol v5 and higher).
+   *
+   * @param encoder The encoder. The socket takes ownership.
+   */
+  void set_segment_encoder(SegmentEncoder* encoder) { segment_encoder_.reset(encoder); }
+
   /**
    * Write a request to the socket and coalesce with outstanding requests. This
    * method doesn't flush.
@@ -320,6 +364,14 @@ public:
    */
   size_t flush();
 
+  /**
+   * Get the number of bytes written to the socket that haven't been completely
+   * written to the network (both buffered and in-flight writes).
+   *
+   * @return The number of pending bytes.
+   */
+  size_t pending_write_bytes() const { return pending_write_bytes_; }
+
   /**
    * Determine if the socket is closing.
    *
@@ -367,12 +419,14 @@ private:
 
   uv_tcp_t tcp_;
   ScopedPtr<SocketHandlerBase> handler_;
+  ScopedPtr<SegmentEncoder> segment_encoder_;
 
   SocketWriteBase::List pending_writes_;
   SocketWriteVec free_writes_;
 
   bool is_defunct_;
   size_t max_reusable_write_objects_;
+  size_t pending_write_bytes_;
 
   Address address_;
 };
@@ -44,7 +44,7 @@ public:
   SPSCQueue(size_t size)
       : size_(next_pow_2(size))
       , mask_(size_ - 1)
-      , buffer_(new T[size])
+      , buffer_(new T[size_])
       , tail_(0)
       , head_(0) {}
 
@@ -69,7 +69,15 @@ public:
     return true;
   }
 
-  bool is_empty() { return head_.load(MEMORY_ORDER_ACQUIRE) == tail_.load(MEMORY_ORDER_ACQUIRE); }
+  bool is_empty() const {
+    return head_.load(MEMORY_ORDER_ACQUIRE) == tail_.load(MEMORY_ORDER_ACQUIRE);
+  }
+
+  // The number of items in the queue. This is only an estimate when called
+  // concurrently with the producer or consumer.
+  size_t approx_size() const {
+    return (tail_.load(MEMORY_ORDER_ACQUIRE) - head_.load(MEMORY_ORDER_ACQUIRE)) & mask_;
+  }
 
   static void memory_fence() {
     // Internally, libuv has a "pending" flag check whose load can be reordered
@@ -18,9 +18,9 @@
 #define DATASTAX_INTERNAL_STREAM_MANAGER_HPP
 
 #include "constants.hpp"
-#include "dense_hash_map.hpp"
 #include "macros.hpp"
 #include "scoped_ptr.hpp"
+#include "vector.hpp"
 
 #include <assert.h>
 #include <stdint.h>
@@ -32,10 +32,13 @@
 
 namespace datastax { namespace internal { namespace core {
 
-struct StreamHash {
-  std::size_t operator()(int stream) const { return ((stream & 0x3F) << 10) | (stream >> 6); }
-};
-
+/**
+ * Allocates stream IDs and tracks the item (usually a request callback)
+ * associated with each in-flight stream. Items are stored in a flat array
+ * indexed by stream ID. Available streams are tracked using a two-level
+ * bitmap: a bit per stream and a summary bit per word of streams so that
+ * finding an available stream is fast even when most streams are in use.
+ */
 template <class T>
 class StreamManager {
 public:
@@ -43,44 +46,44 @@ public:
       : max_streams_(CASS_MAX_STREAMS)
       , num_words_(max_streams_ / NUM_BITS_PER_WORD)
       , offset_(0)
-      , words_(num_words_, ~static_cast<word_t>(0)) {
-    // Client request stream IDs are always positive values so it's
-    // safe to use negative values for the empty and deleted keys.
-    pending_.set_empty_key(-1);
-    pending_.set_deleted_key(-2);
-    pending_.max_load_factor(0.4f);
+      , pending_count_(0)
+      , words_(num_words_, ~static_cast<word_t>(0))
+      , summary_((num_words_ + NUM_BITS_PER_WORD - 1) / NUM_BITS_PER_WORD, 0)
+      , pending_(max_streams_) {
+    for (size_t i = 0; i < num_words_; ++i) {
+      set_summary(i);
+    }
   }
 
   int acquire(const T& item) {
     int stream = acquire_stream();
     if (stream < 0) return -1;
-    pending_.insert(std::pair<int, T>(stream, item));
+    pending_[stream] = item;
+    ++pending_count_;
     return stream;
   }
 
   void release(int stream) {
     assert(stream >= 0 && static_cast<size_t>(stream) < max_streams_);
-    assert(pending_.count(stream) > 0);
-    pending_.erase(stream);
+    assert(is_pending(stream));
+    pending_[stream] = T();
+    --pending_count_;
     release_stream(stream);
   }
 
   bool get(int stream, T& output) {
-    typename PendingMap::iterator i = pending_.find(stream);
-    if (i != pending_.end()) {
-      output = i->second;
-      return true;
+    if (stream < 0 || static_cast<size_t>(stream) >= max_streams_ || !is_pending(stream)) {
+      return false;
     }
-    return false;
+    output = pending_[stream];
+    return true;
   }
 
-  size_t available_streams() const { return max_streams_ - pending_.size(); }
-  size_t pending_streams() const { return pending_.size(); }
+  size_t available_streams() const { return max_streams_ - pending_count_; }
+  size_t pending_streams() const { return pending_count_; }
   size_t max_streams() const { return max_streams_; }
 
 private:
-  typedef DenseHashMap<int, T, StreamHash> PendingMap;
-
 #if defined(_MSC_VER) && defined(_M_AMD64)
   typedef __int64 word_t;
 #else
@@ -107,20 +110,21 @@ private:
 
 private:
   int acquire_stream() {
-    const size_t offset = offset_;
-    const size_t num_words = num_words_;
-
+    // Rotate the starting word so that recently released streams aren't
+    // immediately reused.
+    const size_t start = offset_ % num_words_;
     ++offset_;
 
-    for (size_t i = 0; i < num_words; ++i) {
-      size_t index = (i + offset) % num_words;
-      int bit = get_and_set_first_available_stream(index);
-      if (bit >= 0) {
-        return bit + (NUM_BITS_PER_WORD * index);
-      }
-    }
+    size_t index;
+    if (!find_available_word(start, &index)) return -1;
+
+    word_t word = words_[index];
+    int bit = count_trailing_zeros(word);
+    word ^= (static_cast<word_t>(1) << bit);
+    words_[index] = word;
+    if (word == 0) clear_summary(index);
 
-    return -1;
+    return bit + (NUM_BITS_PER_WORD * index);
   }
 
   inline void release_stream(int stream) {
@@ -128,22 +132,54 @@ private:
     int bit = stream % NUM_BITS_PER_WORD;
     assert((words_[index] & (static_cast<word_t>(1) << (bit))) == 0);
     words_[index] |= (static_cast<word_t>(1) << (bit));
+    set_summary(index);
   }
 
-  inline int get_and_set_first_available_stream(size_t index) {
-    word_t word = words_[index];
-    if (word == 0) return -1;
-    int stream = count_trailing_zeros(word);
-    words_[index] ^= (static_cast<word_t>(1) << stream);
-    return stream;
+  inline bool is_pending(int stream) const {
+    size_t index = stream / NUM_BITS_PER_WORD;
+    int bit = stream % NUM_BITS_PER_WORD;
+    return (words_[index] & (static_cast<word_t>(1) << (bit))) == 0;
+  }
+
+  // Find the first word, at or after the start word (wrapping around), that
+  // has an available stream using the summary bitmap.
+  inline bool find_available_word(size_t start, size_t* index) const {
+    const size_t num_summary_words = summary_.size();
+    size_t summary_index = start / NUM_BITS_PER_WORD;
+    word_t summary = summary_[summary_index] &
+                     (~static_cast<word_t>(0) << (start % NUM_BITS_PER_WORD));
+
+    // The starting summary word is checked twice so that the words before the
+    // start are searched after wrapping around.
+    for (size_t i = 0; i <= num_summary_words; ++i) {
+      if (summary != 0) {
+        *index = summary_index * NUM_BITS_PER_WORD + count_trailing_zeros(summary);
+        return true;
+      }
+      summary_index = (summary_index + 1) % num_summary_words;
+      summary = summary_[summary_index];
+    }
+
+    return false;
+  }
+
+  inline void set_summary(size_t index) {
+    summary_[index / NUM_BITS_PER_WORD] |= (static_cast<word_t>(1) << (index % NUM_BITS_PER_WORD));
+  }
+
+  inline void clear_summary(size_t index) {
+    summary_[index / NUM_BITS_PER_WORD] &=
+        ~(static_cast<word_t>(1) << (index % NUM_BITS_PER_WORD));
   }
 
 private:
   const size_t max_streams_;
   const size_t num_words_;
   size_t offset_;
+  size_t pending_count_;
   Vector<word_t> words_;
-  PendingMap pending_;
+  Vector<word_t> summary_;
+  Vector<T> pending_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(StreamManager);
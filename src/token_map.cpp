@@ -33,3 +33,59 @@ TokenMap::Ptr TokenMap::from_partitioner(StringRef partitioner) {
     return Ptr();
   }
 }
+
+extern "C" {
+
+void cass_token_map_free(const CassTokenMap* token_map) { token_map->dec_ref(); }
+
+const CassReplicas* cass_token_map_get_replicas(const CassTokenMap* token_map,
+                                                const char* keyspace, const char* routing_key,
+                                                size_t routing_key_length) {
+  return cass_token_map_get_replicas_n(token_map, keyspace, SAFE_STRLEN(keyspace), routing_key,
+                                       routing_key_length);
+}
+
+const CassReplicas* cass_token_map_get_replicas_n(const CassTokenMap* token_map,
+                                                  const char* keyspace, size_t keyspace_length,
+                                                  const char* routing_key,
+                                                  size_t routing_key_length) {
+  const CopyOnWriteHostVec& replicas(token_map->get_replicas(
+      String(keyspace, keyspace_length), String(routing_key, routing_key_length)));
+  // The replicas are owned by the token map so they're returned without a copy
+  return replicas ? CassReplicas::to(&*replicas) : NULL;
+}
+
+CassError cass_token_map_get_replicas_batch(const CassTokenMap* token_map, const char* keyspace,
+                                            const char* const* routing_keys,
+                                            const size_t* routing_key_lengths, size_t count,
+                                            const CassReplicas** replicas) {
+  if (count > 0 && (routing_keys == NULL || routing_key_lengths == NULL || replicas == NULL)) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+
+  const String keyspace_name(keyspace, SAFE_STRLEN(keyspace));
+  String routing_key;
+  for (size_t i = 0; i < count; ++i) {
+    routing_key.assign(routing_keys[i], routing_key_lengths[i]);
+    const CopyOnWriteHostVec& hosts(token_map->get_replicas(keyspace_name, routing_key));
+    replicas[i] = hosts ? CassReplicas::to(&*hosts) : NULL;
+  }
+  return CASS_OK;
+}
+
+size_t cass_replicas_count(const CassReplicas* replicas) { return replicas->size(); }
+
+CassError cass_replicas_get_address(const CassReplicas* replicas, size_t index, CassInet* address,
+                                    int* port) {
+  if (index >= replicas->size()) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+  const Address& host_address = (*replicas)[index]->address();
+  address->address_length = host_address.to_inet(address->address);
+  if (port != NULL) {
+    *port = host_address.port();
+  }
+  return CASS_OK;
+}
+
+} // extern "C"
@@ -17,7 +17,9 @@
 #ifndef DATASTAX_INTERNAL_TOKEN_MAP_HPP
 #define DATASTAX_INTERNAL_TOKEN_MAP_HPP
 
+#include "external.hpp"
 #include "host.hpp"
+#include "parallel_task_pool.hpp"
 #include "ref_counted.hpp"
 #include "string.hpp"
 #include "string_ref.hpp"
@@ -50,10 +52,40 @@ public:
 
   virtual TokenMap::Ptr copy() const = 0;
 
+  /**
+   * Set the threads used to build the replicas. The replicas of keyspaces
+   * with different replication strategies are built in parallel. If no pool
+   * is set then the replicas are built by the calling thread.
+   *
+   * @param pool The thread pool, it's shared by the token map's copies.
+   */
+  virtual void set_build_pool(const ParallelTaskPool::Ptr& pool) = 0;
+
+  /**
+   * Set the keyspaces that have their replicas built when the token map is
+   * built. If no keyspaces are set then the replicas of all keyspaces are
+   * built (unless lazy replicas are enabled).
+   *
+   * @param keyspace_names The names of the keyspaces.
+   */
+  virtual void set_replica_keyspaces(const StringVec& keyspace_names) = 0;
+
+  /**
+   * Enable or disable building a keyspace's replicas the first time they're
+   * used (instead of when the token map is built). This applies to the
+   * keyspaces not set using `set_replica_keyspaces()`.
+   *
+   * @param enabled
+   */
+  virtual void set_lazy_replicas(bool enabled) = 0;
+
   virtual const CopyOnWriteHostVec& get_replicas(const String& keyspace_name,
                                                  const String& routing_key) const = 0;
 };
 
 }}} // namespace datastax::internal::core
 
+EXTERNAL_TYPE(datastax::internal::core::TokenMap, CassTokenMap)
+EXTERNAL_TYPE(datastax::internal::core::HostVec, CassReplicas)
+
 #endif
@@ -90,6 +90,113 @@ static void parse_int128(const char* p, size_t n, uint64_t* h, uint64_t* l) {
 const uint32_t IdGenerator::EMPTY_KEY(0);
 const uint32_t IdGenerator::DELETED_KEY(CASS_UINT32_MAX);
 
+const size_t TokenRingChanges::NEW_TOKEN(static_cast<size_t>(-1));
+
+void TokenRingChanges::set_removed(const Vector<bool>& is_removed) {
+  removed_.resize(is_removed.size() + 1);
+  removed_[0] = 0;
+  for (size_t i = 0; i < is_removed.size(); ++i) {
+    removed_[i + 1] = removed_[i] + (is_removed[i] ? 1 : 0);
+  }
+}
+
+bool TokenRingChanges::set_inserted(const Vector<bool>& is_new) {
+  size_t old_size = this->old_size();
+  Vector<bool> is_inserted_after(old_size, false);
+  old_indices_.clear();
+  old_indices_.reserve(is_new.size());
+
+  size_t old_index = 0;
+  size_t prev_old_index = NEW_TOKEN;
+  bool has_leading_inserts = false;
+
+  for (size_t i = 0; i < is_new.size(); ++i) {
+    if (is_new[i]) {
+      old_indices_.push_back(NEW_TOKEN);
+      if (prev_old_index == NEW_TOKEN) {
+        has_leading_inserts = true;
+      } else {
+        is_inserted_after[prev_old_index] = true;
+      }
+    } else {
+      // The remaining tokens keep their relative order so the next one is
+      // the next token of the previous ring that wasn't removed.
+      while (old_index < old_size && removed_[old_index + 1] != removed_[old_index]) {
+        ++old_index;
+      }
+      if (old_index == old_size) {
+        return false;
+      }
+      old_indices_.push_back(old_index);
+      prev_old_index = old_index++;
+    }
+  }
+
+  // Every remaining token must be in the new ring
+  if (prev_old_index == NEW_TOKEN ||
+      removed_[old_size] - removed_[old_index] != old_size - old_index) {
+    return false;
+  }
+
+  // Tokens inserted before the first remaining token are between the last
+  // and first remaining tokens when wrapping around the ring.
+  if (has_leading_inserts) {
+    is_inserted_after[prev_old_index] = true;
+  }
+
+  inserted_after_.resize(old_size + 1);
+  inserted_after_[0] = 0;
+  for (size_t i = 0; i < old_size; ++i) {
+    inserted_after_[i + 1] = inserted_after_[i] + (is_inserted_after[i] ? 1 : 0);
+  }
+
+  return true;
+}
+
+size_t TokenRingChanges::count_in_range(const Vector<size_t>& counts, size_t begin,
+                                        size_t count) {
+  size_t size = counts.size() - 1;
+  size_t end = begin + count;
+  if (end <= size) {
+    return counts[end] - counts[begin];
+  }
+  return (counts[size] - counts[begin]) + counts[end - size];
+}
+
+CopyOnWriteHostVec ReplicaInterner::intern(const CopyOnWriteHostVec& replicas) {
+  if (!replicas) return replicas;
+
+  const HostVec& hosts = *replicas;
+  size_t hash = 0;
+  for (HostVec::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
+    hash ^= reinterpret_cast<size_t>(i->get()) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  if (hash == 0) hash = 1; // Zero is the empty key
+
+  size_t head = NO_NEXT;
+  IndexMap::const_iterator it = indices_.find(hash);
+  if (it != indices_.end()) {
+    head = it->second;
+    for (size_t index = head; index != NO_NEXT; index = next_[index]) {
+      const CopyOnWriteHostVec& interned = replicas_[index];
+      if (equals(*interned, hosts)) return interned;
+    }
+  }
+
+  indices_[hash] = replicas_.size();
+  replicas_.push_back(replicas);
+  next_.push_back(head);
+  return replicas;
+}
+
+bool ReplicaInterner::equals(const HostVec& a, const HostVec& b) {
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (a[i].get() != b[i].get()) return false;
+  }
+  return true;
+}
+
 Murmur3Partitioner::Token Murmur3Partitioner::from_string(const StringRef& str) {
   return parse_int64(str.data(), str.size());
 }
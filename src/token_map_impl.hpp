@@ -27,8 +27,10 @@
 #include "result_iterator.hpp"
 #include "result_response.hpp"
 #include "row.hpp"
+#include "scoped_lock.hpp"
 #include "string_ref.hpp"
 #include "token_map.hpp"
+#include "token_ring.hpp"
 #include "value.hpp"
 #include "vector.hpp"
 
@@ -184,11 +186,40 @@ struct ReplicationFactor {
   }
 };
 
-inline void build_datacenters(const HostSet& hosts, DatacenterMap& result) {
+struct HostIds {
+  HostIds()
+      : rack_id(0)
+      , dc_id(0) {}
+  HostIds(uint32_t rack_id, uint32_t dc_id)
+      : rack_id(rack_id)
+      , dc_id(dc_id) {}
+  uint32_t rack_id;
+  uint32_t dc_id;
+};
+
+// The rack and datacenter identifiers of each host. They're kept by each
+// token map, instead of the shared host objects, because token maps are built
+// on other threads using their own identifier generators.
+class HostIdMap : public DenseHashMap<Address, HostIds> {
+public:
+  HostIdMap() {
+    set_empty_key(Address::EMPTY_KEY);
+    set_deleted_key(Address::DELETED_KEY);
+  }
+
+  HostIds get(const Host* host) const {
+    const_iterator i = find(host->address());
+    return i != end() ? i->second : HostIds();
+  }
+};
+
+inline void build_datacenters(const HostSet& hosts, const HostIdMap& host_ids,
+                              DatacenterMap& result) {
   result.clear();
   for (HostSet::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
-    uint32_t dc = (*i)->dc_id();
-    uint32_t rack = (*i)->rack_id();
+    HostIds ids(host_ids.get(i->get()));
+    uint32_t dc = ids.dc_id;
+    uint32_t rack = ids.rack_id;
     if (dc != 0 && rack != 0) {
       Datacenter& datacenter = result[dc];
       datacenter.racks.insert(rack);
@@ -202,6 +233,101 @@ public:
   ReplicationFactorMap() { set_empty_key(IdGenerator::EMPTY_KEY); }
 };
 
+/**
+ * The changes made to a sorted token ring when a single host's tokens are
+ * removed and/or inserted. It's used to determine which tokens' replicas can
+ * be reused from the previous ring instead of being recomputed.
+ */
+class TokenRingChanges {
+public:
+  static const size_t NEW_TOKEN;
+
+  /**
+   * Set the tokens removed from the previous ring.
+   *
+   * @param is_removed For each token of the previous ring, true if it was
+   * removed.
+   */
+  void set_removed(const Vector<bool>& is_removed);
+
+  /**
+   * Set the tokens inserted into the new ring. This must be called after
+   * set_removed().
+   *
+   * @param is_new For each token of the new ring, true if it was inserted.
+   * @return false if none of the previous ring's tokens remain.
+   */
+  bool set_inserted(const Vector<bool>& is_new);
+
+  size_t old_size() const { return removed_.empty() ? 0 : removed_.size() - 1; }
+
+  /**
+   * Get the index of a token in the previous ring.
+   *
+   * @param index The index of the token in the new ring.
+   * @return The index of the token in the previous ring or NEW_TOKEN if it
+   * was inserted.
+   */
+  size_t old_index(size_t index) const { return old_indices_[index]; }
+
+  /**
+   * Determine if a range of the previous ring is unchanged in the new ring,
+   * that is, none of its tokens were removed and no tokens were inserted
+   * between them. The range wraps around the end of the ring.
+   *
+   * @param old_index The index of the first token of the range in the
+   * previous ring.
+   * @param count The number of tokens in the range (from 1 to old_size()).
+   * @return true if the range is unchanged.
+   */
+  bool is_unchanged(size_t old_index, size_t count) const {
+    return count_in_range(removed_, old_index, count) == 0 &&
+           count_in_range(inserted_after_, old_index, count - 1) == 0;
+  }
+
+private:
+  static size_t count_in_range(const Vector<size_t>& counts, size_t begin, size_t count);
+
+private:
+  Vector<size_t> old_indices_;
+  // Prefix counts over the previous ring's tokens: the number of tokens
+  // before a given index that were removed and the number that were followed
+  // by inserted tokens.
+  Vector<size_t> removed_;
+  Vector<size_t> inserted_after_;
+};
+
+/**
+ * Interns replica host vectors so that tokens with the same replicas, in the
+ * same order, share a single vector.
+ */
+class ReplicaInterner {
+public:
+  ReplicaInterner() { indices_.set_empty_key(0); }
+
+  /**
+   * Intern replicas.
+   *
+   * @param replicas The replicas to intern.
+   * @return Previously interned replicas that are equal to the provided
+   * replicas or the provided replicas if there aren't any.
+   */
+  CopyOnWriteHostVec intern(const CopyOnWriteHostVec& replicas);
+
+private:
+  typedef DenseHashMap<size_t, size_t> IndexMap;
+
+  static bool equals(const HostVec& a, const HostVec& b);
+
+  // Interned replicas are indexed by the hash of their hosts. Replicas whose
+  // hashes collide are chained using the index of the next replicas with the
+  // same hash (or `NO_NEXT` for the last).
+  static const size_t NO_NEXT = static_cast<size_t>(-1);
+  IndexMap indices_;
+  Vector<CopyOnWriteHostVec> replicas_;
+  Vector<size_t> next_;
+};
+
 template <class Partitioner>
 class ReplicationStrategy {
 public:
@@ -215,6 +341,10 @@ public:
 
   typedef Deque<typename TokenHostVec::const_iterator> TokenHostQueue;
 
+  // Spans larger than the maximum are saturated and always recomputed
+  typedef Vector<uint16_t> TokenSpanVec;
+  enum { MAX_TOKEN_SPAN = 0xFFFF };
+
   struct DatacenterRackInfo {
     DatacenterRackInfo()
         : replica_count(0)
@@ -241,20 +371,76 @@ public:
 
   void init(IdGenerator& dc_ids, const VersionNumber& cassandra_version, const Row* row);
 
+  bool operator==(const ReplicationStrategy& other) const { return !(*this != other); }
+
   bool operator!=(const ReplicationStrategy& other) const {
     return type_ != other.type_ || replication_factors_ != other.replication_factors_;
   }
 
-  void build_replicas(const TokenHostVec& tokens, const DatacenterMap& datacenters,
-                      TokenReplicasVec& result) const;
+  /**
+   * Build the replicas for every token.
+   *
+   * @param tokens The sorted tokens of the ring.
+   * @param host_ids The rack and datacenter identifiers of the ring's hosts.
+   * @param datacenters The datacenters of the ring's hosts.
+   * @param result The replicas of each token.
+   * @param spans If not NULL, the number of consecutive tokens that were
+   * visited to find each token's replicas. It's used to incrementally update
+   * the replicas using update_replicas().
+   * @param interner If not NULL, used to share equal replicas.
+   */
+  void build_replicas(const TokenHostVec& tokens, const HostIdMap& host_ids,
+                      const DatacenterMap& datacenters, TokenReplicasVec& result,
+                      TokenSpanVec* spans = NULL, ReplicaInterner* interner = NULL) const;
+
+  /**
+   * Update the replicas after a single host's tokens were removed and/or
+   * inserted. Only the tokens whose range of visited tokens changed are
+   * recomputed, the replicas of the other tokens are reused. The result is the
+   * same as build_replicas().
+   *
+   * @param tokens The sorted tokens of the new ring.
+   * @param host_ids The rack and datacenter identifiers of the new ring's hosts.
+   * @param datacenters The datacenters of the new ring's hosts.
+   * @param old_datacenters The datacenters used to build the previous replicas.
+   * @param changes The changes between the previous and new rings.
+   * @param old_replicas The replicas of the previous ring.
+   * @param old_spans The spans of the previous ring.
+   * @param result The replicas of each token.
+   * @param spans The spans of each token.
+   * @param interner If not NULL, used to share equal replicas.
+   * @return The number of tokens whose replicas were recomputed.
+   */
+  size_t update_replicas(const TokenHostVec& tokens, const HostIdMap& host_ids,
+                         const DatacenterMap& datacenters, const DatacenterMap& old_datacenters,
+                         const TokenRingChanges& changes, const TokenReplicasVec& old_replicas,
+                         const TokenSpanVec& old_spans, TokenReplicasVec& result,
+                         TokenSpanVec* spans, ReplicaInterner* interner = NULL) const;
 
 private:
-  void build_replicas_network_topology(const TokenHostVec& tokens, const DatacenterMap& datacenters,
-                                       TokenReplicasVec& result) const;
-  void build_replicas_simple(const TokenHostVec& tokens, const DatacenterMap& datacenters,
-                             TokenReplicasVec& result) const;
-  void build_replicas_non_replicated(const TokenHostVec& tokens, const DatacenterMap& datacenters,
-                                     TokenReplicasVec& result) const;
+  struct BuildContext {
+    BuildContext()
+        : num_replicas(0) {}
+    bool operator==(const BuildContext& other) const;
+    size_t num_replicas;
+    DatacenterRackInfoMap dc_racks;
+    Vector<HostIds> token_host_ids; // Indexed by token, only used by network topology
+  };
+
+  bool init_context(size_t num_tokens, const DatacenterMap& datacenters, bool log_warnings,
+                    BuildContext* context) const;
+  void init_token_host_ids(const TokenHostVec& tokens, const HostIdMap& host_ids,
+                           BuildContext* context) const;
+  void build_all_replicas(const TokenHostVec& tokens, BuildContext* context,
+                          TokenReplicasVec& result, TokenSpanVec* spans,
+                          ReplicaInterner* interner) const;
+  CopyOnWriteHostVec build_token_replicas(const TokenHostVec& tokens, size_t index,
+                                          BuildContext* context, size_t* span) const;
+  CopyOnWriteHostVec build_token_replicas_network_topology(const TokenHostVec& tokens,
+                                                           size_t index, BuildContext* context,
+                                                           size_t* span) const;
+  CopyOnWriteHostVec build_token_replicas_simple(const TokenHostVec& tokens, size_t index,
+                                                 const BuildContext& context, size_t* span) const;
 
 private:
   Type type_;
@@ -337,172 +523,289 @@ void ReplicationStrategy<Partitioner>::init(IdGenerator& dc_ids,
 
 template <class Partitioner>
 void ReplicationStrategy<Partitioner>::build_replicas(const TokenHostVec& tokens,
+                                                      const HostIdMap& host_ids,
                                                       const DatacenterMap& datacenters,
-                                                      TokenReplicasVec& result) const {
+                                                      TokenReplicasVec& result,
+                                                      TokenSpanVec* spans,
+                                                      ReplicaInterner* interner) const {
   result.clear();
   result.reserve(tokens.size());
+  if (spans) {
+    spans->clear();
+    spans->reserve(tokens.size());
+  }
 
-  switch (type_) {
-    case NETWORK_TOPOLOGY_STRATEGY:
-      build_replicas_network_topology(tokens, datacenters, result);
-      break;
-    case SIMPLE_STRATEGY:
-      build_replicas_simple(tokens, datacenters, result);
-      break;
-    default:
-      build_replicas_non_replicated(tokens, datacenters, result);
-      break;
+  BuildContext context;
+  if (init_context(tokens.size(), datacenters, true, &context)) {
+    init_token_host_ids(tokens, host_ids, &context);
+    build_all_replicas(tokens, &context, result, spans, interner);
   }
 }
 
 template <class Partitioner>
-void ReplicationStrategy<Partitioner>::build_replicas_network_topology(
-    const TokenHostVec& tokens, const DatacenterMap& datacenters, TokenReplicasVec& result) const {
-  if (replication_factors_.empty()) {
-    return;
+size_t ReplicationStrategy<Partitioner>::update_replicas(
+    const TokenHostVec& tokens, const HostIdMap& host_ids, const DatacenterMap& datacenters,
+    const DatacenterMap& old_datacenters, const TokenRingChanges& changes,
+    const TokenReplicasVec& old_replicas, const TokenSpanVec& old_spans, TokenReplicasVec& result,
+    TokenSpanVec* spans, ReplicaInterner* interner) const {
+  result.clear();
+  result.reserve(tokens.size());
+  spans->clear();
+  spans->reserve(tokens.size());
+
+  BuildContext context;
+  if (!init_context(tokens.size(), datacenters, true, &context)) {
+    return 0;
+  }
+  init_token_host_ids(tokens, host_ids, &context);
+
+  // The previous replicas can only be reused if they were built using the
+  // same number of replicas per datacenter and the same number of racks.
+  size_t old_size = changes.old_size();
+  BuildContext old_context;
+  if (old_replicas.size() != old_size || old_spans.size() != old_size ||
+      !init_context(old_size, old_datacenters, false, &old_context) || !(context == old_context)) {
+    build_all_replicas(tokens, &context, result, spans, interner);
+    return tokens.size();
   }
 
-  DatacenterRackInfoMap dc_racks;
-  dc_racks.resize(datacenters.size());
+  size_t num_rebuilt = 0;
+  for (size_t i = 0, size = tokens.size(); i < size; ++i) {
+    // A token's replicas only depend on the hosts of the tokens visited to
+    // find them. If that range of tokens is unchanged then so are the
+    // replicas.
+    size_t old_index = changes.old_index(i);
+    if (old_index != TokenRingChanges::NEW_TOKEN) {
+      size_t span = old_spans[old_index];
+      if (span < MAX_TOKEN_SPAN && span < old_size && changes.is_unchanged(old_index, span)) {
+        const CopyOnWriteHostVec& replicas = old_replicas[old_index].second;
+        result.push_back(TokenReplicas(tokens[i].first, interner ? interner->intern(replicas)
+                                                                 : replicas));
+        spans->push_back(old_spans[old_index]);
+        continue;
+      }
+    }
 
-  size_t num_replicas = 0;
+    size_t span = 0;
+    CopyOnWriteHostVec replicas(build_token_replicas(tokens, i, &context, &span));
+    result.push_back(TokenReplicas(tokens[i].first, interner ? interner->intern(replicas)
+                                                             : replicas));
+    spans->push_back(static_cast<uint16_t>(std::min<size_t>(span, MAX_TOKEN_SPAN)));
+    ++num_rebuilt;
+  }
 
-  // Populate the datacenter and rack information. Only considering valid
-  // datacenters that actually have hosts. If there's a replication factor
-  // for a datacenter that doesn't exist or has no node then it will not
-  // be counted.
-  for (ReplicationFactorMap::const_iterator i = replication_factors_.begin(),
-                                            end = replication_factors_.end();
+  return num_rebuilt;
+}
+
+template <class Partitioner>
+bool ReplicationStrategy<Partitioner>::BuildContext::operator==(const BuildContext& other) const {
+  if (num_replicas != other.num_replicas || dc_racks.size() != other.dc_racks.size()) {
+    return false;
+  }
+  for (typename DatacenterRackInfoMap::const_iterator i = dc_racks.begin(), end = dc_racks.end();
        i != end; ++i) {
-    DatacenterMap::const_iterator j = datacenters.find(i->first);
-    // Don't include datacenters that don't exist
-    if (j != datacenters.end()) {
-      // A replication factor cannot exceed the number of nodes in a datacenter
-      size_t replication_factor = std::min<size_t>(i->second.count, j->second.num_nodes);
-      num_replicas += replication_factor;
-      DatacenterRackInfo dc_rack_info;
-      dc_rack_info.replication_factor = replication_factor;
-      dc_rack_info.rack_count = j->second.racks.size();
-      dc_racks[j->first] = dc_rack_info;
-    } else {
-      LOG_WARN("No nodes in datacenter '%s'. Check your replication strategies.",
-               i->second.name.c_str());
+    typename DatacenterRackInfoMap::const_iterator j = other.dc_racks.find(i->first);
+    if (j == other.dc_racks.end() ||
+        i->second.replication_factor != j->second.replication_factor ||
+        i->second.rack_count != j->second.rack_count) {
+      return false;
     }
   }
+  return true;
+}
+
+template <class Partitioner>
+bool ReplicationStrategy<Partitioner>::init_context(size_t num_tokens,
+                                                    const DatacenterMap& datacenters,
+                                                    bool log_warnings,
+                                                    BuildContext* context) const {
+  switch (type_) {
+    case NETWORK_TOPOLOGY_STRATEGY: {
+      if (replication_factors_.empty()) {
+        return false;
+      }
 
-  if (num_replicas == 0) {
-    return;
+      context->dc_racks.resize(datacenters.size());
+
+      // Populate the datacenter and rack information. Only considering valid
+      // datacenters that actually have hosts. If there's a replication factor
+      // for a datacenter that doesn't exist or has no node then it will not
+      // be counted.
+      for (ReplicationFactorMap::const_iterator i = replication_factors_.begin(),
+                                                end = replication_factors_.end();
+           i != end; ++i) {
+        DatacenterMap::const_iterator j = datacenters.find(i->first);
+        // Don't include datacenters that don't exist
+        if (j != datacenters.end()) {
+          // A replication factor cannot exceed the number of nodes in a datacenter
+          size_t replication_factor = std::min<size_t>(i->second.count, j->second.num_nodes);
+          context->num_replicas += replication_factor;
+          DatacenterRackInfo dc_rack_info;
+          dc_rack_info.replication_factor = replication_factor;
+          dc_rack_info.rack_count = j->second.racks.size();
+          context->dc_racks[j->first] = dc_rack_info;
+        } else if (log_warnings) {
+          LOG_WARN("No nodes in datacenter '%s'. Check your replication strategies.",
+                   i->second.name.c_str());
+        }
+      }
+
+      return context->num_replicas > 0;
+    }
+    case SIMPLE_STRATEGY: {
+      ReplicationFactorMap::const_iterator it = replication_factors_.find(1);
+      if (it == replication_factors_.end()) {
+        return false;
+      }
+      context->num_replicas = std::min<size_t>(it->second.count, num_tokens);
+      return context->num_replicas > 0;
+    }
+    default:
+      context->num_replicas = 1;
+      return true;
   }
+}
 
+template <class Partitioner>
+void ReplicationStrategy<Partitioner>::init_token_host_ids(const TokenHostVec& tokens,
+                                                           const HostIdMap& host_ids,
+                                                           BuildContext* context) const {
+  // Looked up once per token instead of for every token visited
+  if (type_ != NETWORK_TOPOLOGY_STRATEGY) return;
+  context->token_host_ids.reserve(tokens.size());
   for (typename TokenHostVec::const_iterator i = tokens.begin(), end = tokens.end(); i != end;
        ++i) {
-    Token token = i->first;
-    typename TokenHostVec::const_iterator token_it = i;
-
-    CopyOnWriteHostVec replicas(new HostVec());
-    replicas->reserve(num_replicas);
-
-    // Clear datacenter and rack information for the next token
-    for (typename DatacenterRackInfoMap::iterator j = dc_racks.begin(), end = dc_racks.end();
-         j != end; ++j) {
-      j->second.replica_count = 0;
-      j->second.racks_observed.clear();
-      j->second.skipped_endpoints.clear();
-    }
-
-    for (typename TokenHostVec::const_iterator j = tokens.begin(), end = tokens.end();
-         j != end && replicas->size() < num_replicas; ++j) {
-      typename TokenHostVec::const_iterator curr_token_it = token_it;
-      Host* host = curr_token_it->second;
-      uint32_t dc = host->dc_id();
-      uint32_t rack = host->rack_id();
-
-      ++token_it;
-      if (token_it == tokens.end()) {
-        token_it = tokens.begin();
-      }
+    context->token_host_ids.push_back(host_ids.get(i->second));
+  }
+}
 
-      typename DatacenterRackInfoMap::iterator dc_rack_it = dc_racks.find(dc);
-      if (dc_rack_it == dc_racks.end()) {
-        continue;
-      }
+template <class Partitioner>
+void ReplicationStrategy<Partitioner>::build_all_replicas(const TokenHostVec& tokens,
+                                                          BuildContext* context,
+                                                          TokenReplicasVec& result,
+                                                          TokenSpanVec* spans,
+                                                          ReplicaInterner* interner) const {
+  for (size_t i = 0, size = tokens.size(); i < size; ++i) {
+    size_t span = 0;
+    CopyOnWriteHostVec replicas(build_token_replicas(tokens, i, context, &span));
+    result.push_back(TokenReplicas(tokens[i].first, interner ? interner->intern(replicas)
+                                                             : replicas));
+    if (spans) {
+      spans->push_back(static_cast<uint16_t>(std::min<size_t>(span, MAX_TOKEN_SPAN)));
+    }
+  }
+}
 
-      DatacenterRackInfo& dc_rack_info = dc_rack_it->second;
+template <class Partitioner>
+CopyOnWriteHostVec ReplicationStrategy<Partitioner>::build_token_replicas(
+    const TokenHostVec& tokens, size_t index, BuildContext* context, size_t* span) const {
+  switch (type_) {
+    case NETWORK_TOPOLOGY_STRATEGY:
+      return build_token_replicas_network_topology(tokens, index, context, span);
+    case SIMPLE_STRATEGY:
+      return build_token_replicas_simple(tokens, index, *context, span);
+    default:
+      *span = 1;
+      return CopyOnWriteHostVec(new HostVec(1, Host::Ptr(tokens[index].second)));
+  }
+}
 
-      size_t& replica_count_this_dc = dc_rack_info.replica_count;
-      const size_t replication_factor = dc_rack_info.replication_factor;
+template <class Partitioner>
+CopyOnWriteHostVec ReplicationStrategy<Partitioner>::build_token_replicas_network_topology(
+    const TokenHostVec& tokens, size_t index, BuildContext* context, size_t* span) const {
+  const size_t num_replicas = context->num_replicas;
+  DatacenterRackInfoMap& dc_racks = context->dc_racks;
+  typename TokenHostVec::const_iterator token_it = tokens.begin() + index;
+
+  CopyOnWriteHostVec replicas(new HostVec());
+  replicas->reserve(num_replicas);
+
+  // Clear datacenter and rack information for the next token
+  for (typename DatacenterRackInfoMap::iterator j = dc_racks.begin(), end = dc_racks.end();
+       j != end; ++j) {
+    j->second.replica_count = 0;
+    j->second.racks_observed.clear();
+    j->second.skipped_endpoints.clear();
+  }
 
-      if (replica_count_this_dc >= replication_factor) {
-        continue;
-      }
+  *span = 0;
+  for (typename TokenHostVec::const_iterator j = tokens.begin(), end = tokens.end();
+       j != end && replicas->size() < num_replicas; ++j) {
+    typename TokenHostVec::const_iterator curr_token_it = token_it;
+    Host* host = curr_token_it->second;
+    const HostIds& ids = context->token_host_ids[curr_token_it - tokens.begin()];
+    uint32_t dc = ids.dc_id;
+    uint32_t rack = ids.rack_id;
+
+    ++*span;
+    ++token_it;
+    if (token_it == tokens.end()) {
+      token_it = tokens.begin();
+    }
+
+    typename DatacenterRackInfoMap::iterator dc_rack_it = dc_racks.find(dc);
+    if (dc_rack_it == dc_racks.end()) {
+      continue;
+    }
+
+    DatacenterRackInfo& dc_rack_info = dc_rack_it->second;
+
+    size_t& replica_count_this_dc = dc_rack_info.replica_count;
+    const size_t replication_factor = dc_rack_info.replication_factor;
+
+    if (replica_count_this_dc >= replication_factor) {
+      continue;
+    }
 
-      RackSet& racks_observed_this_dc = dc_rack_info.racks_observed;
-      const size_t rack_count_this_dc = dc_rack_info.rack_count;
+    RackSet& racks_observed_this_dc = dc_rack_info.racks_observed;
+    const size_t rack_count_this_dc = dc_rack_info.rack_count;
 
-      // First, attempt to distribute replicas over all possible racks in a
-      // datacenter only then consider hosts in the same rack
+    // First, attempt to distribute replicas over all possible racks in a
+    // datacenter only then consider hosts in the same rack
 
-      if (rack == 0 || racks_observed_this_dc.size() == rack_count_this_dc) {
+    if (rack == 0 || racks_observed_this_dc.size() == rack_count_this_dc) {
+      ++replica_count_this_dc;
+      replicas->push_back(Host::Ptr(host));
+    } else {
+      TokenHostQueue& skipped_endpoints_this_dc = dc_rack_info.skipped_endpoints;
+      if (racks_observed_this_dc.count(rack) > 0) {
+        skipped_endpoints_this_dc.push_back(curr_token_it);
+      } else {
         ++replica_count_this_dc;
         replicas->push_back(Host::Ptr(host));
-      } else {
-        TokenHostQueue& skipped_endpoints_this_dc = dc_rack_info.skipped_endpoints;
-        if (racks_observed_this_dc.count(rack) > 0) {
-          skipped_endpoints_this_dc.push_back(curr_token_it);
-        } else {
-          ++replica_count_this_dc;
-          replicas->push_back(Host::Ptr(host));
-          racks_observed_this_dc.insert(rack);
-
-          // Once we visited every rack in the current datacenter then starting considering
-          // hosts we've already skipped.
-          if (racks_observed_this_dc.size() == rack_count_this_dc) {
-            while (!skipped_endpoints_this_dc.empty() &&
-                   replica_count_this_dc < replication_factor) {
-              ++replica_count_this_dc;
-              replicas->push_back(Host::Ptr(skipped_endpoints_this_dc.front()->second));
-              skipped_endpoints_this_dc.pop_front();
-            }
+        racks_observed_this_dc.insert(rack);
+
+        // Once we visited every rack in the current datacenter then starting considering
+        // hosts we've already skipped.
+        if (racks_observed_this_dc.size() == rack_count_this_dc) {
+          while (!skipped_endpoints_this_dc.empty() &&
+                 replica_count_this_dc < replication_factor) {
+            ++replica_count_this_dc;
+            replicas->push_back(Host::Ptr(skipped_endpoints_this_dc.front()->second));
+            skipped_endpoints_this_dc.pop_front();
           }
         }
       }
     }
-
-    result.push_back(TokenReplicas(token, replicas));
   }
-}
 
-template <class Partitioner>
-void ReplicationStrategy<Partitioner>::build_replicas_simple(const TokenHostVec& tokens,
-                                                             const DatacenterMap& not_used,
-                                                             TokenReplicasVec& result) const {
-  ReplicationFactorMap::const_iterator it = replication_factors_.find(1);
-  if (it == replication_factors_.end()) {
-    return;
-  }
-  size_t num_replicas = std::min<size_t>(it->second.count, tokens.size());
-  for (typename TokenHostVec::const_iterator i = tokens.begin(), end = tokens.end(); i != end;
-       ++i) {
-    CopyOnWriteHostVec replicas(new HostVec());
-    typename TokenHostVec::const_iterator token_it = i;
-    do {
-      replicas->push_back(Host::Ptr(token_it->second));
-      ++token_it;
-      if (token_it == tokens.end()) {
-        token_it = tokens.begin();
-      }
-    } while (replicas->size() < num_replicas);
-    result.push_back(TokenReplicas(i->first, replicas));
-  }
+  return replicas;
 }
 
 template <class Partitioner>
-void ReplicationStrategy<Partitioner>::build_replicas_non_replicated(
-    const TokenHostVec& tokens, const DatacenterMap& not_used, TokenReplicasVec& result) const {
-  for (typename TokenHostVec::const_iterator i = tokens.begin(); i != tokens.end(); ++i) {
-    CopyOnWriteHostVec replicas(new HostVec(1, Host::Ptr(i->second)));
-    result.push_back(TokenReplicas(i->first, replicas));
-  }
+CopyOnWriteHostVec ReplicationStrategy<Partitioner>::build_token_replicas_simple(
+    const TokenHostVec& tokens, size_t index, const BuildContext& context, size_t* span) const {
+  CopyOnWriteHostVec replicas(new HostVec());
+  typename TokenHostVec::const_iterator token_it = tokens.begin() + index;
+  do {
+    replicas->push_back(Host::Ptr(token_it->second));
+    ++token_it;
+    if (token_it == tokens.end()) {
+      token_it = tokens.begin();
+    }
+  } while (replicas->size() < context.num_replicas);
+  *span = context.num_replicas;
+  return replicas;
 }
 
 template <class Partitioner>
@@ -535,20 +838,98 @@ public:
 
   typedef std::pair<Token, CopyOnWriteHostVec> TokenReplicas;
   typedef Vector<TokenReplicas> TokenReplicasVec;
+  typedef TokenRing<Token, CopyOnWriteHostVec> TokenReplicasRing;
+  typedef typename ReplicationStrategy<Partitioner>::TokenSpanVec TokenSpanVec;
 
-  struct TokenReplicasCompare {
-    bool operator()(const TokenReplicas& lhs, const TokenReplicas& rhs) const {
-      return lhs.first < rhs.first;
-    }
+  // The replicas of a replication strategy. They're shared by all the
+  // keyspaces that use the same replication strategy.
+  struct StrategyReplicas : public RefCounted<StrategyReplicas> {
+    typedef SharedRefPtr<StrategyReplicas> Ptr;
+    typedef SharedRefPtr<const StrategyReplicas> ConstPtr;
+
+    TokenReplicasRing ring;
+    TokenSpanVec spans; // Used to incrementally update the replicas
   };
 
-  typedef DenseHashMap<String, TokenReplicasVec> KeyspaceReplicaMap;
+  typedef DenseHashMap<String, typename StrategyReplicas::ConstPtr> KeyspaceReplicaMap;
   typedef DenseHashMap<String, ReplicationStrategy<Partitioner> > KeyspaceStrategyMap;
 
+  // Builds or updates the replicas of a replication strategy. These tasks are
+  // independent and are run in parallel.
+  class StrategyReplicasTask : public ParallelTask {
+  public:
+    StrategyReplicasTask(const TokenMapImpl* token_map,
+                         const ReplicationStrategy<Partitioner>* strategy,
+                         const TokenRingChanges* changes, const DatacenterMap* old_datacenters,
+                         const typename StrategyReplicas::ConstPtr& old_replicas)
+        : token_map_(token_map)
+        , strategy_(strategy)
+        , changes_(changes)
+        , old_datacenters_(old_datacenters)
+        , old_replicas_(old_replicas)
+        , num_rebuilt_(0) {}
+
+    virtual void run();
+
+    const ReplicationStrategy<Partitioner>* strategy() const { return strategy_; }
+    const typename StrategyReplicas::ConstPtr& replicas() const { return replicas_; }
+    size_t num_rebuilt() const { return num_rebuilt_; }
+
+  private:
+    const TokenMapImpl* token_map_;
+    const ReplicationStrategy<Partitioner>* strategy_;
+    const TokenRingChanges* changes_;
+    const DatacenterMap* old_datacenters_;
+    typename StrategyReplicas::ConstPtr old_replicas_;
+    typename StrategyReplicas::ConstPtr replicas_;
+    size_t num_rebuilt_;
+  };
+
+  // The replicas of a replication strategy that are built the first time
+  // they're used. They're shared by all the keyspaces that use the same
+  // replication strategy and only belong to a single token map because
+  // they're built using that token map's tokens.
+  struct LazyReplicas : public RefCounted<LazyReplicas> {
+    typedef SharedRefPtr<LazyReplicas> Ptr;
+
+    LazyReplicas(const ReplicationStrategy<Partitioner>& strategy)
+        : strategy(strategy)
+        , replicas(NULL) {
+      uv_mutex_init(&mutex);
+    }
+
+    ~LazyReplicas() {
+      const StrategyReplicas* built = replicas.load();
+      if (built) built->dec_ref();
+      uv_mutex_destroy(&mutex);
+    }
+
+    // Returns the replicas, building them if they haven't been built yet
+    const StrategyReplicas* get(const TokenMapImpl* token_map);
+
+    // Returns the replicas if they've been built, otherwise null
+    const StrategyReplicas* get_if_built() const {
+      return replicas.load(MEMORY_ORDER_ACQUIRE);
+    }
+
+    const ReplicationStrategy<Partitioner> strategy;
+    uv_mutex_t mutex;
+    Atomic<const StrategyReplicas*> replicas;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(LazyReplicas);
+  };
+
+  typedef DenseHashMap<String, typename LazyReplicas::Ptr> KeyspaceLazyReplicaMap;
+
   TokenMapImpl()
-      : no_replicas_dummy_(NULL) {
+      : is_lazy_replicas_(false)
+      , num_rebuilt_(0)
+      , no_replicas_dummy_(NULL) {
     replicas_.set_empty_key(String());
     replicas_.set_deleted_key(String(1, '\0'));
+    lazy_replicas_.set_empty_key(String());
+    lazy_replicas_.set_deleted_key(String(1, '\0'));
     strategies_.set_empty_key(String());
     strategies_.set_deleted_key(String(1, '\0'));
   }
@@ -556,11 +937,31 @@ public:
   TokenMapImpl(const TokenMapImpl& other)
       : tokens_(other.tokens_)
       , hosts_(other.hosts_)
+      , host_ids_(other.host_ids_)
+      , datacenters_(other.datacenters_)
       , replicas_(other.replicas_)
       , strategies_(other.strategies_)
       , rack_ids_(other.rack_ids_)
       , dc_ids_(other.dc_ids_)
-      , no_replicas_dummy_(NULL) {}
+      , build_pool_(other.build_pool_)
+      , replica_keyspaces_(other.replica_keyspaces_)
+      , is_lazy_replicas_(other.is_lazy_replicas_)
+      , num_rebuilt_(0)
+      , no_replicas_dummy_(NULL) {
+    lazy_replicas_.set_empty_key(String());
+    lazy_replicas_.set_deleted_key(String(1, '\0'));
+    // Replicas that were built because they were used are kept up to date
+    // by this token map
+    for (typename KeyspaceLazyReplicaMap::const_iterator i = other.lazy_replicas_.begin(),
+                                                        end = other.lazy_replicas_.end();
+         i != end; ++i) {
+      const StrategyReplicas* built = i->second->get_if_built();
+      if (built) {
+        replicas_[i->first] = typename StrategyReplicas::ConstPtr(built);
+      }
+    }
+    reset_lazy_replicas();
+  }
 
   virtual void add_host(const Host::Ptr& host);
   virtual void update_host_and_build(const Host::Ptr& host);
@@ -575,6 +976,15 @@ public:
 
   virtual TokenMap::Ptr copy() const;
 
+  virtual void set_build_pool(const ParallelTaskPool::Ptr& pool) { build_pool_ = pool; }
+
+  virtual void set_replica_keyspaces(const StringVec& keyspace_names) {
+    replica_keyspaces_ = keyspace_names;
+    std::sort(replica_keyspaces_.begin(), replica_keyspaces_.end());
+  }
+
+  virtual void set_lazy_replicas(bool enabled) { is_lazy_replicas_ = enabled; }
+
   virtual const CopyOnWriteHostVec& get_replicas(const String& keyspace_name,
                                                  const String& routing_key) const;
 
@@ -587,21 +997,63 @@ public:
     return false;
   }
 
+  // Test only
+  void get_all_replicas(const String& keyspace_name, TokenReplicasVec* result) const {
+    result->clear();
+    typename KeyspaceReplicaMap::const_iterator i = replicas_.find(keyspace_name);
+    if (i != replicas_.end()) {
+      i->second->ring.get_entries(result);
+    }
+  }
+
+  // Test only. The number of token replicas, summed over the distinct
+  // replication strategies, that were recomputed by the last build or host
+  // update.
+  size_t num_rebuilt() const { return num_rebuilt_; }
+
+  // Test only
+  bool is_replicas_built(const String& keyspace_name) const {
+    if (replicas_.find(keyspace_name) != replicas_.end()) return true;
+    typename KeyspaceLazyReplicaMap::const_iterator i = lazy_replicas_.find(keyspace_name);
+    return i != lazy_replicas_.end() && i->second->get_if_built() != NULL;
+  }
+
+  // Test only
+  bool is_sharing_replicas(const String& keyspace_name1, const String& keyspace_name2) const {
+    typename KeyspaceReplicaMap::const_iterator i = replicas_.find(keyspace_name1);
+    typename KeyspaceReplicaMap::const_iterator j = replicas_.find(keyspace_name2);
+    return i != replicas_.end() && j != replicas_.end() && i->second.get() == j->second.get();
+  }
+
 private:
   void update_keyspace(const VersionNumber& cassandra_version, const ResultResponse* result,
                        bool should_build_replicas);
   void remove_host_tokens(const Host::Ptr& host);
   void update_host_ids(const Host::Ptr& host);
-  void build_replicas();
+  size_t build_replicas(const TokenRingChanges* changes = NULL,
+                        const DatacenterMap* old_datacenters = NULL);
+  typename StrategyReplicas::ConstPtr
+  find_replicas(const ReplicationStrategy<Partitioner>& strategy,
+                const String& excluded_keyspace_name) const;
+  void mark_removed_tokens(const Host::Ptr& host, TokenRingChanges* changes) const;
+  bool mark_inserted_tokens(const Host::Ptr& host, TokenRingChanges* changes) const;
+  bool is_replicas_needed(const String& keyspace_name) const;
+  void reset_lazy_replicas();
 
 private:
   TokenHostVec tokens_;
   HostSet hosts_;
+  HostIdMap host_ids_;
   DatacenterMap datacenters_;
   KeyspaceReplicaMap replicas_;
+  KeyspaceLazyReplicaMap lazy_replicas_;
   KeyspaceStrategyMap strategies_;
   IdGenerator rack_ids_;
   IdGenerator dc_ids_;
+  ParallelTaskPool::Ptr build_pool_;
+  StringVec replica_keyspaces_;
+  bool is_lazy_replicas_;
+  size_t num_rebuilt_;
   CopyOnWriteHostVec no_replicas_dummy_;
 };
 
@@ -620,9 +1072,14 @@ void TokenMapImpl<Partitioner>::add_host(const Host::Ptr& host) {
 template <class Partitioner>
 void TokenMapImpl<Partitioner>::update_host_and_build(const Host::Ptr& host) {
   uint64_t start = uv_hrtime();
+  DatacenterMap old_datacenters(datacenters_);
+  TokenRingChanges changes;
+  mark_removed_tokens(host, &changes);
   remove_host_tokens(host);
 
   update_host_ids(host);
+  // Replace the previous host object so that its datacenter and rack are up to date
+  hosts_.erase(host);
   hosts_.insert(host);
 
   TokenHostVec new_tokens;
@@ -639,11 +1096,13 @@ void TokenMapImpl<Partitioner>::update_host_and_build(const Host::Ptr& host) {
              TokenHostCompare());
   tokens_ = merged;
 
-  build_replicas();
-  LOG_DEBUG("Updated token map with host %s (%u tokens). Rebuilt token map with %u hosts and %u "
-            "tokens in %f ms",
+  size_t num_rebuilt = mark_inserted_tokens(host, &changes)
+                           ? build_replicas(&changes, &old_datacenters)
+                           : build_replicas();
+  LOG_DEBUG("Updated token map with host %s (%u tokens). Rebuilt %u token replicas for token map "
+            "with %u hosts and %u tokens in %f ms",
             host->address_string().c_str(), (unsigned int)new_tokens.size(),
-            (unsigned int)hosts_.size(), (unsigned int)tokens_.size(),
+            (unsigned int)num_rebuilt, (unsigned int)hosts_.size(), (unsigned int)tokens_.size(),
             (double)(uv_hrtime() - start) / (1000.0 * 1000.0));
 }
 
@@ -651,13 +1110,21 @@ template <class Partitioner>
 void TokenMapImpl<Partitioner>::remove_host_and_build(const Host::Ptr& host) {
   if (hosts_.find(host) == hosts_.end()) return;
   uint64_t start = uv_hrtime();
+  DatacenterMap old_datacenters(datacenters_);
+  TokenRingChanges changes;
+  mark_removed_tokens(host, &changes);
   remove_host_tokens(host);
   hosts_.erase(host);
-  build_replicas();
-  LOG_DEBUG(
-      "Removed host %s from token map. Rebuilt token map with %u hosts and %u tokens in %f ms",
-      host->address_string().c_str(), (unsigned int)hosts_.size(), (unsigned int)tokens_.size(),
-      (double)(uv_hrtime() - start) / (1000.0 * 1000.0));
+  host_ids_.erase(host->address());
+
+  size_t num_rebuilt = mark_inserted_tokens(host, &changes)
+                           ? build_replicas(&changes, &old_datacenters)
+                           : build_replicas();
+  LOG_DEBUG("Removed host %s from token map. Rebuilt %u token replicas for token map with %u hosts "
+            "and %u tokens in %f ms",
+            host->address_string().c_str(), (unsigned int)num_rebuilt,
+            (unsigned int)hosts_.size(), (unsigned int)tokens_.size(),
+            (double)(uv_hrtime() - start) / (1000.0 * 1000.0));
 }
 
 template <class Partitioner>
@@ -675,6 +1142,7 @@ void TokenMapImpl<Partitioner>::update_keyspaces_and_build(const VersionNumber&
 template <class Partitioner>
 void TokenMapImpl<Partitioner>::drop_keyspace(const String& keyspace_name) {
   replicas_.erase(keyspace_name);
+  lazy_replicas_.erase(keyspace_name);
   strategies_.erase(keyspace_name);
 }
 
@@ -698,15 +1166,14 @@ const CopyOnWriteHostVec& TokenMapImpl<Partitioner>::get_replicas(const String&
   typename KeyspaceReplicaMap::const_iterator ks_it = replicas_.find(keyspace_name);
 
   if (ks_it != replicas_.end()) {
-    Token token = Partitioner::hash(routing_key);
-    const TokenReplicasVec& replicas = ks_it->second;
-    typename TokenReplicasVec::const_iterator replicas_it =
-        std::upper_bound(replicas.begin(), replicas.end(), TokenReplicas(token, no_replicas_dummy_),
-                         TokenReplicasCompare());
-    if (replicas_it != replicas.end()) {
-      return replicas_it->second;
-    } else if (!replicas.empty()) {
-      return replicas.front().second;
+    const CopyOnWriteHostVec* replicas = ks_it->second->ring.find(Partitioner::hash(routing_key));
+    if (replicas) return *replicas;
+  } else if (!lazy_replicas_.empty()) {
+    typename KeyspaceLazyReplicaMap::const_iterator lazy_it = lazy_replicas_.find(keyspace_name);
+    if (lazy_it != lazy_replicas_.end()) {
+      const CopyOnWriteHostVec* replicas =
+          lazy_it->second->get(this)->ring.find(Partitioner::hash(routing_key));
+      if (replicas) return *replicas;
     }
   }
 
@@ -739,17 +1206,38 @@ void TokenMapImpl<Partitioner>::update_keyspace(const VersionNumber& cassandra_v
       } else {
         i->second = strategy;
       }
-      if (should_build_replicas) {
+      if (should_build_replicas && is_replicas_needed(keyspace_name)) {
         uint64_t start = uv_hrtime();
-        build_datacenters(hosts_, datacenters_);
-        strategy.build_replicas(tokens_, datacenters_, replicas_[keyspace_name]);
+        build_datacenters(hosts_, host_ids_, datacenters_);
+        // Use the replicas of another keyspace with the same replication strategy if there is
+        // one
+        typename StrategyReplicas::ConstPtr keyspace_replicas(
+            find_replicas(strategy, keyspace_name));
+        if (!keyspace_replicas) {
+          typename StrategyReplicas::Ptr strategy_replicas(new StrategyReplicas());
+          TokenReplicasVec replicas;
+          ReplicaInterner interner;
+          strategy.build_replicas(tokens_, host_ids_, datacenters_, replicas,
+                                  &strategy_replicas->spans, &interner);
+          strategy_replicas->ring.build(replicas);
+          keyspace_replicas = typename StrategyReplicas::ConstPtr(strategy_replicas);
+        }
+        replicas_[keyspace_name] = keyspace_replicas;
         LOG_DEBUG("Updated token map with keyspace '%s'. Rebuilt token map with %u hosts and %u "
                   "tokens in %f ms",
                   keyspace_name.c_str(), (unsigned int)hosts_.size(), (unsigned int)tokens_.size(),
                   (double)(uv_hrtime() - start) / (1000.0 * 1000.0));
+      } else {
+        // The existing replicas are out of date, they're rebuilt by the next build (or the
+        // next time they're used)
+        replicas_.erase(keyspace_name);
       }
     }
   }
+
+  if (should_build_replicas) {
+    reset_lazy_replicas();
+  }
 }
 
 template <class Partitioner>
@@ -761,19 +1249,191 @@ void TokenMapImpl<Partitioner>::remove_host_tokens(const Host::Ptr& host) {
 
 template <class Partitioner>
 void TokenMapImpl<Partitioner>::update_host_ids(const Host::Ptr& host) {
-  host->set_rack_and_dc_ids(rack_ids_.get(host->rack()), dc_ids_.get(host->dc()));
+  host_ids_[host->address()] = HostIds(rack_ids_.get(host->rack()), dc_ids_.get(host->dc()));
 }
 
 template <class Partitioner>
-void TokenMapImpl<Partitioner>::build_replicas() {
-  build_datacenters(hosts_, datacenters_);
+size_t TokenMapImpl<Partitioner>::build_replicas(const TokenRingChanges* changes,
+                                                 const DatacenterMap* old_datacenters) {
+  build_datacenters(hosts_, host_ids_, datacenters_);
+
+  // Keyspaces with the same replication strategy share the same replicas so
+  // they're only built once for each distinct strategy. There are usually
+  // only a few distinct strategies so a linear search is used.
+  Vector<StrategyReplicasTask> tasks;
   for (typename KeyspaceStrategyMap::const_iterator i = strategies_.begin(),
                                                     end = strategies_.end();
        i != end; ++i) {
-    const String& keyspace_name = i->first;
+    if (!is_replicas_needed(i->first)) continue;
     const ReplicationStrategy<Partitioner>& strategy = i->second;
-    strategy.build_replicas(tokens_, datacenters_, replicas_[keyspace_name]);
+    size_t index = 0;
+    while (index < tasks.size() && !(*tasks[index].strategy() == strategy)) {
+      ++index;
+    }
+    if (index == tasks.size()) {
+      typename StrategyReplicas::ConstPtr old_replicas;
+      if (changes) {
+        typename KeyspaceReplicaMap::const_iterator j = replicas_.find(i->first);
+        if (j != replicas_.end()) {
+          old_replicas = j->second;
+        }
+      }
+      tasks.push_back(
+          StrategyReplicasTask(this, &strategy, changes, old_datacenters, old_replicas));
+    }
+  }
+
+  if (build_pool_) {
+    ParallelTaskVec parallel_tasks;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      parallel_tasks.push_back(&tasks[i]);
+    }
+    build_pool_->run(parallel_tasks);
+  } else {
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      tasks[i].run();
+    }
+  }
+
+  size_t num_rebuilt = 0;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    num_rebuilt += tasks[i].num_rebuilt();
+  }
+  num_rebuilt_ = num_rebuilt;
+
+  // Keyspaces that don't need their replicas built still use the replicas of
+  // another keyspace with the same replication strategy because they're free.
+  for (typename KeyspaceStrategyMap::const_iterator i = strategies_.begin(),
+                                                    end = strategies_.end();
+       i != end; ++i) {
+    size_t index = 0;
+    while (index < tasks.size() && !(*tasks[index].strategy() == i->second)) {
+      ++index;
+    }
+    if (index < tasks.size()) {
+      replicas_[i->first] = tasks[index].replicas();
+    } else {
+      replicas_.erase(i->first);
+    }
+  }
+
+  reset_lazy_replicas();
+
+  return num_rebuilt;
+}
+
+template <class Partitioner>
+void TokenMapImpl<Partitioner>::StrategyReplicasTask::run() {
+  typename StrategyReplicas::Ptr replicas(new StrategyReplicas());
+  TokenReplicasVec entries;
+  ReplicaInterner interner;
+  if (changes_ && old_replicas_) {
+    TokenReplicasVec old_entries;
+    old_replicas_->ring.get_entries(&old_entries);
+    num_rebuilt_ = strategy_->update_replicas(
+        token_map_->tokens_, token_map_->host_ids_, token_map_->datacenters_, *old_datacenters_,
+        *changes_, old_entries, old_replicas_->spans, entries, &replicas->spans, &interner);
+  } else {
+    strategy_->build_replicas(token_map_->tokens_, token_map_->host_ids_,
+                              token_map_->datacenters_, entries, &replicas->spans, &interner);
+    num_rebuilt_ = entries.size();
+  }
+  replicas->ring.build(entries);
+  replicas_ = typename StrategyReplicas::ConstPtr(replicas);
+}
+
+template <class Partitioner>
+typename TokenMapImpl<Partitioner>::StrategyReplicas::ConstPtr
+TokenMapImpl<Partitioner>::find_replicas(const ReplicationStrategy<Partitioner>& strategy,
+                                         const String& excluded_keyspace_name) const {
+  for (typename KeyspaceStrategyMap::const_iterator i = strategies_.begin(),
+                                                    end = strategies_.end();
+       i != end; ++i) {
+    if (i->first != excluded_keyspace_name && i->second == strategy) {
+      typename KeyspaceReplicaMap::const_iterator j = replicas_.find(i->first);
+      if (j != replicas_.end()) {
+        return j->second;
+      }
+    }
+  }
+  return typename StrategyReplicas::ConstPtr();
+}
+
+template <class Partitioner>
+const typename TokenMapImpl<Partitioner>::StrategyReplicas*
+TokenMapImpl<Partitioner>::LazyReplicas::get(const TokenMapImpl* token_map) {
+  const StrategyReplicas* built = replicas.load(MEMORY_ORDER_ACQUIRE);
+  if (built) return built;
+
+  ScopedMutex l(&mutex);
+  built = replicas.load(MEMORY_ORDER_ACQUIRE);
+  if (!built) {
+    uint64_t start = uv_hrtime();
+    StrategyReplicasTask task(token_map, &strategy, NULL, NULL,
+                              typename StrategyReplicas::ConstPtr());
+    task.run();
+    built = task.replicas().get();
+    built->inc_ref();
+    replicas.store(built, MEMORY_ORDER_RELEASE);
+    LOG_DEBUG("Built replicas on first use for token map with %u hosts and %u tokens in %f ms",
+              (unsigned int)token_map->hosts_.size(), (unsigned int)token_map->tokens_.size(),
+              (double)(uv_hrtime() - start) / (1000.0 * 1000.0));
+  }
+  return built;
+}
+
+template <class Partitioner>
+bool TokenMapImpl<Partitioner>::is_replicas_needed(const String& keyspace_name) const {
+  // Replicas that have already been built (because they were used) are kept
+  // up to date
+  if (replicas_.find(keyspace_name) != replicas_.end()) return true;
+  if (replica_keyspaces_.empty()) return !is_lazy_replicas_;
+  return std::binary_search(replica_keyspaces_.begin(), replica_keyspaces_.end(), keyspace_name);
+}
+
+template <class Partitioner>
+void TokenMapImpl<Partitioner>::reset_lazy_replicas() {
+  lazy_replicas_.clear();
+  if (!is_lazy_replicas_) return;
+
+  // There are usually only a few distinct strategies so a linear search is
+  // used to share the lazy replicas between keyspaces.
+  Vector<typename LazyReplicas::Ptr> distinct;
+  for (typename KeyspaceStrategyMap::const_iterator i = strategies_.begin(),
+                                                    end = strategies_.end();
+       i != end; ++i) {
+    if (replicas_.find(i->first) != replicas_.end()) continue;
+    size_t index = 0;
+    while (index < distinct.size() && !(distinct[index]->strategy == i->second)) {
+      ++index;
+    }
+    if (index == distinct.size()) {
+      distinct.push_back(typename LazyReplicas::Ptr(new LazyReplicas(i->second)));
+    }
+    lazy_replicas_[i->first] = distinct[index];
+  }
+}
+
+template <class Partitioner>
+void TokenMapImpl<Partitioner>::mark_removed_tokens(const Host::Ptr& host,
+                                                    TokenRingChanges* changes) const {
+  RemoveTokenHostIf is_removed(host);
+  Vector<bool> removed(tokens_.size(), false);
+  for (size_t i = 0, size = tokens_.size(); i < size; ++i) {
+    removed[i] = is_removed(tokens_[i]);
+  }
+  changes->set_removed(removed);
+}
+
+template <class Partitioner>
+bool TokenMapImpl<Partitioner>::mark_inserted_tokens(const Host::Ptr& host,
+                                                     TokenRingChanges* changes) const {
+  // The tokens of other hosts were kept so only the host's tokens are new
+  Vector<bool> inserted(tokens_.size(), false);
+  for (size_t i = 0, size = tokens_.size(); i < size; ++i) {
+    inserted[i] = tokens_[i].second == host.get();
   }
+  return changes->set_inserted(inserted);
 }
 
 }}} // namespace datastax::internal::core
@@ -0,0 +1,184 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "token_map_updater.hpp"
+
+#include "logger.hpp"
+
+using namespace datastax;
+using namespace datastax::internal::core;
+
+TokenMapUpdater::TokenMapUpdater(uv_loop_t* loop, size_t num_build_threads,
+                                 const Callback& callback)
+    : loop_(loop)
+    , callback_(callback)
+    , build_pool_(num_build_threads > 1 ? new ParallelTaskPool(num_build_threads) : NULL)
+    , is_running_(false)
+    , is_rebuilding_(false)
+    , is_closed_(false)
+    , generation_(0)
+    , running_generation_(0) {
+  request_.data = this;
+}
+
+void TokenMapUpdater::reset(const TokenMap::Ptr& token_map) {
+  token_map_ = token_map;
+  operations_.clear();
+  is_rebuilding_ = false;
+  ++generation_; // Drop the result of a running update
+}
+
+void TokenMapUpdater::rebuild(const TokenMap::Ptr& token_map) {
+  // The new token map replaces the current token map so there's no reason to
+  // apply the pending updates.
+  operations_.clear();
+  is_rebuilding_ = true;
+  Operation operation(Operation::REBUILD);
+  operation.token_map = token_map;
+  add_operation(operation);
+}
+
+void TokenMapUpdater::update_host(const Host::Ptr& host) {
+  if (!has_token_map()) return;
+  Operation operation(Operation::UPDATE_HOST);
+  operation.host = host;
+  add_operation(operation);
+}
+
+void TokenMapUpdater::remove_host(const Host::Ptr& host) {
+  if (!has_token_map()) return;
+  Operation operation(Operation::REMOVE_HOST);
+  operation.host = host;
+  add_operation(operation);
+}
+
+void TokenMapUpdater::update_keyspaces(const VersionNumber& cassandra_version,
+                                       const ResultResponse::Ptr& result) {
+  if (!has_token_map()) return;
+  Operation operation(Operation::UPDATE_KEYSPACES);
+  operation.cassandra_version = cassandra_version;
+  operation.result = result;
+  add_operation(operation);
+}
+
+void TokenMapUpdater::drop_keyspace(const String& keyspace_name) {
+  if (!has_token_map()) return;
+  Operation operation(Operation::DROP_KEYSPACE);
+  operation.keyspace_name = keyspace_name;
+  add_operation(operation);
+}
+
+void TokenMapUpdater::close() {
+  is_closed_ = true;
+  operations_.clear();
+}
+
+bool TokenMapUpdater::has_token_map() const { return token_map_ || is_rebuilding_; }
+
+void TokenMapUpdater::add_operation(const Operation& operation) {
+  if (is_closed_) return;
+  operations_.push_back(operation);
+  maybe_start();
+}
+
+void TokenMapUpdater::maybe_start() {
+  if (is_running_ || is_closed_ || operations_.empty()) return;
+
+  is_running_ = true;
+  base_token_map_ = token_map_;
+  running_operations_.swap(operations_);
+  running_generation_ = generation_;
+
+  inc_ref(); // Keep the updater alive until the update is finished
+  int rc = uv_queue_work(loop_, &request_, on_work, on_after_work);
+  if (rc != 0) {
+    LOG_ERROR("Unable to queue token map update: %s", uv_strerror(rc));
+    // Fallback to updating the token map on the event loop thread
+    handle_work();
+    handle_after_work();
+    dec_ref();
+  }
+}
+
+void TokenMapUpdater::on_work(uv_work_t* request) {
+  TokenMapUpdater* updater = static_cast<TokenMapUpdater*>(request->data);
+  updater->handle_work();
+}
+
+void TokenMapUpdater::on_after_work(uv_work_t* request, int status) {
+  TokenMapUpdater* updater = static_cast<TokenMapUpdater*>(request->data);
+  updater->handle_after_work();
+  updater->dec_ref();
+}
+
+void TokenMapUpdater::handle_work() {
+  TokenMap::Ptr token_map;
+
+  for (OperationVec::const_iterator it = running_operations_.begin(),
+                                    end = running_operations_.end();
+       it != end; ++it) {
+    if (it->type == Operation::REBUILD) {
+      token_map = it->token_map;
+      token_map->build();
+      continue;
+    }
+
+    if (!token_map) {
+      if (!base_token_map_) continue;
+      // Published token maps are never modified so the updates are applied to
+      // a copy.
+      token_map = base_token_map_->copy();
+    }
+
+    switch (it->type) {
+      case Operation::UPDATE_HOST:
+        token_map->update_host_and_build(it->host);
+        break;
+      case Operation::REMOVE_HOST:
+        token_map->remove_host_and_build(it->host);
+        break;
+      case Operation::UPDATE_KEYSPACES:
+        token_map->update_keyspaces_and_build(it->cassandra_version, it->result.get());
+        break;
+      case Operation::DROP_KEYSPACE:
+        token_map->drop_keyspace(it->keyspace_name);
+        break;
+      default:
+        break;
+    }
+  }
+
+  result_ = token_map;
+}
+
+void TokenMapUpdater::handle_after_work() {
+  TokenMap::Ptr result(result_);
+  result_.reset();
+  base_token_map_.reset();
+  running_operations_.clear();
+  is_running_ = false;
+
+  // Only the first pending operation can be a rebuild because a rebuild
+  // discards the operations that come before it.
+  is_rebuilding_ = !operations_.empty() && operations_.front().type == Operation::REBUILD;
+
+  if (!is_closed_ && result && running_generation_ == generation_) {
+    token_map_ = result;
+    callback_(this);
+  }
+
+  maybe_start();
+}
@@ -0,0 +1,155 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_TOKEN_MAP_UPDATER_HPP
+#define DATASTAX_INTERNAL_TOKEN_MAP_UPDATER_HPP
+
+#include "callback.hpp"
+#include "host.hpp"
+#include "parallel_task_pool.hpp"
+#include "ref_counted.hpp"
+#include "result_response.hpp"
+#include "string.hpp"
+#include "token_map.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Applies token map updates on a libuv worker thread so that building the
+ * replicas doesn't block the event loop. Updates are applied, in order, to a
+ * copy of the most recently built token map. The current token map continues
+ * to be used until the updated token map is published using the callback (on
+ * the event loop thread). Only a single update runs at a time; updates that
+ * arrive while an update is running are batched into the next update.
+ */
+class TokenMapUpdater : public RefCounted<TokenMapUpdater> {
+public:
+  typedef internal::Callback<void, const TokenMapUpdater*> Callback;
+
+  typedef SharedRefPtr<TokenMapUpdater> Ptr;
+
+  /**
+   * Constructor.
+   *
+   * @param loop The event loop used to queue updates and publish the results.
+   * @param num_build_threads The number of threads used to build the
+   * replicas. The extra threads are kept for the lifetime of the updater
+   * instead of being created for every update.
+   * @param callback A callback that's called on the event loop thread when an
+   * updated token map is available.
+   */
+  TokenMapUpdater(uv_loop_t* loop, size_t num_build_threads, const Callback& callback);
+
+  /**
+   * The most recently built token map.
+   */
+  const TokenMap::Ptr& token_map() const { return token_map_; }
+
+  /**
+   * The threads used to build the replicas or null if they're built by a
+   * single thread. It should be set on the token maps that are updated.
+   */
+  const ParallelTaskPool::Ptr& build_pool() const { return build_pool_; }
+
+  /**
+   * Replace the current token map (which must already be built) and discard
+   * any pending or running updates. The callback is not called.
+   *
+   * @param token_map The new token map or null if token maps are disabled.
+   */
+  void reset(const TokenMap::Ptr& token_map);
+
+  /**
+   * Build a new token map replacing the current token map and any updates
+   * that haven't been applied yet.
+   *
+   * @param token_map A populated, but not yet built, token map.
+   */
+  void rebuild(const TokenMap::Ptr& token_map);
+
+  void update_host(const Host::Ptr& host);
+  void remove_host(const Host::Ptr& host);
+  void update_keyspaces(const VersionNumber& cassandra_version, const ResultResponse::Ptr& result);
+  void drop_keyspace(const String& keyspace_name);
+
+  /**
+   * Discard any pending updates and stop publishing results. A running update
+   * is allowed to finish, but its result is dropped.
+   */
+  void close();
+
+  /**
+   * Determines if there are updates that haven't been published yet.
+   */
+  bool is_updating() const { return is_running_ || !operations_.empty(); }
+
+private:
+  struct Operation {
+    enum Type { REBUILD, UPDATE_HOST, REMOVE_HOST, UPDATE_KEYSPACES, DROP_KEYSPACE };
+
+    Operation(Type type)
+        : type(type) {}
+
+    Type type;
+    TokenMap::Ptr token_map;
+    Host::Ptr host;
+    VersionNumber cassandra_version;
+    ResultResponse::Ptr result;
+    String keyspace_name;
+  };
+
+  typedef Vector<Operation> OperationVec;
+
+private:
+  bool has_token_map() const;
+  void add_operation(const Operation& operation);
+  void maybe_start();
+
+  static void on_work(uv_work_t* request);
+  static void on_after_work(uv_work_t* request, int status);
+
+  void handle_work();
+  void handle_after_work();
+
+private:
+  uv_loop_t* const loop_;
+  uv_work_t request_;
+  Callback callback_;
+  ParallelTaskPool::Ptr build_pool_;
+  TokenMap::Ptr token_map_;
+  OperationVec operations_;
+  bool is_running_;
+  bool is_rebuilding_;
+  bool is_closed_;
+  unsigned generation_;
+
+  // The state of the running update. It's set on the event loop thread before
+  // the update is queued and isn't touched again until the update completes.
+  TokenMap::Ptr base_token_map_;
+  OperationVec running_operations_;
+  TokenMap::Ptr result_;
+  unsigned running_generation_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(TokenMapUpdater);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -0,0 +1,149 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_TOKEN_RING_HPP
+#define DATASTAX_INTERNAL_TOKEN_RING_HPP
+
+#include "vector.hpp"
+
+#include <stddef.h>
+#include <utility>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TOKEN_RING_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define TOKEN_RING_PREFETCH(addr)
+#endif
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A ring of sorted tokens, each with an associated value. It's used to find
+ * the value of the first token that's greater than a given token, wrapping
+ * around to the first token of the ring.
+ *
+ * The tokens are stored in a dense array using the Eytzinger (breadth-first)
+ * layout: the children of the element at index k are at 2k and 2k + 1 and
+ * index 0 is unused. The top levels of the implicit search tree share a few
+ * cache lines and the elements searched next are prefetched, which is much
+ * more cache friendly than a binary search over a sorted array of
+ * (token, value) pairs. The values are kept in a parallel array so that they
+ * don't take space in the cache lines used by the search.
+ */
+template <class Token, class Value>
+class TokenRing {
+public:
+  typedef std::pair<Token, Value> Entry;
+  typedef Vector<Entry> EntryVec;
+
+  TokenRing()
+      : first_(0) {}
+
+  /**
+   * Build the ring.
+   *
+   * @param sorted The tokens and their values sorted by token.
+   */
+  void build(const EntryVec& sorted) {
+    size_t size = sorted.size();
+    tokens_.clear();
+    values_.clear();
+    first_ = 0;
+    if (size == 0) return;
+
+    // Index 0 is unused, fill it with the first entry
+    tokens_.resize(size + 1, sorted.front().first);
+    values_.resize(size + 1, sorted.front().second);
+    size_t index = 0;
+    build(sorted, 1, &index);
+
+    first_ = 1;
+    while (2 * first_ <= size) {
+      first_ *= 2;
+    }
+  }
+
+  /**
+   * Find the value of the first token greater than a token.
+   *
+   * @param token The token to search for.
+   * @return The value of the first token greater than the provided token or
+   * the value of the first token of the ring if there isn't one. NULL if the
+   * ring is empty.
+   */
+  const Value* find(const Token& token) const {
+    size_t size = this->size();
+    if (size == 0) return NULL;
+
+    const Token* tokens = &tokens_[0];
+    size_t k = 1;
+    while (k <= size) {
+      TOKEN_RING_PREFETCH(tokens + 16 * k);
+      k = 2 * k + !(token < tokens[k]);
+    }
+
+    // The result is the last element where the search went left. Remove the
+    // right turns (trailing one bits) and the final left turn.
+    while (k & 1) {
+      k >>= 1;
+    }
+    k >>= 1;
+
+    return k == 0 ? &values_[first_] : &values_[k];
+  }
+
+  /**
+   * Get the tokens and values sorted by token.
+   *
+   * @param sorted The resulting tokens and values.
+   */
+  void get_entries(EntryVec* sorted) const {
+    sorted->clear();
+    sorted->reserve(size());
+    get_entries(1, sorted);
+  }
+
+  size_t size() const { return tokens_.empty() ? 0 : tokens_.size() - 1; }
+  bool empty() const { return tokens_.empty(); }
+
+private:
+  void build(const EntryVec& sorted, size_t k, size_t* index) {
+    if (k < tokens_.size()) {
+      build(sorted, 2 * k, index);
+      tokens_[k] = sorted[*index].first;
+      values_[k] = sorted[*index].second;
+      ++*index;
+      build(sorted, 2 * k + 1, index);
+    }
+  }
+
+  void get_entries(size_t k, EntryVec* sorted) const {
+    if (k < tokens_.size()) {
+      get_entries(2 * k, sorted);
+      sorted->push_back(Entry(tokens_[k], values_[k]));
+      get_entries(2 * k + 1, sorted);
+    }
+  }
+
+private:
+  Vector<Token> tokens_;
+  Vector<Value> values_;
+  size_t first_;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif